@@ -0,0 +1,62 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaBenchmarkRunner.h"
+
+#include "XsollaMockServer.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXsollaBenchmarkTest, "Xsolla.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FXsollaBenchmarkTest::RunTest(const FString& Parameters)
+{
+	int32 Iterations = FXsollaBenchmarkRunner::DefaultIterations;
+	int32 PayloadSize = FXsollaBenchmarkRunner::DefaultPayloadSize;
+	int32 ImageSize = FXsollaBenchmarkRunner::DefaultImageSize;
+	FParse::Value(FCommandLine::Get(), TEXT("XsollaBenchmarkIterations="), Iterations);
+	FParse::Value(FCommandLine::Get(), TEXT("XsollaBenchmarkPayloadSize="), PayloadSize);
+	FParse::Value(FCommandLine::Get(), TEXT("XsollaBenchmarkImageSize="), ImageSize);
+
+	// Requests go to local mock server, so results don't depend on network
+	FXsollaMockServerModule& MockServer = FXsollaMockServerModule::Get();
+	const bool bStartedServer = !MockServer.IsServerRunning();
+	if (bStartedServer && !TestTrue(TEXT("Mock server is started"), MockServer.StartServer(FXsollaMockServerModule::DefaultPort)))
+	{
+		return false;
+	}
+
+	TSharedRef<FXsollaBenchmarkRunner> Runner = MakeShared<FXsollaBenchmarkRunner>(Iterations, PayloadSize, ImageSize);
+	Runner->Start();
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Runner, bStartedServer]() {
+		if (!Runner->Tick())
+		{
+			return false;
+		}
+
+		for (const FString& Error : Runner->GetErrors())
+		{
+			AddError(Error);
+		}
+
+		const FString BaseFilename = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("XsollaBenchmark"), FString::Printf(TEXT("Benchmark-%s"), *FDateTime::Now().ToString()));
+		TestTrue(TEXT("Results are saved"), Runner->SaveResults(BaseFilename));
+
+		if (bStartedServer)
+		{
+			FXsollaMockServerModule::Get().StopServer();
+		}
+
+		return true;
+	}));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,19 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaBenchmark.h"
+
+#include "XsollaBenchmarkDefines.h"
+
+void FXsollaBenchmarkModule::StartupModule()
+{
+	UE_LOG(LogXsollaBenchmark, Log, TEXT("%s: XsollaBenchmark module started"), *VA_FUNC_LINE);
+}
+
+void FXsollaBenchmarkModule::ShutdownModule()
+{
+}
+
+IMPLEMENT_MODULE(FXsollaBenchmarkModule, XsollaBenchmark)
+
+DEFINE_LOG_CATEGORY(LogXsollaBenchmark);
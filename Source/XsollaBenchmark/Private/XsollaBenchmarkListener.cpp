@@ -0,0 +1,53 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaBenchmarkListener.h"
+
+#include "XsollaBenchmarkRunner.h"
+
+UXsollaBenchmarkListener::UXsollaBenchmarkListener()
+	: Runner(nullptr)
+	, OrderId(0)
+{
+}
+
+void UXsollaBenchmarkListener::OnRequestSuccess()
+{
+	if (Runner)
+	{
+		Runner->CompleteRequest(true);
+	}
+}
+
+void UXsollaBenchmarkListener::OnFetchTokenSuccess(const FString& AccessToken, int32 InOrderId)
+{
+	OrderId = InOrderId;
+	OnRequestSuccess();
+}
+
+void UXsollaBenchmarkListener::OnCheckOrder(int32 InOrderId, EXsollaOrderStatus OrderStatus)
+{
+	OnRequestSuccess();
+}
+
+void UXsollaBenchmarkListener::OnAuthUpdate(const FXsollaLoginData& LoginData)
+{
+	AuthToken = LoginData.AuthToken.JWT;
+	OnRequestSuccess();
+}
+
+void UXsollaBenchmarkListener::OnStoreError(int32 StatusCode, int32 ErrorCode, const FString& ErrorMessage)
+{
+	if (Runner)
+	{
+		Runner->CompleteRequest(false, FString::Printf(TEXT("%d %d %s"), StatusCode, ErrorCode, *ErrorMessage));
+	}
+}
+
+void UXsollaBenchmarkListener::OnAuthError(const FString& Code, const FString& Description)
+{
+	if (Runner)
+	{
+		Runner->CompleteRequest(false, FString::Printf(TEXT("%s %s"), *Code, *Description));
+	}
+}
@@ -0,0 +1,51 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "XsollaLoginTypes.h"
+#include "XsollaStoreSubsystem.h"
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+
+#include "XsollaBenchmarkListener.generated.h"
+
+class FXsollaBenchmarkRunner;
+
+/** Receives SDK callbacks of benchmark requests and passes completion to runner */
+UCLASS()
+class UXsollaBenchmarkListener : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UXsollaBenchmarkListener();
+
+	UFUNCTION()
+	void OnRequestSuccess();
+
+	UFUNCTION()
+	void OnFetchTokenSuccess(const FString& AccessToken, int32 InOrderId);
+
+	UFUNCTION()
+	void OnCheckOrder(int32 InOrderId, EXsollaOrderStatus OrderStatus);
+
+	UFUNCTION()
+	void OnAuthUpdate(const FXsollaLoginData& LoginData);
+
+	UFUNCTION()
+	void OnStoreError(int32 StatusCode, int32 ErrorCode, const FString& ErrorMessage);
+
+	UFUNCTION()
+	void OnAuthError(const FString& Code, const FString& Description);
+
+	/** Runner waiting for callbacks */
+	FXsollaBenchmarkRunner* Runner;
+
+	/** Token received by last authentication */
+	FString AuthToken;
+
+	/** Order created by last payment token request */
+	int32 OrderId;
+};
@@ -0,0 +1,791 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaBenchmarkRunner.h"
+
+#include "XsollaBenchmarkDefines.h"
+#include "XsollaBenchmarkListener.h"
+#include "XsollaLoginSubsystem.h"
+#include "XsollaLoginTypes.h"
+#include "XsollaStoreDataModel.h"
+#include "XsollaStoreImageLoader.h"
+#include "XsollaStoreSubsystem.h"
+#include "XsollaUtilsMemory.h"
+#include "XsollaUtilsTokenParser.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "JsonObjectConverter.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/StructOnScope.h"
+
+namespace XsollaBenchmarkRunner
+{
+	/** Number of item groups in synthetic catalog */
+	static const int32 GroupCount = 8;
+
+	/** Payload bytes as they come from http response */
+	TArray<uint8> ToUtf8(const FString& Payload)
+	{
+		FTCHARToUTF8 Converter(*Payload);
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+	}
+
+	/** Same conversion as IHttpResponse::GetContentAsString() */
+	FString FromUtf8(const TArray<uint8>& Content)
+	{
+		FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Content.GetData()), Content.Num());
+		return FString(Converter.Length(), Converter.Get());
+	}
+
+	/** Nearest-rank percentile of sorted timings */
+	double GetPercentile(const TArray<double>& SortedTimings, double Percentile)
+	{
+		const int32 Rank = FMath::CeilToInt(Percentile * SortedTimings.Num()) - 1;
+		return SortedTimings[FMath::Clamp(Rank, 0, SortedTimings.Num() - 1)];
+	}
+
+	FString EncodeBase64Url(const FString& Source)
+	{
+		return FBase64::Encode(Source).Replace(TEXT("+"), TEXT("-")).Replace(TEXT("/"), TEXT("_")).Replace(TEXT("="), TEXT(""));
+	}
+
+	FString MakePriceJson(int32 Index)
+	{
+		const FString Amount = FString::Printf(TEXT("%d.99"), Index % 100);
+		return FString::Printf(TEXT("{\"amount\":\"%s\",\"amount_without_discount\":\"%s\",\"currency\":\"USD\"}"), *Amount, *Amount);
+	}
+
+	FString MakeGroupJson(int32 GroupIndex)
+	{
+		return FString::Printf(TEXT("{\"external_id\":\"group_%d\",\"name\":\"Group %d\"}"), GroupIndex, GroupIndex);
+	}
+
+	FString MakeVirtualCurrencyJson(int32 Index)
+	{
+		return FString::Printf(TEXT("{\"sku\":\"currency_%d\",\"name\":\"Currency %d\",\"description\":\"\",\"image_url\":\"\",\"attributes\":[],\"is_free\":false,\"order\":%d,\"groups\":[],\"price\":%s}"),
+			Index, Index, Index, *MakePriceJson(Index));
+	}
+
+	FString MakeVirtualCurrencyPackageJson(int32 Index)
+	{
+		return FString::Printf(TEXT("{\"sku\":\"package_%d\",\"name\":\"Package %d\",\"description\":\"\",\"image_url\":\"\",\"is_free\":false,\"order\":%d,\"groups\":[],\"price\":%s,")
+							   TEXT("\"content\":{\"sku\":\"crystal\",\"name\":\"Crystals\",\"description\":\"\",\"image_url\":\"\",\"quantity\":%d}}"),
+			Index, Index, Index, *MakePriceJson(Index), 100 * (1 + Index));
+	}
+
+	FString MakeItemsJson(int32 Count, TFunctionRef<FString(int32)> MakeItem)
+	{
+		TArray<FString> Items;
+		Items.Reserve(Count);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Items.Add(MakeItem(Index));
+		}
+
+		return FString::Printf(TEXT("{\"items\":[%s]}"), *FString::Join(Items, TEXT(",")));
+	}
+} // namespace XsollaBenchmarkRunner
+
+const int32 FXsollaBenchmarkRunner::DefaultIterations = 100;
+const int32 FXsollaBenchmarkRunner::DefaultPayloadSize = 500;
+const int32 FXsollaBenchmarkRunner::DefaultImageSize = 256;
+const int32 FXsollaBenchmarkRunner::CatalogMemoryItemCount = 10000;
+const double FXsollaBenchmarkRunner::RequestTimeout = 10.;
+
+FXsollaBenchmarkRunner::FXsollaBenchmarkRunner(int32 InIterations, int32 InPayloadSize, int32 InImageSize)
+	: Iterations(FMath::Max(1, InIterations))
+	, PayloadSize(FMath::Max(1, InPayloadSize))
+	, ImageSize(FMath::Max(1, InImageSize))
+	, RequestCaseIndex(0)
+	, RequestRun(0)
+	, RequestStartTime(0.)
+	, bRequestInFlight(false)
+	, bRequestCaseFailed(false)
+{
+	StoreSubsystem = NewObject<UXsollaStoreSubsystem>(GetTransientPackage());
+	StoreSubsystem->AddToRoot();
+	StoreSubsystem->Initialize(TEXT("benchmark"));
+
+	LoginSubsystem = NewObject<UXsollaLoginSubsystem>(GetTransientPackage());
+	LoginSubsystem->AddToRoot();
+	LoginSubsystem->Initialize(TEXT("benchmark"), TEXT("benchmark"));
+
+	Listener = NewObject<UXsollaBenchmarkListener>(GetTransientPackage());
+	Listener->AddToRoot();
+	Listener->Runner = this;
+}
+
+FXsollaBenchmarkRunner::~FXsollaBenchmarkRunner()
+{
+	Listener->Runner = nullptr;
+	Listener->RemoveFromRoot();
+	LoginSubsystem->RemoveFromRoot();
+	StoreSubsystem->RemoveFromRoot();
+}
+
+void FXsollaBenchmarkRunner::Start()
+{
+	UE_LOG(LogXsollaBenchmark, Log, TEXT("%s: Running benchmarks: %d iterations, payload size %d, image size %d"), *VA_FUNC_LINE, Iterations, PayloadSize, ImageSize);
+
+	Results.Empty();
+	MemoryResults.Empty();
+	Errors.Empty();
+
+	RunJsonConversions();
+	RunTokenParsing();
+	RunImageDecoding();
+
+	AddRequestCases();
+}
+
+bool FXsollaBenchmarkRunner::Tick()
+{
+	if (bRequestInFlight)
+	{
+		if (FPlatformTime::Seconds() - RequestStartTime < RequestTimeout)
+		{
+			return false;
+		}
+
+		CompleteRequest(false, TEXT("Request timed out"));
+	}
+
+	while (RequestCases.IsValidIndex(RequestCaseIndex))
+	{
+		const FRequestCase& RequestCase = RequestCases[RequestCaseIndex];
+
+		// Warm-up run goes first, so connection setup doesn't get into results
+		const int32 RunCount = RequestCase.Name.IsEmpty() ? 1 : Iterations + 1;
+		if (!bRequestCaseFailed && RequestRun < RunCount)
+		{
+			bRequestInFlight = true;
+			RequestStartTime = FPlatformTime::Seconds();
+			RequestCase.Send();
+			return false;
+		}
+
+		if (!bRequestCaseFailed)
+		{
+			if (!RequestCase.Name.IsEmpty())
+			{
+				AddResult(RequestCase.Name, RequestCase.EntryCount, 0, RequestTimings);
+			}
+
+			if (RequestCase.OnFinished)
+			{
+				RequestCase.OnFinished();
+			}
+		}
+
+		RequestCaseIndex++;
+		RequestRun = 0;
+		RequestTimings.Reset();
+		bRequestCaseFailed = false;
+	}
+
+	for (const FXsollaBenchmarkResult& Result : Results)
+	{
+		UE_LOG(LogXsollaBenchmark, Log, TEXT("%-40s size %6d  p50 %8.3f ms  p90 %8.3f ms  p99 %8.3f ms  max %8.3f ms"),
+			*Result.Name, Result.PayloadSize, Result.P50, Result.P90, Result.P99, Result.Max);
+	}
+
+	for (const FXsollaBenchmarkMemoryResult& MemoryResult : MemoryResults)
+	{
+		UE_LOG(LogXsollaBenchmark, Log, TEXT("%-40s size %6d  %10lld bytes"), *MemoryResult.Name, MemoryResult.PayloadSize, MemoryResult.Bytes);
+	}
+
+	return true;
+}
+
+void FXsollaBenchmarkRunner::CompleteRequest(bool bSucceeded, const FString& ErrorMessage)
+{
+	// Callback of timed out request
+	if (!bRequestInFlight)
+	{
+		return;
+	}
+
+	bRequestInFlight = false;
+
+	if (!bSucceeded)
+	{
+		const FString& CaseName = RequestCases[RequestCaseIndex].Name;
+		Errors.Add(FString::Printf(TEXT("%s: %s"), CaseName.IsEmpty() ? TEXT("Catalog request") : *CaseName, *ErrorMessage));
+		UE_LOG(LogXsollaBenchmark, Error, TEXT("%s: %s"), *VA_FUNC_LINE, *Errors.Last());
+
+		bRequestCaseFailed = true;
+		return;
+	}
+
+	if (RequestRun > 0)
+	{
+		RequestTimings.Add((FPlatformTime::Seconds() - RequestStartTime) * 1000.);
+	}
+
+	RequestRun++;
+}
+
+const TArray<FXsollaBenchmarkResult>& FXsollaBenchmarkRunner::GetResults() const
+{
+	return Results;
+}
+
+const TArray<FXsollaBenchmarkMemoryResult>& FXsollaBenchmarkRunner::GetMemoryResults() const
+{
+	return MemoryResults;
+}
+
+const TArray<FString>& FXsollaBenchmarkRunner::GetErrors() const
+{
+	return Errors;
+}
+
+bool FXsollaBenchmarkRunner::SaveResults(const FString& BaseFilename) const
+{
+	TSharedRef<FJsonObject> ReportJson = MakeShared<FJsonObject>();
+	ReportJson->SetNumberField(TEXT("iterations"), Iterations);
+	ReportJson->SetNumberField(TEXT("payload_size"), PayloadSize);
+	ReportJson->SetNumberField(TEXT("image_size"), ImageSize);
+
+	TArray<TSharedPtr<FJsonValue>> ResultsJson;
+	FString CsvStr = TEXT("name,payload_size,payload_bytes,iterations,min_ms,mean_ms,p50_ms,p90_ms,p99_ms,max_ms\n");
+	for (const FXsollaBenchmarkResult& Result : Results)
+	{
+		TSharedRef<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+		ResultJson->SetStringField(TEXT("name"), Result.Name);
+		ResultJson->SetNumberField(TEXT("payload_size"), Result.PayloadSize);
+		ResultJson->SetNumberField(TEXT("payload_bytes"), Result.PayloadBytes);
+		ResultJson->SetNumberField(TEXT("iterations"), Result.Iterations);
+		ResultJson->SetNumberField(TEXT("min_ms"), Result.Min);
+		ResultJson->SetNumberField(TEXT("mean_ms"), Result.Mean);
+		ResultJson->SetNumberField(TEXT("p50_ms"), Result.P50);
+		ResultJson->SetNumberField(TEXT("p90_ms"), Result.P90);
+		ResultJson->SetNumberField(TEXT("p99_ms"), Result.P99);
+		ResultJson->SetNumberField(TEXT("max_ms"), Result.Max);
+		ResultsJson.Add(MakeShared<FJsonValueObject>(ResultJson));
+
+		CsvStr += FString::Printf(TEXT("%s,%d,%d,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n"),
+			*Result.Name, Result.PayloadSize, Result.PayloadBytes, Result.Iterations, Result.Min, Result.Mean, Result.P50, Result.P90, Result.P99, Result.Max);
+	}
+	ReportJson->SetArrayField(TEXT("results"), ResultsJson);
+
+	TArray<TSharedPtr<FJsonValue>> MemoryResultsJson;
+	for (const FXsollaBenchmarkMemoryResult& MemoryResult : MemoryResults)
+	{
+		TSharedRef<FJsonObject> MemoryResultJson = MakeShared<FJsonObject>();
+		MemoryResultJson->SetStringField(TEXT("name"), MemoryResult.Name);
+		MemoryResultJson->SetNumberField(TEXT("payload_size"), MemoryResult.PayloadSize);
+		MemoryResultJson->SetNumberField(TEXT("bytes"), MemoryResult.Bytes);
+		MemoryResultsJson.Add(MakeShared<FJsonValueObject>(MemoryResultJson));
+	}
+	ReportJson->SetArrayField(TEXT("memory"), MemoryResultsJson);
+
+	FString JsonStr;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonStr);
+	FJsonSerializer::Serialize(ReportJson, Writer);
+
+	const FString JsonFilename = BaseFilename + TEXT(".json");
+	const FString CsvFilename = BaseFilename + TEXT(".csv");
+	if (!FFileHelper::SaveStringToFile(JsonStr, *JsonFilename) || !FFileHelper::SaveStringToFile(CsvStr, *CsvFilename))
+	{
+		UE_LOG(LogXsollaBenchmark, Error, TEXT("%s: Can't write benchmark results: %s"), *VA_FUNC_LINE, *BaseFilename);
+		return false;
+	}
+
+	UE_LOG(LogXsollaBenchmark, Log, TEXT("%s: Benchmark results saved: %s"), *VA_FUNC_LINE, *JsonFilename);
+	return true;
+}
+
+void FXsollaBenchmarkRunner::RunJsonConversions()
+{
+	using namespace XsollaBenchmarkRunner;
+
+	MeasureJsonConversion(TEXT("Json.UpdateVirtualItems"), MakeStoreItemsPayload(PayloadSize), FStoreItemsData::StaticStruct());
+	MeasureJsonConversion(TEXT("Json.UpdateItemGroups"), MakeGroupsPayload(PayloadSize), FStoreItemsData::StaticStruct());
+	MeasureJsonConversion(TEXT("Json.UpdateInventory"), MakeInventoryPayload(PayloadSize), FStoreInventory::StaticStruct());
+	MeasureJsonConversion(TEXT("Json.UpdateVirtualCurrencies"), MakeVirtualCurrenciesPayload(PayloadSize), FVirtualCurrencyData::StaticStruct());
+	MeasureJsonConversion(TEXT("Json.UpdateVirtualCurrencyPackages"), MakeVirtualCurrencyPackagesPayload(PayloadSize), FVirtualCurrencyPackagesData::StaticStruct());
+	MeasureJsonConversion(TEXT("Json.UpdateVirtualCurrencyBalance"), MakeVirtualCurrencyBalancePayload(PayloadSize), FVirtualCurrencyBalanceData::StaticStruct());
+	MeasureJsonConversion(TEXT("Json.UpdateSubscriptions"), MakeSubscriptionsPayload(PayloadSize), FStoreSubscriptionData::StaticStruct());
+	MeasureJsonConversion(TEXT("Json.UpdateCart"), MakeCartPayload(PayloadSize), FStoreCart::StaticStruct());
+
+	// Single entity responses
+	MeasureJsonConversion(TEXT("Json.GetVirtualCurrency"), MakeVirtualCurrencyJson(0), FVirtualCurrency::StaticStruct());
+	Results.Last().PayloadSize = 1;
+	MeasureJsonConversion(TEXT("Json.GetVirtualCurrencyPackage"), MakeVirtualCurrencyPackageJson(0), FVirtualCurrencyPackage::StaticStruct());
+	Results.Last().PayloadSize = 1;
+
+	const TArray<uint8> UserAttributesContent = ToUtf8(MakeUserAttributesPayload(PayloadSize));
+	Measure(TEXT("Json.UpdateUserAttributes"), UserAttributesContent.Num(), [&UserAttributesContent]() {
+		TArray<FXsollaUserAttribute> UserAttributes;
+		FJsonObjectConverter::JsonArrayStringToUStruct(FromUtf8(UserAttributesContent), &UserAttributes, 0, 0);
+	});
+}
+
+void FXsollaBenchmarkRunner::AddRequestCases()
+{
+	RequestCases.Empty();
+	RequestCaseIndex = 0;
+	RequestRun = 0;
+	RequestTimings.Reset();
+	bRequestInFlight = false;
+	bRequestCaseFailed = false;
+
+	FOnStoreUpdate StoreUpdateCallback;
+	StoreUpdateCallback.BindDynamic(Listener, &UXsollaBenchmarkListener::OnRequestSuccess);
+
+	FOnStoreCartUpdate CartUpdateCallback;
+	CartUpdateCallback.BindDynamic(Listener, &UXsollaBenchmarkListener::OnRequestSuccess);
+
+	FOnFetchTokenSuccess FetchTokenCallback;
+	FetchTokenCallback.BindDynamic(Listener, &UXsollaBenchmarkListener::OnFetchTokenSuccess);
+
+	FOnCheckOrder CheckOrderCallback;
+	CheckOrderCallback.BindDynamic(Listener, &UXsollaBenchmarkListener::OnCheckOrder);
+
+	FOnStoreError StoreErrorCallback;
+	StoreErrorCallback.BindDynamic(Listener, &UXsollaBenchmarkListener::OnStoreError);
+
+	FOnAuthUpdate AuthUpdateCallback;
+	AuthUpdateCallback.BindDynamic(Listener, &UXsollaBenchmarkListener::OnAuthUpdate);
+
+	FOnAuthError AuthErrorCallback;
+	AuthErrorCallback.BindDynamic(Listener, &UXsollaBenchmarkListener::OnAuthError);
+
+	SetMockCatalogSize(PayloadSize);
+
+	// Mock server issues token for any credentials
+	AddRequestCase(TEXT("Login.AuthenticateUser"), 1, [this, AuthUpdateCallback, AuthErrorCallback]() {
+		LoginSubsystem->AuthenticateUser(TEXT("benchmark"), TEXT("benchmark"), AuthUpdateCallback, AuthErrorCallback);
+	});
+
+	// Catalog is kept for local queries
+	AddRequestCase(
+		TEXT("Store.UpdateVirtualItems"), PayloadSize, [this, StoreUpdateCallback, StoreErrorCallback]() {
+			StoreSubsystem->UpdateVirtualItems(StoreUpdateCallback, StoreErrorCallback);
+		},
+		[this]() {
+			RunStoreQueries();
+		});
+
+	AddRequestCase(TEXT("Store.UpdateVirtualCurrencyPackages"), 0, [this, StoreUpdateCallback, StoreErrorCallback]() {
+		StoreSubsystem->UpdateVirtualCurrencyPackages(StoreUpdateCallback, StoreErrorCallback);
+	});
+
+	AddRequestCase(TEXT("Store.FetchPaymentToken"), 1, [this, FetchTokenCallback, StoreErrorCallback]() {
+		StoreSubsystem->FetchPaymentToken(Listener->AuthToken, TEXT("sword_basic"), TEXT("USD"), FString(), FString(), FetchTokenCallback, StoreErrorCallback);
+	});
+
+	AddRequestCase(TEXT("Store.CheckOrder"), 1, [this, CheckOrderCallback, StoreErrorCallback]() {
+		StoreSubsystem->CheckOrder(Listener->AuthToken, Listener->OrderId, CheckOrderCallback, StoreErrorCallback);
+	});
+
+	AddRequestCase(TEXT("Store.AddToCart"), 1, [this, CartUpdateCallback, StoreErrorCallback]() {
+		StoreSubsystem->AddToCart(Listener->AuthToken, FString(), TEXT("sword_basic"), 1, CartUpdateCallback, StoreErrorCallback);
+	});
+
+	// Large catalog for memory comparison isn't measured
+	AddRequestCase(
+		FString(), CatalogMemoryItemCount, [this, StoreUpdateCallback, StoreErrorCallback]() {
+			SetMockCatalogSize(CatalogMemoryItemCount);
+			StoreSubsystem->UpdateVirtualItems(StoreUpdateCallback, StoreErrorCallback);
+		},
+		[this]() {
+			SetMockCatalogSize(0);
+			RunCatalogMemory();
+		});
+}
+
+void FXsollaBenchmarkRunner::RunStoreQueries()
+{
+	// Same catalog as Blueprint structs for item by item baselines
+	const TArray<FStoreItem> Items = StoreSubsystem->GetVirtualItems(FString());
+	if (Items.Num() == 0)
+	{
+		Errors.Add(TEXT("Store catalog is empty, local queries are skipped"));
+		UE_LOG(LogXsollaBenchmark, Error, TEXT("%s: %s"), *VA_FUNC_LINE, *Errors.Last());
+		return;
+	}
+
+	Measure(TEXT("Store.GetVirtualItems"), 0, [this]() {
+		StoreSubsystem->GetVirtualItems(TEXT("weapons"));
+	});
+
+	Measure(TEXT("Store.GetVirtualItemsAll"), 0, [this]() {
+		StoreSubsystem->GetVirtualItems(FString());
+	});
+
+	Measure(TEXT("Store.GetVirtualItemsWithoutGroup"), 0, [this]() {
+		StoreSubsystem->GetVirtualItemsWithoutGroup();
+	});
+
+	// Typical shop page: paid items of group in price range, cheapest first
+	FStoreItemsQuery Query;
+	Query.Group = TEXT("weapons");
+	Query.FreeFilter = EXsollaItemsFreeFilter::Paid;
+	Query.MinPrice = TEXT("1");
+	Query.MaxPrice = TEXT("4");
+	Query.SortBy = EXsollaItemsSortBy::Price;
+	Query.Limit = 20;
+
+	Measure(TEXT("Store.QueryItems"), 0, [this, &Query]() {
+		StoreSubsystem->QueryVirtualItems(Query);
+	});
+
+	// Same query filtered item by item over blueprint structs
+	Measure(TEXT("Store.FilterByPredicate"), 0, [&Items, &Query]() {
+		const double MinPrice = FCString::Atod(*Query.MinPrice);
+		const double MaxPrice = FCString::Atod(*Query.MaxPrice);
+
+		TArray<FStoreItem> FilteredItems = Items.FilterByPredicate([&Query, MinPrice, MaxPrice](const FStoreItem& Item) {
+			if (Item.is_free || !Item.groups.ContainsByPredicate([&Query](const FStoreGroup& Group) { return Group.external_id == Query.Group; }))
+			{
+				return false;
+			}
+
+			const double Price = FCString::Atod(*Item.price.amount);
+			return Price >= MinPrice && Price <= MaxPrice;
+		});
+
+		FilteredItems.StableSort([](const FStoreItem& A, const FStoreItem& B) {
+			return FCString::Atod(*A.price.amount) < FCString::Atod(*B.price.amount);
+		});
+		FilteredItems.SetNum(FMath::Min(FilteredItems.Num(), Query.Limit));
+	});
+
+	// Incomplete word typed in search box
+	Measure(TEXT("Store.Search"), 0, [this]() {
+		StoreSubsystem->SearchVirtualItems(TEXT("flame sw"));
+	});
+
+	Measure(TEXT("Store.SearchTypo"), 0, [this]() {
+		StoreSubsystem->SearchVirtualItems(TEXT("swrod"));
+	});
+
+	// Same search as substring match over blueprint structs
+	Measure(TEXT("Store.SearchSubstring"), 0, [&Items]() {
+		Items.FilterByPredicate([](const FStoreItem& Item) {
+			return Item.name.Contains(TEXT("flame sw")) || Item.description.Contains(TEXT("flame sw")) || Item.sku.Contains(TEXT("flame sw"));
+		});
+	});
+
+	if (StoreSubsystem->GetCurrencyLibrary())
+	{
+		Measure(TEXT("Store.FormatPrice"), 0, [this]() {
+			StoreSubsystem->FormatPrice(1234.56f, TEXT("USD"));
+		});
+
+		const FStoreDecimal Amount(123456, 2);
+		Measure(TEXT("Store.FormatPriceDecimal"), 0, [this, &Amount]() {
+			StoreSubsystem->FormatPriceDecimal(Amount, TEXT("USD"));
+		});
+	}
+	else
+	{
+		UE_LOG(LogXsollaBenchmark, Warning, TEXT("%s: Currency library isn't loaded, FormatPrice is skipped"), *VA_FUNC_LINE);
+	}
+}
+
+void FXsollaBenchmarkRunner::RunTokenParsing()
+{
+	const FString Token = MakeToken(0);
+
+	Measure(
+		TEXT("Login.ParseToken"), Token.Len(), [&Token]() {
+			FXsollaUtilsTokenParser::GetClaims(Token);
+		},
+		[]() {
+			FXsollaUtilsTokenParser::ResetCache();
+		});
+
+	Measure(TEXT("Login.ParseTokenCached"), Token.Len(), [&Token]() {
+		FXsollaUtilsTokenParser::GetClaims(Token);
+	});
+
+	FXsollaUtilsTokenParser::ResetCache();
+
+	for (int32 Index = Results.Num() - 2; Index < Results.Num(); ++Index)
+	{
+		Results[Index].PayloadSize = 1;
+	}
+}
+
+void FXsollaBenchmarkRunner::RunImageDecoding()
+{
+	// Synthetic gradient with noise, so compressed size is close to real artwork
+	TArray<uint8> RawData;
+	RawData.SetNumUninitialized(ImageSize * ImageSize * 4);
+	FRandomStream RandomStream(ImageSize);
+	for (int32 Y = 0; Y < ImageSize; ++Y)
+	{
+		for (int32 X = 0; X < ImageSize; ++X)
+		{
+			uint8* Pixel = &RawData[(Y * ImageSize + X) * 4];
+			Pixel[0] = static_cast<uint8>(X * 255 / ImageSize);
+			Pixel[1] = static_cast<uint8>(Y * 255 / ImageSize);
+			Pixel[2] = static_cast<uint8>(RandomStream.RandRange(0, 63));
+			Pixel[3] = 255;
+		}
+	}
+
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	const TPair<EImageFormat, const TCHAR*> Formats[] = {
+		TPair<EImageFormat, const TCHAR*>(EImageFormat::PNG, TEXT("Image.DecodePNG")),
+		TPair<EImageFormat, const TCHAR*>(EImageFormat::JPEG, TEXT("Image.DecodeJPEG"))};
+
+	for (const auto& Format : Formats)
+	{
+		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(Format.Key);
+		if (!ImageWrapper.IsValid() || !ImageWrapper->SetRaw(RawData.GetData(), RawData.Num(), ImageSize, ImageSize, ERGBFormat::BGRA, 8))
+		{
+			UE_LOG(LogXsollaBenchmark, Warning, TEXT("%s: Can't encode synthetic image for %s"), *VA_FUNC_LINE, Format.Value);
+			continue;
+		}
+
+		const TArray<uint8> ImageData(ImageWrapper->GetCompressed(90));
+		Measure(Format.Value, ImageData.Num(), [&ImageData]() {
+			TArray<uint8> DecodedData;
+			int32 Width = 0;
+			int32 Height = 0;
+			UXsollaStoreImageLoader::DecodeImage(ImageData, DecodedData, Width, Height);
+		});
+
+		Results.Last().PayloadSize = ImageSize;
+	}
+}
+
+void FXsollaBenchmarkRunner::MeasureJsonConversion(const FString& Name, const FString& Payload, UScriptStruct* Struct)
+{
+	using namespace XsollaBenchmarkRunner;
+
+	const TArray<uint8> Content = ToUtf8(Payload);
+	FStructOnScope StructData(Struct);
+
+	bool bConverted = true;
+	Measure(Name, Content.Num(), [&Content, &StructData, &bConverted, Struct]() {
+		TSharedPtr<FJsonObject> JsonObject;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FromUtf8(Content));
+		bConverted &= FJsonSerializer::Deserialize(Reader, JsonObject) && FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), Struct, StructData.GetStructMemory());
+	});
+
+	if (!bConverted)
+	{
+		UE_LOG(LogXsollaBenchmark, Warning, TEXT("%s: Synthetic payload wasn't converted: %s"), *VA_FUNC_LINE, *Name);
+	}
+}
+
+void FXsollaBenchmarkRunner::Measure(const FString& Name, int32 PayloadBytes, TFunctionRef<void()> Body, TFunctionRef<void()> Setup)
+{
+	// Warm-up run, so lazy initialization doesn't get into results
+	Setup();
+	Body();
+
+	TArray<double> Timings;
+	Timings.Reserve(Iterations);
+
+	for (int32 Index = 0; Index < Iterations; ++Index)
+	{
+		Setup();
+
+		const double StartTime = FPlatformTime::Seconds();
+		Body();
+		Timings.Add((FPlatformTime::Seconds() - StartTime) * 1000.);
+	}
+
+	AddResult(Name, PayloadSize, PayloadBytes, Timings);
+}
+
+void FXsollaBenchmarkRunner::AddRequestCase(const FString& Name, int32 EntryCount, TFunction<void()> Send, TFunction<void()> OnFinished)
+{
+	FRequestCase& RequestCase = RequestCases.AddDefaulted_GetRef();
+	RequestCase.Name = Name;
+	RequestCase.EntryCount = EntryCount;
+	RequestCase.Send = MoveTemp(Send);
+	RequestCase.OnFinished = MoveTemp(OnFinished);
+}
+
+void FXsollaBenchmarkRunner::AddResult(const FString& Name, int32 EntryCount, int32 PayloadBytes, TArray<double>& Timings)
+{
+	using namespace XsollaBenchmarkRunner;
+
+	if (Timings.Num() == 0)
+	{
+		return;
+	}
+
+	double TotalTime = 0.;
+	for (const double Time : Timings)
+	{
+		TotalTime += Time;
+	}
+
+	Timings.Sort();
+
+	FXsollaBenchmarkResult Result;
+	Result.Name = Name;
+	Result.PayloadSize = EntryCount;
+	Result.PayloadBytes = PayloadBytes;
+	Result.Iterations = Timings.Num();
+	Result.Min = Timings[0];
+	Result.Mean = TotalTime / Timings.Num();
+	Result.P50 = GetPercentile(Timings, 0.5);
+	Result.P90 = GetPercentile(Timings, 0.9);
+	Result.P99 = GetPercentile(Timings, 0.99);
+	Result.Max = Timings.Last();
+
+	Results.Add(Result);
+}
+
+FString FXsollaBenchmarkRunner::MakeStoreItemsPayload(int32 Count)
+{
+	using namespace XsollaBenchmarkRunner;
+
+	return MakeItemsJson(Count, [](int32 Index) {
+		// Every tenth item has no group
+		const FString Groups = (Index % 10 == 9) ? FString() : MakeGroupJson(Index % GroupCount);
+		return FString::Printf(TEXT("{\"sku\":\"item_%d\",\"name\":\"Item %d\",\"description\":\"Synthetic item %d description\",\"type\":\"virtual_good\",")
+							   TEXT("\"groups\":[%s],\"is_free\":false,\"price\":%s,")
+							   TEXT("\"virtual_prices\":[{\"sku\":\"crystal\",\"is_default\":true,\"amount\":%d,\"amount_without_discount\":%d,\"image_url\":\"\",\"name\":\"Crystals\",\"description\":\"\",\"type\":\"virtual_currency\"}],")
+							   TEXT("\"image_url\":\"https://cdn.xsolla.net/img/item_%d.png\",\"inventory_options\":{\"expiration_period\":{\"value\":0,\"type\":\"day\"}}}"),
+			Index, Index, Index, *Groups, *MakePriceJson(Index), 10 + Index, 10 + Index, Index);
+	});
+}
+
+FString FXsollaBenchmarkRunner::MakeGroupsPayload(int32 Count)
+{
+	TArray<FString> Groups;
+	Groups.Reserve(Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Groups.Add(FString::Printf(TEXT("{\"id\":%d,\"external_id\":\"group_%d\",\"name\":\"Group %d\",\"description\":\"\",\"image_url\":\"\",\"level\":1,\"order\":%d,\"parent_external_id\":\"\"}"),
+			Index + 1, Index, Index, Index));
+	}
+
+	return FString::Printf(TEXT("{\"groups\":[%s]}"), *FString::Join(Groups, TEXT(",")));
+}
+
+FString FXsollaBenchmarkRunner::MakeInventoryPayload(int32 Count)
+{
+	using namespace XsollaBenchmarkRunner;
+
+	return MakeItemsJson(Count, [](int32 Index) {
+		return FString::Printf(TEXT("{\"sku\":\"item_%d\",\"name\":\"Item %d\",\"type\":\"virtual_good\",\"description\":\"Synthetic item %d description\",")
+							   TEXT("\"image_url\":\"\",\"attributes\":[],\"groups\":[%s],\"instance_id\":\"\",\"quantity\":%d,\"remaining_uses\":0}"),
+			Index, Index, Index, *MakeGroupJson(Index % GroupCount), 1 + Index % 5);
+	});
+}
+
+FString FXsollaBenchmarkRunner::MakeVirtualCurrenciesPayload(int32 Count)
+{
+	using namespace XsollaBenchmarkRunner;
+
+	return MakeItemsJson(Count, MakeVirtualCurrencyJson);
+}
+
+FString FXsollaBenchmarkRunner::MakeVirtualCurrencyPackagesPayload(int32 Count)
+{
+	using namespace XsollaBenchmarkRunner;
+
+	return MakeItemsJson(Count, MakeVirtualCurrencyPackageJson);
+}
+
+FString FXsollaBenchmarkRunner::MakeVirtualCurrencyBalancePayload(int32 Count)
+{
+	using namespace XsollaBenchmarkRunner;
+
+	return MakeItemsJson(Count, [](int32 Index) {
+		return FString::Printf(TEXT("{\"sku\":\"currency_%d\",\"name\":\"Currency %d\",\"description\":\"\",\"image_url\":\"\",\"amount\":%d}"), Index, Index, Index * 10);
+	});
+}
+
+FString FXsollaBenchmarkRunner::MakeSubscriptionsPayload(int32 Count)
+{
+	using namespace XsollaBenchmarkRunner;
+
+	return MakeItemsJson(Count, [](int32 Index) {
+		return FString::Printf(TEXT("{\"sku\":\"subscription_%d\",\"name\":\"Subscription %d\",\"type\":\"virtual_good\",\"description\":\"\",\"image_url\":\"\",\"class\":\"time_limited\",\"expired_at\":1600000000,\"status\":\"active\"}"),
+			Index, Index);
+	});
+}
+
+FString FXsollaBenchmarkRunner::MakeCartPayload(int32 Count)
+{
+	using namespace XsollaBenchmarkRunner;
+
+	const FString ItemsJson = MakeItemsJson(Count, [](int32 Index) {
+		return FString::Printf(TEXT("{\"sku\":\"item_%d\",\"name\":\"Item %d\",\"description\":\"\",\"long_description\":\"\",\"is_free\":false,\"price\":%s,\"vc_prices\":[],\"image_url\":\"\",\"quantity\":1}"),
+			Index, Index, *MakePriceJson(Index));
+	});
+
+	// Reuse items array of {"items":[...]}
+	return FString::Printf(TEXT("{\"cart_id\":\"12345\",\"price\":%s,\"is_free\":false,%s"), *MakePriceJson(Count), *ItemsJson.RightChop(1));
+}
+
+FString FXsollaBenchmarkRunner::MakeUserAttributesPayload(int32 Count)
+{
+	TArray<FString> Attributes;
+	Attributes.Reserve(Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Attributes.Add(FString::Printf(TEXT("{\"key\":\"attribute_%d\",\"permission\":\"public\",\"value\":\"value_%d\"}"), Index, Index));
+	}
+
+	return FString::Printf(TEXT("[%s]"), *FString::Join(Attributes, TEXT(",")));
+}
+
+FString FXsollaBenchmarkRunner::MakeToken(int32 Index)
+{
+	using namespace XsollaBenchmarkRunner;
+
+	const FString Header = TEXT("{\"alg\":\"HS256\",\"typ\":\"JWT\"}");
+	const FString Payload = FString::Printf(TEXT("{\"sub\":\"00000000-0000-0000-0000-%012d\",\"email\":\"user%d@example.com\",\"exp\":%lld,\"iss\":\"https://login.xsolla.com\",\"aud\":[\"store\"],\"type\":\"xsolla_login\",\"xsolla_login_project_id\":\"00000000-0000-0000-0000-000000000000\"}"),
+		Index, Index, FDateTime::UtcNow().ToUnixTimestamp() + 3600);
+
+	return FString::Printf(TEXT("%s.%s.%s"), *EncodeBase64Url(Header), *EncodeBase64Url(Payload), *EncodeBase64Url(TEXT("signature")));
+}
+
+void FXsollaBenchmarkRunner::SetMockCatalogSize(int32 CatalogSize)
+{
+	IConsoleVariable* CatalogSizeVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Xsolla.MockServer.CatalogSize"));
+	if (CatalogSizeVar)
+	{
+		CatalogSizeVar->Set(CatalogSize);
+	}
+}
+
+void FXsollaBenchmarkRunner::RunCatalogMemory()
+{
+	// Blueprint structs as they were cached before
+	const TArray<FStoreItem> Items = StoreSubsystem->GetVirtualItems(FString());
+
+	FXsollaBenchmarkMemoryResult& StructsResult = MemoryResults.AddDefaulted_GetRef();
+	StructsResult.Name = TEXT("Memory.CatalogStructs");
+	StructsResult.PayloadSize = Items.Num();
+	StructsResult.Bytes = Items.GetAllocatedSize();
+	for (const FStoreItem& Item : Items)
+	{
+		StructsResult.Bytes += FXsollaUtilsMemory::GetAllocatedSize(FStoreItem::StaticStruct(), &Item);
+	}
+
+	const int64 StructsBytes = StructsResult.Bytes;
+
+	const FStoreMemoryReport Report = StoreSubsystem->GetMemoryReport();
+	FXsollaBenchmarkMemoryResult& CompactResult = MemoryResults.AddDefaulted_GetRef();
+	CompactResult.Name = TEXT("Memory.CatalogCompact");
+	CompactResult.PayloadSize = Items.Num();
+	CompactResult.Bytes = Report.Items + Report.Groups;
+
+	UE_LOG(LogXsollaBenchmark, Log, TEXT("%s: Catalog of %d items: %lld bytes as structs, %lld bytes compact (%.1f%% saved)"), *VA_FUNC_LINE,
+		Items.Num(), StructsBytes, CompactResult.Bytes, StructsBytes > 0 ? 100. * (StructsBytes - CompactResult.Bytes) / StructsBytes : 0.);
+}
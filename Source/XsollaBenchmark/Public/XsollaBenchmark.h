@@ -0,0 +1,43 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+/**
+ * Performance benchmarks of Store and Login hot paths on synthetic payloads and mock server responses.
+ *
+ * Automation test: Xsolla.Benchmark
+ * Headless run: -nullrhi -ExecCmds="Automation RunTests Xsolla.Benchmark; Quit" -XsollaBenchmarkIterations=200 -XsollaBenchmarkPayloadSize=1000
+ * Results are written to Saved/XsollaBenchmark as json and csv.
+ */
+class FXsollaBenchmarkModule : public IModuleInterface
+{
+public:
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+	/**
+	 * Singleton-like access to this module's interface.  This is just for convenience!
+	 * Beware of calling this during the shutdown phase, though.  Your module might have been unloaded already.
+	 *
+	 * @return Returns singleton instance, loading the module on demand if needed
+	 */
+	static inline FXsollaBenchmarkModule& Get()
+	{
+		return FModuleManager::LoadModuleChecked<FXsollaBenchmarkModule>("XsollaBenchmark");
+	}
+
+	/**
+	 * Checks to see if this module is loaded and ready.  It is only valid to call Get() if IsAvailable() returns true.
+	 *
+	 * @return True if the module is loaded and ready to use
+	 */
+	static inline bool IsAvailable()
+	{
+		return FModuleManager::Get().IsModuleLoaded("XsollaBenchmark");
+	}
+};
@@ -0,0 +1,197 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+class UScriptStruct;
+
+/** Timing of single benchmark case (milliseconds) */
+struct XSOLLABENCHMARK_API FXsollaBenchmarkResult
+{
+	/** Case name, e.g. Json.UpdateVirtualItems */
+	FString Name;
+
+	/** Number of entries in synthetic payload */
+	int32 PayloadSize;
+
+	/** Size of synthetic payload in bytes */
+	int32 PayloadBytes;
+
+	int32 Iterations;
+
+	double Min;
+	double Mean;
+	double P50;
+	double P90;
+	double P99;
+	double Max;
+
+	FXsollaBenchmarkResult()
+		: PayloadSize(0)
+		, PayloadBytes(0)
+		, Iterations(0)
+		, Min(0.)
+		, Mean(0.)
+		, P50(0.)
+		, P90(0.)
+		, P99(0.)
+		, Max(0.){};
+};
+
+/** Resident memory of cached data */
+struct XSOLLABENCHMARK_API FXsollaBenchmarkMemoryResult
+{
+	/** Case name, e.g. Memory.CatalogCompact */
+	FString Name;
+
+	/** Number of cached entries */
+	int32 PayloadSize;
+
+	int64 Bytes;
+
+	FXsollaBenchmarkMemoryResult()
+		: PayloadSize(0)
+		, Bytes(0){};
+};
+
+class UXsollaBenchmarkListener;
+class UXsollaLoginSubsystem;
+class UXsollaStoreSubsystem;
+
+/**
+ * Measures Store and Login hot paths: json conversion of http handler payloads, SDK requests
+ * handled by mock server, local cache queries, price formatting, token parsing and image decoding.
+ * Request cases go through public SDK calls, so mock server has to be running (see FXsollaMockServerModule).
+ */
+class XSOLLABENCHMARK_API FXsollaBenchmarkRunner
+{
+public:
+	FXsollaBenchmarkRunner(int32 InIterations, int32 InPayloadSize, int32 InImageSize);
+	~FXsollaBenchmarkRunner();
+
+	FXsollaBenchmarkRunner(const FXsollaBenchmarkRunner&) = delete;
+	FXsollaBenchmarkRunner& operator=(const FXsollaBenchmarkRunner&) = delete;
+
+	/** Run local cases and start request cases */
+	void Start();
+
+	/** Send next request of current case, returns true when all cases are finished */
+	bool Tick();
+
+	/** Called by listener when SDK request callback is executed */
+	void CompleteRequest(bool bSucceeded, const FString& ErrorMessage = FString());
+
+	/** Collected results */
+	const TArray<FXsollaBenchmarkResult>& GetResults() const;
+
+	/** Collected memory results */
+	const TArray<FXsollaBenchmarkMemoryResult>& GetMemoryResults() const;
+
+	/** Errors of failed cases */
+	const TArray<FString>& GetErrors() const;
+
+	/** Write results to BaseFilename.json and BaseFilename.csv */
+	bool SaveResults(const FString& BaseFilename) const;
+
+	static const int32 DefaultIterations;
+	static const int32 DefaultPayloadSize;
+	static const int32 DefaultImageSize;
+
+	/** Number of items in catalog memory comparison */
+	static const int32 CatalogMemoryItemCount;
+
+	/** Time to wait for single request (seconds) */
+	static const double RequestTimeout;
+
+private:
+	/** Json conversions done by Store and Login http handlers */
+	void RunJsonConversions();
+
+	/** Token claims parsing, cold and cached */
+	void RunTokenParsing();
+
+	/** Image decoding of image loader */
+	void RunImageDecoding();
+
+	/** SDK requests handled by mock server */
+	void AddRequestCases();
+
+	/** Store local cache queries and price formatting (catalog is loaded by request case) */
+	void RunStoreQueries();
+
+	/** Resident catalog memory: Blueprint structs against compact catalog */
+	void RunCatalogMemory();
+
+	/** Measure json object conversion to struct the same way handlers do */
+	void MeasureJsonConversion(const FString& Name, const FString& Payload, UScriptStruct* Struct);
+
+	/** Run Body Iterations times (after warm-up) and add result. Setup is called before each run and isn't measured */
+	void Measure(const FString& Name, int32 PayloadBytes, TFunctionRef<void()> Body, TFunctionRef<void()> Setup = [] {});
+
+	/**
+	 * Add case measured from Send call to SDK callback. Send has to pass listener callbacks to SDK.
+	 * OnFinished is called after last run. Case without name is run once and isn't added to results.
+	 */
+	void AddRequestCase(const FString& Name, int32 EntryCount, TFunction<void()> Send, TFunction<void()> OnFinished = nullptr);
+
+	/** Add result calculated from timings */
+	void AddResult(const FString& Name, int32 EntryCount, int32 PayloadBytes, TArray<double>& Timings);
+
+	/** Set number of catalog items served by mock server */
+	static void SetMockCatalogSize(int32 CatalogSize);
+
+	static FString MakeStoreItemsPayload(int32 Count);
+	static FString MakeGroupsPayload(int32 Count);
+	static FString MakeInventoryPayload(int32 Count);
+	static FString MakeVirtualCurrenciesPayload(int32 Count);
+	static FString MakeVirtualCurrencyPackagesPayload(int32 Count);
+	static FString MakeVirtualCurrencyBalancePayload(int32 Count);
+	static FString MakeSubscriptionsPayload(int32 Count);
+	static FString MakeCartPayload(int32 Count);
+	static FString MakeUserAttributesPayload(int32 Count);
+	static FString MakeToken(int32 Index);
+
+private:
+	struct FRequestCase
+	{
+		FString Name;
+		int32 EntryCount;
+		TFunction<void()> Send;
+		TFunction<void()> OnFinished;
+	};
+
+	int32 Iterations;
+	int32 PayloadSize;
+	int32 ImageSize;
+
+	TArray<FXsollaBenchmarkResult> Results;
+
+	TArray<FXsollaBenchmarkMemoryResult> MemoryResults;
+
+	TArray<FString> Errors;
+
+	/** Subsystems are created in transient package, so benchmark data is kept away from game session */
+	UXsollaStoreSubsystem* StoreSubsystem;
+	UXsollaLoginSubsystem* LoginSubsystem;
+
+	UXsollaBenchmarkListener* Listener;
+
+	TArray<FRequestCase> RequestCases;
+
+	/** Index of request case in progress */
+	int32 RequestCaseIndex;
+
+	/** Run of current request case, warm-up run is 0 */
+	int32 RequestRun;
+
+	TArray<double> RequestTimings;
+
+	double RequestStartTime;
+
+	bool bRequestInFlight;
+
+	bool bRequestCaseFailed;
+};
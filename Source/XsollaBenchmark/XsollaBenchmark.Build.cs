@@ -0,0 +1,36 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+using UnrealBuildTool;
+
+public class XsollaBenchmark : ModuleRules
+{
+    public XsollaBenchmark(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core"
+            }
+            );
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "CoreUObject",
+                "Engine",
+                "ImageWrapper",
+                "Json",
+                "JsonUtilities",
+                "XsollaLogin",
+                "XsollaMockServer",
+                "XsollaStore",
+                "XsollaUtils"
+            }
+            );
+
+        PublicDefinitions.Add("WITH_XSOLLA_BENCHMARK=1");
+    }
+}
@@ -3,6 +3,8 @@
 
 #include "XsollaLoginSave.h"
 
+#include "XsollaUtilsTrace.h"
+
 #include "Kismet/GameplayStatics.h"
 
 const FString UXsollaLoginSave::SaveSlotName = "XsollaLoginSaveSlot";
@@ -21,13 +23,32 @@ FXsollaLoginData UXsollaLoginSave::Load()
 
 void UXsollaLoginSave::Save(const FXsollaLoginData& InLoginData)
 {
+	// Whole slot is overwritten, so there is no need to load it first
+	auto SaveInstance = Cast<UXsollaLoginSave>(UGameplayStatics::CreateSaveGameObject(UXsollaLoginSave::StaticClass()));
+	SaveInstance->LoginData = InLoginData;
+
+	UGameplayStatics::SaveGameToSlot(SaveInstance, UXsollaLoginSave::SaveSlotName, UXsollaLoginSave::UserIndex);
+}
+
+UXsollaLoginSave* UXsollaLoginSave::LoadOrCreate()
+{
+	XSOLLA_TRACE_SCOPE(XsollaSaveGameLoad);
+
 	auto SaveInstance = Cast<UXsollaLoginSave>(UGameplayStatics::LoadGameFromSlot(UXsollaLoginSave::SaveSlotName, UXsollaLoginSave::UserIndex));
 	if (!SaveInstance)
 	{
 		SaveInstance = Cast<UXsollaLoginSave>(UGameplayStatics::CreateSaveGameObject(UXsollaLoginSave::StaticClass()));
 	}
 
-	SaveInstance->LoginData = InLoginData;
+	return SaveInstance;
+}
+
+const FXsollaLoginData& UXsollaLoginSave::GetLoginData() const
+{
+	return LoginData;
+}
 
-	UGameplayStatics::SaveGameToSlot(SaveInstance, UXsollaLoginSave::SaveSlotName, 0);
+void UXsollaLoginSave::SetLoginData(const FXsollaLoginData& InLoginData)
+{
+	LoginData = InLoginData;
 }
@@ -9,7 +9,11 @@ UXsollaLoginSettings::UXsollaLoginSettings(const FObjectInitializer& ObjectIniti
 	UserDataStorage = EUserDataStorage::Xsolla;
 	AccountLinkingURL = TEXT("https://livedemo.xsolla.com/sdk/shadow_account/link");
 	PlatformAuthenticationURL = TEXT("https://livedemo.xsolla.com/sdk/shadow_account/auth");
+	TokenVerification = EXsollaTokenVerification::Remote;
 	UseCrossPlatformAccountLinking = false;
+	TokenExpirationLeadTime = 300.f;
+	ReauthenticateOnTokenExpiration = true;
+	EnableConnectionWarmUp = false;
 	DemoProjectID = TEXT("44056");
 	DemoLoginID = TEXT("e6dfaac6-78a8-11e9-9244-42010aa80004");
 }
@@ -8,19 +8,25 @@
 #include "XsollaLoginLibrary.h"
 #include "XsollaLoginSave.h"
 #include "XsollaLoginSettings.h"
+#include "XsollaUtilsAssetLoader.h"
+#include "XsollaUtilsConnectionWarmer.h"
+#include "XsollaUtilsHttpTelemetry.h"
+#include "XsollaUtilsSaveGameWriter.h"
+#include "XsollaUtilsStats.h"
+#include "XsollaUtilsTokenParser.h"
+#include "XsollaUtilsTrace.h"
+#include "XsollaUtilsUrlOverrides.h"
 
 #include "Developer/Settings/Public/ISettingsModule.h"
 #include "Dom/JsonObject.h"
 #include "Engine/Engine.h"
 #include "JsonObjectConverter.h"
 #include "Kismet/GameplayStatics.h"
-#include "Misc/Base64.h"
 #include "OnlineSubsystem.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
-#include "UObject/ConstructorHelpers.h"
 #include "UObject/Package.h"
 
 #define LOCTEXT_NAMESPACE "FXsollaLoginModule"
@@ -36,6 +42,26 @@ const FString UXsollaLoginSubsystem::ProxyResetPasswordEndpoint(TEXT("https://lo
 
 const FString UXsollaLoginSubsystem::ValidateTokenEndpoint(TEXT("https://login.xsolla.com/api/token/validate"));
 
+const FString UXsollaLoginSubsystem::TokenVerificationErrorCode(TEXT("401"));
+
+/** Minimal interval between JWKS downloads (seconds) */
+static const double JwksRequestCooldown = 60.;
+
+/** Allowed clock skew between us and Login server (seconds) */
+static const int32 TokenVerificationLeeway = 30;
+
+/** Get secret key for HS256 token verification from server command line or environment, it's never kept in config */
+static FString GetTokenVerificationSecret()
+{
+	FString Secret;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("XsollaLoginJwtSecret="), Secret))
+	{
+		Secret = FPlatformMisc::GetEnvironmentVariable(TEXT("XSOLLA_LOGIN_JWT_SECRET"));
+	}
+
+	return Secret;
+}
+
 const FString UXsollaLoginSubsystem::UserAttributesEndpoint(TEXT("https://login.xsolla.com/api/attributes"));
 
 const FString UXsollaLoginSubsystem::CrossAuthEndpoint(TEXT("https://livedemo.xsolla.com/sdk/token"));
@@ -44,27 +70,80 @@ const FString UXsollaLoginSubsystem::AccountLinkingCodeEndpoint(TEXT("https://lo
 
 UXsollaLoginSubsystem::UXsollaLoginSubsystem()
 	: UGameInstanceSubsystem()
+	, LastJwksRequestTime(0.)
+	, SaveInstance(nullptr)
 {
-	static ConstructorHelpers::FClassFinder<UUserWidget> BrowserWidgetFinder(TEXT("/Xsolla/Browser/W_LoginBrowser.W_LoginBrowser_C"));
-	DefaultBrowserWidgetClass = BrowserWidgetFinder.Class;
+	// Widget isn't loaded until it's used or prefetched
+	DefaultBrowserWidgetClass = TSoftClassPtr<UUserWidget>(FSoftObjectPath(TEXT("/Xsolla/Browser/W_LoginBrowser.W_LoginBrowser_C")));
+	AssetLoader = MakeShared<FXsollaUtilsAssetLoader>(TArray<FSoftObjectPath>{DefaultBrowserWidgetClass.ToSoftObjectPath()});
 }
 
 void UXsollaLoginSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
+	XSOLLA_LLM_SCOPE();
+
+	SaveWriter = MakeShared<FXsollaSaveGameWriter>(UXsollaLoginSave::SaveSlotName, UXsollaLoginSave::UserIndex);
+
 	LoadSavedData();
 
 	// Initialize subsystem with project identifiers provided by user
 	const UXsollaLoginSettings* Settings = FXsollaLoginModule::Get().GetSettings();
+	if (!Settings->LoginApiBaseURL.IsEmpty())
+	{
+		FXsollaUtilsUrlOverrides::SetBaseUrlOverride(FXsollaUtilsUrlOverrides::LoginApiBaseUrl, Settings->LoginApiBaseURL);
+	}
+
+	if (Settings->EnableConnectionWarmUp)
+	{
+		FXsollaUtilsConnectionWarmer::WarmUp(FXsollaUtilsUrlOverrides::LoginApiBaseUrl, this);
+	}
+
 	Initialize(Settings->ProjectID, Settings->LoginID);
 
+	TokenVerifier = MakeShared<FXsollaJwtVerifier, ESPMode::ThreadSafe>();
+	if (Settings->TokenVerification == EXsollaTokenVerification::LocalSecret)
+	{
+		// Secret key would be extracted from game client, so clients verify RS256 tokens with public keys only
+		if (!IsRunningDedicatedServer())
+		{
+			UE_LOG(LogXsollaLogin, Error, TEXT("%s: HS256 token verification is available on dedicated server only, JWKS or remote validation is used"), *VA_FUNC_LINE);
+			RequestJwks(FOnAuthUpdate(), FOnAuthError(), false);
+		}
+		else
+		{
+			const FString Secret = GetTokenVerificationSecret();
+			if (Secret.IsEmpty())
+			{
+				UE_LOG(LogXsollaLogin, Error, TEXT("%s: No HS256 secret key provided (-XsollaLoginJwtSecret= or XSOLLA_LOGIN_JWT_SECRET), remote validation is used"), *VA_FUNC_LINE);
+			}
+			else
+			{
+				TokenVerifier->SetSecret(Secret);
+			}
+		}
+	}
+	else if (Settings->TokenVerification == EXsollaTokenVerification::LocalJwks)
+	{
+		// Download keys in advance, so first login doesn't wait for them
+		RequestJwks(FOnAuthUpdate(), FOnAuthError(), false);
+	}
+
 	UE_LOG(LogXsollaLogin, Log, TEXT("%s: XsollaLogin subsystem initialized"), *VA_FUNC_LINE);
 }
 
 void UXsollaLoginSubsystem::Deinitialize()
 {
-	// Do nothing for now
+	// Don't lose data waiting for coalesced write
+	if (SaveWriter.IsValid())
+	{
+		SaveWriter->Flush();
+	}
+
+	// Warmed up hosts are static, so they would outlive PIE session (other game instances keep their own)
+	FXsollaUtilsConnectionWarmer::Release(this);
+
 	Super::Deinitialize();
 }
 
@@ -79,6 +158,7 @@ void UXsollaLoginSubsystem::Initialize(const FString& InProjectId, const FString
 	{
 		UE_LOG(LogXsollaLogin, Warning, TEXT("%s: Xsolla Launcher login token is used"), *VA_FUNC_LINE);
 		LoginData.AuthToken.JWT = LauncherLoginJwt;
+		OnTokenChanged.Broadcast(LoginData.AuthToken.JWT);
 	}
 }
 
@@ -110,7 +190,7 @@ void UXsollaLoginSubsystem::RegistrateUser(const FString& Username, const FStrin
 		*FGenericPlatformHttp::UrlEncode(Settings->CallbackURL));
 
 	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaLoginRequestVerb::POST, PostContent);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaLoginSubsystem::Default_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaLoginSubsystem::Default_HttpRequestComplete, SuccessCallback, ErrorCallback);
 	HttpRequest->ProcessRequest();
 }
 
@@ -149,7 +229,7 @@ void UXsollaLoginSubsystem::AuthenticateUser(const FString& Username, const FStr
 		*FGenericPlatformHttp::UrlEncode(Settings->CallbackURL));
 
 	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaLoginRequestVerb::POST, PostContent);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaLoginSubsystem::UserLogin_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaLoginSubsystem::UserLogin_HttpRequestComplete, SuccessCallback, ErrorCallback);
 	HttpRequest->ProcessRequest();
 }
 
@@ -179,11 +259,36 @@ void UXsollaLoginSubsystem::ResetUserPassword(const FString& Username, const FOn
 		*FGenericPlatformHttp::UrlEncode(Settings->CallbackURL));
 
 	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaLoginRequestVerb::POST, PostContent);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaLoginSubsystem::Default_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaLoginSubsystem::Default_HttpRequestComplete, SuccessCallback, ErrorCallback);
 	HttpRequest->ProcessRequest();
 }
 
 void UXsollaLoginSubsystem::ValidateToken(const FOnAuthUpdate& SuccessCallback, const FOnAuthError& ErrorCallback)
+{
+	const UXsollaLoginSettings* Settings = FXsollaLoginModule::Get().GetSettings();
+	if (Settings->TokenVerification != EXsollaTokenVerification::Remote)
+	{
+		const EXsollaJwtVerifyResult Result = VerifyTokenLocally(LoginData.AuthToken.JWT);
+		if (Result != EXsollaJwtVerifyResult::KeyNotFound)
+		{
+			CompleteTokenVerification(Result, SuccessCallback, ErrorCallback);
+			return;
+		}
+
+		// Keys could be rotated, so refresh them before asking validation server
+		if (CanRequestJwks())
+		{
+			RequestJwks(SuccessCallback, ErrorCallback, true);
+			return;
+		}
+
+		UE_LOG(LogXsollaLogin, Log, TEXT("%s: Signing key not found, fall back to remote token validation"), *VA_FUNC_LINE);
+	}
+
+	ValidateTokenRemotely(SuccessCallback, ErrorCallback);
+}
+
+void UXsollaLoginSubsystem::ValidateTokenRemotely(const FOnAuthUpdate& SuccessCallback, const FOnAuthError& ErrorCallback)
 {
 	// Prepare request payload
 	TSharedPtr<FJsonObject> RequestDataJson = MakeShareable(new FJsonObject());
@@ -198,7 +303,7 @@ void UXsollaLoginSubsystem::ValidateToken(const FOnAuthUpdate& SuccessCallback,
 	const FString Url = (!Settings->JWTValidationURL.IsEmpty()) ? Settings->JWTValidationURL : ValidateTokenEndpoint;
 
 	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaLoginRequestVerb::POST, PostContent);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaLoginSubsystem::TokenVerify_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaLoginSubsystem::TokenVerify_HttpRequestComplete, SuccessCallback, ErrorCallback);
 	HttpRequest->ProcessRequest();
 }
 
@@ -213,18 +318,42 @@ void UXsollaLoginSubsystem::GetSocialAuthenticationUrl(const FString& ProviderNa
 		*FGenericPlatformHttp::UrlEncode(Settings->CallbackURL));
 
 	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaLoginRequestVerb::GET);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaLoginSubsystem::SocialAuthUrl_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaLoginSubsystem::SocialAuthUrl_HttpRequestComplete, SuccessCallback, ErrorCallback);
 	HttpRequest->ProcessRequest();
+
+	// Authentication browser is likely to be opened once url is received
+	if (!Settings->OverrideBrowserWidgetClass)
+	{
+		PrefetchAssets();
+	}
 }
 
 void UXsollaLoginSubsystem::LaunchSocialAuthentication(const FString& SocialAuthenticationUrl, UUserWidget*& BrowserWidget, bool bRememberMe)
+{
+	LaunchSocialAuthentication(SocialAuthenticationUrl, BrowserWidget, bRememberMe, FOnAuthError());
+}
+
+void UXsollaLoginSubsystem::LaunchSocialAuthentication(const FString& SocialAuthenticationUrl, UUserWidget*& BrowserWidget, bool bRememberMe, const FOnAuthError& ErrorCallback)
 {
 	PendingSocialAuthenticationUrl = SocialAuthenticationUrl;
 
 	const UXsollaLoginSettings* Settings = FXsollaLoginModule::Get().GetSettings();
 
 	// Check for user browser widget override
-	auto BrowserWidgetClass = (Settings->OverrideBrowserWidgetClass) ? Settings->OverrideBrowserWidgetClass : DefaultBrowserWidgetClass;
+	TSubclassOf<UUserWidget> BrowserWidgetClass = Settings->OverrideBrowserWidgetClass;
+	if (!BrowserWidgetClass)
+	{
+		AssetLoader->Load();
+		BrowserWidgetClass = DefaultBrowserWidgetClass.Get();
+	}
+
+	if (!BrowserWidgetClass)
+	{
+		UE_LOG(LogXsollaLogin, Error, TEXT("%s: Can't load browser widget class"), *VA_FUNC_LINE);
+		BrowserWidget = nullptr;
+		ErrorCallback.ExecuteIfBound(TEXT("Social authentication failed"), TEXT("Can't load browser widget class"));
+		return;
+	}
 
 	auto MyBrowser = CreateWidget<UUserWidget>(GEngine->GameViewport->GetWorld(), BrowserWidgetClass);
 	MyBrowser->AddToViewport(MAX_int32);
@@ -237,10 +366,17 @@ void UXsollaLoginSubsystem::LaunchSocialAuthentication(const FString& SocialAuth
 	SaveData();
 }
 
+void UXsollaLoginSubsystem::PrefetchAssets()
+{
+	AssetLoader->Prefetch();
+}
+
 void UXsollaLoginSubsystem::SetToken(const FString& Token)
 {
 	LoginData.AuthToken.JWT = Token;
 	SaveData();
+
+	OnTokenChanged.Broadcast(LoginData.AuthToken.JWT);
 }
 
 void UXsollaLoginSubsystem::AuthenticateWithSessionTicket(const FString& ProviderName, const FString& SessionTicket, const FString& AppId, const FOnAuthUpdate& SuccessCallback, const FOnAuthError& ErrorCallback)
@@ -254,7 +390,7 @@ void UXsollaLoginSubsystem::AuthenticateWithSessionTicket(const FString& Provide
 		*SessionTicket);
 
 	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaLoginSubsystem::CrossAuth_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaLoginSubsystem::CrossAuth_HttpRequestComplete, SuccessCallback, ErrorCallback);
 	HttpRequest->ProcessRequest();
 }
 
@@ -282,7 +418,7 @@ void UXsollaLoginSubsystem::UpdateUserAttributes(const FString& AuthToken, const
 
 	const FString Url = FString::Printf(TEXT("%s/users/me/get"), *UserAttributesEndpoint);
 	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaLoginRequestVerb::POST, PostContent, AuthToken);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaLoginSubsystem::UpdateUserAttributes_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaLoginSubsystem::UpdateUserAttributes_HttpRequestComplete, SuccessCallback, ErrorCallback);
 	HttpRequest->ProcessRequest();
 }
 
@@ -311,7 +447,7 @@ void UXsollaLoginSubsystem::ModifyUserAttributes(const FString& AuthToken, const
 	const FString Url = FString::Printf(TEXT("%s/users/me/update"), *UserAttributesEndpoint);
 
 	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaLoginRequestVerb::POST, PostContent, AuthToken);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaLoginSubsystem::Default_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaLoginSubsystem::Default_HttpRequestComplete, SuccessCallback, ErrorCallback);
 	HttpRequest->ProcessRequest();
 }
 
@@ -329,14 +465,14 @@ void UXsollaLoginSubsystem::RemoveUserAttributes(const FString& AuthToken, const
 	const FString Url = FString::Printf(TEXT("%s/users/me/update"), *UserAttributesEndpoint);
 
 	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaLoginRequestVerb::POST, PostContent, AuthToken);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaLoginSubsystem::Default_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaLoginSubsystem::Default_HttpRequestComplete, SuccessCallback, ErrorCallback);
 	HttpRequest->ProcessRequest();
 }
 
 void UXsollaLoginSubsystem::CreateAccountLinkingCode(const FString& AuthToken, const FOnCodeReceived& SuccessCallback, const FOnAuthError& ErrorCallback)
 {
 	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(AccountLinkingCodeEndpoint, EXsollaLoginRequestVerb::POST, TEXT(""), AuthToken);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaLoginSubsystem::AccountLinkingCode_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaLoginSubsystem::AccountLinkingCode_HttpRequestComplete, SuccessCallback, ErrorCallback);
 	HttpRequest->ProcessRequest();
 }
 
@@ -347,7 +483,7 @@ void UXsollaLoginSubsystem::LinkAccount(const FString& UserId, const EXsollaTarg
 	const FString Url = FString::Printf(TEXT("%s?user_id=%s&platform=%s&code=%s"), *Settings->AccountLinkingURL, *UserId, *PlatformName, *Code);
 
 	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaLoginRequestVerb::POST);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaLoginSubsystem::Default_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaLoginSubsystem::Default_HttpRequestComplete, SuccessCallback, ErrorCallback);
 	HttpRequest->ProcessRequest();
 }
 
@@ -358,7 +494,7 @@ void UXsollaLoginSubsystem::AuthenticatePlatformAccountUser(const FString& UserI
 	const FString Url = FString::Printf(TEXT("%s?user_id=%s&platform=%s"), *Settings->PlatformAuthenticationURL, *UserId, *PlatformName);
 
 	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaLoginRequestVerb::GET);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaLoginSubsystem::AuthConsoleAccountUser_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaLoginSubsystem::AuthConsoleAccountUser_HttpRequestComplete, SuccessCallback, ErrorCallback);
 	HttpRequest->ProcessRequest();
 }
 
@@ -389,7 +525,7 @@ void UXsollaLoginSubsystem::UserLogin_HttpRequestComplete(FHttpRequestPtr HttpRe
 
 	TSharedPtr<FJsonObject> JsonObject;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*ResponseStr);
-	if (FJsonSerializer::Deserialize(Reader, JsonObject))
+	if (XSOLLA_TRACE_EXPRESSION(XsollaJsonParse, FJsonSerializer::Deserialize(Reader, JsonObject)))
 	{
 		static const FString LoginUrlFieldName = TEXT("login_url");
 		if (JsonObject->HasTypedField<EJson::String>(LoginUrlFieldName))
@@ -403,8 +539,11 @@ void UXsollaLoginSubsystem::UserLogin_HttpRequestComplete(FHttpRequestPtr HttpRe
 
 			UE_LOG(LogXsollaLogin, Log, TEXT("%s: Received token: %s"), *VA_FUNC_LINE, *LoginData.AuthToken.JWT);
 
-			// Check if verification URL is provided
-			if (FXsollaLoginModule::Get().GetSettings()->JWTValidationURL.IsEmpty())
+			OnTokenChanged.Broadcast(LoginData.AuthToken.JWT);
+
+			// Check if verification URL is provided or token is verified locally
+			const UXsollaLoginSettings* Settings = FXsollaLoginModule::Get().GetSettings();
+			if (Settings->TokenVerification == EXsollaTokenVerification::Remote && Settings->JWTValidationURL.IsEmpty())
 			{
 				UE_LOG(LogXsollaLogin, Verbose, TEXT("%s: No JWT Validation URL is set, skip token verification step"), *VA_FUNC_LINE);
 
@@ -449,6 +588,31 @@ void UXsollaLoginSubsystem::TokenVerify_HttpRequestComplete(FHttpRequestPtr Http
 	SuccessCallback.ExecuteIfBound(LoginData);
 }
 
+void UXsollaLoginSubsystem::Jwks_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnAuthUpdate SuccessCallback, FOnAuthError ErrorCallback, bool bValidateToken)
+{
+	// Errors aren't reported to caller, remote validator is used instead
+	if (!HandleRequestError(HttpRequest, HttpResponse, bSucceeded, FOnAuthError()))
+	{
+		TokenVerifier->SetJwks(HttpResponse->GetContentAsString());
+	}
+
+	if (!bValidateToken)
+	{
+		return;
+	}
+
+	const EXsollaJwtVerifyResult Result = VerifyTokenLocally(LoginData.AuthToken.JWT);
+	if (Result == EXsollaJwtVerifyResult::KeyNotFound)
+	{
+		UE_LOG(LogXsollaLogin, Log, TEXT("%s: Signing key not found in JWKS, fall back to remote token validation"), *VA_FUNC_LINE);
+
+		ValidateTokenRemotely(SuccessCallback, ErrorCallback);
+		return;
+	}
+
+	CompleteTokenVerification(Result, SuccessCallback, ErrorCallback);
+}
+
 void UXsollaLoginSubsystem::SocialAuthUrl_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnSocialUrlReceived SuccessCallback, FOnAuthError ErrorCallback)
 {
 	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
@@ -463,7 +627,7 @@ void UXsollaLoginSubsystem::SocialAuthUrl_HttpRequestComplete(FHttpRequestPtr Ht
 
 	TSharedPtr<FJsonObject> JsonObject;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*ResponseStr);
-	if (FJsonSerializer::Deserialize(Reader, JsonObject))
+	if (XSOLLA_TRACE_EXPRESSION(XsollaJsonParse, FJsonSerializer::Deserialize(Reader, JsonObject)))
 	{
 		static const FString SocialUrlFieldName = TEXT("url");
 		if (JsonObject->HasTypedField<EJson::String>(SocialUrlFieldName))
@@ -500,7 +664,7 @@ void UXsollaLoginSubsystem::CrossAuth_HttpRequestComplete(FHttpRequestPtr HttpRe
 
 	TSharedPtr<FJsonObject> JsonObject;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*ResponseStr);
-	if (FJsonSerializer::Deserialize(Reader, JsonObject))
+	if (XSOLLA_TRACE_EXPRESSION(XsollaJsonParse, FJsonSerializer::Deserialize(Reader, JsonObject)))
 	{
 		static const FString TokenFieldName = TEXT("token");
 		if (JsonObject->HasTypedField<EJson::String>(TokenFieldName))
@@ -513,6 +677,8 @@ void UXsollaLoginSubsystem::CrossAuth_HttpRequestComplete(FHttpRequestPtr HttpRe
 
 			UE_LOG(LogXsollaLogin, Log, TEXT("%s: Received token: %s"), *VA_FUNC_LINE, *LoginData.AuthToken.JWT);
 
+			OnTokenChanged.Broadcast(LoginData.AuthToken.JWT);
+
 			SuccessCallback.ExecuteIfBound(LoginData);
 
 			return;
@@ -540,7 +706,7 @@ void UXsollaLoginSubsystem::UpdateUserAttributes_HttpRequestComplete(FHttpReques
 
 	FString ResponseStr = HttpResponse->GetContentAsString();
 	TArray<FXsollaUserAttribute> userAttributesData;
-	if (FJsonObjectConverter::JsonArrayStringToUStruct(ResponseStr, &userAttributesData, 0, 0))
+	if (XSOLLA_TRACE_EXPRESSION(XsollaJsonToStruct, FJsonObjectConverter::JsonArrayStringToUStruct(ResponseStr, &userAttributesData, 0, 0)))
 	{
 		UserAttributes = userAttributesData;
 		SuccessCallback.ExecuteIfBound();
@@ -566,7 +732,7 @@ void UXsollaLoginSubsystem::AccountLinkingCode_HttpRequestComplete(FHttpRequestP
 
 	TSharedPtr<FJsonObject> JsonObject;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*ResponseStr);
-	if (FJsonSerializer::Deserialize(Reader, JsonObject))
+	if (XSOLLA_TRACE_EXPRESSION(XsollaJsonParse, FJsonSerializer::Deserialize(Reader, JsonObject)))
 	{
 		static const FString AccountLinkingCode = TEXT("code");
 		if (JsonObject->HasTypedField<EJson::String>(AccountLinkingCode))
@@ -603,7 +769,7 @@ void UXsollaLoginSubsystem::AuthConsoleAccountUser_HttpRequestComplete(FHttpRequ
 
 	TSharedPtr<FJsonObject> JsonObject;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*ResponseStr);
-	if (FJsonSerializer::Deserialize(Reader, JsonObject))
+	if (XSOLLA_TRACE_EXPRESSION(XsollaJsonParse, FJsonSerializer::Deserialize(Reader, JsonObject)))
 	{
 		static const FString TokenFieldName = TEXT("token");
 		if (JsonObject->HasTypedField<EJson::String>(TokenFieldName))
@@ -616,6 +782,8 @@ void UXsollaLoginSubsystem::AuthConsoleAccountUser_HttpRequestComplete(FHttpRequ
 
 			UE_LOG(LogXsollaLogin, Log, TEXT("%s: Received token: %s"), *VA_FUNC_LINE, *LoginData.AuthToken.JWT);
 
+			OnTokenChanged.Broadcast(LoginData.AuthToken.JWT);
+
 			SuccessCallback.ExecuteIfBound(LoginData);
 
 			return;
@@ -652,7 +820,7 @@ bool UXsollaLoginSubsystem::HandleRequestError(FHttpRequestPtr HttpRequest, FHtt
 			// Example: {"error":{"code":"003-003","description":"The username is already taken"}}
 			TSharedPtr<FJsonObject> JsonObject;
 			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*ResponseStr);
-			if (FJsonSerializer::Deserialize(Reader, JsonObject))
+			if (XSOLLA_TRACE_EXPRESSION(XsollaJsonParse, FJsonSerializer::Deserialize(Reader, JsonObject)))
 			{
 				static const FString ErrorFieldName = TEXT("error");
 				if (JsonObject->HasTypedField<EJson::Object>(ErrorFieldName))
@@ -696,7 +864,7 @@ TSharedRef<IHttpRequest> UXsollaLoginSubsystem::CreateHttpRequest(const FString&
 		Url.Contains(TEXT("?")) ? TEXT("&") : TEXT("?"),
 		ENGINE_VERSION_STRING,
 		XSOLLA_LOGIN_VERSION);
-	HttpRequest->SetURL(Url + MetaUrl);
+	HttpRequest->SetURL(FXsollaUtilsUrlOverrides::Apply(Url) + MetaUrl);
 
 	switch (Verb)
 	{
@@ -743,6 +911,8 @@ TSharedRef<IHttpRequest> UXsollaLoginSubsystem::CreateHttpRequest(const FString&
 	HttpRequest->SetHeader(TEXT("X-SDK"), TEXT("LOGIN"));
 	HttpRequest->SetHeader(TEXT("X-SDK-V"), XSOLLA_LOGIN_VERSION);
 
+	FXsollaHttpTelemetry::Get().TrackRequest(HttpRequest);
+
 	return HttpRequest;
 }
 
@@ -757,26 +927,6 @@ void UXsollaLoginSubsystem::SetStringArrayField(TSharedPtr<FJsonObject> Object,
 	Object->SetArrayField(FieldName, StringJsonArray);
 }
 
-bool UXsollaLoginSubsystem::ParseTokenPayload(const FString& Token, TSharedPtr<FJsonObject>& PayloadJsonObject) const
-{
-	TArray<FString> TokenParts;
-	Token.ParseIntoArray(TokenParts, TEXT("."));
-
-	FString PayloadStr;
-	if (!FBase64::Decode(TokenParts[1], PayloadStr))
-	{
-		return false;
-	}
-
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PayloadStr);
-	if (!FJsonSerializer::Deserialize(Reader, PayloadJsonObject))
-	{
-		return false;
-	}
-
-	return true;
-}
-
 FString UXsollaLoginSubsystem::GetTargetPlatformName(EXsollaTargetPlatform Platform)
 {
 	FString platform;
@@ -843,63 +993,122 @@ FXsollaLoginData UXsollaLoginSubsystem::GetLoginData()
 	return LoginData;
 }
 
+void UXsollaLoginSubsystem::CompleteTokenVerification(EXsollaJwtVerifyResult Result, const FOnAuthUpdate& SuccessCallback, const FOnAuthError& ErrorCallback)
+{
+	if (Result != EXsollaJwtVerifyResult::Valid)
+	{
+		UE_LOG(LogXsollaLogin, Warning, TEXT("%s: Token verification failed: %s"), *VA_FUNC_LINE, LexToString(Result));
+		ErrorCallback.ExecuteIfBound(TokenVerificationErrorCode, LexToString(Result));
+		return;
+	}
+
+	LoginData.AuthToken.bIsVerified = true;
+	SaveData();
+
+	SuccessCallback.ExecuteIfBound(LoginData);
+}
+
+void UXsollaLoginSubsystem::RequestJwks(const FOnAuthUpdate& SuccessCallback, const FOnAuthError& ErrorCallback, bool bValidateToken)
+{
+	const UXsollaLoginSettings* Settings = FXsollaLoginModule::Get().GetSettings();
+	if (Settings->JWKSURL.IsEmpty())
+	{
+		UE_LOG(LogXsollaLogin, Warning, TEXT("%s: JWKS URL is not set, tokens will be validated remotely"), *VA_FUNC_LINE);
+		return;
+	}
+
+	LastJwksRequestTime = FPlatformTime::Seconds();
+
+	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Settings->JWKSURL);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaLoginSubsystem::Jwks_HttpRequestComplete, SuccessCallback, ErrorCallback, bValidateToken);
+	HttpRequest->ProcessRequest();
+}
+
+bool UXsollaLoginSubsystem::CanRequestJwks() const
+{
+	const UXsollaLoginSettings* Settings = FXsollaLoginModule::Get().GetSettings();
+	return !Settings->JWKSURL.IsEmpty() && (LastJwksRequestTime == 0. || FPlatformTime::Seconds() - LastJwksRequestTime >= JwksRequestCooldown);
+}
+
+EXsollaJwtVerifyResult UXsollaLoginSubsystem::VerifyTokenLocally(const FString& Token) const
+{
+	return VerifyTokenLocally(Token, GetTokenVerifyOptions());
+}
+
+EXsollaJwtVerifyResult UXsollaLoginSubsystem::VerifyTokenLocally(const FString& Token, const FXsollaJwtVerifyOptions& Options) const
+{
+	return TokenVerifier.IsValid() ? TokenVerifier->Verify(Token, Options) : EXsollaJwtVerifyResult::KeyNotFound;
+}
+
+FXsollaJwtVerifyOptions UXsollaLoginSubsystem::GetTokenVerifyOptions() const
+{
+	check(IsInGameThread());
+
+	const UXsollaLoginSettings* Settings = FXsollaLoginModule::Get().GetSettings();
+
+	FXsollaJwtVerifyOptions Options;
+	Options.Issuer = Settings->JWTIssuer;
+	Options.Audience = Settings->JWTAudience;
+	Options.Leeway = TokenVerificationLeeway;
+
+	return Options;
+}
+
 void UXsollaLoginSubsystem::DropLoginData()
 {
 	LoginData = FXsollaLoginData();
 
 	// Drop saved data too
-	UXsollaLoginSave::Save(LoginData);
+	SaveData();
 }
 
 FString UXsollaLoginSubsystem::GetUserId(const FString& Token)
 {
-	TSharedPtr<FJsonObject> PayloadJsonObject;
-	if (!ParseTokenPayload(Token, PayloadJsonObject))
+	const FXsollaJwtClaimsPtr Claims = FXsollaUtilsTokenParser::GetClaims(Token);
+	if (!Claims.IsValid())
 	{
 		UE_LOG(LogXsollaLogin, Error, TEXT("%s: Can't parse token payload"), *VA_FUNC_LINE);
 		return FString();
 	}
 
-	FString UserId;
-	if (!PayloadJsonObject->TryGetStringField(TEXT("sub"), UserId))
+	if (Claims->Sub.IsEmpty())
 	{
 		UE_LOG(LogXsollaLogin, Error, TEXT("%s: Can't find user ID in token payload"), *VA_FUNC_LINE);
 		return FString();
 	}
 
-	return UserId;
+	return Claims->Sub;
 }
 
 FString UXsollaLoginSubsystem::GetTokenProvider(const FString& Token)
 {
-	TSharedPtr<FJsonObject> PayloadJsonObject;
-	if (!ParseTokenPayload(Token, PayloadJsonObject))
+	const FXsollaJwtClaimsPtr Claims = FXsollaUtilsTokenParser::GetClaims(Token);
+	if (!Claims.IsValid())
 	{
 		UE_LOG(LogXsollaLogin, Error, TEXT("%s: Can't parse token payload"), *VA_FUNC_LINE);
 		return FString();
 	}
 
-	FString Provider;
-	if (!PayloadJsonObject->TryGetStringField(TEXT("provider"), Provider))
+	if (Claims->Provider.IsEmpty())
 	{
 		UE_LOG(LogXsollaLogin, Error, TEXT("%s: Can't find provider in token payload"), *VA_FUNC_LINE);
 		return FString();
 	}
 
-	return Provider;
+	return Claims->Provider;
 }
 
 FString UXsollaLoginSubsystem::GetTokenParameter(const FString& Token, const FString& Parameter)
 {
-	TSharedPtr<FJsonObject> PayloadJsonObject;
-	if (!ParseTokenPayload(Token, PayloadJsonObject))
+	const FXsollaJwtClaimsPtr Claims = FXsollaUtilsTokenParser::GetClaims(Token);
+	if (!Claims.IsValid())
 	{
 		UE_LOG(LogXsollaLogin, Error, TEXT("%s: Can't parse token payload"), *VA_FUNC_LINE);
 		return FString();
 	}
 
 	FString ParameterValue;
-	if (!PayloadJsonObject->TryGetStringField(Parameter, ParameterValue))
+	if (!Claims->TryGetClaim(Parameter, ParameterValue))
 	{
 		UE_LOG(LogXsollaLogin, Error, TEXT("%s: Can't find parameter %s in token payload"), *VA_FUNC_LINE, *Parameter);
 		return FString();
@@ -910,38 +1119,40 @@ FString UXsollaLoginSubsystem::GetTokenParameter(const FString& Token, const FSt
 
 bool UXsollaLoginSubsystem::IsMasterAccount(const FString& Token)
 {
-	TSharedPtr<FJsonObject> PayloadJsonObject;
-	if (!ParseTokenPayload(Token, PayloadJsonObject))
+	const FXsollaJwtClaimsPtr Claims = FXsollaUtilsTokenParser::GetClaims(Token);
+	if (!Claims.IsValid())
 	{
 		UE_LOG(LogXsollaLogin, Error, TEXT("%s: Can't parse token payload"), *VA_FUNC_LINE);
 		return false;
 	}
 
-	bool ParameterValue = false;
-	if (!PayloadJsonObject->TryGetBoolField(TEXT("is_master"), ParameterValue))
-	{
-		return false;
-	}
-
-	return ParameterValue;
+	return Claims->bIsMaster;
 }
 
 void UXsollaLoginSubsystem::LoadSavedData()
 {
-	LoginData = UXsollaLoginSave::Load();
+	// Slot is read once, save object in memory is the actual data afterwards
+	if (!SaveInstance)
+	{
+		SaveInstance = UXsollaLoginSave::LoadOrCreate();
+	}
+
+	LoginData = SaveInstance->GetLoginData();
 }
 
 void UXsollaLoginSubsystem::SaveData()
 {
-	if (LoginData.bRememberMe)
-	{
-		UXsollaLoginSave::Save(LoginData);
-	}
-	else
+	// Dron't drop cache in memory but reset save file if RememberMe is false
+	const FXsollaLoginData& DataToSave = LoginData.bRememberMe ? LoginData : FXsollaLoginData();
+
+	if (!SaveInstance || !SaveWriter.IsValid())
 	{
-		// Dron't drop cache in memory but reset save file
-		UXsollaLoginSave::Save(FXsollaLoginData());
+		UXsollaLoginSave::Save(DataToSave);
+		return;
 	}
+
+	SaveInstance->SetLoginData(DataToSave);
+	SaveWriter->Save(SaveInstance);
 }
 
 FString UXsollaLoginSubsystem::GetPendingSocialAuthenticationUrl() const
@@ -0,0 +1,211 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaLoginTokenManager.h"
+
+#include "XsollaLogin.h"
+#include "XsollaLoginDefines.h"
+#include "XsollaLoginSettings.h"
+#include "XsollaLoginSubsystem.h"
+#include "XsollaUtilsTokenParser.h"
+
+#include "Engine/GameInstance.h"
+#include "TimerManager.h"
+
+/** Delay before failed token refresh is retried (seconds) */
+static const float TokenRefreshRetryDelay = 30.f;
+
+UXsollaLoginTokenManager::UXsollaLoginTokenManager()
+	: UGameInstanceSubsystem()
+	, LoginSubsystem(nullptr)
+	, bRefreshInProgress(false)
+{
+}
+
+void UXsollaLoginTokenManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Collection.InitializeDependency(UXsollaLoginSubsystem::StaticClass());
+	LoginSubsystem = GetGameInstance()->GetSubsystem<UXsollaLoginSubsystem>();
+	if (!LoginSubsystem)
+	{
+		UE_LOG(LogXsollaLogin, Error, TEXT("%s: Can't find XsollaLogin subsystem"), *VA_FUNC_LINE);
+		return;
+	}
+
+	TokenChangedHandle = LoginSubsystem->OnTokenChanged.AddUObject(this, &UXsollaLoginTokenManager::OnLoginTokenChanged);
+	FXsollaAuthTokenProviderRegistry::Register(GetGameInstance(), this);
+
+	// Token could be restored from save game or launcher already
+	OnLoginTokenChanged(GetAuthToken());
+
+	UE_LOG(LogXsollaLogin, Log, TEXT("%s: XsollaLogin token manager initialized"), *VA_FUNC_LINE);
+}
+
+void UXsollaLoginTokenManager::Deinitialize()
+{
+	GetGameInstance()->GetTimerManager().ClearTimer(TokenExpirationTimerHandle);
+	GetGameInstance()->GetTimerManager().ClearTimer(RefreshRetryTimerHandle);
+	FXsollaAuthTokenProviderRegistry::Unregister(GetGameInstance());
+
+	if (LoginSubsystem)
+	{
+		LoginSubsystem->OnTokenChanged.Remove(TokenChangedHandle);
+		LoginSubsystem = nullptr;
+	}
+
+	Super::Deinitialize();
+}
+
+FString UXsollaLoginTokenManager::GetAuthToken() const
+{
+	return LoginSubsystem ? LoginSubsystem->GetLoginData().AuthToken.JWT : FString();
+}
+
+FString UXsollaLoginTokenManager::GetRefreshedAuthToken(const FString& AuthToken) const
+{
+	return RefreshedTokens.Contains(AuthToken) ? GetAuthToken() : FString();
+}
+
+FDateTime UXsollaLoginTokenManager::GetTokenExpirationTime() const
+{
+	const FXsollaJwtClaimsPtr Claims = FXsollaUtilsTokenParser::GetClaims(GetAuthToken());
+	if (!Claims.IsValid() || Claims->Exp == 0)
+	{
+		return FDateTime(0);
+	}
+
+	return FDateTime::FromUnixTimestamp(Claims->Exp);
+}
+
+float UXsollaLoginTokenManager::GetTokenTimeLeft() const
+{
+	const FXsollaJwtClaimsPtr Claims = FXsollaUtilsTokenParser::GetClaims(GetAuthToken());
+	if (!Claims.IsValid() || Claims->Exp == 0)
+	{
+		return -1.f;
+	}
+
+	return FMath::Max<float>(Claims->Exp - FDateTime::UtcNow().ToUnixTimestamp(), 0.f);
+}
+
+void UXsollaLoginTokenManager::RefreshToken()
+{
+	if (!LoginSubsystem || bRefreshInProgress)
+	{
+		return;
+	}
+
+	const FXsollaLoginData LoginData = LoginSubsystem->GetLoginData();
+	if (LoginData.AuthToken.JWT.IsEmpty())
+	{
+		UE_LOG(LogXsollaLogin, Warning, TEXT("%s: No token to refresh"), *VA_FUNC_LINE);
+		return;
+	}
+
+	// Login API has no refresh endpoint, so new token can only be received by authentication
+	const UXsollaLoginSettings* Settings = FXsollaLoginModule::Get().GetSettings();
+	if (!Settings->ReauthenticateOnTokenExpiration)
+	{
+		UE_LOG(LogXsollaLogin, Warning, TEXT("%s: Token isn't refreshed because re-authentication on token expiration is disabled, user should log in again"), *VA_FUNC_LINE);
+		return;
+	}
+
+	if (LoginData.Username.IsEmpty() || LoginData.Password.IsEmpty())
+	{
+		UE_LOG(LogXsollaLogin, Warning, TEXT("%s: Token isn't refreshed because there are no saved credentials, user should log in again"), *VA_FUNC_LINE);
+		return;
+	}
+
+	bRefreshInProgress = true;
+	RefreshingToken = LoginData.AuthToken.JWT;
+
+	FOnAuthUpdate SuccessCallback;
+	SuccessCallback.BindDynamic(this, &UXsollaLoginTokenManager::OnRefreshSuccess);
+
+	FOnAuthError ErrorCallback;
+	ErrorCallback.BindDynamic(this, &UXsollaLoginTokenManager::OnRefreshError);
+
+	UE_LOG(LogXsollaLogin, Log, TEXT("%s: Re-authenticate user with saved credentials"), *VA_FUNC_LINE);
+	LoginSubsystem->AuthenticateUser(LoginData.Username, LoginData.Password, SuccessCallback, ErrorCallback, LoginData.bRememberMe);
+}
+
+void UXsollaLoginTokenManager::OnLoginTokenChanged(const FString& Token)
+{
+	GetGameInstance()->GetTimerManager().ClearTimer(TokenExpirationTimerHandle);
+	GetGameInstance()->GetTimerManager().ClearTimer(RefreshRetryTimerHandle);
+
+	if (!bRefreshInProgress)
+	{
+		// New session (or logout), tokens of previous one must not be replaced with this one
+		RefreshedTokens.Empty();
+		RefreshingToken.Empty();
+
+		// Let other modules start user requests while token is being validated
+		if (!Token.IsEmpty())
+		{
+			FXsollaAuthTokenProviderRegistry::OnAuthTokenReceived().Broadcast(GetGameInstance(), Token);
+		}
+	}
+
+	const FXsollaJwtClaimsPtr Claims = FXsollaUtilsTokenParser::GetClaims(Token);
+	if (!Claims.IsValid() || Claims->Exp == 0)
+	{
+		return;
+	}
+
+	const UXsollaLoginSettings* Settings = FXsollaLoginModule::Get().GetSettings();
+	const int64 SecondsLeft = Claims->Exp - FDateTime::UtcNow().ToUnixTimestamp();
+
+	// Timer can't be fired immediately, so use small delay for tokens which are expiring already
+	const float Delay = FMath::Max(SecondsLeft - Settings->TokenExpirationLeadTime, 1.f);
+	GetGameInstance()->GetTimerManager().SetTimer(TokenExpirationTimerHandle, this, &UXsollaLoginTokenManager::OnTokenExpirationTimer, Delay, false);
+
+	UE_LOG(LogXsollaLogin, Verbose, TEXT("%s: Token expires in %lld seconds, refresh is scheduled in %.1f seconds"), *VA_FUNC_LINE, SecondsLeft, Delay);
+}
+
+void UXsollaLoginTokenManager::OnTokenExpirationTimer()
+{
+	const FString Token = GetAuthToken();
+	const int32 SecondsLeft = FMath::RoundToInt(GetTokenTimeLeft());
+
+	UE_LOG(LogXsollaLogin, Log, TEXT("%s: Token expires in %d seconds"), *VA_FUNC_LINE, SecondsLeft);
+	OnTokenExpiring.Broadcast(Token, SecondsLeft);
+
+	// Don't try to refresh the same token twice
+	if (Token != RefreshingToken)
+	{
+		RefreshToken();
+	}
+}
+
+void UXsollaLoginTokenManager::OnRefreshSuccess(const FXsollaLoginData& LoginData)
+{
+	bRefreshInProgress = false;
+
+	// Expiration of the same token can't be moved, so it's retried like failed refresh
+	if (LoginData.AuthToken.JWT == RefreshingToken)
+	{
+		OnRefreshError(FString(), TEXT("Re-authentication returned the same token"));
+		return;
+	}
+
+	RefreshedTokens.Add(RefreshingToken);
+	OnTokenRefreshed.Broadcast(LoginData.AuthToken.JWT);
+}
+
+void UXsollaLoginTokenManager::OnRefreshError(const FString& Code, const FString& Description)
+{
+	bRefreshInProgress = false;
+
+	// Let the same token be refreshed again
+	RefreshingToken.Empty();
+
+	UE_LOG(LogXsollaLogin, Warning, TEXT("%s: Can't refresh token: %s %s"), *VA_FUNC_LINE, *Code, *Description);
+
+	if (!GetAuthToken().IsEmpty())
+	{
+		GetGameInstance()->GetTimerManager().SetTimer(RefreshRetryTimerHandle, this, &UXsollaLoginTokenManager::OnTokenExpirationTimer, TokenRefreshRetryDelay, false);
+	}
+}
@@ -18,6 +18,12 @@ public:
 	static FXsollaLoginData Load();
 	static void Save(const FXsollaLoginData& InLoginData);
 
+	/** Load save object from slot or create new one, it's kept in memory for further writes */
+	static UXsollaLoginSave* LoadOrCreate();
+
+	const FXsollaLoginData& GetLoginData() const;
+	void SetLoginData(const FXsollaLoginData& InLoginData);
+
 public:
 	static const FString SaveSlotName;
 
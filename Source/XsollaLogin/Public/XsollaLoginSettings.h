@@ -38,6 +38,24 @@ enum class EXsollaTargetPlatform : uint8
 	PcOther
 };
 
+/** Where user authorization token signature is verified */
+UENUM()
+enum class EXsollaTokenVerification : uint8
+{
+	/** Token is sent to JWT Validation URL (or Xsolla validation endpoint) */
+	Remote UMETA(DisplayName = "Remote validation"),
+
+	/**
+	 * Token is verified locally with the project secret key (HS256). Dedicated servers only: the key is never stored in settings
+	 * and is read from -XsollaLoginJwtSecret= command line argument or XSOLLA_LOGIN_JWT_SECRET environment variable.
+	 * Clients ignore the secret and verify RS256 tokens with JWKS URL keys (if set) or remotely.
+	 */
+	LocalSecret UMETA(DisplayName = "Local (HS256 secret key, server only)"),
+
+	/** Token is verified locally with public keys downloaded from JWKS URL (RS256) */
+	LocalJwks UMETA(DisplayName = "Local (RS256 JWKS)"),
+};
+
 UCLASS(config = Engine, defaultconfig)
 class XSOLLALOGIN_API UXsollaLoginSettings : public UObject
 {
@@ -76,6 +94,25 @@ public:
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Login Settings", meta = (DisplayName = "JWT Validation URL"))
 	FString JWTValidationURL;
 
+	/**
+	 * Token verification method. Local verification checks signature, expiration, issuer and audience
+	 * without network round trip. Remote validator is used only if signing key is unknown.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Login Settings")
+	EXsollaTokenVerification TokenVerification;
+
+	/** URL of JSON Web Key Set used to verify RS256 tokens. Keys are downloaded on start and on key rotation. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Login Settings", meta = (DisplayName = "JWKS URL", EditCondition = "TokenVerification == EXsollaTokenVerification::LocalJwks"))
+	FString JWKSURL;
+
+	/** Expected token issuer (iss claim). Not checked if empty. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Login Settings", meta = (DisplayName = "JWT Issuer", EditCondition = "TokenVerification != EXsollaTokenVerification::Remote"))
+	FString JWTIssuer;
+
+	/** Expected token audience (aud claim). Not checked if empty. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Login Settings", meta = (DisplayName = "JWT Audience", EditCondition = "TokenVerification != EXsollaTokenVerification::Remote"))
+	FString JWTAudience;
+
 	/** If enabled, Login SDK will imitate platform-specific authentication so you can try account linking from different platforms. */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, DisplayName = "Use Cross-Platform Account Linking", Category = "Xsolla Login Settings")
 	bool UseCrossPlatformAccountLinking;
@@ -100,6 +137,28 @@ public:
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Login Settings", meta = (EditCondition = "UseCrossPlatformAccountLinking && Platform != EXsollaTargetPlatform::Xsolla"))
 	FString PlatformAccountID;
 
+	/** Time (in seconds) before token expiration when token manager notifies about it and tries to refresh the token. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Login Settings", meta = (ClampMin = "0"))
+	float TokenExpirationLeadTime;
+
+	/**
+	 * If enabled, token manager authenticates user again with saved credentials before token expiration.
+	 * Token isn't refreshed otherwise (or if there are no saved credentials), so user should log in again on OnTokenExpiring.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Login Settings")
+	bool ReauthenticateOnTokenExpiration;
+
+	/** If enabled, connection to Login API is opened on subsystem initialization, so first request doesn't wait for DNS lookup and TLS handshake. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Login Settings")
+	bool EnableConnectionWarmUp;
+
+	/**
+	 * Base URL of Login API used instead of https://login.xsolla.com/api (staging or mock server, for example).
+	 * Leave empty to use live service.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Login Settings", meta = (DisplayName = "Login API Base URL"))
+	FString LoginApiBaseURL;
+
 	/** Demo Project ID */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Login Demo")
 	FString DemoProjectID;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "XsollaLoginTypes.h"
+#include "XsollaUtilsJwtVerifier.h"
 
 #include "Blueprint/UserWidget.h"
 #include "Http.h"
@@ -23,6 +24,9 @@ enum class EXsollaLoginRequestVerb : uint8
 };
 
 class FJsonObject;
+class FXsollaSaveGameWriter;
+class FXsollaUtilsAssetLoader;
+class UXsollaLoginSave;
 
 /** Common callback for operations without any user-friendly messages from server on success */
 DECLARE_DYNAMIC_DELEGATE(FOnRequestSuccess);
@@ -32,6 +36,8 @@ DECLARE_DYNAMIC_DELEGATE_OneParam(FOnSocialUrlReceived, const FString&, Url);
 DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnAuthError, const FString&, Code, const FString&, Description);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnCodeReceived, const FString&, Code);
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnLoginTokenChanged, const FString& /* Token */);
+
 UCLASS()
 class XSOLLALOGIN_API UXsollaLoginSubsystem : public UGameInstanceSubsystem
 {
@@ -87,7 +93,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Xsolla|Login", meta = (AutoCreateRefTerm = "SuccessCallback, ErrorCallback"))
 	void ResetUserPassword(const FString& Username, const FOnRequestSuccess& SuccessCallback, const FOnAuthError& ErrorCallback);
 
-	/** Internal request for token validation (called with each auth update automatically)
+	/** Internal request for token validation (called with each auth update automatically).
+	 * Token is verified locally if it's enabled in settings, remote validator is used on signing key miss.
 	 *
 	 * @param SuccessCallback Callback function called after successful token validation.
 	 * @param ErrorCallback Callback function called after request resulted with an error.
@@ -108,11 +115,19 @@ public:
 	 *
 	 * @param SocialAuthenticationUrl URL with social network authentication form.
 	 * @param BrowserWidget Widget to represent social network authentication form. Can be set in project settings.
-	 * @param bRememberMe Whether the user agrees to save the authentication data. Default is 'false'.
+	 * @param bRememberMe Whether the user agrees to save the authentication data.
+	 * @param ErrorCallback Called if browser widget can't be created.
 	 */
-	UFUNCTION(BlueprintCallable, Category = "Xsolla|Login")
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Login", meta = (AutoCreateRefTerm = "ErrorCallback"))
+	void LaunchSocialAuthentication(const FString& SocialAuthenticationUrl, UUserWidget*& BrowserWidget, bool bRememberMe, const FOnAuthError& ErrorCallback);
+
+	UE_DEPRECATED(4.25, "Use LaunchSocialAuthentication with ErrorCallback to know when browser widget can't be created")
 	void LaunchSocialAuthentication(const FString& SocialAuthenticationUrl, UUserWidget*& BrowserWidget, bool bRememberMe = false);
 
+	/** Start background loading of default browser widget, otherwise it's loaded on first use */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Login")
+	void PrefetchAssets();
+
 	/** Set new value of token (used when token obtained via social network authentication etc.)
 	 *
 	 * @param Token User authorization token.
@@ -202,6 +217,8 @@ protected:
 	void AccountLinkingCode_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnCodeReceived SuccessCallback, FOnAuthError ErrorCallback);
 	void AuthConsoleAccountUser_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnAuthUpdate SuccessCallback, FOnAuthError ErrorCallback);
 
+	void Jwks_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnAuthUpdate SuccessCallback, FOnAuthError ErrorCallback, bool bValidateToken);
+
 	/** Return true if error has happened */
 	bool HandleRequestError(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnAuthError ErrorCallback);
 
@@ -212,18 +229,39 @@ private:
 	/** Set a Json string array field named FieldName and value of Array */
 	void SetStringArrayField(TSharedPtr<FJsonObject> Object, const FString& FieldName, const TArray<FString>& Array) const;
 
-	/** Parse JWT token and get its payload as json object */
-	bool ParseTokenPayload(const FString& Token, TSharedPtr<FJsonObject>& PayloadJsonObject) const;
-
 	/** Get name of target platform */
 	FString GetTargetPlatformName(EXsollaTargetPlatform Platform);
 
+	/** Send token to validation server */
+	void ValidateTokenRemotely(const FOnAuthUpdate& SuccessCallback, const FOnAuthError& ErrorCallback);
+
+	/** Mark token verified or report verification failure */
+	void CompleteTokenVerification(EXsollaJwtVerifyResult Result, const FOnAuthUpdate& SuccessCallback, const FOnAuthError& ErrorCallback);
+
+	/** Download JWKS and optionally validate current token with updated keys */
+	void RequestJwks(const FOnAuthUpdate& SuccessCallback, const FOnAuthError& ErrorCallback, bool bValidateToken);
+
+	/** Whether JWKS can be downloaded again (limited to protect from tokens with random kid) */
+	bool CanRequestJwks() const;
+
 	/** Cached Xsolla project id */
 	FString ProjectID;
 
 	/** Cached Xsolla Login project id */
 	FString LoginID;
 
+	/** Local verifier of token signatures */
+	TSharedPtr<FXsollaJwtVerifier, ESPMode::ThreadSafe> TokenVerifier;
+
+	/** Time of last JWKS request (FPlatformTime::Seconds) */
+	double LastJwksRequestTime;
+
+	/** Background writer of login data, repeated saves are coalesced */
+	TSharedPtr<FXsollaSaveGameWriter> SaveWriter;
+
+	/** Lazy loader of default browser widget */
+	TSharedPtr<FXsollaUtilsAssetLoader> AssetLoader;
+
 public:
 	/** Get user login state data */
 	UFUNCTION(BlueprintPure, Category = "Xsolla|Login")
@@ -265,7 +303,7 @@ public:
 	/** Load save game and extract data */
 	void LoadSavedData();
 
-	/** Save cached data or reset one if RememberMe is false */
+	/** Save cached data or reset one if RememberMe is false. Data is written in background */
 	void SaveData();
 
 	/** Get pending social authentication url to be opened in browser */
@@ -276,6 +314,29 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Xsolla|Login")
 	TArray<FXsollaUserAttribute> GetUserAttributes();
 
+	/** Verify token signature and claims locally using settings of Login project. Should be called on game thread.
+	 *
+	 * @param Token User authorization token.
+	 */
+	EXsollaJwtVerifyResult VerifyTokenLocally(const FString& Token) const;
+
+	/** Verify token signature and claims locally with options captured by GetTokenVerifyOptions.
+	 * Doesn't touch login state or settings, so it's safe to call from any thread (on dedicated server, for example).
+	 *
+	 * @param Token User authorization token.
+	 * @param Options Claims expectations, should be captured on game thread.
+	 */
+	EXsollaJwtVerifyResult VerifyTokenLocally(const FString& Token, const FXsollaJwtVerifyOptions& Options) const;
+
+	/** Get claims expectations from settings of Login project. Should be called on game thread */
+	FXsollaJwtVerifyOptions GetTokenVerifyOptions() const;
+
+	/** Error code passed to error callback when token fails local verification (same as status of rejected remote validation) */
+	static const FString TokenVerificationErrorCode;
+
+	/** Event occured when user authorization token was changed */
+	FOnLoginTokenChanged OnTokenChanged;
+
 protected:
 	/** Keeps state of user login */
 	FXsollaLoginData LoginData;
@@ -306,5 +367,9 @@ protected:
 
 private:
 	UPROPERTY()
-	TSubclassOf<UUserWidget> DefaultBrowserWidgetClass;
+	TSoftClassPtr<UUserWidget> DefaultBrowserWidgetClass;
+
+	/** Save object kept in memory, so slot isn't read on each save */
+	UPROPERTY()
+	UXsollaLoginSave* SaveInstance;
 };
@@ -0,0 +1,97 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "XsollaLoginTypes.h"
+#include "XsollaUtilsAuthTokenProvider.h"
+
+#include "Engine/EngineTypes.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Subsystems/SubsystemCollection.h"
+
+#include "XsollaLoginTokenManager.generated.h"
+
+class UXsollaLoginSubsystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTokenExpiring, const FString&, Token, int32, SecondsLeft);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTokenRefreshed, const FString&, Token);
+
+/**
+ * Tracks expiration of user authorization token and refreshes it in advance.
+ * Provides actual token to other Xsolla modules (see IXsollaAuthTokenProvider).
+ */
+UCLASS()
+class XSOLLALOGIN_API UXsollaLoginTokenManager : public UGameInstanceSubsystem, public IXsollaAuthTokenProvider
+{
+	GENERATED_BODY()
+
+public:
+	UXsollaLoginTokenManager();
+
+	// Begin USubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem
+
+	// Begin IXsollaAuthTokenProvider
+	virtual FString GetAuthToken() const override;
+	virtual FString GetRefreshedAuthToken(const FString& AuthToken) const override;
+	// End IXsollaAuthTokenProvider
+
+	/** Get expiration time (UTC) of current token, returns zero date if token doesn't expire */
+	UFUNCTION(BlueprintPure, Category = "Xsolla|Login|Token")
+	FDateTime GetTokenExpirationTime() const;
+
+	/** Get time (in seconds) left before current token expiration, negative if token doesn't expire */
+	UFUNCTION(BlueprintPure, Category = "Xsolla|Login|Token")
+	float GetTokenTimeLeft() const;
+
+	/** Refresh token right now by re-authentication with saved credentials (see project settings) */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Login|Token")
+	void RefreshToken();
+
+protected:
+	/** Schedule expiration check for new token */
+	void OnLoginTokenChanged(const FString& Token);
+
+	/** Called by timer when token is about to expire */
+	void OnTokenExpirationTimer();
+
+	UFUNCTION()
+	void OnRefreshSuccess(const FXsollaLoginData& LoginData);
+
+	UFUNCTION()
+	void OnRefreshError(const FString& Code, const FString& Description);
+
+public:
+	/** Event occured when token will expire soon */
+	UPROPERTY(BlueprintAssignable, Category = "Xsolla|Login|Token")
+	FOnTokenExpiring OnTokenExpiring;
+
+	/** Event occured when token was refreshed by token manager */
+	UPROPERTY(BlueprintAssignable, Category = "Xsolla|Login|Token")
+	FOnTokenRefreshed OnTokenRefreshed;
+
+private:
+	UPROPERTY()
+	UXsollaLoginSubsystem* LoginSubsystem;
+
+	/** Timer used to refresh token before expiration */
+	FTimerHandle TokenExpirationTimerHandle;
+
+	/** Login subsystem token change subscription */
+	FDelegateHandle TokenChangedHandle;
+
+	/** Token refresh was requested for, cleared if refresh fails so it can be retried */
+	FString RefreshingToken;
+
+	/** Tokens of current user session replaced by refresh */
+	TSet<FString> RefreshedTokens;
+
+	/** Timer used to retry failed refresh */
+	FTimerHandle RefreshRetryTimerHandle;
+
+	/** Whether refresh request is in progress */
+	bool bRefreshInProgress;
+};
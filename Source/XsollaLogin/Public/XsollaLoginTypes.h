@@ -48,7 +48,7 @@ struct FXsollaLoginData
 };
 
 USTRUCT(BlueprintType)
-struct FXsollaUserAttribute
+struct XSOLLALOGIN_API FXsollaUserAttribute
 {
 	GENERATED_BODY()
 
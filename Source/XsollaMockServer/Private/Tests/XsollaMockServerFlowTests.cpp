@@ -0,0 +1,297 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaMockServer.h"
+#include "XsollaMockBackend.h"
+#include "XsollaMockServerTestListener.h"
+
+#include "XsollaLoginSubsystem.h"
+#include "XsollaStoreSubsystem.h"
+
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace XsollaMockServerFlowTests
+{
+	/** Time to wait for each SDK request (seconds) */
+	static const double RequestTimeout = 10.;
+
+	/** Subsystems driven by flow test, created outside of game instance like benchmark does */
+	struct FFlowState
+	{
+		UXsollaStoreSubsystem* StoreSubsystem = nullptr;
+		UXsollaLoginSubsystem* LoginSubsystem = nullptr;
+		UXsollaMockServerTestListener* Listener = nullptr;
+		double StartTime = 0.;
+		bool bRequestSent = false;
+		bool bStartedServer = false;
+		bool bFailed = false;
+	};
+
+	/** Starts mock server with clean backend state and creates subsystems */
+	static TSharedPtr<FFlowState> StartFlow(FAutomationTestBase* Test)
+	{
+		FXsollaMockServerModule& MockServer = FXsollaMockServerModule::Get();
+
+		TSharedPtr<FFlowState> State = MakeShared<FFlowState>();
+		State->bStartedServer = !MockServer.IsServerRunning();
+		if (State->bStartedServer && !Test->TestTrue(TEXT("Mock server is started"), MockServer.StartServer(FXsollaMockServerModule::DefaultPort)))
+		{
+			return nullptr;
+		}
+
+		MockServer.GetBackend()->ResetState();
+
+		State->StoreSubsystem = NewObject<UXsollaStoreSubsystem>(GetTransientPackage());
+		State->StoreSubsystem->AddToRoot();
+		State->StoreSubsystem->Initialize(TEXT("flow"));
+
+		State->LoginSubsystem = NewObject<UXsollaLoginSubsystem>(GetTransientPackage());
+		State->LoginSubsystem->AddToRoot();
+		State->LoginSubsystem->Initialize(TEXT("flow"), TEXT("flow"));
+
+		State->Listener = NewObject<UXsollaMockServerTestListener>(GetTransientPackage());
+		State->Listener->AddToRoot();
+
+		return State;
+	}
+
+	/** Sends request and waits for its callback, following steps are skipped once one fails */
+	static void AddRequestStep(FAutomationTestBase* Test, TSharedRef<FFlowState> State, const FString& Name, TFunction<void()> SendRequest)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Test, State, Name, SendRequest]() {
+			if (State->bFailed)
+			{
+				return true;
+			}
+
+			if (!State->bRequestSent)
+			{
+				State->Listener->Reset();
+				State->bRequestSent = true;
+				State->StartTime = FPlatformTime::Seconds();
+				SendRequest();
+			}
+
+			if (!State->Listener->bCompleted)
+			{
+				if (FPlatformTime::Seconds() - State->StartTime < RequestTimeout)
+				{
+					return false;
+				}
+
+				State->Listener->Error = TEXT("timed out");
+			}
+
+			State->bRequestSent = false;
+			if (!State->Listener->bSucceeded)
+			{
+				Test->AddError(FString::Printf(TEXT("%s failed: %s"), *Name, *State->Listener->Error));
+				State->bFailed = true;
+			}
+
+			return true;
+		}));
+	}
+
+	/** Runs checks once all preceding requests succeeded */
+	static void AddCheckStep(TSharedRef<FFlowState> State, TFunction<void()> Check)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([State, Check]() {
+			if (!State->bFailed)
+			{
+				Check();
+			}
+
+			return true;
+		}));
+	}
+
+	/** Releases subsystems and stops mock server if flow has started it */
+	static void AddFinishStep(TSharedRef<FFlowState> State)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([State]() {
+			State->Listener->RemoveFromRoot();
+			State->LoginSubsystem->RemoveFromRoot();
+			State->StoreSubsystem->RemoveFromRoot();
+
+			if (State->bStartedServer)
+			{
+				FXsollaMockServerModule::Get().StopServer();
+			}
+
+			return true;
+		}));
+	}
+
+	static void AddAuthenticateStep(FAutomationTestBase* Test, TSharedRef<FFlowState> State)
+	{
+		AddRequestStep(Test, State, TEXT("AuthenticateUser"), [State]() {
+			FOnAuthUpdate SuccessCallback;
+			SuccessCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnAuthUpdate);
+			FOnAuthError ErrorCallback;
+			ErrorCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnAuthError);
+			State->LoginSubsystem->AuthenticateUser(TEXT("flow"), TEXT("flow"), SuccessCallback, ErrorCallback);
+		});
+	}
+} // namespace XsollaMockServerFlowTests
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXsollaMockServerLoginFlowTest, "Xsolla.MockServer.Flows.Login", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FXsollaMockServerLoginFlowTest::RunTest(const FString& Parameters)
+{
+	using namespace XsollaMockServerFlowTests;
+
+	TSharedPtr<FFlowState> StatePtr = StartFlow(this);
+	if (!StatePtr.IsValid())
+	{
+		return false;
+	}
+
+	TSharedRef<FFlowState> State = StatePtr.ToSharedRef();
+	AddAuthenticateStep(this, State);
+
+	AddCheckStep(State, [this, State]() {
+		TestFalse(TEXT("Auth token is received"), State->Listener->AuthToken.IsEmpty());
+		TestEqual(TEXT("Login data keeps auth token"), State->LoginSubsystem->GetLoginData().AuthToken.JWT, State->Listener->AuthToken);
+	});
+
+	AddRequestStep(this, State, TEXT("CreateAccountLinkingCode"), [State]() {
+		FOnCodeReceived SuccessCallback;
+		SuccessCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnCodeReceived);
+		FOnAuthError ErrorCallback;
+		ErrorCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnAuthError);
+		State->LoginSubsystem->CreateAccountLinkingCode(State->Listener->AuthToken, SuccessCallback, ErrorCallback);
+	});
+
+	AddCheckStep(State, [this, State]() {
+		TestEqual(TEXT("Account linking code is received"), State->Listener->Code, FString(TEXT("MOCK42")));
+	});
+
+	AddFinishStep(State);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXsollaMockServerCatalogFlowTest, "Xsolla.MockServer.Flows.Catalog", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FXsollaMockServerCatalogFlowTest::RunTest(const FString& Parameters)
+{
+	using namespace XsollaMockServerFlowTests;
+
+	TSharedPtr<FFlowState> StatePtr = StartFlow(this);
+	if (!StatePtr.IsValid())
+	{
+		return false;
+	}
+
+	TSharedRef<FFlowState> State = StatePtr.ToSharedRef();
+	AddRequestStep(this, State, TEXT("UpdateVirtualItems"), [State]() {
+		FOnStoreUpdate SuccessCallback;
+		SuccessCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnRequestSuccess);
+		FOnStoreError ErrorCallback;
+		ErrorCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnStoreError);
+		State->StoreSubsystem->UpdateVirtualItems(SuccessCallback, ErrorCallback);
+	});
+
+	AddCheckStep(State, [this, State]() {
+		const FStoreItemsData ItemsData = State->StoreSubsystem->GetItemsData();
+		TestTrue(TEXT("Catalog has items"), ItemsData.Items.Num() > 0);
+		TestTrue(TEXT("Catalog has fixture item"), ItemsData.Items.ContainsByPredicate([](const FStoreItem& Item) {
+			return Item.sku == TEXT("sword_basic");
+		}));
+	});
+
+	AddFinishStep(State);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXsollaMockServerCartFlowTest, "Xsolla.MockServer.Flows.Cart", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FXsollaMockServerCartFlowTest::RunTest(const FString& Parameters)
+{
+	using namespace XsollaMockServerFlowTests;
+
+	TSharedPtr<FFlowState> StatePtr = StartFlow(this);
+	if (!StatePtr.IsValid())
+	{
+		return false;
+	}
+
+	TSharedRef<FFlowState> State = StatePtr.ToSharedRef();
+	AddAuthenticateStep(this, State);
+
+	AddRequestStep(this, State, TEXT("AddToCart"), [State]() {
+		FOnStoreCartUpdate SuccessCallback;
+		SuccessCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnRequestSuccess);
+		FOnStoreError ErrorCallback;
+		ErrorCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnStoreError);
+		State->StoreSubsystem->AddToCart(State->Listener->AuthToken, FString(), TEXT("sword_basic"), 2, SuccessCallback, ErrorCallback);
+	});
+
+	AddRequestStep(this, State, TEXT("UpdateCart"), [State]() {
+		FOnStoreCartUpdate SuccessCallback;
+		SuccessCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnRequestSuccess);
+		FOnStoreError ErrorCallback;
+		ErrorCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnStoreError);
+		State->StoreSubsystem->UpdateCart(State->Listener->AuthToken, FString(), SuccessCallback, ErrorCallback);
+	});
+
+	AddCheckStep(State, [this, State]() {
+		// Cart is read back from server, so it matches backend state rather than local update
+		const FStoreCart Cart = State->StoreSubsystem->GetCart();
+		const FStoreCartItem* CartItem = Cart.Items.FindByPredicate([](const FStoreCartItem& Item) {
+			return Item.sku == TEXT("sword_basic");
+		});
+		if (TestNotNull(TEXT("Cart has added item"), CartItem))
+		{
+			TestEqual(TEXT("Cart item quantity"), CartItem->quantity, 2);
+		}
+	});
+
+	AddFinishStep(State);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXsollaMockServerPurchaseFlowTest, "Xsolla.MockServer.Flows.Purchase", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FXsollaMockServerPurchaseFlowTest::RunTest(const FString& Parameters)
+{
+	using namespace XsollaMockServerFlowTests;
+
+	TSharedPtr<FFlowState> StatePtr = StartFlow(this);
+	if (!StatePtr.IsValid())
+	{
+		return false;
+	}
+
+	TSharedRef<FFlowState> State = StatePtr.ToSharedRef();
+	AddAuthenticateStep(this, State);
+
+	AddRequestStep(this, State, TEXT("FetchPaymentToken"), [State]() {
+		FOnFetchTokenSuccess SuccessCallback;
+		SuccessCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnFetchTokenSuccess);
+		FOnStoreError ErrorCallback;
+		ErrorCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnStoreError);
+		State->StoreSubsystem->FetchPaymentToken(State->Listener->AuthToken, TEXT("sword_basic"), TEXT("USD"), FString(), FString(), SuccessCallback, ErrorCallback);
+	});
+
+	AddRequestStep(this, State, TEXT("CheckOrder"), [State]() {
+		FOnCheckOrder SuccessCallback;
+		SuccessCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnCheckOrder);
+		FOnStoreError ErrorCallback;
+		ErrorCallback.BindDynamic(State->Listener, &UXsollaMockServerTestListener::OnStoreError);
+		State->StoreSubsystem->CheckOrder(State->Listener->AuthToken, State->Listener->OrderId, SuccessCallback, ErrorCallback);
+	});
+
+	AddCheckStep(State, [this, State]() {
+		TestTrue(TEXT("Order is created"), State->Listener->OrderId > 0);
+		TestTrue(TEXT("Order is done"), State->Listener->OrderStatus == EXsollaOrderStatus::Done);
+	});
+
+	AddFinishStep(State);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,61 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaMockServerTestListener.h"
+
+UXsollaMockServerTestListener::UXsollaMockServerTestListener()
+	: bCompleted(false)
+	, bSucceeded(false)
+	, OrderId(0)
+	, OrderStatus(EXsollaOrderStatus::Unknown)
+{
+}
+
+void UXsollaMockServerTestListener::Reset()
+{
+	bCompleted = false;
+	bSucceeded = false;
+	Error.Empty();
+}
+
+void UXsollaMockServerTestListener::OnRequestSuccess()
+{
+	bCompleted = true;
+	bSucceeded = true;
+}
+
+void UXsollaMockServerTestListener::OnAuthUpdate(const FXsollaLoginData& LoginData)
+{
+	AuthToken = LoginData.AuthToken.JWT;
+	OnRequestSuccess();
+}
+
+void UXsollaMockServerTestListener::OnCodeReceived(const FString& InCode)
+{
+	Code = InCode;
+	OnRequestSuccess();
+}
+
+void UXsollaMockServerTestListener::OnFetchTokenSuccess(const FString& AccessToken, int32 InOrderId)
+{
+	OrderId = InOrderId;
+	OnRequestSuccess();
+}
+
+void UXsollaMockServerTestListener::OnCheckOrder(int32 InOrderId, EXsollaOrderStatus InOrderStatus)
+{
+	OrderStatus = InOrderStatus;
+	OnRequestSuccess();
+}
+
+void UXsollaMockServerTestListener::OnStoreError(int32 StatusCode, int32 ErrorCode, const FString& ErrorMessage)
+{
+	bCompleted = true;
+	Error = FString::Printf(TEXT("%d %d %s"), StatusCode, ErrorCode, *ErrorMessage);
+}
+
+void UXsollaMockServerTestListener::OnAuthError(const FString& InCode, const FString& Description)
+{
+	bCompleted = true;
+	Error = FString::Printf(TEXT("%s %s"), *InCode, *Description);
+}
@@ -0,0 +1,67 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "XsollaLoginTypes.h"
+#include "XsollaStoreDataModel.h"
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+
+#include "XsollaMockServerTestListener.generated.h"
+
+/** Receives SDK callbacks of flow test requests, test waits until request is completed */
+UCLASS()
+class UXsollaMockServerTestListener : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UXsollaMockServerTestListener();
+
+	/** Forget result of previous request */
+	void Reset();
+
+	UFUNCTION()
+	void OnRequestSuccess();
+
+	UFUNCTION()
+	void OnAuthUpdate(const FXsollaLoginData& LoginData);
+
+	UFUNCTION()
+	void OnCodeReceived(const FString& InCode);
+
+	UFUNCTION()
+	void OnFetchTokenSuccess(const FString& AccessToken, int32 InOrderId);
+
+	UFUNCTION()
+	void OnCheckOrder(int32 InOrderId, EXsollaOrderStatus InOrderStatus);
+
+	UFUNCTION()
+	void OnStoreError(int32 StatusCode, int32 ErrorCode, const FString& ErrorMessage);
+
+	UFUNCTION()
+	void OnAuthError(const FString& Code, const FString& Description);
+
+	/** Whether callback of last request was called */
+	bool bCompleted;
+
+	/** Whether last request succeeded */
+	bool bSucceeded;
+
+	/** Error of last request */
+	FString Error;
+
+	/** Token received by last authentication */
+	FString AuthToken;
+
+	/** Code received by last account linking code request */
+	FString Code;
+
+	/** Order created by last payment token request */
+	int32 OrderId;
+
+	/** Status received by last order check */
+	EXsollaOrderStatus OrderStatus;
+};
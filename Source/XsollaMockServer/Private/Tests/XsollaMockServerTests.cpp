@@ -0,0 +1,102 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaMockServer.h"
+
+#include "XsollaUtilsConnectionWarmer.h"
+#include "XsollaUtilsUrlOverrides.h"
+
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace XsollaMockServerTests
+{
+	/** Time to wait for warm-up and request (seconds) */
+	static const double RequestTimeout = 10.;
+
+	struct FConnectionReuseState
+	{
+		FString Url;
+		double StartTime = 0.;
+		bool bWarmUpFailed = false;
+		bool bRequestComplete = false;
+		bool bRequestSucceeded = false;
+	};
+} // namespace XsollaMockServerTests
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXsollaMockServerConnectionReuseTest, "Xsolla.MockServer.WarmUpConnectionReuse", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FXsollaMockServerConnectionReuseTest::RunTest(const FString& Parameters)
+{
+	using namespace XsollaMockServerTests;
+
+	FXsollaMockServerModule& MockServer = FXsollaMockServerModule::Get();
+	MockServer.StopServer();
+	if (!TestTrue(TEXT("Mock server is started with TLS"), MockServer.StartServer(FXsollaMockServerModule::DefaultPort, FXsollaMockServerModule::DefaultTlsPort)))
+	{
+		return false;
+	}
+
+	FXsollaUtilsConnectionWarmer::Reset();
+
+	TSharedRef<FConnectionReuseState> State = MakeShared<FConnectionReuseState>();
+	State->Url = FXsollaUtilsUrlOverrides::Apply(FXsollaUtilsUrlOverrides::StoreApiBaseUrl + TEXT("/v2/project/0/items/virtual_items"));
+	State->StartTime = FPlatformTime::Seconds();
+	FXsollaUtilsConnectionWarmer::WarmUp(State->Url);
+
+	// Request is sent once warm-up connection is open
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]() {
+		if (!FXsollaUtilsConnectionWarmer::IsWarmedUp(State->Url))
+		{
+			if (FPlatformTime::Seconds() - State->StartTime < RequestTimeout)
+			{
+				return false;
+			}
+
+			AddError(TEXT("Warm-up failed, http module should trust Saved/XsollaMockServer/localhost.pem or run with n.VerifyPeer=false"));
+			State->bWarmUpFailed = true;
+			return true;
+		}
+
+		TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
+		HttpRequest->SetURL(State->Url);
+		HttpRequest->SetVerb(TEXT("GET"));
+		HttpRequest->OnProcessRequestComplete().BindLambda([State](FHttpRequestPtr, FHttpResponsePtr HttpResponse, bool bSucceeded) {
+			State->bRequestComplete = true;
+			State->bRequestSucceeded = bSucceeded && HttpResponse.IsValid();
+		});
+		HttpRequest->ProcessRequest();
+
+		State->StartTime = FPlatformTime::Seconds();
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]() {
+		if (!State->bWarmUpFailed && !State->bRequestComplete && FPlatformTime::Seconds() - State->StartTime < RequestTimeout)
+		{
+			return false;
+		}
+
+		FXsollaMockServerModule& MockServer = FXsollaMockServerModule::Get();
+		if (State->bRequestSucceeded)
+		{
+			TestEqual(TEXT("Request reuses warm-up connection"), MockServer.GetTlsConnectionCount(), 1);
+		}
+		else if (!State->bWarmUpFailed)
+		{
+			AddError(TEXT("Request to mock server failed"));
+		}
+
+		MockServer.StopServer();
+		FXsollaUtilsConnectionWarmer::Reset();
+		return true;
+	}));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,756 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaMockBackend.h"
+
+#include "XsollaMockServerDefines.h"
+#include "XsollaUtilsCrypto.h"
+#include "XsollaUtilsJwtVerifier.h"
+
+#include "Dom/JsonObject.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "Misc/Base64.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace XsollaMockBackend
+{
+	static const FString MockCartId = TEXT("mock-cart");
+	static const FString DefaultLoginUrl = TEXT("https://login.xsolla.com/api/blank");
+
+	/** Fixture names, each one is loaded from <name>.json */
+	static const TCHAR* FixtureNames[] = {
+		TEXT("virtual_items"),
+		TEXT("groups"),
+		TEXT("virtual_currency"),
+		TEXT("virtual_currency_package"),
+		TEXT("inventory"),
+		TEXT("virtual_currency_balance"),
+		TEXT("subscriptions")};
+
+	FString EncodeBase64Url(const uint8* Data, int32 DataSize)
+	{
+		FString Result = FBase64::Encode(Data, DataSize);
+		Result.ReplaceInline(TEXT("+"), TEXT("-"));
+		Result.ReplaceInline(TEXT("/"), TEXT("_"));
+		Result.RemoveFromEnd(TEXT("=="));
+		Result.RemoveFromEnd(TEXT("="));
+		return Result;
+	}
+
+	FString EncodeBase64Url(const FString& Source)
+	{
+		FTCHARToUTF8 SourceUtf8(*Source);
+		return EncodeBase64Url(reinterpret_cast<const uint8*>(SourceUtf8.Get()), SourceUtf8.Length());
+	}
+
+	/** Segment value or empty string if path is shorter */
+	const FString& GetSegment(const TArray<FString>& Segments, int32 Index)
+	{
+		static const FString EmptySegment;
+		return Segments.IsValidIndex(Index) ? Segments[Index] : EmptySegment;
+	}
+} // namespace XsollaMockBackend
+
+FXsollaMockBackend::FXsollaMockBackend()
+	: CatalogSize(0)
+	, TokenSecret(TEXT("xsolla-mock-secret"))
+	, LastOrderId(0)
+{
+}
+
+bool FXsollaMockBackend::LoadFixtures(const FString& FixturesDir)
+{
+	using namespace XsollaMockBackend;
+
+	Fixtures.Empty();
+
+	bool bLoaded = true;
+	for (const TCHAR* FixtureName : FixtureNames)
+	{
+		const FString FilePath = FPaths::Combine(FixturesDir, FString(FixtureName) + TEXT(".json"));
+
+		FString FixtureStr;
+		TSharedPtr<FJsonObject> FixtureJson;
+		if (!FFileHelper::LoadFileToString(FixtureStr, *FilePath) || !(FixtureJson = ParseJson(FixtureStr)).IsValid())
+		{
+			UE_LOG(LogXsollaMockServer, Error, TEXT("%s: Can't load fixture: %s"), *VA_FUNC_LINE, *FilePath);
+			bLoaded = false;
+			continue;
+		}
+
+		Fixtures.Add(FixtureName, FixtureJson);
+	}
+
+	ResetState();
+
+	return bLoaded;
+}
+
+void FXsollaMockBackend::ResetState()
+{
+	Inventory.Empty();
+	Balances.Empty();
+	CartItems.Empty();
+	Orders.Empty();
+	OrderContents.Empty();
+	LastOrderId = 0;
+
+	const TArray<TSharedPtr<FJsonValue>>* Items = nullptr;
+	if (Fixtures.Contains(TEXT("inventory")) && Fixtures[TEXT("inventory")]->TryGetArrayField(TEXT("items"), Items))
+	{
+		for (const auto& Item : *Items)
+		{
+			const TSharedPtr<FJsonObject> ItemObject = Item->AsObject();
+			Inventory.Add(ItemObject->GetStringField(TEXT("sku")), ItemObject->GetIntegerField(TEXT("quantity")));
+		}
+	}
+
+	if (Fixtures.Contains(TEXT("virtual_currency_balance")) && Fixtures[TEXT("virtual_currency_balance")]->TryGetArrayField(TEXT("items"), Items))
+	{
+		for (const auto& Item : *Items)
+		{
+			const TSharedPtr<FJsonObject> ItemObject = Item->AsObject();
+			Balances.Add(ItemObject->GetStringField(TEXT("sku")), ItemObject->GetIntegerField(TEXT("amount")));
+		}
+	}
+}
+
+FXsollaMockResponse FXsollaMockBackend::HandleStoreRequest(const FString& Verb, const FString& Path, const TMap<FString, FString>& QueryParams, const FString& Body)
+{
+	using namespace XsollaMockBackend;
+
+	// v2/project/{project_id}/...
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("/"));
+	if (Segments.Num() < 4 || Segments[0] != TEXT("v2") || Segments[1] != TEXT("project"))
+	{
+		return MakeStoreError(404, FString::Printf(TEXT("Unknown path: %s"), *Path));
+	}
+
+	Segments.RemoveAt(0, 3);
+
+	const FString& Section = Segments[0];
+	if (Section == TEXT("items") && Verb == TEXT("GET"))
+	{
+		return HandleCatalogRequest(Segments);
+	}
+
+	if (Section == TEXT("user"))
+	{
+		const FString& Resource = GetSegment(Segments, 1);
+		if (Resource == TEXT("inventory") && GetSegment(Segments, 2) == TEXT("items"))
+		{
+			TArray<TSharedPtr<FJsonValue>> Items;
+			for (const auto& InventoryItem : Inventory)
+			{
+				TSharedPtr<FJsonObject> ItemObject = MakeShareable(new FJsonObject);
+				const TSharedPtr<FJsonObject> CatalogItem = FindCatalogItem(InventoryItem.Key);
+				if (CatalogItem.IsValid())
+				{
+					ItemObject->Values = CatalogItem->Values;
+				}
+
+				ItemObject->SetStringField(TEXT("sku"), InventoryItem.Key);
+				ItemObject->SetNumberField(TEXT("quantity"), InventoryItem.Value);
+				ItemObject->SetStringField(TEXT("type"), TEXT("virtual_good"));
+				Items.Add(MakeShareable(new FJsonValueObject(ItemObject)));
+			}
+
+			return FXsollaMockResponse(200, MakeItemsJson(Items));
+		}
+
+		if (Resource == TEXT("inventory") && GetSegment(Segments, 3) == TEXT("consume") && Verb == TEXT("POST"))
+		{
+			return HandleConsumeRequest(Body);
+		}
+
+		if (Resource == TEXT("virtual_currency_balance"))
+		{
+			TArray<TSharedPtr<FJsonValue>> Items;
+			for (const auto& Balance : Balances)
+			{
+				TSharedPtr<FJsonObject> ItemObject = MakeShareable(new FJsonObject);
+				const TSharedPtr<FJsonObject> CatalogItem = FindCatalogItem(Balance.Key);
+				if (CatalogItem.IsValid())
+				{
+					ItemObject->Values = CatalogItem->Values;
+				}
+
+				ItemObject->SetStringField(TEXT("sku"), Balance.Key);
+				ItemObject->SetNumberField(TEXT("amount"), Balance.Value);
+				Items.Add(MakeShareable(new FJsonValueObject(ItemObject)));
+			}
+
+			return FXsollaMockResponse(200, MakeItemsJson(Items));
+		}
+
+		if (Resource == TEXT("subscriptions") && Fixtures.Contains(TEXT("subscriptions")))
+		{
+			return FXsollaMockResponse(200, SerializeJson(Fixtures[TEXT("subscriptions")].ToSharedRef()));
+		}
+	}
+
+	if (Section == TEXT("cart"))
+	{
+		return HandleCartRequest(Verb, Segments, Body);
+	}
+
+	if (Section == TEXT("payment") && Verb == TEXT("POST"))
+	{
+		return HandlePaymentRequest(Segments);
+	}
+
+	if (Section == TEXT("order") && Verb == TEXT("GET"))
+	{
+		const int32 OrderId = FCString::Atoi(*GetSegment(Segments, 1));
+		FString* Status = Orders.Find(OrderId);
+		if (!Status)
+		{
+			return MakeStoreError(404, TEXT("Order not found"));
+		}
+
+		// Order is considered paid as soon as it's checked, so payment flow completes without Pay Station
+		if (*Status != TEXT("done"))
+		{
+			*Status = TEXT("done");
+			for (const auto& ContentItem : OrderContents.FindRef(OrderId))
+			{
+				GrantItem(ContentItem.Key, ContentItem.Value);
+			}
+		}
+
+		TSharedRef<FJsonObject> OrderJson = MakeShareable(new FJsonObject);
+		OrderJson->SetNumberField(TEXT("order_id"), OrderId);
+		OrderJson->SetStringField(TEXT("status"), *Status);
+		return FXsollaMockResponse(200, SerializeJson(OrderJson));
+	}
+
+	return MakeStoreError(404, FString::Printf(TEXT("Unknown path: %s"), *Path));
+}
+
+FXsollaMockResponse FXsollaMockBackend::HandleLoginRequest(const FString& Verb, const FString& Path, const TMap<FString, FString>& QueryParams, const FString& Body)
+{
+	using namespace XsollaMockBackend;
+
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("/"));
+	if (Segments.Num() > 0 && Segments[0] == TEXT("proxy"))
+	{
+		// Proxy endpoints behave like regular ones
+		Segments.RemoveAt(0);
+	}
+
+	const FString Endpoint = FString::Join(Segments, TEXT("/"));
+	const TSharedPtr<FJsonObject> BodyJson = ParseJson(Body);
+
+	if (Endpoint == TEXT("login") && Verb == TEXT("POST"))
+	{
+		FString Username;
+		if (!BodyJson.IsValid() || !BodyJson->TryGetStringField(TEXT("username"), Username) || Username.IsEmpty())
+		{
+			return MakeLoginError(422, TEXT("Username is required"));
+		}
+
+		const FString* LoginUrlParam = QueryParams.Find(TEXT("login_url"));
+		const FString LoginUrl = (LoginUrlParam && !LoginUrlParam->IsEmpty()) ? FGenericPlatformHttp::UrlDecode(*LoginUrlParam) : DefaultLoginUrl;
+
+		TSharedRef<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+		ResponseJson->SetStringField(TEXT("login_url"), FString::Printf(TEXT("%s%stoken=%s"), *LoginUrl, LoginUrl.Contains(TEXT("?")) ? TEXT("&") : TEXT("?"), *MakeToken(Username)));
+		return FXsollaMockResponse(200, SerializeJson(ResponseJson));
+	}
+
+	if ((Endpoint == TEXT("user") || Endpoint == TEXT("registration") || Endpoint == TEXT("password/reset/request") || Endpoint == TEXT("password/reset")) && Verb == TEXT("POST"))
+	{
+		return FXsollaMockResponse();
+	}
+
+	if (Endpoint == TEXT("token/validate") && Verb == TEXT("POST"))
+	{
+		FString Token;
+		if (BodyJson.IsValid())
+		{
+			BodyJson->TryGetStringField(TEXT("token"), Token);
+		}
+
+		FXsollaJwtVerifier Verifier;
+		Verifier.SetSecret(TokenSecret);
+
+		const EXsollaJwtVerifyResult Result = Verifier.Verify(Token, FXsollaJwtVerifyOptions());
+		if (Result != EXsollaJwtVerifyResult::Valid)
+		{
+			return MakeLoginError(422, LexToString(Result));
+		}
+
+		return FXsollaMockResponse(200, TEXT("{}"));
+	}
+
+	if (GetSegment(Segments, 0) == TEXT("social") && GetSegment(Segments, 2) == TEXT("login_url"))
+	{
+		TSharedRef<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+		ResponseJson->SetStringField(TEXT("url"), FString::Printf(TEXT("%s?provider=%s"), *DefaultLoginUrl, *GetSegment(Segments, 1)));
+		return FXsollaMockResponse(200, SerializeJson(ResponseJson));
+	}
+
+	if (Endpoint == TEXT("attributes/users/me/get"))
+	{
+		return FXsollaMockResponse(200, TEXT("[]"));
+	}
+
+	if (Endpoint == TEXT("attributes/users/me/update"))
+	{
+		return FXsollaMockResponse();
+	}
+
+	if (Endpoint == TEXT("users/account/code"))
+	{
+		return FXsollaMockResponse(200, TEXT("{\"code\":\"MOCK42\"}"));
+	}
+
+	return MakeLoginError(404, FString::Printf(TEXT("Unknown path: %s"), *Path));
+}
+
+FXsollaMockResponse FXsollaMockBackend::MakeStoreError(int32 Code, const FString& Message)
+{
+	// Example: {"statusCode":403,"errorCode":0,"errorMessage":"Token not found"}
+	TSharedRef<FJsonObject> ErrorJson = MakeShareable(new FJsonObject);
+	ErrorJson->SetNumberField(TEXT("statusCode"), Code);
+	ErrorJson->SetNumberField(TEXT("errorCode"), 0);
+	ErrorJson->SetStringField(TEXT("errorMessage"), Message);
+	return FXsollaMockResponse(Code, SerializeJson(ErrorJson));
+}
+
+FXsollaMockResponse FXsollaMockBackend::MakeLoginError(int32 Code, const FString& Message)
+{
+	// Example: {"error":{"code":"003-003","description":"The username is already taken"}}
+	TSharedPtr<FJsonObject> ErrorObject = MakeShareable(new FJsonObject);
+	ErrorObject->SetStringField(TEXT("code"), FString::Printf(TEXT("%03d-000"), Code));
+	ErrorObject->SetStringField(TEXT("description"), Message);
+
+	TSharedRef<FJsonObject> ErrorJson = MakeShareable(new FJsonObject);
+	ErrorJson->SetObjectField(TEXT("error"), ErrorObject);
+	return FXsollaMockResponse(Code, SerializeJson(ErrorJson));
+}
+
+FXsollaMockResponse FXsollaMockBackend::HandleCatalogRequest(const TArray<FString>& Segments)
+{
+	using namespace XsollaMockBackend;
+
+	const FString& Resource = GetSegment(Segments, 1);
+	if (Resource == TEXT("virtual_items"))
+	{
+		return FXsollaMockResponse(200, MakeItemsJson(GetCatalogItems()));
+	}
+
+	if (Resource == TEXT("groups") && Fixtures.Contains(TEXT("groups")))
+	{
+		return FXsollaMockResponse(200, SerializeJson(Fixtures[TEXT("groups")].ToSharedRef()));
+	}
+
+	if (Resource == TEXT("virtual_currency"))
+	{
+		// items/virtual_currency[/package][/sku/{sku}]
+		const bool bPackages = GetSegment(Segments, 2) == TEXT("package");
+		const FString FixtureName = bPackages ? TEXT("virtual_currency_package") : TEXT("virtual_currency");
+		const TSharedPtr<FJsonObject>* Fixture = Fixtures.Find(FixtureName);
+		if (!Fixture)
+		{
+			return MakeStoreError(404, TEXT("Fixture not found"));
+		}
+
+		const int32 SkuIndex = bPackages ? 3 : 2;
+		if (GetSegment(Segments, SkuIndex) != TEXT("sku"))
+		{
+			return FXsollaMockResponse(200, SerializeJson(Fixture->ToSharedRef()));
+		}
+
+		const FString& Sku = GetSegment(Segments, SkuIndex + 1);
+		for (const auto& Item : (*Fixture)->GetArrayField(TEXT("items")))
+		{
+			if (Item->AsObject()->GetStringField(TEXT("sku")) == Sku)
+			{
+				return FXsollaMockResponse(200, SerializeJson(Item->AsObject().ToSharedRef()));
+			}
+		}
+
+		return MakeStoreError(404, FString::Printf(TEXT("Item not found: %s"), *Sku));
+	}
+
+	return MakeStoreError(404, TEXT("Unknown catalog resource"));
+}
+
+FXsollaMockResponse FXsollaMockBackend::HandleCartRequest(const FString& Verb, const TArray<FString>& Segments, const FString& Body)
+{
+	using namespace XsollaMockBackend;
+
+	// cart, cart/{id}, cart[/{id}]/item/{sku}, cart[/{id}]/clear
+	int32 Index = 1;
+	const FString& Next = GetSegment(Segments, Index);
+	if (!Next.IsEmpty() && Next != TEXT("item") && Next != TEXT("clear"))
+	{
+		// Only one cart exists, so cart id is ignored
+		Index++;
+	}
+
+	const FString& Action = GetSegment(Segments, Index);
+	if (Action.IsEmpty() && Verb == TEXT("GET"))
+	{
+		return FXsollaMockResponse(200, MakeCartJson());
+	}
+
+	if (Action == TEXT("clear"))
+	{
+		CartItems.Empty();
+		return FXsollaMockResponse();
+	}
+
+	if (Action == TEXT("item"))
+	{
+		const FString& Sku = GetSegment(Segments, Index + 1);
+		if (!FindCatalogItem(Sku).IsValid())
+		{
+			return MakeStoreError(404, FString::Printf(TEXT("Item not found: %s"), *Sku));
+		}
+
+		if (Verb == TEXT("DELETE"))
+		{
+			CartItems.Remove(Sku);
+			return FXsollaMockResponse();
+		}
+
+		if (Verb == TEXT("PUT"))
+		{
+			const TSharedPtr<FJsonObject> BodyJson = ParseJson(Body);
+			int32 Quantity = 1;
+			if (BodyJson.IsValid())
+			{
+				BodyJson->TryGetNumberField(TEXT("quantity"), Quantity);
+			}
+
+			if (Quantity <= 0)
+			{
+				CartItems.Remove(Sku);
+			}
+			else
+			{
+				CartItems.Add(Sku, Quantity);
+			}
+
+			return FXsollaMockResponse();
+		}
+	}
+
+	return MakeStoreError(404, TEXT("Unknown cart resource"));
+}
+
+FXsollaMockResponse FXsollaMockBackend::HandlePaymentRequest(const TArray<FString>& Segments)
+{
+	using namespace XsollaMockBackend;
+
+	const FString& Kind = GetSegment(Segments, 1);
+	if (Kind == TEXT("cart"))
+	{
+		if (CartItems.Num() == 0)
+		{
+			return MakeStoreError(422, TEXT("Cart is empty"));
+		}
+
+		const int32 OrderId = CreateOrder(CartItems, TEXT("new"));
+		CartItems.Empty();
+
+		TSharedRef<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+		ResponseJson->SetStringField(TEXT("token"), FString::Printf(TEXT("mock-payment-token-%d"), OrderId));
+		ResponseJson->SetNumberField(TEXT("order_id"), OrderId);
+		return FXsollaMockResponse(200, SerializeJson(ResponseJson));
+	}
+
+	if (Kind != TEXT("item"))
+	{
+		return MakeStoreError(404, TEXT("Unknown payment resource"));
+	}
+
+	const FString& Sku = GetSegment(Segments, 2);
+	const TSharedPtr<FJsonObject> CatalogItem = FindCatalogItem(Sku);
+	if (!CatalogItem.IsValid())
+	{
+		return MakeStoreError(404, FString::Printf(TEXT("Item not found: %s"), *Sku));
+	}
+
+	TMap<FString, int32> Content;
+	Content.Add(Sku, 1);
+
+	// payment/item/{sku}/virtual/{currency_sku}
+	if (GetSegment(Segments, 3) == TEXT("virtual"))
+	{
+		const FString& CurrencySku = GetSegment(Segments, 4);
+
+		int32 Price = -1;
+		const TArray<TSharedPtr<FJsonValue>>* VirtualPrices = nullptr;
+		if (CatalogItem->TryGetArrayField(TEXT("virtual_prices"), VirtualPrices))
+		{
+			for (const auto& VirtualPrice : *VirtualPrices)
+			{
+				if (VirtualPrice->AsObject()->GetStringField(TEXT("sku")) == CurrencySku)
+				{
+					Price = VirtualPrice->AsObject()->GetIntegerField(TEXT("amount"));
+				}
+			}
+		}
+
+		if (Price < 0)
+		{
+			return MakeStoreError(422, FString::Printf(TEXT("Item can't be bought for %s"), *CurrencySku));
+		}
+
+		int32& Balance = Balances.FindOrAdd(CurrencySku);
+		if (Balance < Price)
+		{
+			return MakeStoreError(422, TEXT("Not enough virtual currency"));
+		}
+
+		Balance -= Price;
+		GrantItem(Sku, 1);
+
+		TSharedRef<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+		ResponseJson->SetNumberField(TEXT("order_id"), CreateOrder(Content, TEXT("done")));
+		return FXsollaMockResponse(200, SerializeJson(ResponseJson));
+	}
+
+	const int32 OrderId = CreateOrder(Content, TEXT("new"));
+
+	TSharedRef<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+	ResponseJson->SetStringField(TEXT("token"), FString::Printf(TEXT("mock-payment-token-%d"), OrderId));
+	ResponseJson->SetNumberField(TEXT("order_id"), OrderId);
+	return FXsollaMockResponse(200, SerializeJson(ResponseJson));
+}
+
+FXsollaMockResponse FXsollaMockBackend::HandleConsumeRequest(const FString& Body)
+{
+	const TSharedPtr<FJsonObject> BodyJson = ParseJson(Body);
+	if (!BodyJson.IsValid())
+	{
+		return MakeStoreError(422, TEXT("Invalid request body"));
+	}
+
+	FString Sku;
+	int32 Quantity = 1;
+	BodyJson->TryGetStringField(TEXT("sku"), Sku);
+	BodyJson->TryGetNumberField(TEXT("quantity"), Quantity);
+
+	int32* Owned = Inventory.Find(Sku);
+	if (!Owned)
+	{
+		return MakeStoreError(404, FString::Printf(TEXT("Item not found in inventory: %s"), *Sku));
+	}
+
+	if (*Owned < Quantity)
+	{
+		return MakeStoreError(422, TEXT("Not enough items to consume"));
+	}
+
+	*Owned -= Quantity;
+	if (*Owned == 0)
+	{
+		Inventory.Remove(Sku);
+	}
+
+	return FXsollaMockResponse();
+}
+
+TSharedPtr<FJsonObject> FXsollaMockBackend::FindCatalogItem(const FString& Sku) const
+{
+	for (const TCHAR* FixtureName : {TEXT("virtual_items"), TEXT("virtual_currency"), TEXT("virtual_currency_package")})
+	{
+		const TSharedPtr<FJsonObject>* Fixture = Fixtures.Find(FixtureName);
+		const TArray<TSharedPtr<FJsonValue>>* Items = nullptr;
+		if (!Fixture || !(*Fixture)->TryGetArrayField(TEXT("items"), Items))
+		{
+			continue;
+		}
+
+		for (const auto& Item : *Items)
+		{
+			if (Item->AsObject()->GetStringField(TEXT("sku")) == Sku)
+			{
+				return Item->AsObject();
+			}
+		}
+	}
+
+	// Replicated catalog items have numeric sku suffix
+	int32 SuffixIndex = INDEX_NONE;
+	if (CatalogSize > 0 && Sku.FindLastChar(TEXT('_'), SuffixIndex) && Sku.Mid(SuffixIndex + 1).IsNumeric())
+	{
+		for (const auto& Item : GetCatalogItems())
+		{
+			if (Item->AsObject()->GetStringField(TEXT("sku")) == Sku)
+			{
+				return Item->AsObject();
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+TArray<TSharedPtr<FJsonValue>> FXsollaMockBackend::GetCatalogItems() const
+{
+	TArray<TSharedPtr<FJsonValue>> Items;
+
+	const TSharedPtr<FJsonObject>* Fixture = Fixtures.Find(TEXT("virtual_items"));
+	const TArray<TSharedPtr<FJsonValue>>* FixtureItems = nullptr;
+	if (!Fixture || !(*Fixture)->TryGetArrayField(TEXT("items"), FixtureItems) || FixtureItems->Num() == 0)
+	{
+		return Items;
+	}
+
+	Items = *FixtureItems;
+	if (CatalogSize <= 0)
+	{
+		return Items;
+	}
+
+	// Replicate fixture items to get requested payload size
+	Items.SetNum(FMath::Min(Items.Num(), CatalogSize));
+	for (int32 Index = Items.Num(); Index < CatalogSize; ++Index)
+	{
+		const TSharedPtr<FJsonObject> Source = (*FixtureItems)[Index % FixtureItems->Num()]->AsObject();
+
+		TSharedPtr<FJsonObject> Copy = MakeShareable(new FJsonObject);
+		Copy->Values = Source->Values;
+		Copy->SetStringField(TEXT("sku"), FString::Printf(TEXT("%s_%d"), *Source->GetStringField(TEXT("sku")), Index));
+		Items.Add(MakeShareable(new FJsonValueObject(Copy)));
+	}
+
+	return Items;
+}
+
+void FXsollaMockBackend::GrantItem(const FString& Sku, int32 Quantity)
+{
+	// Virtual currency goes to balance, packages add their content
+	const TSharedPtr<FJsonObject> CatalogItem = FindCatalogItem(Sku);
+	const TSharedPtr<FJsonObject>* PackageContent = nullptr;
+	if (CatalogItem.IsValid() && CatalogItem->TryGetObjectField(TEXT("content"), PackageContent))
+	{
+		Balances.FindOrAdd((*PackageContent)->GetStringField(TEXT("sku"))) += (*PackageContent)->GetIntegerField(TEXT("quantity")) * Quantity;
+		return;
+	}
+
+	if (Balances.Contains(Sku))
+	{
+		Balances[Sku] += Quantity;
+		return;
+	}
+
+	Inventory.FindOrAdd(Sku) += Quantity;
+}
+
+int32 FXsollaMockBackend::CreateOrder(const TMap<FString, int32>& Content, const FString& Status)
+{
+	const int32 OrderId = ++LastOrderId;
+	Orders.Add(OrderId, Status);
+	OrderContents.Add(OrderId, Content);
+	return OrderId;
+}
+
+FString FXsollaMockBackend::MakeCartJson() const
+{
+	using namespace XsollaMockBackend;
+
+	double TotalAmount = 0.;
+	FString Currency = TEXT("USD");
+
+	TArray<TSharedPtr<FJsonValue>> Items;
+	for (const auto& CartItem : CartItems)
+	{
+		const TSharedPtr<FJsonObject> CatalogItem = FindCatalogItem(CartItem.Key);
+		if (!CatalogItem.IsValid())
+		{
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> ItemObject = MakeShareable(new FJsonObject);
+		ItemObject->Values = CatalogItem->Values;
+		ItemObject->SetNumberField(TEXT("quantity"), CartItem.Value);
+		Items.Add(MakeShareable(new FJsonValueObject(ItemObject)));
+
+		const TSharedPtr<FJsonObject>* Price = nullptr;
+		if (CatalogItem->TryGetObjectField(TEXT("price"), Price))
+		{
+			TotalAmount += FCString::Atod(*(*Price)->GetStringField(TEXT("amount"))) * CartItem.Value;
+			Currency = (*Price)->GetStringField(TEXT("currency"));
+		}
+	}
+
+	const FString Amount = FString::Printf(TEXT("%.2f"), TotalAmount);
+
+	TSharedPtr<FJsonObject> PriceObject = MakeShareable(new FJsonObject);
+	PriceObject->SetStringField(TEXT("amount"), Amount);
+	PriceObject->SetStringField(TEXT("amount_without_discount"), Amount);
+	PriceObject->SetStringField(TEXT("currency"), Currency);
+
+	TSharedRef<FJsonObject> CartJson = MakeShareable(new FJsonObject);
+	CartJson->SetStringField(TEXT("cart_id"), MockCartId);
+	CartJson->SetObjectField(TEXT("price"), PriceObject);
+	CartJson->SetBoolField(TEXT("is_free"), false);
+	CartJson->SetArrayField(TEXT("items"), Items);
+
+	return SerializeJson(CartJson);
+}
+
+FString FXsollaMockBackend::MakeToken(const FString& Username) const
+{
+	using namespace XsollaMockBackend;
+
+	TSharedRef<FJsonObject> PayloadJson = MakeShareable(new FJsonObject);
+	PayloadJson->SetStringField(TEXT("sub"), FString::Printf(TEXT("mock-%s"), *Username));
+	PayloadJson->SetStringField(TEXT("username"), Username);
+	PayloadJson->SetStringField(TEXT("provider"), TEXT("xsolla"));
+	PayloadJson->SetStringField(TEXT("type"), TEXT("xsolla_login"));
+	PayloadJson->SetStringField(TEXT("iss"), TEXT("https://login.xsolla.com"));
+	PayloadJson->SetBoolField(TEXT("is_master"), true);
+	PayloadJson->SetNumberField(TEXT("iat"), FDateTime::UtcNow().ToUnixTimestamp());
+	PayloadJson->SetNumberField(TEXT("exp"), FDateTime::UtcNow().ToUnixTimestamp() + 86400);
+
+	const FString SigningInput = EncodeBase64Url(TEXT("{\"alg\":\"HS256\",\"typ\":\"JWT\"}")) + TEXT(".") + EncodeBase64Url(SerializeJson(PayloadJson));
+
+	FTCHARToUTF8 SecretUtf8(*TokenSecret);
+	FTCHARToUTF8 SigningInputUtf8(*SigningInput);
+
+	uint8 Signature[FXsollaUtilsCrypto::Sha256DigestSize];
+	FXsollaUtilsCrypto::HmacSha256(reinterpret_cast<const uint8*>(SecretUtf8.Get()), SecretUtf8.Length(),
+		reinterpret_cast<const uint8*>(SigningInputUtf8.Get()), SigningInputUtf8.Length(), Signature);
+
+	return SigningInput + TEXT(".") + EncodeBase64Url(Signature, FXsollaUtilsCrypto::Sha256DigestSize);
+}
+
+FString FXsollaMockBackend::MakeItemsJson(const TArray<TSharedPtr<FJsonValue>>& Items)
+{
+	TSharedRef<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+	ResponseJson->SetArrayField(TEXT("items"), Items);
+	return SerializeJson(ResponseJson);
+}
+
+FString FXsollaMockBackend::SerializeJson(const TSharedRef<FJsonObject>& JsonObject)
+{
+	FString JsonStr;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonStr);
+	FJsonSerializer::Serialize(JsonObject, Writer);
+	return JsonStr;
+}
+
+TSharedPtr<FJsonObject> FXsollaMockBackend::ParseJson(const FString& JsonStr)
+{
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonStr);
+	if (JsonStr.IsEmpty() || !FJsonSerializer::Deserialize(Reader, JsonObject))
+	{
+		return nullptr;
+	}
+
+	return JsonObject;
+}
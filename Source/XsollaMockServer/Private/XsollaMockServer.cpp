@@ -0,0 +1,320 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaMockServer.h"
+
+#include "XsollaMockBackend.h"
+#include "XsollaMockServerDefines.h"
+#include "XsollaMockTlsProxy.h"
+#include "XsollaUtilsUrlOverrides.h"
+
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+
+namespace XsollaMockServer
+{
+	static TAutoConsoleVariable<float> CVarLatency(
+		TEXT("Xsolla.MockServer.Latency"),
+		0.f,
+		TEXT("Delay of every mock server response (ms)"));
+
+	static TAutoConsoleVariable<float> CVarLatencyJitter(
+		TEXT("Xsolla.MockServer.LatencyJitter"),
+		0.f,
+		TEXT("Random extra delay of mock server response, from 0 to this value (ms)"));
+
+	static TAutoConsoleVariable<float> CVarErrorRate(
+		TEXT("Xsolla.MockServer.ErrorRate"),
+		0.f,
+		TEXT("Share of mock server requests failed with Xsolla.MockServer.ErrorCode (0..1)"));
+
+	static TAutoConsoleVariable<int32> CVarErrorCode(
+		TEXT("Xsolla.MockServer.ErrorCode"),
+		500,
+		TEXT("Http status of injected mock server errors"));
+
+	static TAutoConsoleVariable<int32> CVarCatalogSize(
+		TEXT("Xsolla.MockServer.CatalogSize"),
+		0,
+		TEXT("Number of virtual items served by mock server, fixture items are replicated to reach it (0 to serve fixture as is)"));
+
+	static TAutoConsoleVariable<int32> CVarSeed(
+		TEXT("Xsolla.MockServer.Seed"),
+		0,
+		TEXT("Seed of mock server latency jitter and error injection, applied on server start"));
+
+	static FAutoConsoleCommand StartCommand(
+		TEXT("Xsolla.MockServer.Start"),
+		TEXT("Start Xsolla mock server and redirect SDK requests to it. Usage: Xsolla.MockServer.Start [Port] [TlsPort]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+			const uint32 Port = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : FXsollaMockServerModule::DefaultPort;
+			const uint32 TlsPort = (Args.Num() > 1) ? FCString::Atoi(*Args[1]) : 0;
+			FXsollaMockServerModule::Get().StartServer(Port, TlsPort);
+		}));
+
+	static FAutoConsoleCommand StopCommand(
+		TEXT("Xsolla.MockServer.Stop"),
+		TEXT("Stop Xsolla mock server and restore default API URLs"),
+		FConsoleCommandDelegate::CreateLambda([]() {
+			FXsollaMockServerModule::Get().StopServer();
+		}));
+
+	static FAutoConsoleCommand ResetCommand(
+		TEXT("Xsolla.MockServer.Reset"),
+		TEXT("Reset inventory, balances, cart and orders of Xsolla mock server"),
+		FConsoleCommandDelegate::CreateLambda([]() {
+			if (TSharedPtr<FXsollaMockBackend> Backend = FXsollaMockServerModule::Get().GetBackend())
+			{
+				Backend->ResetState();
+			}
+		}));
+
+	FString GetVerbName(EHttpServerRequestVerbs Verb)
+	{
+		switch (Verb)
+		{
+		case EHttpServerRequestVerbs::VERB_GET:
+			return TEXT("GET");
+
+		case EHttpServerRequestVerbs::VERB_POST:
+			return TEXT("POST");
+
+		case EHttpServerRequestVerbs::VERB_PUT:
+			return TEXT("PUT");
+
+		case EHttpServerRequestVerbs::VERB_DELETE:
+			return TEXT("DELETE");
+
+		default:
+			return TEXT("UNKNOWN");
+		}
+	}
+} // namespace XsollaMockServer
+
+const uint32 FXsollaMockServerModule::DefaultPort = 18080;
+const uint32 FXsollaMockServerModule::DefaultTlsPort = 18443;
+
+void FXsollaMockServerModule::StartupModule()
+{
+	ServerPort = 0;
+
+	UE_LOG(LogXsollaMockServer, Log, TEXT("%s: XsollaMockServer module started"), *VA_FUNC_LINE);
+
+	uint32 Port = DefaultPort;
+	if (FParse::Value(FCommandLine::Get(), TEXT("XsollaMockServer="), Port) || FParse::Param(FCommandLine::Get(), TEXT("XsollaMockServer")))
+	{
+		uint32 TlsPort = 0;
+		FParse::Value(FCommandLine::Get(), TEXT("XsollaMockServerTls="), TlsPort);
+		StartServer(Port, TlsPort);
+	}
+}
+
+void FXsollaMockServerModule::ShutdownModule()
+{
+	StopServer();
+}
+
+bool FXsollaMockServerModule::StartServer(uint32 Port, uint32 TlsPort)
+{
+	using namespace XsollaMockServer;
+
+	if (IsServerRunning())
+	{
+		UE_LOG(LogXsollaMockServer, Warning, TEXT("%s: Mock server is already running on port %d"), *VA_FUNC_LINE, ServerPort);
+		return false;
+	}
+
+	const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("Xsolla"));
+	if (!Plugin.IsValid())
+	{
+		UE_LOG(LogXsollaMockServer, Error, TEXT("%s: Can't find Xsolla plugin to load fixtures from"), *VA_FUNC_LINE);
+		return false;
+	}
+
+	TSharedPtr<FXsollaMockBackend> NewBackend = MakeShared<FXsollaMockBackend>();
+	if (!NewBackend->LoadFixtures(FPaths::Combine(Plugin->GetBaseDir(), TEXT("Resources"), TEXT("MockServer"))))
+	{
+		return false;
+	}
+
+	TSharedPtr<IHttpRouter> Router = FHttpServerModule::Get().GetHttpRouter(Port);
+	if (!Router.IsValid())
+	{
+		UE_LOG(LogXsollaMockServer, Error, TEXT("%s: Can't create http router on port %d"), *VA_FUNC_LINE, Port);
+		return false;
+	}
+
+	// Routes are matched by path prefix, so each one serves the whole API
+	const EHttpServerRequestVerbs Verbs = EHttpServerRequestVerbs::VERB_GET | EHttpServerRequestVerbs::VERB_POST | EHttpServerRequestVerbs::VERB_PUT | EHttpServerRequestVerbs::VERB_DELETE;
+	StoreRouteHandle = Router->BindRoute(FHttpPath(TEXT("/store")), Verbs, [this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) {
+		return HandleHttpRequest(Request, OnComplete, true);
+	});
+	LoginRouteHandle = Router->BindRoute(FHttpPath(TEXT("/login")), Verbs, [this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) {
+		return HandleHttpRequest(Request, OnComplete, false);
+	});
+	PayStationRouteHandle = Router->BindRoute(FHttpPath(TEXT("/paystation")), EHttpServerRequestVerbs::VERB_GET, [](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) {
+		OnComplete(FHttpServerResponse::Create(TEXT("<html><body><h1>Xsolla mock PayStation</h1><p>Order is paid once it's checked by SDK.</p></body></html>"), TEXT("text/html")));
+		return true;
+	});
+
+	FHttpServerModule::Get().StartAllListeners();
+
+	if (TlsPort != 0)
+	{
+		TSharedPtr<FXsollaMockTlsProxy> NewTlsProxy = MakeShared<FXsollaMockTlsProxy>();
+		if (!NewTlsProxy->Start(TlsPort, Port))
+		{
+			UnbindRoutes(Port);
+			return false;
+		}
+
+		TlsProxy = NewTlsProxy;
+	}
+
+	Backend = NewBackend;
+	ServerPort = Port;
+	RandomStream.Initialize(CVarSeed.GetValueOnGameThread());
+
+	const FString ServerUrl = (TlsPort != 0) ? FString::Printf(TEXT("https://localhost:%d"), TlsPort) : FString::Printf(TEXT("http://localhost:%d"), Port);
+	FXsollaUtilsUrlOverrides::SetBaseUrlOverride(FXsollaUtilsUrlOverrides::StoreApiBaseUrl, ServerUrl + TEXT("/store/api"));
+	FXsollaUtilsUrlOverrides::SetBaseUrlOverride(FXsollaUtilsUrlOverrides::LoginApiBaseUrl, ServerUrl + TEXT("/login/api"));
+	FXsollaUtilsUrlOverrides::SetBaseUrlOverride(FXsollaUtilsUrlOverrides::PayStationBaseUrl, ServerUrl + TEXT("/paystation"));
+	FXsollaUtilsUrlOverrides::SetBaseUrlOverride(FXsollaUtilsUrlOverrides::SandboxPayStationBaseUrl, ServerUrl + TEXT("/paystation"));
+
+	UE_LOG(LogXsollaMockServer, Log, TEXT("%s: Mock server is listening on %s"), *VA_FUNC_LINE, *ServerUrl);
+
+	return true;
+}
+
+void FXsollaMockServerModule::StopServer()
+{
+	if (!IsServerRunning())
+	{
+		return;
+	}
+
+	UnbindRoutes(ServerPort);
+
+	FXsollaUtilsUrlOverrides::SetBaseUrlOverride(FXsollaUtilsUrlOverrides::StoreApiBaseUrl, FString());
+	FXsollaUtilsUrlOverrides::SetBaseUrlOverride(FXsollaUtilsUrlOverrides::LoginApiBaseUrl, FString());
+	FXsollaUtilsUrlOverrides::SetBaseUrlOverride(FXsollaUtilsUrlOverrides::PayStationBaseUrl, FString());
+	FXsollaUtilsUrlOverrides::SetBaseUrlOverride(FXsollaUtilsUrlOverrides::SandboxPayStationBaseUrl, FString());
+
+	if (TlsProxy.IsValid())
+	{
+		TlsProxy->Shutdown();
+		TlsProxy.Reset();
+	}
+
+	Backend.Reset();
+	ServerPort = 0;
+
+	UE_LOG(LogXsollaMockServer, Log, TEXT("%s: Mock server stopped"), *VA_FUNC_LINE);
+}
+
+bool FXsollaMockServerModule::IsServerRunning() const
+{
+	return Backend.IsValid();
+}
+
+TSharedPtr<FXsollaMockBackend> FXsollaMockServerModule::GetBackend() const
+{
+	return Backend;
+}
+
+int32 FXsollaMockServerModule::GetTlsConnectionCount() const
+{
+	return TlsProxy.IsValid() ? TlsProxy->GetAcceptedConnections() : 0;
+}
+
+bool FXsollaMockServerModule::HandleHttpRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete, bool bStoreApi)
+{
+	using namespace XsollaMockServer;
+
+	if (!Backend.IsValid())
+	{
+		return false;
+	}
+
+	// Strip route prefix: /store/api/v2/project/... -> v2/project/...
+	static const FString ApiRoot = TEXT("/api/");
+	const FString FullPath = Request.RelativePath.GetPath();
+	const int32 ApiIndex = FullPath.Find(ApiRoot);
+	const FString ApiPath = (ApiIndex == INDEX_NONE) ? FullPath : FullPath.RightChop(ApiIndex + ApiRoot.Len());
+
+	FUTF8ToTCHAR BodyConverter(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+	const FString Body(BodyConverter.Length(), BodyConverter.Get());
+	const FString Verb = GetVerbName(Request.Verb);
+
+	const float ErrorRate = CVarErrorRate.GetValueOnGameThread();
+	if (ErrorRate > 0.f && RandomStream.FRand() < ErrorRate)
+	{
+		const int32 ErrorCode = CVarErrorCode.GetValueOnGameThread();
+		SendResponse(bStoreApi ? FXsollaMockBackend::MakeStoreError(ErrorCode, TEXT("Injected error")) : FXsollaMockBackend::MakeLoginError(ErrorCode, TEXT("Injected error")), OnComplete);
+		return true;
+	}
+
+	Backend->CatalogSize = CVarCatalogSize.GetValueOnGameThread();
+
+	const FXsollaMockResponse Response = bStoreApi ? Backend->HandleStoreRequest(Verb, ApiPath, Request.QueryParams, Body) : Backend->HandleLoginRequest(Verb, ApiPath, Request.QueryParams, Body);
+	UE_LOG(LogXsollaMockServer, Verbose, TEXT("%s: %s %s -> %d"), *VA_FUNC_LINE, *Verb, *FullPath, Response.Code);
+
+	SendResponse(Response, OnComplete);
+	return true;
+}
+
+void FXsollaMockServerModule::UnbindRoutes(uint32 Port)
+{
+	TSharedPtr<IHttpRouter> Router = FHttpServerModule::Get().GetHttpRouter(Port);
+	if (Router.IsValid())
+	{
+		Router->UnbindRoute(StoreRouteHandle);
+		Router->UnbindRoute(LoginRouteHandle);
+		Router->UnbindRoute(PayStationRouteHandle);
+	}
+
+	StoreRouteHandle.Reset();
+	LoginRouteHandle.Reset();
+	PayStationRouteHandle.Reset();
+
+	// Listener would keep the port bound, so server couldn't be restarted on another one
+	FHttpServerModule::Get().StopAllListeners();
+}
+
+void FXsollaMockServerModule::SendResponse(const FXsollaMockResponse& Response, const FHttpResultCallback& OnComplete)
+{
+	using namespace XsollaMockServer;
+
+	const int32 Code = Response.Code;
+	const FString Body = Response.Body;
+	auto Respond = [Code, Body, OnComplete]() {
+		TUniquePtr<FHttpServerResponse> HttpResponse = FHttpServerResponse::Create(Body, TEXT("application/json"));
+		HttpResponse->Code = static_cast<EHttpServerResponseCodes>(Code);
+		OnComplete(MoveTemp(HttpResponse));
+	};
+
+	const float Delay = (CVarLatency.GetValueOnGameThread() + RandomStream.FRandRange(0.f, CVarLatencyJitter.GetValueOnGameThread())) / 1000.f;
+	if (Delay <= 0.f)
+	{
+		Respond();
+		return;
+	}
+
+	FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Respond](float DeltaTime) {
+		Respond();
+		return false;
+	}),
+		Delay);
+}
+
+IMPLEMENT_MODULE(FXsollaMockServerModule, XsollaMockServer)
+
+DEFINE_LOG_CATEGORY(LogXsollaMockServer);
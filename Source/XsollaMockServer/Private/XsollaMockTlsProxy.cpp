@@ -0,0 +1,405 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaMockTlsProxy.h"
+
+#include "XsollaMockServerDefines.h"
+
+#include "Common/TcpSocketBuilder.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Ssl.h"
+
+#define UI UI_ST
+THIRD_PARTY_INCLUDES_START
+#include "openssl/bio.h"
+#include "openssl/bn.h"
+#include "openssl/err.h"
+#include "openssl/evp.h"
+#include "openssl/pem.h"
+#include "openssl/rsa.h"
+#include "openssl/ssl.h"
+#include "openssl/x509.h"
+#include "openssl/x509v3.h"
+THIRD_PARTY_INCLUDES_END
+#undef UI
+
+namespace XsollaMockTlsProxy
+{
+	static const int32 BufferSize = 16 * 1024;
+
+	/** Certificate is regenerated on every start, so it doesn't need to live long */
+	static const long CertificateLifetime = 60 * 60 * 24 * 30;
+} // namespace XsollaMockTlsProxy
+
+FXsollaMockTlsProxy::FXsollaMockTlsProxy()
+	: Context(nullptr)
+	, ListenSocket(nullptr)
+	, Thread(nullptr)
+	, TargetPort(0)
+{
+}
+
+FXsollaMockTlsProxy::~FXsollaMockTlsProxy()
+{
+	Shutdown();
+}
+
+bool FXsollaMockTlsProxy::Start(uint32 Port, uint32 InTargetPort)
+{
+	check(!Thread);
+
+	FSslModule::Get().GetSslManager().InitializeSsl();
+
+	if (!CreateContext())
+	{
+		UE_LOG(LogXsollaMockServer, Error, TEXT("%s: Can't create TLS certificate"), *VA_FUNC_LINE);
+		Shutdown();
+		return false;
+	}
+
+	ListenSocket = FTcpSocketBuilder(TEXT("XsollaMockTlsListener"))
+					   .AsReusable()
+					   .AsNonBlocking()
+					   .BoundToEndpoint(FIPv4Endpoint(FIPv4Address(127, 0, 0, 1), Port))
+					   .Listening(16)
+					   .Build();
+	if (!ListenSocket)
+	{
+		UE_LOG(LogXsollaMockServer, Error, TEXT("%s: Can't listen on TLS port %d"), *VA_FUNC_LINE, Port);
+		Shutdown();
+		return false;
+	}
+
+	TargetPort = InTargetPort;
+	bStopping = false;
+	AcceptedConnections.Reset();
+
+	Thread = FRunnableThread::Create(this, TEXT("XsollaMockTlsProxy"));
+
+	return Thread != nullptr;
+}
+
+void FXsollaMockTlsProxy::Shutdown()
+{
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	for (FConnection& Connection : Connections)
+	{
+		CloseConnection(Connection);
+	}
+	Connections.Empty();
+
+	DestroySocket(ListenSocket);
+
+	if (Context)
+	{
+		SSL_CTX_free(Context);
+		Context = nullptr;
+
+		FSslModule::Get().GetSslManager().ShutdownSsl();
+	}
+}
+
+int32 FXsollaMockTlsProxy::GetAcceptedConnections() const
+{
+	return AcceptedConnections.GetValue();
+}
+
+uint32 FXsollaMockTlsProxy::Run()
+{
+	while (!bStopping)
+	{
+		bool bActive = AcceptConnections();
+
+		for (int32 Index = Connections.Num() - 1; Index >= 0; --Index)
+		{
+			if (!PumpConnection(Connections[Index], bActive))
+			{
+				CloseConnection(Connections[Index]);
+				Connections.RemoveAtSwap(Index);
+			}
+		}
+
+		if (!bActive)
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}
+	}
+
+	return 0;
+}
+
+void FXsollaMockTlsProxy::Stop()
+{
+	bStopping = true;
+}
+
+bool FXsollaMockTlsProxy::CreateContext()
+{
+	using namespace XsollaMockTlsProxy;
+
+	EVP_PKEY* Key = EVP_PKEY_new();
+	RSA* Rsa = RSA_new();
+	BIGNUM* Exponent = BN_new();
+	X509* Certificate = X509_new();
+
+	bool bCreated = Key && Rsa && Exponent && Certificate &&
+					BN_set_word(Exponent, RSA_F4) == 1 &&
+					RSA_generate_key_ex(Rsa, 2048, Exponent, nullptr) == 1 &&
+					EVP_PKEY_assign_RSA(Key, Rsa) == 1;
+
+	if (bCreated)
+	{
+		// Key owns RSA now
+		Rsa = nullptr;
+
+		X509_set_version(Certificate, 2);
+		ASN1_INTEGER_set(X509_get_serialNumber(Certificate), 1);
+		X509_gmtime_adj(X509_get_notBefore(Certificate), 0);
+		X509_gmtime_adj(X509_get_notAfter(Certificate), CertificateLifetime);
+		X509_set_pubkey(Certificate, Key);
+
+		X509_NAME* Name = X509_get_subject_name(Certificate);
+		X509_NAME_add_entry_by_txt(Name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+		X509_set_issuer_name(Certificate, Name);
+
+		// Host name is checked against alternative names
+		X509_EXTENSION* AltName = X509V3_EXT_conf_nid(nullptr, nullptr, NID_subject_alt_name, const_cast<char*>("DNS:localhost,IP:127.0.0.1"));
+		bCreated = AltName && X509_add_ext(Certificate, AltName, -1) == 1 && X509_sign(Certificate, Key, EVP_sha256()) > 0;
+		X509_EXTENSION_free(AltName);
+	}
+
+	if (bCreated)
+	{
+		Context = SSL_CTX_new(SSLv23_server_method());
+		bCreated = Context && SSL_CTX_use_certificate(Context, Certificate) == 1 && SSL_CTX_use_PrivateKey(Context, Key) == 1;
+	}
+
+	if (bCreated)
+	{
+		BIO* PemBio = BIO_new(BIO_s_mem());
+		if (PemBio && PEM_write_bio_X509(PemBio, Certificate) == 1)
+		{
+			char* PemData = nullptr;
+			const long PemSize = BIO_get_mem_data(PemBio, &PemData);
+
+			const FString CertificatePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("XsollaMockServer"), TEXT("localhost.pem"));
+			const FUTF8ToTCHAR PemConverter(PemData, PemSize);
+			FFileHelper::SaveStringToFile(FString(PemConverter.Length(), PemConverter.Get()), *CertificatePath);
+
+			UE_LOG(LogXsollaMockServer, Log, TEXT("%s: TLS certificate is written to %s"), *VA_FUNC_LINE, *CertificatePath);
+		}
+		BIO_free(PemBio);
+	}
+
+	RSA_free(Rsa);
+	BN_free(Exponent);
+	X509_free(Certificate);
+	EVP_PKEY_free(Key);
+
+	if (!bCreated)
+	{
+		ERR_clear_error();
+	}
+
+	return bCreated;
+}
+
+bool FXsollaMockTlsProxy::AcceptConnections()
+{
+	bool bAccepted = false;
+
+	bool bPending = false;
+	while (ListenSocket->HasPendingConnection(bPending) && bPending)
+	{
+		FSocket* ClientSocket = ListenSocket->Accept(TEXT("XsollaMockTlsClient"));
+		if (!ClientSocket)
+		{
+			break;
+		}
+
+		ClientSocket->SetNonBlocking(true);
+
+		FConnection& Connection = Connections.AddDefaulted_GetRef();
+		Connection.Client = ClientSocket;
+		Connection.Target = nullptr;
+		Connection.Ssl = SSL_new(Context);
+		SSL_set_bio(Connection.Ssl, BIO_new(BIO_s_mem()), BIO_new(BIO_s_mem()));
+		SSL_set_accept_state(Connection.Ssl);
+
+		AcceptedConnections.Increment();
+		bAccepted = true;
+
+		UE_LOG(LogXsollaMockServer, Verbose, TEXT("%s: TLS connection accepted (%d in total)"), *VA_FUNC_LINE, AcceptedConnections.GetValue());
+	}
+
+	return bAccepted;
+}
+
+bool FXsollaMockTlsProxy::PumpConnection(FConnection& Connection, bool& bOutActive)
+{
+	using namespace XsollaMockTlsProxy;
+
+	uint8 Buffer[BufferSize];
+	int32 BytesRead = 0;
+
+	// Encrypted data from client
+	do
+	{
+		if (!ReceiveAvailable(Connection.Client, Buffer, BufferSize, BytesRead))
+		{
+			return false;
+		}
+
+		if (BytesRead > 0)
+		{
+			BIO_write(SSL_get_rbio(Connection.Ssl), Buffer, BytesRead);
+			bOutActive = true;
+		}
+	} while (BytesRead > 0);
+
+	// Handshake is driven by reads too
+	for (;;)
+	{
+		const int32 Decrypted = SSL_read(Connection.Ssl, Buffer, BufferSize);
+		if (Decrypted <= 0)
+		{
+			const int32 Error = SSL_get_error(Connection.Ssl, Decrypted);
+			if (Error == SSL_ERROR_WANT_READ || Error == SSL_ERROR_WANT_WRITE)
+			{
+				break;
+			}
+
+			if (Error != SSL_ERROR_ZERO_RETURN)
+			{
+				UE_LOG(LogXsollaMockServer, Warning, TEXT("%s: TLS connection failed (error %d), is mock server certificate trusted?"), *VA_FUNC_LINE, Error);
+				ERR_clear_error();
+			}
+
+			return false;
+		}
+
+		if (!Connection.Target || Connection.Target->GetConnectionState() != SCS_Connected)
+		{
+			DestroySocket(Connection.Target);
+
+			Connection.Target = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateSocket(NAME_Stream, TEXT("XsollaMockTlsTarget"), false);
+			if (!Connection.Target || !Connection.Target->Connect(*FIPv4Endpoint(FIPv4Address(127, 0, 0, 1), TargetPort).ToInternetAddr()))
+			{
+				UE_LOG(LogXsollaMockServer, Warning, TEXT("%s: Can't connect to mock server on port %d"), *VA_FUNC_LINE, TargetPort);
+				return false;
+			}
+
+			Connection.Target->SetNonBlocking(true);
+		}
+
+		if (!SendAll(Connection.Target, Buffer, Decrypted))
+		{
+			return false;
+		}
+
+		bOutActive = true;
+	}
+
+	// Responses of http listener, it may close connection after each of them
+	if (Connection.Target)
+	{
+		do
+		{
+			if (!ReceiveAvailable(Connection.Target, Buffer, BufferSize, BytesRead))
+			{
+				DestroySocket(Connection.Target);
+				break;
+			}
+
+			if (BytesRead > 0)
+			{
+				SSL_write(Connection.Ssl, Buffer, BytesRead);
+				bOutActive = true;
+			}
+		} while (BytesRead > 0);
+	}
+
+	// Encrypted data to client
+	BIO* OutBio = SSL_get_wbio(Connection.Ssl);
+	while (BIO_ctrl_pending(OutBio) > 0)
+	{
+		const int32 Encrypted = BIO_read(OutBio, Buffer, BufferSize);
+		if (Encrypted <= 0 || !SendAll(Connection.Client, Buffer, Encrypted))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FXsollaMockTlsProxy::CloseConnection(FConnection& Connection)
+{
+	if (Connection.Ssl)
+	{
+		SSL_free(Connection.Ssl);
+		Connection.Ssl = nullptr;
+	}
+
+	DestroySocket(Connection.Client);
+	DestroySocket(Connection.Target);
+}
+
+void FXsollaMockTlsProxy::DestroySocket(FSocket*& Socket)
+{
+	if (Socket)
+	{
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		Socket = nullptr;
+	}
+}
+
+bool FXsollaMockTlsProxy::SendAll(FSocket* Socket, const uint8* Data, int32 Size)
+{
+	while (Size > 0 && !bStopping)
+	{
+		int32 BytesSent = 0;
+		if (!Socket->Send(Data, Size, BytesSent))
+		{
+			if (ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() != SE_EWOULDBLOCK)
+			{
+				return false;
+			}
+
+			FPlatformProcess::Sleep(0.f);
+			continue;
+		}
+
+		Data += BytesSent;
+		Size -= BytesSent;
+	}
+
+	return Size == 0;
+}
+
+bool FXsollaMockTlsProxy::ReceiveAvailable(FSocket* Socket, uint8* Buffer, int32 BufferSize, int32& OutBytesRead)
+{
+	// Stream socket reports would-block as success with no data and graceful close as failure
+	OutBytesRead = 0;
+	if (!Socket->Recv(Buffer, BufferSize, OutBytesRead))
+	{
+		OutBytesRead = 0;
+		return false;
+	}
+
+	return true;
+}
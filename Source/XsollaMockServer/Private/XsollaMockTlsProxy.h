@@ -0,0 +1,87 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+
+class FRunnableThread;
+class FSocket;
+struct ssl_ctx_st;
+struct ssl_st;
+
+/**
+ * TLS front of mock server: terminates https connections on localhost with self-signed certificate
+ * and forwards decrypted requests to plain http listener. Accepted connections are counted,
+ * so tests can check whether SDK requests reuse connection opened by warm-up.
+ * Certificate is written to Saved/XsollaMockServer/localhost.pem, http module should trust it
+ * (or run with peer verification disabled) to connect.
+ */
+class FXsollaMockTlsProxy : public FRunnable
+{
+public:
+	FXsollaMockTlsProxy();
+	virtual ~FXsollaMockTlsProxy();
+
+	/** Start accepting TLS connections on Port and forwarding them to http listener on TargetPort */
+	bool Start(uint32 Port, uint32 TargetPort);
+
+	/** Close all connections and stop worker thread */
+	void Shutdown();
+
+	/** Number of TLS connections accepted since start */
+	int32 GetAcceptedConnections() const;
+
+	/** FRunnable implementation */
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	struct FConnection
+	{
+		FSocket* Client;
+
+		/** Connection to http listener, opened when request arrives and reopened if listener closes it */
+		FSocket* Target;
+
+		ssl_st* Ssl;
+	};
+
+	/** Generate key and self-signed certificate for localhost */
+	bool CreateContext();
+
+	/** Accept pending connections, returns true if any was accepted */
+	bool AcceptConnections();
+
+	/** Move data between client and listener, returns false when connection should be closed */
+	bool PumpConnection(FConnection& Connection, bool& bOutActive);
+
+	void CloseConnection(FConnection& Connection);
+
+	void DestroySocket(FSocket*& Socket);
+
+	/** Send whole buffer to non-blocking socket */
+	bool SendAll(FSocket* Socket, const uint8* Data, int32 Size);
+
+	/** Read from non-blocking socket, OutBytesRead is 0 if there is no data. Returns false if socket is closed or failed */
+	bool ReceiveAvailable(FSocket* Socket, uint8* Buffer, int32 BufferSize, int32& OutBytesRead);
+
+private:
+	ssl_ctx_st* Context;
+
+	FSocket* ListenSocket;
+
+	/** Used by worker thread only */
+	TArray<FConnection> Connections;
+
+	FRunnableThread* Thread;
+
+	uint32 TargetPort;
+
+	FThreadSafeBool bStopping;
+
+	FThreadSafeCounter AcceptedConnections;
+};
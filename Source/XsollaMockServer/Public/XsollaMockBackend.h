@@ -0,0 +1,109 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class FJsonValue;
+
+/** Response of mock backend */
+struct XSOLLAMOCKSERVER_API FXsollaMockResponse
+{
+	/** Http status code */
+	int32 Code;
+
+	/** Response json (empty for 204) */
+	FString Body;
+
+	FXsollaMockResponse()
+		: Code(204){};
+
+	FXsollaMockResponse(int32 InCode, const FString& InBody)
+		: Code(InCode)
+		, Body(InBody){};
+};
+
+/**
+ * In-memory stand-in for Xsolla Store and Login APIs. Catalog is served from json fixtures,
+ * inventory, balances, cart and orders are kept in memory, so purchase flows behave consistently.
+ * Backend doesn't depend on transport: http server uses it, but tests can call it directly.
+ */
+class XSOLLAMOCKSERVER_API FXsollaMockBackend
+{
+public:
+	FXsollaMockBackend();
+
+	/** Load fixtures from directory (see Resources/MockServer of the plugin) and reset state */
+	bool LoadFixtures(const FString& FixturesDir);
+
+	/** Drop inventory, balances, cart and orders changes */
+	void ResetState();
+
+	/** Handle Store API request. Path is relative to Store API base URL (v2/project/...) */
+	FXsollaMockResponse HandleStoreRequest(const FString& Verb, const FString& Path, const TMap<FString, FString>& QueryParams, const FString& Body);
+
+	/** Handle Login API request. Path is relative to Login API base URL (login, user, ...) */
+	FXsollaMockResponse HandleLoginRequest(const FString& Verb, const FString& Path, const TMap<FString, FString>& QueryParams, const FString& Body);
+
+	/** Make Store API error response */
+	static FXsollaMockResponse MakeStoreError(int32 Code, const FString& Message);
+
+	/** Make Login API error response */
+	static FXsollaMockResponse MakeLoginError(int32 Code, const FString& Message);
+
+	/** Number of catalog items served. Fixture items are replicated with sku suffixes to reach it (0 to serve fixture as is) */
+	int32 CatalogSize;
+
+	/** Secret used to sign issued tokens (HS256) */
+	FString TokenSecret;
+
+private:
+	FXsollaMockResponse HandleCatalogRequest(const TArray<FString>& Segments);
+	FXsollaMockResponse HandleCartRequest(const FString& Verb, const TArray<FString>& Segments, const FString& Body);
+	FXsollaMockResponse HandlePaymentRequest(const TArray<FString>& Segments);
+	FXsollaMockResponse HandleConsumeRequest(const FString& Body);
+
+	/** Find catalog item by sku in any fixture */
+	TSharedPtr<FJsonObject> FindCatalogItem(const FString& Sku) const;
+
+	/** Catalog items with replication applied */
+	TArray<TSharedPtr<FJsonValue>> GetCatalogItems() const;
+
+	/** Add item to inventory (or currency to balance) */
+	void GrantItem(const FString& Sku, int32 Quantity);
+
+	/** Create order with current cart or single item content */
+	int32 CreateOrder(const TMap<FString, int32>& Content, const FString& Status);
+
+	FString MakeCartJson() const;
+
+	/** Issue HS256 signed token for user */
+	FString MakeToken(const FString& Username) const;
+
+	static FString MakeItemsJson(const TArray<TSharedPtr<FJsonValue>>& Items);
+	static FString SerializeJson(const TSharedRef<FJsonObject>& JsonObject);
+	static TSharedPtr<FJsonObject> ParseJson(const FString& JsonStr);
+
+private:
+	/** Fixture documents by name (virtual_items, groups, ...) */
+	TMap<FString, TSharedPtr<FJsonObject>> Fixtures;
+
+	/** Inventory quantities by sku */
+	TMap<FString, int32> Inventory;
+
+	/** Virtual currency balances by sku */
+	TMap<FString, int32> Balances;
+
+	/** Cart content (sku -> quantity) */
+	TMap<FString, int32> CartItems;
+
+	/** Order statuses by id */
+	TMap<int32, FString> Orders;
+
+	/** Order contents by id */
+	TMap<int32, TMap<FString, int32>> OrderContents;
+
+	int32 LastOrderId;
+};
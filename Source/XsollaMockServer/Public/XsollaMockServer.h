@@ -0,0 +1,102 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "Modules/ModuleManager.h"
+
+#include "HttpResultCallback.h"
+#include "HttpRouteHandle.h"
+
+class FXsollaMockBackend;
+class FXsollaMockTlsProxy;
+struct FHttpServerRequest;
+struct FXsollaMockResponse;
+
+/**
+ * Localhost stand-in for Xsolla Store and Login backends. When started, SDK requests are redirected
+ * to it via base URL overrides, so flows can be tested and benchmarked without network access.
+ * Payment console is redirected too and shows placeholder page (orders are paid once they're checked).
+ *
+ * With TLS port set, SDK requests go through https front with self-signed certificate (see FXsollaMockTlsProxy).
+ *
+ * Console: Xsolla.MockServer.Start [Port] [TlsPort], Xsolla.MockServer.Stop, Xsolla.MockServer.Reset
+ * Command line: -XsollaMockServer[=Port] [-XsollaMockServerTls=TlsPort]
+ * Fault injection: Xsolla.MockServer.Latency, Xsolla.MockServer.LatencyJitter, Xsolla.MockServer.ErrorRate,
+ * Xsolla.MockServer.ErrorCode, Xsolla.MockServer.CatalogSize, Xsolla.MockServer.Seed
+ */
+class XSOLLAMOCKSERVER_API FXsollaMockServerModule : public IModuleInterface
+{
+public:
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+	/** Start listening on localhost and redirect SDK requests to mock server (over https if TlsPort isn't 0) */
+	bool StartServer(uint32 Port, uint32 TlsPort = 0);
+
+	/** Stop server and restore default base URLs */
+	void StopServer();
+
+	/** Whether server is started */
+	bool IsServerRunning() const;
+
+	/** In-process backend (valid when server is running) */
+	TSharedPtr<FXsollaMockBackend> GetBackend() const;
+
+	/** Number of connections accepted by TLS front since server start (0 without TLS) */
+	int32 GetTlsConnectionCount() const;
+
+	/**
+	 * Singleton-like access to this module's interface.  This is just for convenience!
+	 * Beware of calling this during the shutdown phase, though.  Your module might have been unloaded already.
+	 *
+	 * @return Returns singleton instance, loading the module on demand if needed
+	 */
+	static inline FXsollaMockServerModule& Get()
+	{
+		return FModuleManager::LoadModuleChecked<FXsollaMockServerModule>("XsollaMockServer");
+	}
+
+	/**
+	 * Checks to see if this module is loaded and ready.  It is only valid to call Get() if IsAvailable() returns true.
+	 *
+	 * @return True if the module is loaded and ready to use
+	 */
+	static inline bool IsAvailable()
+	{
+		return FModuleManager::Get().IsModuleLoaded("XsollaMockServer");
+	}
+
+	/** Default port of mock server */
+	static const uint32 DefaultPort;
+
+	/** Default port of mock server TLS front */
+	static const uint32 DefaultTlsPort;
+
+private:
+	/** Handle http request of Store (bStoreApi) or Login API, applying injected latency and errors */
+	bool HandleHttpRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete, bool bStoreApi);
+
+	/** Send response after injected latency */
+	void SendResponse(const FXsollaMockResponse& Response, const FHttpResultCallback& OnComplete);
+
+	/** Unbind routes from router on port and stop http listeners */
+	void UnbindRoutes(uint32 Port);
+
+private:
+	TSharedPtr<FXsollaMockBackend> Backend;
+
+	TSharedPtr<FXsollaMockTlsProxy> TlsProxy;
+
+	FHttpRouteHandle StoreRouteHandle;
+	FHttpRouteHandle LoginRouteHandle;
+	FHttpRouteHandle PayStationRouteHandle;
+
+	uint32 ServerPort;
+
+	/** Random stream for latency jitter and errors, seeded on start for reproducible runs */
+	FRandomStream RandomStream;
+};
@@ -0,0 +1,41 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+using UnrealBuildTool;
+
+public class XsollaMockServer : ModuleRules
+{
+    public XsollaMockServer(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "HTTPServer",
+                "Json",
+                "XsollaUtils"
+            }
+            );
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "CoreUObject",
+                "HTTP",
+                "Networking",
+                "Projects",
+                "Sockets",
+                "SSL",
+                "XsollaLogin",
+                "XsollaStore"
+            }
+            );
+
+        // TLS front with self-signed certificate
+        AddEngineThirdPartyPrivateStaticDependencies(Target, "OpenSSL");
+
+        PublicDefinitions.Add("WITH_XSOLLA_MOCK_SERVER=1");
+    }
+}
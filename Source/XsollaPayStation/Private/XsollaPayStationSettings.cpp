@@ -8,4 +8,7 @@ UXsollaPayStationSettings::UXsollaPayStationSettings(const FObjectInitializer& O
 	TokenRequestURL = TEXT("https://livedemo.xsolla.com/paystation/token_unreal.php");
 	EnableSandbox = false;
 	EnableSandboxInShippingBuild = false;
+	ReuseBrowserWidget = false;
+	EnablePaymentCompletionDetection = true;
+	EnableConnectionWarmUp = false;
 }
\ No newline at end of file
@@ -5,11 +5,18 @@
 #include "XsollaPayStation.h"
 #include "XsollaPayStationDefines.h"
 #include "XsollaPayStationSettings.h"
+#include "XsollaUtilsAssetLoader.h"
+#include "XsollaUtilsConnectionWarmer.h"
+#include "XsollaUtilsHttpTelemetry.h"
+#include "XsollaUtilsPaymentUrl.h"
+#include "XsollaUtilsUrlOverrides.h"
+#include "XsollaWebBrowser.h"
+#include "XsollaWebBrowserHost.h"
+#include "XsollaWebBrowserWidgetPool.h"
 
 #include "Engine/Engine.h"
 #include "Modules/ModuleManager.h"
 #include "Runtime/Launch/Resources/Version.h"
-#include "UObject/ConstructorHelpers.h"
 #include "UObject/Package.h"
 
 #define LOCTEXT_NAMESPACE "FXsollaPayStationModule"
@@ -20,20 +27,37 @@ const FString UXsollaPayStationSubsystem::SandboxPaymentEndpoint(TEXT("https://s
 UXsollaPayStationSubsystem::UXsollaPayStationSubsystem()
 	: UGameInstanceSubsystem()
 {
-	static ConstructorHelpers::FClassFinder<UUserWidget> BrowserWidgetFinder(TEXT("/Xsolla/Browser/W_PayStationBrowser.W_PayStationBrowser_C"));
-	DefaultBrowserWidgetClass = BrowserWidgetFinder.Class;
+	// Widget isn't loaded until it's used or prefetched
+	DefaultBrowserWidgetClass = TSoftClassPtr<UUserWidget>(FSoftObjectPath(TEXT("/Xsolla/Browser/W_PayStationBrowser.W_PayStationBrowser_C")));
+	AssetLoader = MakeShared<FXsollaUtilsAssetLoader>(TArray<FSoftObjectPath>{DefaultBrowserWidgetClass.ToSoftObjectPath()});
+
+	bPaymentCompletionDetected = false;
 }
 
 void UXsollaPayStationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
+	// Payment console itself is loaded by browser which doesn't share connections with http module
+	const UXsollaPayStationSettings* Settings = FXsollaPayStationModule::Get().GetSettings();
+	if (Settings->EnableConnectionWarmUp)
+	{
+		FXsollaUtilsConnectionWarmer::WarmUp(Settings->TokenRequestURL, this);
+	}
+
 	UE_LOG(LogXsollaPayStation, Log, TEXT("%s: XsollaPayStation subsystem initialized"), *VA_FUNC_LINE);
 }
 
 void UXsollaPayStationSubsystem::Deinitialize()
 {
-	// Do nothing for now
+	if (BrowserWidgetPool)
+	{
+		BrowserWidgetPool->Reset();
+	}
+
+	// Warmed up hosts are static, so they would outlive PIE session (other game instances keep their own)
+	FXsollaUtilsConnectionWarmer::Release(this);
+
 	Super::Deinitialize();
 }
 
@@ -41,27 +65,90 @@ void UXsollaPayStationSubsystem::FetchPaymentToken(const FOnFetchPaymentTokenSuc
 {
 	const UXsollaPayStationSettings* Settings = FXsollaPayStationModule::Get().GetSettings();
 	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Settings->TokenRequestURL);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaPayStationSubsystem::FetchPaymentToken_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaPayStationSubsystem::FetchPaymentToken_HttpRequestComplete, SuccessCallback, ErrorCallback);
 	HttpRequest->ProcessRequest();
+
+	// Payment console is likely to be opened once token is received
+	if (!Settings->OverrideBrowserWidgetClass)
+	{
+		PrefetchAssets();
+	}
 }
 
 void UXsollaPayStationSubsystem::LaunchPaymentConsole(const FString& PaymentToken, UUserWidget*& BrowserWidget)
+{
+	LaunchPaymentConsole(PaymentToken, BrowserWidget, FOnPayStationError());
+}
+
+void UXsollaPayStationSubsystem::LaunchPaymentConsole(const FString& PaymentToken, UUserWidget*& BrowserWidget, const FOnPayStationError& ErrorCallback)
 {
 	const FString Endpoint = IsSandboxEnabled() ? SandboxPaymentEndpoint : PaymentEndpoint;
-	const FString PayStationUrl = FString::Printf(TEXT("%s?access_token=%s"), *Endpoint, *PaymentToken);
+	const FString PayStationUrl = FXsollaUtilsUrlOverrides::Apply(FString::Printf(TEXT("%s?access_token=%s"), *Endpoint, *PaymentToken));
 
 	UE_LOG(LogXsollaPayStation, Log, TEXT("%s: Loading PayStation: %s"), *VA_FUNC_LINE, *PayStationUrl);
 
 	const UXsollaPayStationSettings* Settings = FXsollaPayStationModule::Get().GetSettings();
 
-	// Check for user browser widget override
-	auto BrowserWidgetClass = (Settings->OverrideBrowserWidgetClass) ? Settings->OverrideBrowserWidgetClass : DefaultBrowserWidgetClass;
+	auto BrowserWidgetClass = GetBrowserWidgetClass();
+	if (!BrowserWidgetClass)
+	{
+		UE_LOG(LogXsollaPayStation, Error, TEXT("%s: Can't load browser widget class"), *VA_FUNC_LINE);
+		BrowserWidget = nullptr;
+		ErrorCallback.ExecuteIfBound(0, 0, TEXT("Can't load browser widget class"));
+		return;
+	}
 
 	PengindPayStationUrl = PayStationUrl;
-	auto MyBrowser = CreateWidget<UUserWidget>(GEngine->GameViewport->GetWorld(), BrowserWidgetClass);
-	MyBrowser->AddToViewport(MAX_int32);
+	if (Settings->ReuseBrowserWidget)
+	{
+		BrowserWidget = GetBrowserWidgetPool()->Acquire(GEngine->GameViewport->GetWorld(), BrowserWidgetClass, PayStationUrl);
+	}
+	else
+	{
+		auto MyBrowser = CreateWidget<UUserWidget>(GEngine->GameViewport->GetWorld(), BrowserWidgetClass);
+		MyBrowser->AddToViewport(MAX_int32);
+
+		BrowserWidget = MyBrowser;
+	}
+
+	if (Settings->EnablePaymentCompletionDetection)
+	{
+		WatchPaymentBrowser(BrowserWidget);
+	}
+}
+
+void UXsollaPayStationSubsystem::PrewarmPaymentConsole()
+{
+	const UXsollaPayStationSettings* Settings = FXsollaPayStationModule::Get().GetSettings();
+	if (!Settings->ReuseBrowserWidget || !GEngine->GameViewport)
+	{
+		return;
+	}
+
+	UWorld* World = GEngine->GameViewport->GetWorld();
+	auto BrowserWidgetClass = GetBrowserWidgetClass();
+	if (!BrowserWidgetClass)
+	{
+		UE_LOG(LogXsollaPayStation, Error, TEXT("%s: Can't load browser widget class"), *VA_FUNC_LINE);
+		return;
+	}
 
-	BrowserWidget = MyBrowser;
+	// Pending url of shown widget shouldn't be replaced
+	if (GetBrowserWidgetPool()->IsWarm(World, BrowserWidgetClass) || GetBrowserWidgetPool()->IsInUse())
+	{
+		return;
+	}
+
+	UE_LOG(LogXsollaPayStation, Log, TEXT("%s: Prewarming payment browser"), *VA_FUNC_LINE);
+
+	// Widget loads pending url on construct
+	PengindPayStationUrl = FXsollaWebBrowserHost::BlankUrl;
+	GetBrowserWidgetPool()->Prewarm(World, BrowserWidgetClass);
+}
+
+void UXsollaPayStationSubsystem::PrefetchAssets()
+{
+	AssetLoader->Prefetch();
 }
 
 FString UXsollaPayStationSubsystem::GetPendingPayStationUrl() const
@@ -119,7 +206,74 @@ TSharedRef<IHttpRequest> UXsollaPayStationSubsystem::CreateHttpRequest(const FSt
 	HttpRequest->SetHeader(TEXT("X-SDK"), TEXT("PAYSTATION"));
 	HttpRequest->SetHeader(TEXT("X-SDK-V"), XSOLLA_PAYSTATION_VERSION);
 
+	FXsollaHttpTelemetry::Get().TrackRequest(HttpRequest);
+
 	return HttpRequest;
 }
 
+TSubclassOf<UUserWidget> UXsollaPayStationSubsystem::GetBrowserWidgetClass()
+{
+	// Check for user browser widget override
+	const UXsollaPayStationSettings* Settings = FXsollaPayStationModule::Get().GetSettings();
+	if (Settings->OverrideBrowserWidgetClass)
+	{
+		return Settings->OverrideBrowserWidgetClass;
+	}
+
+	AssetLoader->Load();
+	return DefaultBrowserWidgetClass.Get();
+}
+
+UXsollaWebBrowserWidgetPool* UXsollaPayStationSubsystem::GetBrowserWidgetPool()
+{
+	if (!BrowserWidgetPool)
+	{
+		BrowserWidgetPool = NewObject<UXsollaWebBrowserWidgetPool>(this);
+	}
+
+	return BrowserWidgetPool;
+}
+
+void UXsollaPayStationSubsystem::WatchPaymentBrowser(UUserWidget* BrowserWidget)
+{
+	bPaymentCompletionDetected = false;
+
+	for (UXsollaWebBrowser* Browser : UXsollaWebBrowser::FindBrowsers(BrowserWidget))
+	{
+		// Reused widget is bound already
+		Browser->OnUrlChanged.AddUniqueDynamic(this, &UXsollaPayStationSubsystem::HandlePaymentUrlChanged);
+		Browser->OnBeforeNavigation.AddUniqueDynamic(this, &UXsollaPayStationSubsystem::HandlePaymentNavigation);
+	}
+}
+
+void UXsollaPayStationSubsystem::HandlePaymentUrlChanged(const FText& Url)
+{
+	DetectPaymentCompletion(Url.ToString());
+}
+
+void UXsollaPayStationSubsystem::HandlePaymentNavigation(FString Url, bool bIsRedirect)
+{
+	DetectPaymentCompletion(Url);
+}
+
+void UXsollaPayStationSubsystem::DetectPaymentCompletion(const FString& Url)
+{
+	if (bPaymentCompletionDetected)
+	{
+		return;
+	}
+
+	FXsollaPaymentUrlResult PaymentResult;
+	if (!FXsollaUtilsPaymentUrl::Parse(Url, PaymentResult) || PaymentResult.Status == EXsollaPaymentUrlStatus::Unknown)
+	{
+		return;
+	}
+
+	bPaymentCompletionDetected = true;
+
+	UE_LOG(LogXsollaPayStation, Log, TEXT("%s: Payment status detected: %s (invoice %s)"), *VA_FUNC_LINE, *PaymentResult.StatusName, *PaymentResult.InvoiceId);
+
+	OnPaymentStatusDetected.Broadcast(PaymentResult.InvoiceId, PaymentResult.StatusName);
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
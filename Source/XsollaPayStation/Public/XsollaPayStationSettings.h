@@ -27,4 +27,19 @@ public:
 	/** Custom class to handle payment console. */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla PayStation Settings")
 	TSubclassOf<UUserWidget> OverrideBrowserWidgetClass;
+
+	/**
+	 * If enabled, payment browser widget is kept after payment console is closed and reused by next purchase
+	 * (browser view is kept by shared browser host either way). Browser widget should load pending PayStation url on Construct.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla PayStation Settings")
+	bool ReuseBrowserWidget;
+
+	/** If enabled, payment browser URLs are watched for PayStation status and return URL redirects (see OnPaymentStatusDetected). */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla PayStation Settings")
+	bool EnablePaymentCompletionDetection;
+
+	/** If enabled, connection to token request server is opened on subsystem initialization, so first token request doesn't wait for DNS lookup and TLS handshake. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla PayStation Settings")
+	bool EnableConnectionWarmUp;
 };
\ No newline at end of file
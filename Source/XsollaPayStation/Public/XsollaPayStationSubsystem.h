@@ -9,8 +9,12 @@
 
 #include "XsollaPayStationSubsystem.generated.h"
 
+class FXsollaUtilsAssetLoader;
+class UXsollaWebBrowserWidgetPool;
+
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnFetchPaymentTokenSuccess, const FString&, PaymentToken);
 DECLARE_DYNAMIC_DELEGATE_ThreeParams(FOnPayStationError, int32, StatusCode, int32, ErrorCode, const FString&, ErrorMessage);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPayStationPaymentStatus, const FString&, InvoiceId, const FString&, Status);
 
 UCLASS()
 class XSOLLAPAYSTATION_API UXsollaPayStationSubsystem : public UGameInstanceSubsystem
@@ -29,14 +33,29 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Xsolla|PayStation", meta = (AutoCreateRefTerm = "SuccessCallback, ErrorCallback"))
 	void FetchPaymentToken(const FOnFetchPaymentTokenSuccess& SuccessCallback, const FOnPayStationError& ErrorCallback);
 
-	/** Open payment console for provided token */
-	UFUNCTION(BlueprintCallable, Category = "Xsolla|PayStation", meta = (AutoCreateRefTerm = "SuccessCallback, ErrorCallback"))
+	/** Open payment console for provided token, error callback is called if browser widget can't be created */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|PayStation", meta = (AutoCreateRefTerm = "ErrorCallback"))
+	void LaunchPaymentConsole(const FString& PaymentToken, UUserWidget*& BrowserWidget, const FOnPayStationError& ErrorCallback);
+
+	UE_DEPRECATED(4.25, "Use LaunchPaymentConsole with ErrorCallback to know when browser widget can't be created")
 	void LaunchPaymentConsole(const FString& PaymentToken, UUserWidget*& BrowserWidget);
 
+	/** Create payment browser widget ahead of purchase, so LaunchPaymentConsole doesn't wait for widget and browser view creation */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|PayStation")
+	void PrewarmPaymentConsole();
+
+	/** Start background loading of default browser widget, otherwise it's loaded on first use */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|PayStation")
+	void PrefetchAssets();
+
 	/** Get pending PayStation URL to be opened in browser */
 	UFUNCTION(BlueprintCallable, Category = "Xsolla|PayStation")
 	FString GetPendingPayStationUrl() const;
 
+	/** Event occured when payment console reported finished payment (status is done, troubled or canceled) */
+	UPROPERTY(BlueprintAssignable, Category = "Xsolla|PayStation")
+	FOnPayStationPaymentStatus OnPaymentStatusDetected;
+
 protected:
 	void FetchPaymentToken_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnFetchPaymentTokenSuccess SuccessCallback, FOnPayStationError ErrorCallback);
 
@@ -48,14 +67,42 @@ private:
 	/** Create HTTP request and add Xsolla API meta */
 	TSharedRef<IHttpRequest> CreateHttpRequest(const FString& Url);
 
+	/** Get browser widget class set in settings or default one (loaded on first use) */
+	TSubclassOf<UUserWidget> GetBrowserWidgetClass();
+
+	/** Get payment browser widget pool (created on first use) */
+	UXsollaWebBrowserWidgetPool* GetBrowserWidgetPool();
+
+	/** Watch payment browser URLs to detect finished payment */
+	void WatchPaymentBrowser(UUserWidget* BrowserWidget);
+
+	UFUNCTION()
+	void HandlePaymentUrlChanged(const FText& Url);
+
+	UFUNCTION()
+	void HandlePaymentNavigation(FString Url, bool bIsRedirect);
+
+	/** Broadcast payment status once if URL reports it */
+	void DetectPaymentCompletion(const FString& Url);
+
 protected:
 	/** Pending paystation URL to be opened in browser */
 	FString PengindPayStationUrl;
 
+	/** Whether payment status was detected in shown payment console */
+	bool bPaymentCompletionDetected;
+
 	static const FString PaymentEndpoint;
 	static const FString SandboxPaymentEndpoint;
 
 private:
 	UPROPERTY()
-	TSubclassOf<UUserWidget> DefaultBrowserWidgetClass;
+	TSoftClassPtr<UUserWidget> DefaultBrowserWidgetClass;
+
+	/** Lazy loader of default browser widget */
+	TSharedPtr<FXsollaUtilsAssetLoader> AssetLoader;
+
+	/** Payment browser widget reused between purchases */
+	UPROPERTY()
+	UXsollaWebBrowserWidgetPool* BrowserWidgetPool;
 };
\ No newline at end of file
@@ -25,7 +25,8 @@ public class XsollaPayStation : ModuleRules
                 "CoreUObject",
                 "Engine",
                 "Slate",
-                "SlateCore"
+                "SlateCore",
+                "XsollaUtils"
             }
             );
 
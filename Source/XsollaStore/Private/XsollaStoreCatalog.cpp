@@ -0,0 +1,987 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaStoreCatalog.h"
+
+#include "XsollaStoreDefines.h"
+#include "XsollaStoreSearchIndex.h"
+#include "XsollaUtilsMemory.h"
+
+#include "Algo/Reverse.h"
+#include "Misc/Crc.h"
+
+namespace XsollaStoreCatalog
+{
+	/** Keep mask bits of items matching predicate, items are checked in batches of 64 */
+	template <typename PredicateType>
+	void FilterMask(FXsollaStoreItemMask& Mask, PredicateType Predicate)
+	{
+		TArray<uint64>& Words = Mask.GetWords();
+		for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+		{
+			if (Words[WordIndex] == 0)
+			{
+				continue;
+			}
+
+			const int32 FirstIndex = WordIndex * FXsollaStoreItemMask::BitsPerWord;
+			const int32 NumIndices = FMath::Min(FXsollaStoreItemMask::BitsPerWord, Mask.Num() - FirstIndex);
+
+			uint64 Matches = 0;
+			for (int32 Bit = 0; Bit < NumIndices; ++Bit)
+			{
+				Matches |= static_cast<uint64>(Predicate(FirstIndex + Bit)) << Bit;
+			}
+
+			Words[WordIndex] &= Matches;
+		}
+	}
+} // namespace XsollaStoreCatalog
+
+FXsollaStoreStringPool::FXsollaStoreStringPool()
+{
+	Reset();
+}
+
+int32 FXsollaStoreStringPool::Add(const FString& String)
+{
+	const int32 ExistingIndex = Find(String);
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return ExistingIndex;
+	}
+
+	const int32 Index = Strings.Add(String);
+	Indices.Add(FCrc::StrCrc32(*String), Index);
+
+	return Index;
+}
+
+int32 FXsollaStoreStringPool::Find(const FString& String) const
+{
+	if (String.IsEmpty())
+	{
+		return 0;
+	}
+
+	TArray<int32, TInlineAllocator<4>> Candidates;
+	Indices.MultiFind(FCrc::StrCrc32(*String), Candidates);
+	for (const int32 Candidate : Candidates)
+	{
+		if (Strings[Candidate].Equals(String, ESearchCase::CaseSensitive))
+		{
+			return Candidate;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+const FString& FXsollaStoreStringPool::Get(int32 Index) const
+{
+	return Strings[Index];
+}
+
+void FXsollaStoreStringPool::Reset()
+{
+	Strings.Reset();
+	Indices.Reset();
+
+	Strings.Add(FString());
+}
+
+SIZE_T FXsollaStoreStringPool::GetAllocatedSize() const
+{
+	SIZE_T Size = Strings.GetAllocatedSize() + Indices.GetAllocatedSize();
+	for (const FString& String : Strings)
+	{
+		Size += String.GetAllocatedSize();
+	}
+
+	return Size;
+}
+
+FXsollaStoreItemMask::FXsollaStoreItemMask()
+	: NumBits(0)
+{
+}
+
+FXsollaStoreItemMask::FXsollaStoreItemMask(int32 InNumBits, bool bValue)
+	: NumBits(InNumBits)
+{
+	const int32 NumWords = (NumBits + BitsPerWord - 1) / BitsPerWord;
+	Words.Init(bValue ? ~0ull : 0ull, NumWords);
+
+	// Bits past the end are always clear so set bits can be collected word by word
+	const int32 TailBits = NumBits % BitsPerWord;
+	if (bValue && TailBits != 0)
+	{
+		Words.Last() = (1ull << TailBits) - 1;
+	}
+}
+
+void FXsollaStoreItemMask::Set(int32 Index)
+{
+	Words[Index / BitsPerWord] |= 1ull << (Index % BitsPerWord);
+}
+
+bool FXsollaStoreItemMask::Get(int32 Index) const
+{
+	return (Words[Index / BitsPerWord] & (1ull << (Index % BitsPerWord))) != 0;
+}
+
+void FXsollaStoreItemMask::And(const FXsollaStoreItemMask& Other)
+{
+	check(NumBits == Other.NumBits);
+	for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+	{
+		Words[WordIndex] &= Other.Words[WordIndex];
+	}
+}
+
+void FXsollaStoreItemMask::AndNot(const FXsollaStoreItemMask& Other)
+{
+	check(NumBits == Other.NumBits);
+	for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+	{
+		Words[WordIndex] &= ~Other.Words[WordIndex];
+	}
+}
+
+void FXsollaStoreItemMask::Or(const FXsollaStoreItemMask& Other)
+{
+	check(NumBits == Other.NumBits);
+	for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+	{
+		Words[WordIndex] |= Other.Words[WordIndex];
+	}
+}
+
+void FXsollaStoreItemMask::GetSetIndices(TArray<int32>& OutIndices) const
+{
+	for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+	{
+		uint64 Word = Words[WordIndex];
+		while (Word != 0)
+		{
+			const int32 Bit = static_cast<int32>(FPlatformMath::CountTrailingZeros64(Word));
+			OutIndices.Add(WordIndex * BitsPerWord + Bit);
+			Word &= Word - 1;
+		}
+	}
+}
+
+int32 FXsollaStoreItemMask::Num() const
+{
+	return NumBits;
+}
+
+TArray<uint64>& FXsollaStoreItemMask::GetWords()
+{
+	return Words;
+}
+
+const TArray<uint64>& FXsollaStoreItemMask::GetWords() const
+{
+	return Words;
+}
+
+SIZE_T FXsollaStoreItemMask::GetAllocatedSize() const
+{
+	return Words.GetAllocatedSize();
+}
+
+FXsollaStoreCatalog::FXsollaStoreCatalog()
+	: SearchIndex(MakeUnique<FXsollaStoreSearchIndex>())
+{
+}
+
+FXsollaStoreCatalog::~FXsollaStoreCatalog()
+{
+}
+
+void FXsollaStoreCatalog::SetItems(const TArray<FStoreItem>& Items)
+{
+	Rebuild(Items, GetCurrencyPackages());
+	BuildSearchIndex();
+}
+
+void FXsollaStoreCatalog::SetCurrencyPackages(const TArray<FVirtualCurrencyPackage>& Packages)
+{
+	Rebuild(GetItems(), Packages);
+}
+
+void FXsollaStoreCatalog::SetGroups(const TArray<FStoreGroup>& InGroups)
+{
+	Groups = InGroups;
+
+	// Group names are searchable too
+	BuildSearchIndex();
+}
+
+int32 FXsollaStoreCatalog::GetItemCount() const
+{
+	return CompactItems.Num();
+}
+
+FStoreItem FXsollaStoreCatalog::GetItem(int32 Index) const
+{
+	const FCompactItem& CompactItem = CompactItems[Index];
+
+	FStoreItem Item;
+	Item.sku = Strings.Get(CompactItem.Sku);
+	Item.name = Strings.Get(CompactItem.Name);
+	Item.description = Strings.Get(CompactItem.Description);
+	Item.type = Strings.Get(CompactItem.Type);
+	Item.groups = MakeGroups(CompactItem.FirstGroup, CompactItem.NumGroups);
+	Item.is_free = CompactItem.bIsFree;
+	Item.price = MakePrice(CompactItem.Price);
+	Item.image_url = Strings.Get(CompactItem.ImageUrl);
+	Item.inventory_options.expiration_period.value = CompactItem.ExpirationValue;
+	Item.inventory_options.expiration_period.type = Strings.Get(CompactItem.ExpirationType);
+
+	Item.virtual_prices.Reserve(CompactItem.NumVirtualPrices);
+	for (int32 PriceIndex = CompactItem.FirstVirtualPrice; PriceIndex < CompactItem.FirstVirtualPrice + CompactItem.NumVirtualPrices; ++PriceIndex)
+	{
+		const FCompactVirtualPrice& CompactPrice = VirtualPrices[PriceIndex];
+		const FCompactCurrency& Currency = Currencies[CompactPrice.Currency];
+
+		FVirtualCurrencyPrice& VirtualPrice = Item.virtual_prices.AddDefaulted_GetRef();
+		VirtualPrice.sku = Strings.Get(Currency.Sku);
+		VirtualPrice.is_default = CompactPrice.bIsDefault;
+		VirtualPrice.amount = CompactPrice.Amount;
+		VirtualPrice.amount_without_discount = CompactPrice.AmountWithoutDiscount;
+		VirtualPrice.image_url = Strings.Get(Currency.ImageUrl);
+		VirtualPrice.name = Strings.Get(Currency.Name);
+		VirtualPrice.description = Strings.Get(Currency.Description);
+		VirtualPrice.type = Strings.Get(Currency.Type);
+		VirtualPrice.calculated_price.amount = Strings.Get(CompactPrice.CalculatedAmount);
+		VirtualPrice.calculated_price.amount_without_discount = Strings.Get(CompactPrice.CalculatedAmountWithoutDiscount);
+		VirtualPrice.calculated_price.amount_decimal = CompactPrice.CalculatedAmountDecimal;
+		VirtualPrice.calculated_price.amount_without_discount_decimal = CompactPrice.CalculatedAmountWithoutDiscountDecimal;
+	}
+
+	return Item;
+}
+
+TArray<FStoreItem> FXsollaStoreCatalog::GetItems() const
+{
+	TArray<FStoreItem> Items;
+	Items.Reserve(CompactItems.Num());
+	for (int32 Index = 0; Index < CompactItems.Num(); ++Index)
+	{
+		Items.Add(GetItem(Index));
+	}
+
+	return Items;
+}
+
+TArray<FStoreItem> FXsollaStoreCatalog::GetItemsInGroup(const FString& GroupExternalId) const
+{
+	TArray<int32> Indices;
+	GetGroupMask(GroupExternalId).GetSetIndices(Indices);
+
+	TArray<FStoreItem> Items;
+	Items.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
+	{
+		Items.Add(GetItem(Index));
+	}
+
+	return Items;
+}
+
+TArray<FStoreItem> FXsollaStoreCatalog::GetItemsWithoutGroup() const
+{
+	TArray<int32> Indices;
+	NoGroupMask.GetSetIndices(Indices);
+
+	TArray<FStoreItem> Items;
+	Items.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
+	{
+		Items.Add(GetItem(Index));
+	}
+
+	return Items;
+}
+
+int32 FXsollaStoreCatalog::FindItem(const FString& Sku) const
+{
+	// Duplicated skus resolve to the first one like linear search did
+	int32 FoundIndex = INDEX_NONE;
+
+	TArray<int32, TInlineAllocator<4>> Candidates;
+	ItemSkuIndex.MultiFind(GetTypeHash(Sku), Candidates);
+	for (const int32 Candidate : Candidates)
+	{
+		if ((FoundIndex == INDEX_NONE || Candidate < FoundIndex) && Strings.Get(CompactItems[Candidate].Sku) == Sku)
+		{
+			FoundIndex = Candidate;
+		}
+	}
+
+	return FoundIndex;
+}
+
+TArray<int32> FXsollaStoreCatalog::QueryItems(const FStoreItemsQuery& Query) const
+{
+	using namespace XsollaStoreCatalog;
+
+	FXsollaStoreItemMask Mask(CompactItems.Num(), true);
+
+	TArray<FXsollaStoreSearchHit> SearchHits;
+	if (!Query.SearchText.IsEmpty())
+	{
+		SearchHits = SearchIndex->Search(Query.SearchText);
+
+		FXsollaStoreItemMask SearchMask(CompactItems.Num(), false);
+		for (const FXsollaStoreSearchHit& Hit : SearchHits)
+		{
+			SearchMask.Set(Hit.Index);
+		}
+
+		Mask.And(SearchMask);
+	}
+
+	if (!Query.Group.IsEmpty())
+	{
+		Mask.And(GetGroupMask(Query.Group));
+	}
+
+	if (Query.FreeFilter == EXsollaItemsFreeFilter::Free)
+	{
+		Mask.And(FreeMask);
+	}
+	else if (Query.FreeFilter == EXsollaItemsFreeFilter::Paid)
+	{
+		Mask.AndNot(FreeMask);
+	}
+
+	if (!Query.Type.IsEmpty())
+	{
+		const int32 TypeId = TypeNames.IndexOfByPredicate([this, &Query](int32 TypeName) {
+			return Strings.Get(TypeName).Equals(Query.Type, ESearchCase::IgnoreCase);
+		});
+
+		if (TypeId == INDEX_NONE)
+		{
+			return TArray<int32>();
+		}
+
+		FilterMask(Mask, [this, TypeId](int32 Index) {
+			return TypeColumn[Index] == TypeId;
+		});
+	}
+
+	if (!Query.PriceCurrency.IsEmpty())
+	{
+		// Currency column keeps upper case ISO codes
+		const int32 Currency = Strings.Find(Query.PriceCurrency.ToUpper());
+		if (Currency == INDEX_NONE)
+		{
+			return TArray<int32>();
+		}
+
+		FilterMask(Mask, [this, Currency](int32 Index) {
+			return PriceCurrencyColumn[Index] == Currency;
+		});
+	}
+
+	FStoreDecimal MinPriceDecimal;
+	int64 MinPrice = MIN_int64;
+	if (FStoreDecimal::Parse(Query.MinPrice, MinPriceDecimal))
+	{
+		MinPrice = MinPriceDecimal.GetValue(PriceColumnScale);
+	}
+	else if (!Query.MinPrice.IsEmpty())
+	{
+		UE_LOG(LogXsollaStore, Warning, TEXT("%s: Invalid minimal price is ignored: %s"), *VA_FUNC_LINE, *Query.MinPrice);
+	}
+
+	FStoreDecimal MaxPriceDecimal;
+	int64 MaxPrice = MAX_int64;
+	if (FStoreDecimal::Parse(Query.MaxPrice, MaxPriceDecimal))
+	{
+		MaxPrice = MaxPriceDecimal.GetValue(PriceColumnScale);
+	}
+	else if (!Query.MaxPrice.IsEmpty())
+	{
+		UE_LOG(LogXsollaStore, Warning, TEXT("%s: Invalid maximal price is ignored: %s"), *VA_FUNC_LINE, *Query.MaxPrice);
+	}
+
+	if (MinPrice != MIN_int64 || MaxPrice != MAX_int64)
+	{
+		// Item without price doesn't match any price range
+		Mask.And(PriceMask);
+		FilterMask(Mask, [this, MinPrice, MaxPrice](int32 Index) {
+			return PriceColumn[Index] >= MinPrice && PriceColumn[Index] <= MaxPrice;
+		});
+	}
+
+	if (!Query.VirtualCurrency.IsEmpty())
+	{
+		FXsollaStoreItemMask CurrencyMask(CompactItems.Num(), false);
+		for (int32 CurrencyIndex = 0; CurrencyIndex < Currencies.Num(); ++CurrencyIndex)
+		{
+			if (Strings.Get(Currencies[CurrencyIndex].Sku).Equals(Query.VirtualCurrency, ESearchCase::IgnoreCase))
+			{
+				CurrencyMask.Or(CurrencyMasks[CurrencyIndex]);
+			}
+		}
+
+		Mask.And(CurrencyMask);
+	}
+
+	// Search hits are ordered by relevance already
+	const bool bRelevanceOrder = !Query.SearchText.IsEmpty() && (Query.SortBy == EXsollaItemsSortBy::None || Query.SortBy == EXsollaItemsSortBy::Relevance);
+
+	TArray<int32> Indices;
+	if (bRelevanceOrder)
+	{
+		for (const FXsollaStoreSearchHit& Hit : SearchHits)
+		{
+			if (Mask.Get(Hit.Index))
+			{
+				Indices.Add(Hit.Index);
+			}
+		}
+	}
+	else
+	{
+		Mask.GetSetIndices(Indices);
+	}
+
+	// Catalog order breaks ties so results are stable between pages
+	const TArray<int64>* SortColumn64 = nullptr;
+	const TArray<int32>* SortColumn32 = nullptr;
+
+	// Items without sort value go last in both directions
+	const FXsollaStoreItemMask* SortValueMask = nullptr;
+	switch (Query.SortBy)
+	{
+	case EXsollaItemsSortBy::Name:
+		SortColumn32 = &NameRankColumn;
+		break;
+
+	case EXsollaItemsSortBy::Price:
+		SortColumn64 = &PriceColumn;
+		SortValueMask = &PriceMask;
+		break;
+
+	case EXsollaItemsSortBy::VirtualPrice:
+		SortColumn32 = &VirtualPriceColumn;
+		SortValueMask = &VirtualPriceMask;
+		break;
+
+	default:
+		break;
+	}
+
+	const bool bDescending = Query.bSortDescending;
+	if (SortColumn64)
+	{
+		Indices.Sort([SortColumn64, SortValueMask, bDescending](int32 A, int32 B) {
+			const bool bHasValueA = !SortValueMask || SortValueMask->Get(A);
+			const bool bHasValueB = !SortValueMask || SortValueMask->Get(B);
+			if (bHasValueA != bHasValueB)
+			{
+				return bHasValueA;
+			}
+
+			const int64 ValueA = (*SortColumn64)[A];
+			const int64 ValueB = (*SortColumn64)[B];
+			return ValueA != ValueB ? (bDescending ? ValueA > ValueB : ValueA < ValueB) : A < B;
+		});
+	}
+	else if (SortColumn32)
+	{
+		Indices.Sort([SortColumn32, SortValueMask, bDescending](int32 A, int32 B) {
+			const bool bHasValueA = !SortValueMask || SortValueMask->Get(A);
+			const bool bHasValueB = !SortValueMask || SortValueMask->Get(B);
+			if (bHasValueA != bHasValueB)
+			{
+				return bHasValueA;
+			}
+
+			const int32 ValueA = (*SortColumn32)[A];
+			const int32 ValueB = (*SortColumn32)[B];
+			return ValueA != ValueB ? (bDescending ? ValueA > ValueB : ValueA < ValueB) : A < B;
+		});
+	}
+	else if (bDescending)
+	{
+		Algo::Reverse(Indices);
+	}
+
+	return Indices;
+}
+
+TSet<FString> FXsollaStoreCatalog::GetItemGroupIds() const
+{
+	TSet<FString> GroupIds;
+	for (const FCompactItem& CompactItem : CompactItems)
+	{
+		for (int32 RefIndex = CompactItem.FirstGroup; RefIndex < CompactItem.FirstGroup + CompactItem.NumGroups; ++RefIndex)
+		{
+			GroupIds.Add(Strings.Get(ItemGroups[GroupRefs[RefIndex]].ExternalId));
+		}
+	}
+
+	return GroupIds;
+}
+
+const TArray<FStoreGroup>& FXsollaStoreCatalog::GetGroups() const
+{
+	return Groups;
+}
+
+FStoreItemsData FXsollaStoreCatalog::GetItemsData() const
+{
+	FStoreItemsData ItemsData;
+	ItemsData.Items = GetItems();
+	ItemsData.GroupIds = GetItemGroupIds();
+	ItemsData.Groups = Groups;
+
+	return ItemsData;
+}
+
+int32 FXsollaStoreCatalog::GetCurrencyPackageCount() const
+{
+	return CompactPackages.Num();
+}
+
+FVirtualCurrencyPackage FXsollaStoreCatalog::GetCurrencyPackage(int32 Index) const
+{
+	const FCompactPackage& CompactPackage = CompactPackages[Index];
+
+	FVirtualCurrencyPackage Package;
+	Package.sku = Strings.Get(CompactPackage.Sku);
+	Package.name = Strings.Get(CompactPackage.Name);
+	Package.description = Strings.Get(CompactPackage.Description);
+	Package.image_url = Strings.Get(CompactPackage.ImageUrl);
+	Package.is_free = CompactPackage.bIsFree;
+	Package.order = CompactPackage.Order;
+	Package.groups = MakeGroups(CompactPackage.FirstGroup, CompactPackage.NumGroups);
+	Package.price = MakePrice(CompactPackage.Price);
+	Package.content.sku = Strings.Get(CompactPackage.ContentSku);
+	Package.content.name = Strings.Get(CompactPackage.ContentName);
+	Package.content.description = Strings.Get(CompactPackage.ContentDescription);
+	Package.content.image_url = Strings.Get(CompactPackage.ContentImageUrl);
+	Package.content.quantity = CompactPackage.ContentQuantity;
+
+	return Package;
+}
+
+TArray<FVirtualCurrencyPackage> FXsollaStoreCatalog::GetCurrencyPackages() const
+{
+	TArray<FVirtualCurrencyPackage> Packages;
+	Packages.Reserve(CompactPackages.Num());
+	for (int32 Index = 0; Index < CompactPackages.Num(); ++Index)
+	{
+		Packages.Add(GetCurrencyPackage(Index));
+	}
+
+	return Packages;
+}
+
+int32 FXsollaStoreCatalog::FindCurrencyPackage(const FString& Sku) const
+{
+	// Duplicated skus resolve to the first one like linear search did
+	int32 FoundIndex = INDEX_NONE;
+
+	TArray<int32, TInlineAllocator<4>> Candidates;
+	PackageSkuIndex.MultiFind(GetTypeHash(Sku), Candidates);
+	for (const int32 Candidate : Candidates)
+	{
+		if ((FoundIndex == INDEX_NONE || Candidate < FoundIndex) && Strings.Get(CompactPackages[Candidate].Sku) == Sku)
+		{
+			FoundIndex = Candidate;
+		}
+	}
+
+	return FoundIndex;
+}
+
+SIZE_T FXsollaStoreCatalog::GetItemsAllocatedSize() const
+{
+	return Strings.GetAllocatedSize() + CompactItems.GetAllocatedSize() + ItemSkuIndex.GetAllocatedSize() +
+		   Currencies.GetAllocatedSize() + CurrencyIndices.GetAllocatedSize() + VirtualPrices.GetAllocatedSize();
+}
+
+SIZE_T FXsollaStoreCatalog::GetGroupsAllocatedSize() const
+{
+	SIZE_T Size = ItemGroups.GetAllocatedSize() + ItemGroupIndices.GetAllocatedSize() + GroupRefs.GetAllocatedSize() + Groups.GetAllocatedSize();
+	for (const FStoreGroup& Group : Groups)
+	{
+		Size += FXsollaUtilsMemory::GetAllocatedSize(FStoreGroup::StaticStruct(), &Group);
+	}
+
+	return Size;
+}
+
+SIZE_T FXsollaStoreCatalog::GetCurrencyPackagesAllocatedSize() const
+{
+	return CompactPackages.GetAllocatedSize() + PackageSkuIndex.GetAllocatedSize();
+}
+
+SIZE_T FXsollaStoreCatalog::GetSearchIndexAllocatedSize() const
+{
+	return SearchIndex->GetAllocatedSize();
+}
+
+SIZE_T FXsollaStoreCatalog::GetColumnsAllocatedSize() const
+{
+	SIZE_T Size = PriceColumn.GetAllocatedSize() + PriceCurrencyColumn.GetAllocatedSize() + TypeColumn.GetAllocatedSize() +
+				  VirtualPriceColumn.GetAllocatedSize() + NameRankColumn.GetAllocatedSize() + TypeNames.GetAllocatedSize() +
+				  FreeMask.GetAllocatedSize() + PriceMask.GetAllocatedSize() + VirtualPriceMask.GetAllocatedSize() + NoGroupMask.GetAllocatedSize() + GroupMasks.GetAllocatedSize() + CurrencyMasks.GetAllocatedSize();
+
+	for (const FXsollaStoreItemMask& GroupMask : GroupMasks)
+	{
+		Size += GroupMask.GetAllocatedSize();
+	}
+
+	for (const FXsollaStoreItemMask& CurrencyMask : CurrencyMasks)
+	{
+		Size += CurrencyMask.GetAllocatedSize();
+	}
+
+	return Size;
+}
+
+void FXsollaStoreCatalog::Rebuild(const TArray<FStoreItem>& Items, const TArray<FVirtualCurrencyPackage>& Packages)
+{
+	Strings.Reset();
+	CompactItems.Reset(Items.Num());
+	CompactPackages.Reset(Packages.Num());
+	ItemGroups.Reset();
+	ItemGroupIndices.Reset();
+	GroupRefs.Reset();
+	Currencies.Reset();
+	CurrencyIndices.Reset();
+	VirtualPrices.Reset();
+	ItemSkuIndex.Reset();
+	PackageSkuIndex.Reset();
+
+	for (const FStoreItem& Item : Items)
+	{
+		FCompactItem& CompactItem = CompactItems.AddDefaulted_GetRef();
+		CompactItem.Sku = Strings.Add(Item.sku);
+		CompactItem.Name = Strings.Add(Item.name);
+		CompactItem.Description = Strings.Add(Item.description);
+		CompactItem.Type = Strings.Add(Item.type);
+		CompactItem.ImageUrl = Strings.Add(Item.image_url);
+		CompactItem.Price = InternPrice(Item.price);
+		CompactItem.FirstGroup = InternGroups(Item.groups);
+		CompactItem.NumGroups = Item.groups.Num();
+		CompactItem.ExpirationValue = Item.inventory_options.expiration_period.value;
+		CompactItem.ExpirationType = Strings.Add(Item.inventory_options.expiration_period.type);
+		CompactItem.bIsFree = Item.is_free;
+
+		CompactItem.FirstVirtualPrice = VirtualPrices.Num();
+		CompactItem.NumVirtualPrices = Item.virtual_prices.Num();
+		for (const FVirtualCurrencyPrice& VirtualPrice : Item.virtual_prices)
+		{
+			FCompactVirtualPrice& CompactPrice = VirtualPrices.AddDefaulted_GetRef();
+			CompactPrice.Currency = InternCurrency(VirtualPrice);
+			CompactPrice.Amount = VirtualPrice.amount;
+			CompactPrice.AmountWithoutDiscount = VirtualPrice.amount_without_discount;
+			CompactPrice.CalculatedAmount = Strings.Add(VirtualPrice.calculated_price.amount);
+			CompactPrice.CalculatedAmountWithoutDiscount = Strings.Add(VirtualPrice.calculated_price.amount_without_discount);
+			FStoreDecimal::Parse(VirtualPrice.calculated_price.amount, CompactPrice.CalculatedAmountDecimal);
+			FStoreDecimal::Parse(VirtualPrice.calculated_price.amount_without_discount, CompactPrice.CalculatedAmountWithoutDiscountDecimal);
+			CompactPrice.bIsDefault = VirtualPrice.is_default;
+		}
+
+		AddSkuIndex(ItemSkuIndex, Item.sku, CompactItems.Num() - 1);
+	}
+
+	for (const FVirtualCurrencyPackage& Package : Packages)
+	{
+		FCompactPackage& CompactPackage = CompactPackages.AddDefaulted_GetRef();
+		CompactPackage.Sku = Strings.Add(Package.sku);
+		CompactPackage.Name = Strings.Add(Package.name);
+		CompactPackage.Description = Strings.Add(Package.description);
+		CompactPackage.ImageUrl = Strings.Add(Package.image_url);
+		CompactPackage.Price = InternPrice(Package.price);
+		CompactPackage.FirstGroup = InternGroups(Package.groups);
+		CompactPackage.NumGroups = Package.groups.Num();
+		CompactPackage.Order = Package.order;
+		CompactPackage.ContentSku = Strings.Add(Package.content.sku);
+		CompactPackage.ContentName = Strings.Add(Package.content.name);
+		CompactPackage.ContentDescription = Strings.Add(Package.content.description);
+		CompactPackage.ContentImageUrl = Strings.Add(Package.content.image_url);
+		CompactPackage.ContentQuantity = Package.content.quantity;
+		CompactPackage.bIsFree = Package.is_free;
+
+		AddSkuIndex(PackageSkuIndex, Package.sku, CompactPackages.Num() - 1);
+	}
+
+	CompactItems.Shrink();
+	CompactPackages.Shrink();
+	GroupRefs.Shrink();
+	VirtualPrices.Shrink();
+
+	BuildColumns();
+}
+
+void FXsollaStoreCatalog::BuildColumns()
+{
+	const int32 NumItems = CompactItems.Num();
+
+	PriceColumn.SetNumUninitialized(NumItems);
+	PriceCurrencyColumn.SetNumUninitialized(NumItems);
+	TypeColumn.SetNumUninitialized(NumItems);
+	VirtualPriceColumn.SetNumUninitialized(NumItems);
+	NameRankColumn.SetNumUninitialized(NumItems);
+	TypeNames.Reset();
+
+	FreeMask = FXsollaStoreItemMask(NumItems, false);
+	PriceMask = FXsollaStoreItemMask(NumItems, false);
+	VirtualPriceMask = FXsollaStoreItemMask(NumItems, false);
+	NoGroupMask = FXsollaStoreItemMask(NumItems, false);
+	GroupMasks.Init(FXsollaStoreItemMask(NumItems, false), ItemGroups.Num());
+	CurrencyMasks.Init(FXsollaStoreItemMask(NumItems, false), Currencies.Num());
+
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		const FCompactItem& CompactItem = CompactItems[Index];
+
+		// Missing price isn't the same as zero one
+		const bool bHasPrice = CompactItem.Price.AmountDecimal.IsValid();
+		PriceColumn[Index] = bHasPrice ? CompactItem.Price.AmountDecimal.GetValue(PriceColumnScale) : 0;
+		PriceCurrencyColumn[Index] = Strings.Add(Strings.Get(CompactItem.Price.Currency).ToUpper());
+		if (bHasPrice)
+		{
+			PriceMask.Set(Index);
+		}
+
+		int32 TypeId = TypeNames.Find(CompactItem.Type);
+		if (TypeId == INDEX_NONE)
+		{
+			TypeId = TypeNames.Add(CompactItem.Type);
+		}
+		TypeColumn[Index] = static_cast<uint16>(TypeId);
+
+		if (CompactItem.bIsFree)
+		{
+			FreeMask.Set(Index);
+		}
+
+		if (CompactItem.NumGroups == 0)
+		{
+			NoGroupMask.Set(Index);
+		}
+
+		for (int32 RefIndex = CompactItem.FirstGroup; RefIndex < CompactItem.FirstGroup + CompactItem.NumGroups; ++RefIndex)
+		{
+			GroupMasks[GroupRefs[RefIndex]].Set(Index);
+		}
+
+		VirtualPriceColumn[Index] = 0;
+		if (CompactItem.NumVirtualPrices > 0)
+		{
+			VirtualPriceMask.Set(Index);
+		}
+
+		for (int32 PriceIndex = CompactItem.FirstVirtualPrice; PriceIndex < CompactItem.FirstVirtualPrice + CompactItem.NumVirtualPrices; ++PriceIndex)
+		{
+			const FCompactVirtualPrice& VirtualPrice = VirtualPrices[PriceIndex];
+			CurrencyMasks[VirtualPrice.Currency].Set(Index);
+
+			if (VirtualPrice.bIsDefault || PriceIndex == CompactItem.FirstVirtualPrice)
+			{
+				VirtualPriceColumn[Index] = VirtualPrice.Amount;
+			}
+		}
+	}
+
+	// Names are compared once here, so queries sort by integer rank
+	TArray<int32> NameOrder;
+	NameOrder.SetNumUninitialized(NumItems);
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		NameOrder[Index] = Index;
+	}
+
+	NameOrder.Sort([this](int32 A, int32 B) {
+		const int32 Compare = Strings.Get(CompactItems[A].Name).Compare(Strings.Get(CompactItems[B].Name), ESearchCase::IgnoreCase);
+		return Compare != 0 ? Compare < 0 : A < B;
+	});
+
+	for (int32 Rank = 0; Rank < NumItems; ++Rank)
+	{
+		NameRankColumn[NameOrder[Rank]] = Rank;
+	}
+}
+
+void FXsollaStoreCatalog::BuildSearchIndex()
+{
+	// Groups request may have names of groups embedded into items without them
+	TMap<FString, FString> GroupNames;
+	for (const FStoreGroup& Group : Groups)
+	{
+		GroupNames.Add(Group.external_id, Group.name);
+	}
+
+	TArray<FXsollaStoreSearchDocument> Documents;
+	Documents.SetNum(CompactItems.Num());
+
+	for (int32 Index = 0; Index < CompactItems.Num(); ++Index)
+	{
+		const FCompactItem& CompactItem = CompactItems[Index];
+
+		FXsollaStoreSearchDocument& Document = Documents[Index];
+		Document.Sku = Strings.Get(CompactItem.Sku);
+		Document.Name = Strings.Get(CompactItem.Name);
+		Document.Description = Strings.Get(CompactItem.Description);
+
+		for (int32 RefIndex = CompactItem.FirstGroup; RefIndex < CompactItem.FirstGroup + CompactItem.NumGroups; ++RefIndex)
+		{
+			const FCompactGroup& Group = ItemGroups[GroupRefs[RefIndex]];
+			const FString* GroupName = GroupNames.Find(Strings.Get(Group.ExternalId));
+
+			Document.GroupNames += Strings.Get(Group.Name);
+			Document.GroupNames += TEXT(" ");
+			if (GroupName)
+			{
+				Document.GroupNames += *GroupName;
+				Document.GroupNames += TEXT(" ");
+			}
+		}
+	}
+
+	SearchIndex->Build(Documents);
+}
+
+FXsollaStoreItemMask FXsollaStoreCatalog::GetGroupMask(const FString& GroupExternalId) const
+{
+	FXsollaStoreItemMask Mask(CompactItems.Num(), false);
+	for (int32 GroupIndex = 0; GroupIndex < ItemGroups.Num(); ++GroupIndex)
+	{
+		if (Strings.Get(ItemGroups[GroupIndex].ExternalId).Equals(GroupExternalId, ESearchCase::IgnoreCase))
+		{
+			Mask.Or(GroupMasks[GroupIndex]);
+		}
+	}
+
+	return Mask;
+}
+
+FXsollaStoreCatalog::FCompactPrice FXsollaStoreCatalog::InternPrice(const FStorePrice& Price)
+{
+	FCompactPrice CompactPrice;
+	CompactPrice.Amount = Strings.Add(Price.amount);
+	CompactPrice.AmountWithoutDiscount = Strings.Add(Price.amount_without_discount);
+	CompactPrice.Currency = Strings.Add(Price.currency);
+
+	// Amounts are parsed once here, materialized prices carry them as is
+	FStoreDecimal::Parse(Price.amount, CompactPrice.AmountDecimal);
+	FStoreDecimal::Parse(Price.amount_without_discount, CompactPrice.AmountWithoutDiscountDecimal);
+
+	return CompactPrice;
+}
+
+int32 FXsollaStoreCatalog::InternGroups(const TArray<FStoreGroup>& InGroups)
+{
+	const int32 FirstGroup = GroupRefs.Num();
+	for (const FStoreGroup& Group : InGroups)
+	{
+		GroupRefs.Add(InternGroup(Group));
+	}
+
+	return FirstGroup;
+}
+
+int32 FXsollaStoreCatalog::InternGroup(const FStoreGroup& Group)
+{
+	FCompactGroup CompactGroup;
+	CompactGroup.Id = Group.id;
+	CompactGroup.ExternalId = Strings.Add(Group.external_id);
+	CompactGroup.Name = Strings.Add(Group.name);
+	CompactGroup.Description = Strings.Add(Group.description);
+	CompactGroup.ImageUrl = Strings.Add(Group.image_url);
+	CompactGroup.Level = Group.level;
+	CompactGroup.Order = Group.order;
+	CompactGroup.ParentExternalId = Strings.Add(Group.parent_external_id);
+
+	// Groups with the same external id are usually identical, but keep every variant server sent
+	TArray<int32, TInlineAllocator<4>> Candidates;
+	ItemGroupIndices.MultiFind(CompactGroup.ExternalId, Candidates);
+	for (const int32 Candidate : Candidates)
+	{
+		if (FMemory::Memcmp(&ItemGroups[Candidate], &CompactGroup, sizeof(FCompactGroup)) == 0)
+		{
+			return Candidate;
+		}
+	}
+
+	const int32 GroupIndex = ItemGroups.Add(CompactGroup);
+	ItemGroupIndices.Add(CompactGroup.ExternalId, GroupIndex);
+
+	return GroupIndex;
+}
+
+int32 FXsollaStoreCatalog::InternCurrency(const FVirtualCurrencyPrice& VirtualPrice)
+{
+	FCompactCurrency Currency;
+	Currency.Sku = Strings.Add(VirtualPrice.sku);
+	Currency.Name = Strings.Add(VirtualPrice.name);
+	Currency.Description = Strings.Add(VirtualPrice.description);
+	Currency.ImageUrl = Strings.Add(VirtualPrice.image_url);
+	Currency.Type = Strings.Add(VirtualPrice.type);
+
+	TArray<int32, TInlineAllocator<4>> Candidates;
+	CurrencyIndices.MultiFind(Currency.Sku, Candidates);
+	for (const int32 Candidate : Candidates)
+	{
+		if (FMemory::Memcmp(&Currencies[Candidate], &Currency, sizeof(FCompactCurrency)) == 0)
+		{
+			return Candidate;
+		}
+	}
+
+	const int32 CurrencyIndex = Currencies.Add(Currency);
+	CurrencyIndices.Add(Currency.Sku, CurrencyIndex);
+
+	return CurrencyIndex;
+}
+
+FStorePrice FXsollaStoreCatalog::MakePrice(const FCompactPrice& Price) const
+{
+	FStorePrice StorePrice;
+	StorePrice.amount = Strings.Get(Price.Amount);
+	StorePrice.amount_without_discount = Strings.Get(Price.AmountWithoutDiscount);
+	StorePrice.currency = Strings.Get(Price.Currency);
+	StorePrice.amount_decimal = Price.AmountDecimal;
+	StorePrice.amount_without_discount_decimal = Price.AmountWithoutDiscountDecimal;
+
+	return StorePrice;
+}
+
+TArray<FStoreGroup> FXsollaStoreCatalog::MakeGroups(int32 FirstGroup, int32 NumGroups) const
+{
+	TArray<FStoreGroup> StoreGroups;
+	StoreGroups.Reserve(NumGroups);
+	for (int32 RefIndex = FirstGroup; RefIndex < FirstGroup + NumGroups; ++RefIndex)
+	{
+		const FCompactGroup& CompactGroup = ItemGroups[GroupRefs[RefIndex]];
+
+		FStoreGroup& Group = StoreGroups.AddDefaulted_GetRef();
+		Group.id = CompactGroup.Id;
+		Group.external_id = Strings.Get(CompactGroup.ExternalId);
+		Group.name = Strings.Get(CompactGroup.Name);
+		Group.description = Strings.Get(CompactGroup.Description);
+		Group.image_url = Strings.Get(CompactGroup.ImageUrl);
+		Group.level = CompactGroup.Level;
+		Group.order = CompactGroup.Order;
+		Group.parent_external_id = Strings.Get(CompactGroup.ParentExternalId);
+	}
+
+	return StoreGroups;
+}
+
+void FXsollaStoreCatalog::AddSkuIndex(TMultiMap<uint32, int32>& SkuIndex, const FString& Sku, int32 Index)
+{
+	SkuIndex.Add(GetTypeHash(Sku), Index);
+}
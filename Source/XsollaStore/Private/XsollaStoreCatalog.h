@@ -0,0 +1,336 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "XsollaStoreDataModel.h"
+
+class FXsollaStoreSearchIndex;
+
+/** Case-sensitive pool of unique strings referenced by index. Index 0 is always an empty string */
+class FXsollaStoreStringPool
+{
+public:
+	FXsollaStoreStringPool();
+
+	/** Add string to the pool (if it isn't there yet) and get its index */
+	int32 Add(const FString& String);
+
+	/** Index of string or INDEX_NONE */
+	int32 Find(const FString& String) const;
+
+	const FString& Get(int32 Index) const;
+
+	/** Remove all strings except the empty one */
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	TArray<FString> Strings;
+
+	/** Case-sensitive string hash to string index */
+	TMultiMap<uint32, int32> Indices;
+};
+
+/** Bit per catalog item, predicates are combined 64 items at once */
+class FXsollaStoreItemMask
+{
+public:
+	FXsollaStoreItemMask();
+
+	FXsollaStoreItemMask(int32 InNumBits, bool bValue);
+
+	void Set(int32 Index);
+
+	bool Get(int32 Index) const;
+
+	/** Keep bits set in both masks */
+	void And(const FXsollaStoreItemMask& Other);
+
+	/** Keep bits not set in other mask */
+	void AndNot(const FXsollaStoreItemMask& Other);
+
+	/** Set bits set in other mask */
+	void Or(const FXsollaStoreItemMask& Other);
+
+	/** Indices of set bits in ascending order */
+	void GetSetIndices(TArray<int32>& OutIndices) const;
+
+	int32 Num() const;
+
+	TArray<uint64>& GetWords();
+	const TArray<uint64>& GetWords() const;
+
+	SIZE_T GetAllocatedSize() const;
+
+	static const int32 BitsPerWord = 64;
+
+private:
+	TArray<uint64> Words;
+
+	int32 NumBits;
+};
+
+/**
+ * Compact resident model of Store catalog: virtual items and currency packages.
+ * All strings are interned in single pool, groups and virtual currency descriptions
+ * embedded into items are stored once and referenced by index.
+ * Blueprint structs are materialized on demand only.
+ */
+class FXsollaStoreCatalog
+{
+public:
+	FXsollaStoreCatalog();
+	~FXsollaStoreCatalog();
+
+	/** Replace virtual items */
+	void SetItems(const TArray<FStoreItem>& Items);
+
+	/** Replace virtual currency packages */
+	void SetCurrencyPackages(const TArray<FVirtualCurrencyPackage>& Packages);
+
+	/** Replace item groups info (groups request) */
+	void SetGroups(const TArray<FStoreGroup>& InGroups);
+
+	int32 GetItemCount() const;
+
+	/** Materialize item by index */
+	FStoreItem GetItem(int32 Index) const;
+
+	/** Materialize all items */
+	TArray<FStoreItem> GetItems() const;
+
+	/** Materialize items that belong to group with external id */
+	TArray<FStoreItem> GetItemsInGroup(const FString& GroupExternalId) const;
+
+	/** Materialize items without any group */
+	TArray<FStoreItem> GetItemsWithoutGroup() const;
+
+	/** Index of item with sku (case-insensitive) or INDEX_NONE */
+	int32 FindItem(const FString& Sku) const;
+
+	/** Indices of items matching query filters in query order. All filters are evaluated over item columns */
+	TArray<int32> QueryItems(const FStoreItemsQuery& Query) const;
+
+	/** External ids of groups used by items */
+	TSet<FString> GetItemGroupIds() const;
+
+	/** Item groups info */
+	const TArray<FStoreGroup>& GetGroups() const;
+
+	/** Materialize items data struct (items, used group ids and groups info) */
+	FStoreItemsData GetItemsData() const;
+
+	int32 GetCurrencyPackageCount() const;
+
+	/** Materialize currency package by index */
+	FVirtualCurrencyPackage GetCurrencyPackage(int32 Index) const;
+
+	/** Materialize all currency packages */
+	TArray<FVirtualCurrencyPackage> GetCurrencyPackages() const;
+
+	/** Index of currency package with sku (case-insensitive) or INDEX_NONE */
+	int32 FindCurrencyPackage(const FString& Sku) const;
+
+	/** Memory of items and shared string pool */
+	SIZE_T GetItemsAllocatedSize() const;
+
+	/** Memory of groups info and groups embedded into items and packages */
+	SIZE_T GetGroupsAllocatedSize() const;
+
+	/** Memory of currency packages */
+	SIZE_T GetCurrencyPackagesAllocatedSize() const;
+
+	/** Memory of item columns used by queries */
+	SIZE_T GetColumnsAllocatedSize() const;
+
+	/** Memory of search index */
+	SIZE_T GetSearchIndexAllocatedSize() const;
+
+private:
+	struct FCompactPrice
+	{
+		int32 Amount;
+		int32 AmountWithoutDiscount;
+		int32 Currency;
+		FStoreDecimal AmountDecimal;
+		FStoreDecimal AmountWithoutDiscountDecimal;
+	};
+
+	/** Group embedded into item (strings are pool indices) */
+	struct FCompactGroup
+	{
+		int32 Id;
+		int32 ExternalId;
+		int32 Name;
+		int32 Description;
+		int32 ImageUrl;
+		int32 Level;
+		int32 Order;
+		int32 ParentExternalId;
+	};
+
+	/** Virtual currency description shared by virtual prices */
+	struct FCompactCurrency
+	{
+		int32 Sku;
+		int32 Name;
+		int32 Description;
+		int32 ImageUrl;
+		int32 Type;
+	};
+
+	struct FCompactVirtualPrice
+	{
+		int32 Currency;
+		int32 Amount;
+		int32 AmountWithoutDiscount;
+		int32 CalculatedAmount;
+		int32 CalculatedAmountWithoutDiscount;
+		FStoreDecimal CalculatedAmountDecimal;
+		FStoreDecimal CalculatedAmountWithoutDiscountDecimal;
+		bool bIsDefault;
+	};
+
+	struct FCompactItem
+	{
+		int32 Sku;
+		int32 Name;
+		int32 Description;
+		int32 Type;
+		int32 ImageUrl;
+		FCompactPrice Price;
+
+		/** Range in GroupRefs */
+		int32 FirstGroup;
+		int32 NumGroups;
+
+		/** Range in VirtualPrices */
+		int32 FirstVirtualPrice;
+		int32 NumVirtualPrices;
+
+		int32 ExpirationValue;
+		int32 ExpirationType;
+
+		bool bIsFree;
+	};
+
+	struct FCompactPackage
+	{
+		int32 Sku;
+		int32 Name;
+		int32 Description;
+		int32 ImageUrl;
+		FCompactPrice Price;
+
+		/** Range in GroupRefs */
+		int32 FirstGroup;
+		int32 NumGroups;
+
+		int32 Order;
+
+		int32 ContentSku;
+		int32 ContentName;
+		int32 ContentDescription;
+		int32 ContentImageUrl;
+		int32 ContentQuantity;
+
+		bool bIsFree;
+	};
+
+	/** Intern all data from scratch so strings of replaced entries don't stay in the pool */
+	void Rebuild(const TArray<FStoreItem>& Items, const TArray<FVirtualCurrencyPackage>& Packages);
+
+	FCompactPrice InternPrice(const FStorePrice& Price);
+	int32 InternGroups(const TArray<FStoreGroup>& InGroups);
+	int32 InternGroup(const FStoreGroup& Group);
+	int32 InternCurrency(const FVirtualCurrencyPrice& VirtualPrice);
+
+	FStorePrice MakePrice(const FCompactPrice& Price) const;
+	TArray<FStoreGroup> MakeGroups(int32 FirstGroup, int32 NumGroups) const;
+
+	/** Append item index to case-insensitive sku index */
+	static void AddSkuIndex(TMultiMap<uint32, int32>& SkuIndex, const FString& Sku, int32 Index);
+
+	/** Build column-oriented item data for queries */
+	void BuildColumns();
+
+	/** Index item texts for QueryItems search */
+	void BuildSearchIndex();
+
+	/** Items with any group of external id (case-insensitive) */
+	FXsollaStoreItemMask GetGroupMask(const FString& GroupExternalId) const;
+
+private:
+	FXsollaStoreStringPool Strings;
+
+	TArray<FCompactItem> CompactItems;
+	TArray<FCompactPackage> CompactPackages;
+
+	/** Unique groups embedded into items and packages */
+	TArray<FCompactGroup> ItemGroups;
+
+	/** Group external id string index to ItemGroups indices */
+	TMultiMap<int32, int32> ItemGroupIndices;
+
+	/** Item and package group lists (ItemGroups indices) */
+	TArray<int32> GroupRefs;
+
+	/** Unique virtual currencies used by virtual prices */
+	TArray<FCompactCurrency> Currencies;
+
+	/** Currency sku string index to Currencies indices */
+	TMultiMap<int32, int32> CurrencyIndices;
+
+	TArray<FCompactVirtualPrice> VirtualPrices;
+
+	/** Case-insensitive sku hash to item index */
+	TMultiMap<uint32, int32> ItemSkuIndex;
+
+	/** Case-insensitive sku hash to package index */
+	TMultiMap<uint32, int32> PackageSkuIndex;
+
+	/** Groups info from groups request */
+	TArray<FStoreGroup> Groups;
+
+	/** Fraction digits of price column */
+	static const int32 PriceColumnScale = 6;
+
+	/** Item columns: real price in 10^-PriceColumnScale units (0 if item isn't in PriceMask) */
+	TArray<int64> PriceColumn;
+
+	/** Item columns: real price currency string index */
+	TArray<int32> PriceCurrencyColumn;
+
+	/** Item columns: type id (index in TypeNames) */
+	TArray<uint16> TypeColumn;
+
+	/** Item columns: amount of default (or first) virtual price (0 if item isn't in VirtualPriceMask) */
+	TArray<int32> VirtualPriceColumn;
+
+	/** Item columns: position of item in catalog sorted by name */
+	TArray<int32> NameRankColumn;
+
+	/** Unique item types (string indices) */
+	TArray<int32> TypeNames;
+
+	FXsollaStoreItemMask FreeMask;
+
+	/** Items with real price, others are excluded by price filters and sorted last */
+	FXsollaStoreItemMask PriceMask;
+
+	/** Items with virtual price, others are sorted last */
+	FXsollaStoreItemMask VirtualPriceMask;
+
+	/** Items without any group */
+	FXsollaStoreItemMask NoGroupMask;
+
+	/** Items of each group in ItemGroups */
+	TArray<FXsollaStoreItemMask> GroupMasks;
+
+	/** Items with virtual price of each currency in Currencies */
+	TArray<FXsollaStoreItemMask> CurrencyMasks;
+
+	TUniquePtr<FXsollaStoreSearchIndex> SearchIndex;
+};
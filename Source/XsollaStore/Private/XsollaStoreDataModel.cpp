@@ -0,0 +1,282 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaStoreDataModel.h"
+
+namespace XsollaStoreDataModel
+{
+	int64 Pow10(int32 Exponent)
+	{
+		int64 Result = 1;
+		for (int32 Index = 0; Index < Exponent; ++Index)
+		{
+			Result *= 10;
+		}
+
+		return Result;
+	}
+
+	/** Product of two integers, false if it doesn't fit int64 */
+	bool MultiplyChecked(int64 A, int64 B, int64& OutResult)
+	{
+		if (A != 0 && B != 0)
+		{
+			const uint64 AbsA = A < 0 ? 0ull - static_cast<uint64>(A) : static_cast<uint64>(A);
+			const uint64 AbsB = B < 0 ? 0ull - static_cast<uint64>(B) : static_cast<uint64>(B);
+			const uint64 Limit = static_cast<uint64>(MAX_int64) + ((A < 0) != (B < 0) ? 1 : 0);
+			if (AbsA > Limit / AbsB)
+			{
+				return false;
+			}
+		}
+
+		OutResult = A * B;
+		return true;
+	}
+
+	/** Sum of two integers, false if it doesn't fit int64 */
+	bool AddChecked(int64 A, int64 B, int64& OutResult)
+	{
+		if ((B > 0 && A > MAX_int64 - B) || (B < 0 && A < MIN_int64 - B))
+		{
+			return false;
+		}
+
+		OutResult = A + B;
+		return true;
+	}
+
+	/** Integer division rounded half to even */
+	int64 DivideHalfToEven(int64 Value, int64 Divider)
+	{
+		const int64 Quotient = Value / Divider;
+		const int64 Remainder = FMath::Abs(Value % Divider);
+		const int64 Twice = Remainder * 2;
+
+		if (Twice > Divider || (Twice == Divider && (Quotient % 2) != 0))
+		{
+			return Value < 0 ? Quotient - 1 : Quotient + 1;
+		}
+
+		return Quotient;
+	}
+} // namespace XsollaStoreDataModel
+
+bool FStoreDecimal::Parse(const FString& String, FStoreDecimal& OutDecimal)
+{
+	using namespace XsollaStoreDataModel;
+
+	OutDecimal = FStoreDecimal();
+
+	const TCHAR* Char = *String;
+	while (FChar::IsWhitespace(*Char))
+	{
+		++Char;
+	}
+
+	const bool bNegative = (*Char == TEXT('-'));
+	if (*Char == TEXT('-') || *Char == TEXT('+'))
+	{
+		++Char;
+	}
+
+	// Digits are accumulated as negative value, so MIN_int64 can be parsed too
+	bool bHasDigits = false;
+	int64 Result = 0;
+	while (FChar::IsDigit(*Char))
+	{
+		if (!MultiplyChecked(Result, 10, Result) || !AddChecked(Result, -(*Char - TEXT('0')), Result))
+		{
+			return false;
+		}
+
+		bHasDigits = true;
+		++Char;
+	}
+
+	// Keep only fraction digits string has (so "1.99" is 199 with scale 2), digits beyond MaxScale are truncated
+	int32 FractionDigits = 0;
+	if (*Char == TEXT('.'))
+	{
+		++Char;
+
+		while (FChar::IsDigit(*Char))
+		{
+			if (FractionDigits < MaxScale)
+			{
+				if (!MultiplyChecked(Result, 10, Result) || !AddChecked(Result, -(*Char - TEXT('0')), Result))
+				{
+					return false;
+				}
+
+				FractionDigits++;
+			}
+			bHasDigits = true;
+			++Char;
+		}
+	}
+
+	while (FChar::IsWhitespace(*Char))
+	{
+		++Char;
+	}
+
+	if (!bHasDigits || *Char != TEXT('\0') || (!bNegative && Result == MIN_int64))
+	{
+		return false;
+	}
+
+	OutDecimal = FStoreDecimal(bNegative ? Result : -Result, FractionDigits);
+	return true;
+}
+
+bool FStoreDecimal::IsValid() const
+{
+	return bIsValid;
+}
+
+int64 FStoreDecimal::GetValue(int32 InScale) const
+{
+	using namespace XsollaStoreDataModel;
+
+	if (InScale >= Scale)
+	{
+		int64 Result = 0;
+		return MultiplyChecked(Value, Pow10(InScale - Scale), Result) ? Result : (Value < 0 ? MIN_int64 : MAX_int64);
+	}
+
+	return DivideHalfToEven(Value, Pow10(Scale - InScale));
+}
+
+FStoreDecimal FStoreDecimal::Rescale(int32 InScale) const
+{
+	int64 Result = 0;
+	if (!bIsValid || (InScale > Scale && !XsollaStoreDataModel::MultiplyChecked(Value, XsollaStoreDataModel::Pow10(InScale - Scale), Result)))
+	{
+		return FStoreDecimal();
+	}
+
+	return FStoreDecimal(GetValue(InScale), InScale);
+}
+
+int32 FStoreDecimal::Compare(const FStoreDecimal& Other) const
+{
+	// Missing amount goes before any valid one
+	if (!bIsValid || !Other.bIsValid)
+	{
+		return (bIsValid ? 1 : 0) - (Other.bIsValid ? 1 : 0);
+	}
+
+	const int32 CommonScale = FMath::Max(Scale, Other.Scale);
+	const int64 A = GetValue(CommonScale);
+	const int64 B = Other.GetValue(CommonScale);
+
+	return A < B ? -1 : (A > B ? 1 : 0);
+}
+
+int32 FStoreDecimal::GetDiscountPercent(const FStoreDecimal& Amount, const FStoreDecimal& AmountWithoutDiscount)
+{
+	if (!Amount.IsValid() || !AmountWithoutDiscount.IsValid() || AmountWithoutDiscount.Value <= 0 || Amount >= AmountWithoutDiscount)
+	{
+		return 0;
+	}
+
+	const int32 CommonScale = FMath::Max(Amount.Scale, AmountWithoutDiscount.Scale);
+	const int64 Full = AmountWithoutDiscount.GetValue(CommonScale);
+	const int64 Discount = Full - Amount.GetValue(CommonScale);
+
+	// Round half up, so 1.99 of 3.98 is 50%
+	return static_cast<int32>((Discount * 200 + Full) / (Full * 2));
+}
+
+bool FStoreDecimal::IsZero() const
+{
+	return bIsValid && Value == 0;
+}
+
+FString FStoreDecimal::ToString() const
+{
+	using namespace XsollaStoreDataModel;
+
+	if (!bIsValid)
+	{
+		return FString();
+	}
+
+	const int64 Divider = Pow10(Scale);
+	const uint64 AbsValue = static_cast<uint64>(Value < 0 ? -Value : Value);
+
+	FString Result = FString::Printf(TEXT("%s%llu"), Value < 0 ? TEXT("-") : TEXT(""), AbsValue / Divider);
+	if (Scale > 0)
+	{
+		const FString Fraction = FString::Printf(TEXT("%llu"), AbsValue % Divider);
+		Result += TEXT(".") + FString::ChrN(Scale - Fraction.Len(), TEXT('0')) + Fraction;
+	}
+
+	return Result;
+}
+
+double FStoreDecimal::ToDouble() const
+{
+	return static_cast<double>(Value) / static_cast<double>(XsollaStoreDataModel::Pow10(Scale));
+}
+
+FStoreDecimal FStoreDecimal::operator+(const FStoreDecimal& Other) const
+{
+	const int32 CommonScale = FMath::Max(Scale, Other.Scale);
+	const FStoreDecimal A = Rescale(CommonScale);
+	const FStoreDecimal B = Other.Rescale(CommonScale);
+
+	int64 Result = 0;
+	if (!A.IsValid() || !B.IsValid() || !XsollaStoreDataModel::AddChecked(A.Value, B.Value, Result))
+	{
+		return FStoreDecimal();
+	}
+
+	return FStoreDecimal(Result, CommonScale);
+}
+
+FStoreDecimal FStoreDecimal::operator-(const FStoreDecimal& Other) const
+{
+	const int32 CommonScale = FMath::Max(Scale, Other.Scale);
+	const FStoreDecimal A = Rescale(CommonScale);
+	const FStoreDecimal B = Other.Rescale(CommonScale);
+
+	int64 Result = 0;
+	if (!A.IsValid() || !B.IsValid() || B.Value == MIN_int64 || !XsollaStoreDataModel::AddChecked(A.Value, -B.Value, Result))
+	{
+		return FStoreDecimal();
+	}
+
+	return FStoreDecimal(Result, CommonScale);
+}
+
+FStoreDecimal FStoreDecimal::operator*(int32 Quantity) const
+{
+	int64 Result = 0;
+	if (!bIsValid || !XsollaStoreDataModel::MultiplyChecked(Value, Quantity, Result))
+	{
+		return FStoreDecimal();
+	}
+
+	return FStoreDecimal(Result, Scale);
+}
+
+void FStorePrice::ParseAmounts()
+{
+	// Amounts that can't be parsed stay invalid
+	FStoreDecimal::Parse(amount, amount_decimal);
+	FStoreDecimal::Parse(amount_without_discount, amount_without_discount_decimal);
+}
+
+int32 FStorePrice::GetDiscountPercent() const
+{
+	return FStoreDecimal::GetDiscountPercent(amount_decimal, amount_without_discount_decimal);
+}
+
+void FVirtualCurrencyCalculatedPrice::ParseAmounts()
+{
+	// Amounts that can't be parsed stay invalid
+	FStoreDecimal::Parse(amount, amount_decimal);
+	FStoreDecimal::Parse(amount_without_discount, amount_without_discount_decimal);
+}
@@ -0,0 +1,59 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaStoreEndpoints.h"
+
+namespace XsollaStoreEndpoints
+{
+	using ECache = EXsollaStoreEndpointCache;
+	using EVerb = EXsollaRequestVerb;
+
+	// Catalog
+	const TXsollaStoreEndpoint<FStoreItemsData> VirtualItems(TEXT("VirtualItems"), EVerb::GET, TEXT("items/virtual_items"), false);
+	const TXsollaStoreEndpoint<FStoreItemsData> ItemGroups(TEXT("ItemGroups"), EVerb::GET, TEXT("items/groups?locale={0}"), false);
+	const TXsollaStoreEndpoint<FVirtualCurrencyData> VirtualCurrencies(TEXT("VirtualCurrencies"), EVerb::GET, TEXT("items/virtual_currency"), false);
+	const TXsollaStoreEndpoint<FVirtualCurrencyPackagesData> VirtualCurrencyPackages(TEXT("VirtualCurrencyPackages"), EVerb::GET, TEXT("items/virtual_currency/package"), false);
+	const TXsollaStoreEndpoint<FVirtualCurrency> VirtualCurrency(TEXT("VirtualCurrency"), EVerb::GET, TEXT("items/virtual_currency/sku/{0}"), false);
+	const TXsollaStoreEndpoint<FVirtualCurrencyPackage> VirtualCurrencyPackage(TEXT("VirtualCurrencyPackage"), EVerb::GET, TEXT("items/virtual_currency/package/sku/{0}"), false);
+
+	// User data
+	const TXsollaStoreEndpoint<FStoreInventory> Inventory(TEXT("Inventory"), EVerb::GET, TEXT("user/inventory/items"), true, true, ECache::WarmUp);
+	const TXsollaStoreEndpoint<FVirtualCurrencyBalanceData> VirtualCurrencyBalance(TEXT("VirtualCurrencyBalance"), EVerb::GET, TEXT("user/virtual_currency_balance"), true, true, ECache::WarmUp);
+	const TXsollaStoreEndpoint<FStoreSubscriptionData> Subscriptions(TEXT("Subscriptions"), EVerb::GET, TEXT("user/subscriptions"), true, true, ECache::WarmUp);
+	const TXsollaStoreEndpoint<FXsollaStoreNoContent> ConsumeItem(TEXT("ConsumeItem"), EVerb::POST, TEXT("user/inventory/item/consume"), true, true);
+
+	// Purchases
+	const TXsollaStoreEndpoint<TSharedPtr<FJsonObject>> ItemPaymentToken(TEXT("ItemPaymentToken"), EVerb::POST, TEXT("payment/item/{0}"), true);
+	const TXsollaStoreEndpoint<TSharedPtr<FJsonObject>> CartPaymentToken(TEXT("CartPaymentToken"), EVerb::POST, TEXT("payment/cart"), true);
+	const TXsollaStoreEndpoint<TSharedPtr<FJsonObject>> CartByIdPaymentToken(TEXT("CartByIdPaymentToken"), EVerb::POST, TEXT("payment/cart/{0}"), true);
+	const TXsollaStoreEndpoint<TSharedPtr<FJsonObject>> BuyWithVirtualCurrency(TEXT("BuyWithVirtualCurrency"), EVerb::POST, TEXT("payment/item/{0}/virtual/{1}"), true, true);
+	const TXsollaStoreEndpoint<TSharedPtr<FJsonObject>> Order(TEXT("Order"), EVerb::GET, TEXT("order/{0}"), true);
+
+	// Cart (current user cart or cart by id)
+	const TXsollaStoreEndpoint<FStoreCart> Cart(TEXT("Cart"), EVerb::GET, TEXT("cart"), true, false, ECache::WarmUp);
+	const TXsollaStoreEndpoint<FStoreCart> CartById(TEXT("CartById"), EVerb::GET, TEXT("cart/{0}"), true);
+	const TXsollaStoreEndpoint<FXsollaStoreNoContent> ClearCart(TEXT("ClearCart"), EVerb::PUT, TEXT("cart/clear"), true);
+	const TXsollaStoreEndpoint<FXsollaStoreNoContent> ClearCartById(TEXT("ClearCartById"), EVerb::PUT, TEXT("cart/{0}/clear"), true);
+	const TXsollaStoreEndpoint<FXsollaStoreNoContent> CartItem(TEXT("CartItem"), EVerb::PUT, TEXT("cart/item/{0}"), true);
+	const TXsollaStoreEndpoint<FXsollaStoreNoContent> CartByIdItem(TEXT("CartByIdItem"), EVerb::PUT, TEXT("cart/{0}/item/{1}"), true);
+	const TXsollaStoreEndpoint<FXsollaStoreNoContent> RemoveCartItem(TEXT("RemoveCartItem"), EVerb::DELETE, TEXT("cart/item/{0}"), true);
+	const TXsollaStoreEndpoint<FXsollaStoreNoContent> RemoveCartByIdItem(TEXT("RemoveCartByIdItem"), EVerb::DELETE, TEXT("cart/{0}/item/{1}"), true);
+
+	const TArray<const FXsollaStoreEndpoint*> WarmUpEndpoints = {&Inventory, &VirtualCurrencyBalance, &Subscriptions, &Cart};
+
+	FString ParseResponse(const FString& Content, TSharedPtr<FJsonObject>& OutResponse)
+	{
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+		if (!XSOLLA_TRACE_EXPRESSION(XsollaJsonParse, FJsonSerializer::Deserialize(Reader, OutResponse)))
+		{
+			return TEXT("Can't deserialize server response");
+		}
+
+		return FString();
+	}
+
+	FString ParseResponse(const FString& Content, FXsollaStoreNoContent& OutResponse)
+	{
+		return FString();
+	}
+} // namespace XsollaStoreEndpoints
@@ -0,0 +1,158 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "XsollaStoreDataModel.h"
+#include "XsollaStoreSubsystem.h"
+#include "XsollaUtilsTrace.h"
+
+#include "Dom/JsonObject.h"
+#include "JsonObjectConverter.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+/** How endpoint response can be reused */
+enum class EXsollaStoreEndpointCache : uint8
+{
+	/** Each call sends its own request */
+	None,
+
+	/** Response of warm-up request (sent when user is logged in) is taken by first call */
+	WarmUp
+};
+
+/** Store API endpoint description, all requests are built from it */
+struct FXsollaStoreEndpoint
+{
+	/** Name used in logs and as warm-up key */
+	const TCHAR* Name;
+
+	EXsollaRequestVerb Verb;
+
+	/** Path relative to project url, {0}, {1} etc. are replaced with request arguments */
+	const TCHAR* PathTemplate;
+
+	/** Whether request is sent with user authorization token */
+	bool bUserAuth;
+
+	/** Whether publishing platform is added to query */
+	bool bPlatformQuery;
+
+	EXsollaStoreEndpointCache Cache;
+
+	FXsollaStoreEndpoint(const TCHAR* InName, EXsollaRequestVerb InVerb, const TCHAR* InPathTemplate, bool bInUserAuth, bool bInPlatformQuery, EXsollaStoreEndpointCache InCache)
+		: Name(InName)
+		, Verb(InVerb)
+		, PathTemplate(InPathTemplate)
+		, bUserAuth(bInUserAuth)
+		, bPlatformQuery(bInPlatformQuery)
+		, Cache(InCache){};
+};
+
+/** Response of endpoint without useful content */
+struct FXsollaStoreNoContent
+{
+};
+
+/** Typed part of response handling, the rest is done by UXsollaStoreSubsystem::Endpoint_HttpRequestComplete */
+struct FXsollaStoreResponseHandler
+{
+	/** Parse response content and pass it to caller, returns error message if content can't be parsed */
+	TFunction<FString(const FString& Content)> HandleResponse;
+
+	FOnStoreError ErrorCallback;
+
+	/** Called after error callback on any failure (optional) */
+	TFunction<void()> HandleError;
+};
+
+namespace XsollaStoreEndpoints
+{
+	/** Parse response content into struct (USTRUCT with StaticStruct) */
+	template <typename ResponseType>
+	FString ParseResponse(const FString& Content, ResponseType& OutResponse)
+	{
+		TSharedPtr<FJsonObject> JsonObject;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+		if (!XSOLLA_TRACE_EXPRESSION(XsollaJsonParse, FJsonSerializer::Deserialize(Reader, JsonObject)))
+		{
+			return TEXT("Can't deserialize server response");
+		}
+
+		if (!XSOLLA_TRACE_EXPRESSION(XsollaJsonToStruct, FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), ResponseType::StaticStruct(), &OutResponse)))
+		{
+			return TEXT("Can't convert server response to struct");
+		}
+
+		return FString();
+	}
+
+	/** Parse response content into json object (for responses without struct) */
+	FString ParseResponse(const FString& Content, TSharedPtr<FJsonObject>& OutResponse);
+
+	/** Response content is ignored */
+	FString ParseResponse(const FString& Content, FXsollaStoreNoContent& OutResponse);
+} // namespace XsollaStoreEndpoints
+
+/** Endpoint with type its response is parsed to */
+template <typename ResponseType>
+struct TXsollaStoreEndpoint : public FXsollaStoreEndpoint
+{
+	TXsollaStoreEndpoint(const TCHAR* InName, EXsollaRequestVerb InVerb, const TCHAR* InPathTemplate, bool bInUserAuth, bool bInPlatformQuery = false, EXsollaStoreEndpointCache InCache = EXsollaStoreEndpointCache::None)
+		: FXsollaStoreEndpoint(InName, InVerb, InPathTemplate, bInUserAuth, bInPlatformQuery, InCache){};
+
+	/** Make handler passing parsed response to callback */
+	FXsollaStoreResponseHandler MakeHandler(TFunction<void(ResponseType&)> OnResponse, const FOnStoreError& ErrorCallback, TFunction<void()> OnError = nullptr) const
+	{
+		FXsollaStoreResponseHandler Handler;
+		Handler.HandleResponse = [OnResponse](const FString& Content) {
+			ResponseType Response;
+			const FString ParseError = XsollaStoreEndpoints::ParseResponse(Content, Response);
+			if (ParseError.IsEmpty())
+			{
+				OnResponse(Response);
+			}
+
+			return ParseError;
+		};
+		Handler.ErrorCallback = ErrorCallback;
+		Handler.HandleError = MoveTemp(OnError);
+
+		return Handler;
+	}
+};
+
+/** Store API endpoints */
+namespace XsollaStoreEndpoints
+{
+	extern const TXsollaStoreEndpoint<FStoreItemsData> VirtualItems;
+	extern const TXsollaStoreEndpoint<FStoreItemsData> ItemGroups;
+	extern const TXsollaStoreEndpoint<FVirtualCurrencyData> VirtualCurrencies;
+	extern const TXsollaStoreEndpoint<FVirtualCurrencyPackagesData> VirtualCurrencyPackages;
+	extern const TXsollaStoreEndpoint<FVirtualCurrency> VirtualCurrency;
+	extern const TXsollaStoreEndpoint<FVirtualCurrencyPackage> VirtualCurrencyPackage;
+
+	extern const TXsollaStoreEndpoint<FStoreInventory> Inventory;
+	extern const TXsollaStoreEndpoint<FVirtualCurrencyBalanceData> VirtualCurrencyBalance;
+	extern const TXsollaStoreEndpoint<FStoreSubscriptionData> Subscriptions;
+	extern const TXsollaStoreEndpoint<FXsollaStoreNoContent> ConsumeItem;
+
+	extern const TXsollaStoreEndpoint<TSharedPtr<FJsonObject>> ItemPaymentToken;
+	extern const TXsollaStoreEndpoint<TSharedPtr<FJsonObject>> CartPaymentToken;
+	extern const TXsollaStoreEndpoint<TSharedPtr<FJsonObject>> CartByIdPaymentToken;
+	extern const TXsollaStoreEndpoint<TSharedPtr<FJsonObject>> BuyWithVirtualCurrency;
+	extern const TXsollaStoreEndpoint<TSharedPtr<FJsonObject>> Order;
+
+	extern const TXsollaStoreEndpoint<FStoreCart> Cart;
+	extern const TXsollaStoreEndpoint<FStoreCart> CartById;
+	extern const TXsollaStoreEndpoint<FXsollaStoreNoContent> ClearCart;
+	extern const TXsollaStoreEndpoint<FXsollaStoreNoContent> ClearCartById;
+	extern const TXsollaStoreEndpoint<FXsollaStoreNoContent> CartItem;
+	extern const TXsollaStoreEndpoint<FXsollaStoreNoContent> CartByIdItem;
+	extern const TXsollaStoreEndpoint<FXsollaStoreNoContent> RemoveCartItem;
+	extern const TXsollaStoreEndpoint<FXsollaStoreNoContent> RemoveCartByIdItem;
+
+	/** Endpoints requested by warm-up when user is logged in */
+	extern const TArray<const FXsollaStoreEndpoint*> WarmUpEndpoints;
+} // namespace XsollaStoreEndpoints
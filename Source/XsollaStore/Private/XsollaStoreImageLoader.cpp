@@ -4,6 +4,8 @@
 #include "XsollaStoreImageLoader.h"
 
 #include "XsollaStoreDefines.h"
+#include "XsollaUtilsStats.h"
+#include "XsollaUtilsTrace.h"
 
 #include "Framework/Application/SlateApplication.h"
 #include "IImageWrapper.h"
@@ -63,53 +65,37 @@ void UXsollaStoreImageLoader::LoadImage(FString URL, const FOnImageLoaded& Succe
 
 void UXsollaStoreImageLoader::LoadImage_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnImageLoaded SuccessCallback, FOnImageLoadFailed ErrorCallback)
 {
+	XSOLLA_TRACE_SCOPE(XsollaStore_LoadImage);
+	XSOLLA_LLM_SCOPE();
+
 	const FName ResourceName = GetCacheName(HttpRequest->GetURL());
 
 	if (bSucceeded && HttpResponse.IsValid())
 	{
 		const TArray<uint8>& ImageData = HttpResponse->GetContent();
 
-		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-		const EImageFormat ImageType = ImageWrapperModule.DetectImageFormat(ImageData.GetData(), ImageData.Num());
-		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageType);
-
-		if (!ImageWrapper.IsValid())
-		{
-			UE_LOG(LogXsollaStore, Error, TEXT("%s: Invalid image wrapper"), *VA_FUNC_LINE);
-		}
-		else if (ImageWrapper->SetCompressed(ImageData.GetData(), ImageData.Num()))
+		TArray<uint8> RawData;
+		int32 Width = 0;
+		int32 Height = 0;
+		if (DecodeImage(ImageData, RawData, Width, Height))
 		{
-			const int32 BytesPerPixel = ImageWrapper->GetBitDepth();
-			TArray<uint8> RawData;
-
-			if (ImageWrapper->GetRaw(ERGBFormat::BGRA, BytesPerPixel, RawData) && RawData.Num() > 0)
+			if (XSOLLA_TRACE_EXPRESSION(XsollaSlateResource, FSlateApplication::Get().GetRenderer()->GenerateDynamicImageResource(ResourceName, Width, Height, RawData)))
 			{
-				if (FSlateApplication::Get().GetRenderer()->GenerateDynamicImageResource(ResourceName, ImageWrapper->GetWidth(), ImageWrapper->GetHeight(), RawData))
-				{
-					TSharedPtr<FSlateDynamicImageBrush> ImageBrush = MakeShareable(new FSlateDynamicImageBrush(ResourceName, FVector2D(ImageWrapper->GetWidth(), ImageWrapper->GetHeight())));
-					ImageBrushes.Add(ResourceName.ToString(), ImageBrush);
+				TSharedPtr<FSlateDynamicImageBrush> ImageBrush = MakeShareable(new FSlateDynamicImageBrush(ResourceName, FVector2D(Width, Height)));
+				ImageBrushes.Add(ResourceName.ToString(), ImageBrush);
 
-					SuccessCallback.ExecuteIfBound(*ImageBrush.Get());
+				SuccessCallback.ExecuteIfBound(*ImageBrush.Get());
 
-					PendingRequests[ResourceName.ToString()].Broadcast(true);
-					PendingRequests.Remove(ResourceName.ToString());
+				PendingRequests[ResourceName.ToString()].Broadcast(true);
+				PendingRequests.Remove(ResourceName.ToString());
 
-					return;
-				}
-				else
-				{
-					UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't generate resource"), *VA_FUNC_LINE);
-				}
+				return;
 			}
 			else
 			{
-				UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't get raw data"), *VA_FUNC_LINE);
+				UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't generate resource"), *VA_FUNC_LINE);
 			}
 		}
-		else
-		{
-			UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't load compressed data"), *VA_FUNC_LINE);
-		}
 	}
 	else
 	{
@@ -125,6 +111,69 @@ void UXsollaStoreImageLoader::LoadImage_HttpRequestComplete(FHttpRequestPtr Http
 	}
 }
 
+bool UXsollaStoreImageLoader::DecodeImage(const TArray<uint8>& ImageData, TArray<uint8>& OutRawData, int32& OutWidth, int32& OutHeight)
+{
+	XSOLLA_TRACE_SCOPE(XsollaImageDecode);
+
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	const EImageFormat ImageType = ImageWrapperModule.DetectImageFormat(ImageData.GetData(), ImageData.Num());
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageType);
+
+	if (!ImageWrapper.IsValid())
+	{
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Invalid image wrapper"), *VA_FUNC_LINE);
+		return false;
+	}
+
+	if (!ImageWrapper->SetCompressed(ImageData.GetData(), ImageData.Num()))
+	{
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't load compressed data"), *VA_FUNC_LINE);
+		return false;
+	}
+
+	const int32 BytesPerPixel = ImageWrapper->GetBitDepth();
+	if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, BytesPerPixel, OutRawData) || OutRawData.Num() == 0)
+	{
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't get raw data"), *VA_FUNC_LINE);
+		return false;
+	}
+
+	OutWidth = ImageWrapper->GetWidth();
+	OutHeight = ImageWrapper->GetHeight();
+
+	return true;
+}
+
+int32 UXsollaStoreImageLoader::GetImageCount() const
+{
+	return ImageBrushes.Num();
+}
+
+SIZE_T UXsollaStoreImageLoader::GetImagesMemorySize() const
+{
+	SIZE_T Size = ImageBrushes.GetAllocatedSize();
+	for (const auto& ImageBrush : ImageBrushes)
+	{
+		Size += ImageBrush.Key.GetAllocatedSize() + sizeof(FSlateDynamicImageBrush);
+
+		const FVector2D ImageSize = ImageBrush.Value->ImageSize;
+		Size += static_cast<SIZE_T>(ImageSize.X) * static_cast<SIZE_T>(ImageSize.Y) * 4;
+	}
+
+	return Size;
+}
+
+SIZE_T UXsollaStoreImageLoader::GetPendingRequestsMemorySize() const
+{
+	SIZE_T Size = PendingRequests.GetAllocatedSize();
+	for (const auto& PendingRequest : PendingRequests)
+	{
+		Size += PendingRequest.Key.GetAllocatedSize();
+	}
+
+	return Size;
+}
+
 FName UXsollaStoreImageLoader::GetCacheName(const FString& URL) const
 {
 	return FName(*FString::Printf(TEXT("XsollaStoreImage_%s"), *FMD5::HashAnsiString(*URL)));
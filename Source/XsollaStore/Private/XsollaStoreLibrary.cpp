@@ -6,6 +6,7 @@
 #include "XsollaStore.h"
 
 #include "XsollaStoreDataModel.h"
+#include "XsollaStoreDefines.h"
 
 UXsollaStoreLibrary::UXsollaStoreLibrary(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -22,6 +23,56 @@ bool UXsollaStoreLibrary::Equal_StoreCartStoreCart(const FStoreCart& A, const FS
 	return A == B;
 }
 
+bool UXsollaStoreLibrary::EqualEqual_StoreDecimalStoreDecimal(const FStoreDecimal& A, const FStoreDecimal& B)
+{
+	return A == B;
+}
+
+bool UXsollaStoreLibrary::Less_StoreDecimalStoreDecimal(const FStoreDecimal& A, const FStoreDecimal& B)
+{
+	return A < B;
+}
+
+FStoreDecimal UXsollaStoreLibrary::Add_StoreDecimalStoreDecimal(const FStoreDecimal& A, const FStoreDecimal& B)
+{
+	return A + B;
+}
+
+FStoreDecimal UXsollaStoreLibrary::Multiply_StoreDecimalInt(const FStoreDecimal& A, int32 B)
+{
+	return A * B;
+}
+
+FString UXsollaStoreLibrary::Conv_StoreDecimalToString(const FStoreDecimal& InDecimal)
+{
+	return InDecimal.ToString();
+}
+
+int32 UXsollaStoreLibrary::GetPriceDiscountPercent(const FStorePrice& Price)
+{
+	return Price.GetDiscountPercent();
+}
+
+FStoreDecimal UXsollaStoreLibrary::GetCartItemsTotal(const FStoreCart& Cart)
+{
+	FStoreDecimal Total(0, 0);
+	const FString* Currency = nullptr;
+	for (const FStoreCartItem& Item : Cart.Items)
+	{
+		// Amounts of different currencies can't be summed up
+		if (Currency && *Currency != Item.price.currency)
+		{
+			UE_LOG(LogXsollaStore, Warning, TEXT("%s: Cart has items in different currencies (%s, %s)"), *VA_FUNC_LINE, **Currency, *Item.price.currency);
+			return FStoreDecimal();
+		}
+
+		Currency = &Item.price.currency;
+		Total = Total + Item.price.amount_decimal * Item.quantity;
+	}
+
+	return Total;
+}
+
 FDateTime UXsollaStoreLibrary::MakeDateTimeFromTimestamp(int64 time)
 {
 	return FDateTime::FromUnixTimestamp(time);
@@ -0,0 +1,293 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaStoreOfflineJournal.h"
+
+#include "XsollaStoreDefines.h"
+
+#include "Dom/JsonObject.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFilemanager.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace XsollaStoreOfflineJournal
+{
+	static const FString OpFieldName = TEXT("op");
+	static const FString OpAdd = TEXT("add");
+	static const FString OpAck = TEXT("ack");
+	static const FString OpSent = TEXT("sent");
+	static const FString OpNotSent = TEXT("not_sent");
+	static const FString IdFieldName = TEXT("id");
+	static const FString UserFieldName = TEXT("user");
+	static const FString ActionFieldName = TEXT("action");
+	static const FString SentFieldName = TEXT("sent");
+
+	/** Compact journal file after this number of state records */
+	static const int32 CompactionThreshold = 64;
+} // namespace XsollaStoreOfflineJournal
+
+FXsollaStoreOfflineJournal::FXsollaStoreOfflineJournal(const FString& InFilePath)
+	: FilePath(InFilePath)
+	, StateRecords(0)
+{
+}
+
+void FXsollaStoreOfflineJournal::Load()
+{
+	using namespace XsollaStoreOfflineJournal;
+
+	Entries.Empty();
+
+	// Compacted journal is complete before old one is removed, so it's the only valid journal if old one is missing
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString TempFilePath = GetTempFilePath();
+	if (PlatformFile.FileExists(*TempFilePath))
+	{
+		if (PlatformFile.FileExists(*FilePath))
+		{
+			PlatformFile.DeleteFile(*TempFilePath);
+		}
+		else
+		{
+			UE_LOG(LogXsollaStore, Warning, TEXT("%s: Recovering journal after interrupted compaction: %s"), *VA_FUNC_LINE, *FilePath);
+			PlatformFile.MoveFile(*FilePath, *TempFilePath);
+		}
+	}
+
+	TArray<FString> Records;
+	if (!FFileHelper::LoadFileToStringArray(Records, *FilePath))
+	{
+		return;
+	}
+
+	for (const FString& Record : Records)
+	{
+		TSharedPtr<FJsonObject> JsonObject;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Record);
+		if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+		{
+			// Most likely incomplete record written during crash
+			UE_LOG(LogXsollaStore, Warning, TEXT("%s: Skipping malformed journal record: %s"), *VA_FUNC_LINE, *Record);
+			continue;
+		}
+
+		const FString Op = JsonObject->GetStringField(OpFieldName);
+		if (Op == OpAdd)
+		{
+			const TSharedPtr<FJsonObject>* ActionObject = nullptr;
+			FXsollaOfflineJournalEntry Entry;
+			if (!JsonObject->TryGetObjectField(ActionFieldName, ActionObject) ||
+				!FJsonObjectConverter::JsonObjectToUStruct(ActionObject->ToSharedRef(), FStoreOfflineAction::StaticStruct(), &Entry.Action))
+			{
+				UE_LOG(LogXsollaStore, Warning, TEXT("%s: Can't convert journal record to struct: %s"), *VA_FUNC_LINE, *Record);
+				continue;
+			}
+
+			if (!StaticEnum<EXsollaOfflineActionType>()->IsValidEnumValue(static_cast<int64>(Entry.Action.Type)))
+			{
+				UE_LOG(LogXsollaStore, Error, TEXT("%s: Dropping journaled action of unknown type %d: %s"), *VA_FUNC_LINE, static_cast<int32>(Entry.Action.Type), *Record);
+				continue;
+			}
+
+			JsonObject->TryGetStringField(UserFieldName, Entry.UserId);
+			JsonObject->TryGetBoolField(SentFieldName, Entry.bSent);
+
+			Entry.Action.Attempts = 0;
+			Entries.Add(Entry);
+		}
+		else if (Op == OpAck)
+		{
+			const FString ActionId = JsonObject->GetStringField(IdFieldName);
+			Entries.RemoveAll([&ActionId](const FXsollaOfflineJournalEntry& InEntry) {
+				return InEntry.Action.ActionId == ActionId;
+			});
+		}
+		else if (Op == OpSent || Op == OpNotSent)
+		{
+			const FString ActionId = JsonObject->GetStringField(IdFieldName);
+			for (auto& Entry : Entries)
+			{
+				if (Entry.Action.ActionId == ActionId)
+				{
+					Entry.bSent = (Op == OpSent);
+				}
+			}
+		}
+	}
+
+	UE_LOG(LogXsollaStore, Log, TEXT("%s: Restored %d pending offline action(s)"), *VA_FUNC_LINE, Entries.Num());
+
+	Compact();
+}
+
+bool FXsollaStoreOfflineJournal::Append(const FXsollaOfflineJournalEntry& Entry)
+{
+	Entries.Add(Entry);
+
+	return WriteRecord(FilePath, SerializeEntry(Entry));
+}
+
+void FXsollaStoreOfflineJournal::Acknowledge(const FString& ActionId)
+{
+	using namespace XsollaStoreOfflineJournal;
+
+	Entries.RemoveAll([&ActionId](const FXsollaOfflineJournalEntry& InEntry) {
+		return InEntry.Action.ActionId == ActionId;
+	});
+
+	WriteStateRecord(OpAck, ActionId);
+}
+
+void FXsollaStoreOfflineJournal::MarkAttempt(const FString& ActionId)
+{
+	using namespace XsollaStoreOfflineJournal;
+
+	for (auto& Entry : Entries)
+	{
+		if (Entry.Action.ActionId == ActionId)
+		{
+			Entry.Action.Attempts++;
+			Entry.bSent = true;
+			break;
+		}
+	}
+
+	// Written before request is sent, so crash can't make us send it once more after restart
+	WriteStateRecord(OpSent, ActionId);
+}
+
+void FXsollaStoreOfflineJournal::MarkNotSent(const FString& ActionId)
+{
+	using namespace XsollaStoreOfflineJournal;
+
+	for (auto& Entry : Entries)
+	{
+		if (Entry.Action.ActionId == ActionId)
+		{
+			Entry.bSent = false;
+			break;
+		}
+	}
+
+	WriteStateRecord(OpNotSent, ActionId);
+}
+
+void FXsollaStoreOfflineJournal::Compact()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	StateRecords = 0;
+
+	if (Entries.Num() == 0)
+	{
+		PlatformFile.DeleteFile(*FilePath);
+		return;
+	}
+
+	// Write new journal aside and replace old one, so crash can't leave us without any journal
+	const FString TempFilePath = GetTempFilePath();
+	PlatformFile.DeleteFile(*TempFilePath);
+
+	for (const auto& Entry : Entries)
+	{
+		if (!WriteRecord(TempFilePath, SerializeEntry(Entry)))
+		{
+			return;
+		}
+	}
+
+	// Rename replaces existing file atomically where platform allows it (posix), otherwise old journal is removed
+	// first and complete temp file is picked up by Load if we crash in between
+	if (PlatformFile.MoveFile(*FilePath, *TempFilePath))
+	{
+		return;
+	}
+
+	PlatformFile.DeleteFile(*FilePath);
+	if (!PlatformFile.MoveFile(*FilePath, *TempFilePath))
+	{
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't replace journal file: %s"), *VA_FUNC_LINE, *FilePath);
+	}
+}
+
+const TArray<FXsollaOfflineJournalEntry>& FXsollaStoreOfflineJournal::GetEntries() const
+{
+	return Entries;
+}
+
+const FXsollaOfflineJournalEntry* FXsollaStoreOfflineJournal::FindEntry(const FString& ActionId) const
+{
+	return Entries.FindByPredicate([&ActionId](const FXsollaOfflineJournalEntry& InEntry) {
+		return InEntry.Action.ActionId == ActionId;
+	});
+}
+
+FString FXsollaStoreOfflineJournal::GetTempFilePath() const
+{
+	return FilePath + TEXT(".tmp");
+}
+
+bool FXsollaStoreOfflineJournal::WriteRecord(const FString& InFilePath, const FString& Record) const
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(InFilePath));
+
+	TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenWrite(*InFilePath, true));
+	if (!FileHandle)
+	{
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't open journal file: %s"), *VA_FUNC_LINE, *InFilePath);
+		return false;
+	}
+
+	FTCHARToUTF8 RecordUtf8(*(Record + TEXT("\n")));
+	if (!FileHandle->Write(reinterpret_cast<const uint8*>(RecordUtf8.Get()), RecordUtf8.Length()) || !FileHandle->Flush(true))
+	{
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't write journal file: %s"), *VA_FUNC_LINE, *InFilePath);
+		return false;
+	}
+
+	return true;
+}
+
+void FXsollaStoreOfflineJournal::WriteStateRecord(const FString& Op, const FString& ActionId)
+{
+	using namespace XsollaStoreOfflineJournal;
+
+	if (Entries.Num() == 0 || ++StateRecords >= CompactionThreshold)
+	{
+		Compact();
+		return;
+	}
+
+	TSharedPtr<FJsonObject> RecordJson = MakeShareable(new FJsonObject);
+	RecordJson->SetStringField(OpFieldName, Op);
+	RecordJson->SetStringField(IdFieldName, ActionId);
+
+	FString Record;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Record);
+	FJsonSerializer::Serialize(RecordJson.ToSharedRef(), Writer);
+
+	WriteRecord(FilePath, Record);
+}
+
+FString FXsollaStoreOfflineJournal::SerializeEntry(const FXsollaOfflineJournalEntry& Entry) const
+{
+	using namespace XsollaStoreOfflineJournal;
+
+	TSharedPtr<FJsonObject> RecordJson = MakeShareable(new FJsonObject);
+	RecordJson->SetStringField(OpFieldName, OpAdd);
+	RecordJson->SetStringField(UserFieldName, Entry.UserId);
+	RecordJson->SetBoolField(SentFieldName, Entry.bSent);
+	RecordJson->SetObjectField(ActionFieldName, FJsonObjectConverter::UStructToJsonObject(Entry.Action));
+
+	FString Record;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Record);
+	FJsonSerializer::Serialize(RecordJson.ToSharedRef(), Writer);
+
+	return Record;
+}
@@ -0,0 +1,77 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "XsollaStoreDataModel.h"
+
+/** Journaled action with user it should be replayed for */
+struct FXsollaOfflineJournalEntry
+{
+	FStoreOfflineAction Action;
+
+	/** User identifier (sub claim of token the action was made with), token itself is never written to disk */
+	FString UserId;
+
+	/** Request of action left the client and its result is unknown (server could have applied it) */
+	bool bSent;
+
+	FXsollaOfflineJournalEntry()
+		: bSent(false){};
+};
+
+/**
+ * Append-only on-disk journal of Store mutations. Each record is a single json line
+ * flushed to disk before the action is sent. Sent state is appended before request leaves the client,
+ * acknowledgements are appended when server answers.
+ * Incomplete trailing record (crash during write) is ignored on load, as well as unknown action types.
+ */
+class FXsollaStoreOfflineJournal
+{
+public:
+	explicit FXsollaStoreOfflineJournal(const FString& InFilePath);
+
+	/** Restore pending actions from disk (recovering interrupted compaction) and compact the file */
+	void Load();
+
+	/** Persist new action. Returns false if action can't be written to disk (it's still kept in memory) */
+	bool Append(const FXsollaOfflineJournalEntry& Entry);
+
+	/** Mark action as delivered (or dropped) and remove it from pending list */
+	void Acknowledge(const FString& ActionId);
+
+	/** Increase delivery attempts counter of action and persist that its request is about to leave the client */
+	void MarkAttempt(const FString& ActionId);
+
+	/** Persist that request of action didn't reach server (connection failed), so it's safe to send it again */
+	void MarkNotSent(const FString& ActionId);
+
+	/** Rewrite journal file with pending actions only */
+	void Compact();
+
+	/** Pending actions in journal order */
+	const TArray<FXsollaOfflineJournalEntry>& GetEntries() const;
+
+	/** Find pending action by its identifier */
+	const FXsollaOfflineJournalEntry* FindEntry(const FString& ActionId) const;
+
+private:
+	/** Append json line to file and flush it to disk */
+	bool WriteRecord(const FString& FilePath, const FString& Record) const;
+
+	/** Append record changing state of pending action, journal is compacted when there are too many of them */
+	void WriteStateRecord(const FString& Op, const FString& ActionId);
+
+	FString SerializeEntry(const FXsollaOfflineJournalEntry& Entry) const;
+
+	/** Path compacted journal is written to before it replaces the journal */
+	FString GetTempFilePath() const;
+
+private:
+	FString FilePath;
+
+	TArray<FXsollaOfflineJournalEntry> Entries;
+
+	/** Number of state records written since last compaction */
+	int32 StateRecords;
+};
@@ -4,6 +4,7 @@
 #include "XsollaStoreSave.h"
 
 #include "XsollaStoreDefines.h"
+#include "XsollaUtilsTrace.h"
 
 #include "Kismet/GameplayStatics.h"
 
@@ -23,13 +24,32 @@ FXsollaStoreSaveData UXsollaStoreSave::Load()
 
 void UXsollaStoreSave::Save(const FXsollaStoreSaveData& InCartData)
 {
+	// Whole slot is overwritten, so there is no need to load it first
+	auto SaveInstance = Cast<UXsollaStoreSave>(UGameplayStatics::CreateSaveGameObject(UXsollaStoreSave::StaticClass()));
+	SaveInstance->CartData = InCartData;
+
+	UGameplayStatics::SaveGameToSlot(SaveInstance, UXsollaStoreSave::SaveSlotName, UXsollaStoreSave::UserIndex);
+}
+
+UXsollaStoreSave* UXsollaStoreSave::LoadOrCreate()
+{
+	XSOLLA_TRACE_SCOPE(XsollaSaveGameLoad);
+
 	auto SaveInstance = Cast<UXsollaStoreSave>(UGameplayStatics::LoadGameFromSlot(UXsollaStoreSave::SaveSlotName, UXsollaStoreSave::UserIndex));
 	if (!SaveInstance)
 	{
 		SaveInstance = Cast<UXsollaStoreSave>(UGameplayStatics::CreateSaveGameObject(UXsollaStoreSave::StaticClass()));
 	}
 
-	SaveInstance->CartData = InCartData;
+	return SaveInstance;
+}
+
+const FXsollaStoreSaveData& UXsollaStoreSave::GetCartData() const
+{
+	return CartData;
+}
 
-	UGameplayStatics::SaveGameToSlot(SaveInstance, UXsollaStoreSave::SaveSlotName, 0);
+void UXsollaStoreSave::SetCartData(const FXsollaStoreSaveData& InCartData)
+{
+	CartData = InCartData;
 }
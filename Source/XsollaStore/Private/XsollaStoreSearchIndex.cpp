@@ -0,0 +1,398 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaStoreSearchIndex.h"
+
+#include "XsollaStoreDefines.h"
+#include "XsollaUtilsTrace.h"
+
+#include "Algo/BinarySearch.h"
+#include "Internationalization/BreakIterator.h"
+#include "Internationalization/IBreakIterator.h"
+#include "Misc/Crc.h"
+
+namespace XsollaStoreSearchIndex
+{
+	/** Minimal length of query word matched with a typo */
+	const int32 MinTypoLength = 4;
+
+	/** Match quality of exact, prefix and typo matches */
+	const float ExactQuality = 1.f;
+	const float PrefixQuality = 0.5f;
+	const float TypoQuality = 0.4f;
+
+	bool TermLess(const FString& A, const FString& B)
+	{
+		return A.Compare(B, ESearchCase::CaseSensitive) < 0;
+	}
+} // namespace XsollaStoreSearchIndex
+
+FXsollaStoreSearchIndex::FXsollaStoreSearchIndex()
+	: NumDocuments(0)
+{
+}
+
+void FXsollaStoreSearchIndex::Build(const TArray<FXsollaStoreSearchDocument>& Documents)
+{
+	using namespace XsollaStoreSearchIndex;
+
+	XSOLLA_TRACE_SCOPE(XsollaStore_BuildSearchIndex);
+
+	TMap<FString, FCachedDocument> NewDocumentCache;
+	NewDocumentCache.Reserve(Documents.Num());
+
+	TMap<FString, TArray<FPosting>> TermPostings;
+
+	int32 NumTokenized = 0;
+	for (int32 DocumentIndex = 0; DocumentIndex < Documents.Num(); ++DocumentIndex)
+	{
+		const FXsollaStoreSearchDocument& Document = Documents[DocumentIndex];
+
+		uint32 Hash = FCrc::StrCrc32(*Document.Sku);
+		Hash = FCrc::StrCrc32(*Document.Name, Hash);
+		Hash = FCrc::StrCrc32(*Document.Description, Hash);
+		Hash = FCrc::StrCrc32(*Document.GroupNames, Hash);
+
+		// Unchanged items reuse their tokens, only new and edited ones are tokenized
+		FCachedDocument CachedDocument;
+		FCachedDocument* PreviousDocument = DocumentCache.Find(Document.Sku);
+		if (PreviousDocument && PreviousDocument->Hash == Hash)
+		{
+			CachedDocument = MoveTemp(*PreviousDocument);
+			DocumentCache.Remove(Document.Sku);
+		}
+		else
+		{
+			CachedDocument.Hash = Hash;
+			TokenizeDocument(Document, CachedDocument.Tokens);
+			++NumTokenized;
+		}
+
+		for (const FToken& Token : CachedDocument.Tokens)
+		{
+			TArray<FPosting>& DocumentPostings = TermPostings.FindOrAdd(Token.Term);
+			if (DocumentPostings.Num() > 0 && DocumentPostings.Last().Document == DocumentIndex)
+			{
+				DocumentPostings.Last().Field = FMath::Max(DocumentPostings.Last().Field, Token.Field);
+			}
+			else
+			{
+				DocumentPostings.Add({DocumentIndex, Token.Field});
+			}
+		}
+
+		NewDocumentCache.Add(Document.Sku, MoveTemp(CachedDocument));
+	}
+
+	DocumentCache = MoveTemp(NewDocumentCache);
+	NumDocuments = Documents.Num();
+
+	TermPostings.KeySort(&TermLess);
+
+	Terms.Reset(TermPostings.Num());
+	PostingOffsets.Reset(TermPostings.Num() + 1);
+	Postings.Reset();
+	TypoVariants.Reset();
+
+	for (auto& TermPosting : TermPostings)
+	{
+		const int32 TermIndex = Terms.Add(TermPosting.Key);
+		PostingOffsets.Add(Postings.Num());
+		Postings.Append(TermPosting.Value);
+
+		// Query words of MinTypoLength characters may be one insertion away from shorter terms
+		if (TermPosting.Key.Len() >= MinTypoLength - 1)
+		{
+			TypoVariants.Add(GetVariantHash(TermPosting.Key, INDEX_NONE), TermIndex);
+			for (int32 CharIndex = 0; CharIndex < TermPosting.Key.Len(); ++CharIndex)
+			{
+				TypoVariants.Add(GetVariantHash(TermPosting.Key, CharIndex), TermIndex);
+			}
+		}
+	}
+	PostingOffsets.Add(Postings.Num());
+
+	Terms.Shrink();
+	Postings.Shrink();
+
+	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Search index built: %d documents (%d tokenized), %d terms"), *VA_FUNC_LINE, Documents.Num(), NumTokenized, Terms.Num());
+}
+
+TArray<FXsollaStoreSearchHit> FXsollaStoreSearchIndex::Search(const FString& Text) const
+{
+	using namespace XsollaStoreSearchIndex;
+
+	XSOLLA_TRACE_SCOPE(XsollaStore_Search);
+
+	TArray<FString> QueryTerms;
+	Tokenize(Text, QueryTerms);
+
+	TArray<FXsollaStoreSearchHit> Hits;
+	if (QueryTerms.Num() == 0 || NumDocuments == 0)
+	{
+		return Hits;
+	}
+
+	TArray<float> Scores;
+	Scores.SetNumZeroed(NumDocuments);
+
+	// Number of query words matched by document, documents have to match all of them
+	TArray<int32> MatchedTerms;
+	MatchedTerms.SetNumZeroed(NumDocuments);
+
+	TArray<float> TokenScores;
+	TokenScores.SetNumZeroed(NumDocuments);
+
+	TArray<int32> TouchedDocuments;
+	TArray<int32> TypoCandidates;
+
+	for (int32 QueryIndex = 0; QueryIndex < QueryTerms.Num(); ++QueryIndex)
+	{
+		const FString& QueryTerm = QueryTerms[QueryIndex];
+		TouchedDocuments.Reset();
+
+		const int32 ExactTerm = FindTerm(QueryTerm);
+		if (ExactTerm != INDEX_NONE)
+		{
+			ScoreTerm(ExactTerm, ExactQuality, TokenScores, TouchedDocuments);
+		}
+
+		// Terms starting with query word are a contiguous range of sorted terms
+		for (int32 TermIndex = Algo::LowerBound(Terms, QueryTerm, &TermLess); TermIndex < Terms.Num(); ++TermIndex)
+		{
+			const FString& Term = Terms[TermIndex];
+			if (!Term.StartsWith(QueryTerm, ESearchCase::CaseSensitive))
+			{
+				break;
+			}
+
+			if (TermIndex != ExactTerm)
+			{
+				// Longer share of the term typed means better match
+				const float Quality = PrefixQuality * (1.f + static_cast<float>(QueryTerm.Len()) / Term.Len());
+				ScoreTerm(TermIndex, Quality, TokenScores, TouchedDocuments);
+			}
+		}
+
+		if (QueryTerm.Len() >= MinTypoLength)
+		{
+			TypoCandidates.Reset();
+			for (int32 CharIndex = INDEX_NONE; CharIndex < QueryTerm.Len(); ++CharIndex)
+			{
+				for (auto It = TypoVariants.CreateConstKeyIterator(GetVariantHash(QueryTerm, CharIndex)); It; ++It)
+				{
+					TypoCandidates.AddUnique(It.Value());
+				}
+			}
+
+			for (const int32 TermIndex : TypoCandidates)
+			{
+				const FString& Term = Terms[TermIndex];
+				if (TermIndex != ExactTerm && !Term.StartsWith(QueryTerm, ESearchCase::CaseSensitive) && IsSingleTypo(QueryTerm, Term))
+				{
+					ScoreTerm(TermIndex, TypoQuality, TokenScores, TouchedDocuments);
+				}
+			}
+		}
+
+		for (const int32 Document : TouchedDocuments)
+		{
+			if (MatchedTerms[Document] == QueryIndex)
+			{
+				MatchedTerms[Document] = QueryIndex + 1;
+				Scores[Document] += TokenScores[Document];
+			}
+			TokenScores[Document] = 0.f;
+		}
+	}
+
+	// Documents matching the last word are the only candidates to match all of them
+	for (const int32 Document : TouchedDocuments)
+	{
+		if (MatchedTerms[Document] == QueryTerms.Num())
+		{
+			Hits.Emplace(Document, Scores[Document]);
+		}
+	}
+
+	Hits.Sort([](const FXsollaStoreSearchHit& A, const FXsollaStoreSearchHit& B) {
+		return A.Score != B.Score ? A.Score > B.Score : A.Index < B.Index;
+	});
+
+	return Hits;
+}
+
+int32 FXsollaStoreSearchIndex::GetTermCount() const
+{
+	return Terms.Num();
+}
+
+SIZE_T FXsollaStoreSearchIndex::GetAllocatedSize() const
+{
+	SIZE_T Size = Terms.GetAllocatedSize() + PostingOffsets.GetAllocatedSize() + Postings.GetAllocatedSize() +
+				  TypoVariants.GetAllocatedSize() + DocumentCache.GetAllocatedSize();
+
+	for (const FString& Term : Terms)
+	{
+		Size += Term.GetAllocatedSize();
+	}
+
+	for (const auto& CachedDocument : DocumentCache)
+	{
+		Size += CachedDocument.Key.GetAllocatedSize() + CachedDocument.Value.Tokens.GetAllocatedSize();
+		for (const FToken& Token : CachedDocument.Value.Tokens)
+		{
+			Size += Token.Term.GetAllocatedSize();
+		}
+	}
+
+	return Size;
+}
+
+void FXsollaStoreSearchIndex::Tokenize(const FString& Text, TArray<FString>& OutTerms) const
+{
+	if (!WordBreakIterator.IsValid())
+	{
+		WordBreakIterator = FBreakIterator::CreateWordBreakIterator();
+	}
+
+	const FString LowerText = Text.ToLower();
+	WordBreakIterator->SetString(LowerText);
+
+	int32 WordStart = 0;
+	for (int32 WordEnd = WordBreakIterator->MoveToNext(); WordEnd != INDEX_NONE; WordEnd = WordBreakIterator->MoveToNext())
+	{
+		// Words like sku "crystal_pack-10" are indexed as a whole and by parts
+		int32 NumParts = 0;
+		int32 PartStart = INDEX_NONE;
+		for (int32 CharIndex = WordStart; CharIndex <= WordEnd; ++CharIndex)
+		{
+			const bool bAlnum = CharIndex < WordEnd && FChar::IsAlnum(LowerText[CharIndex]);
+			if (bAlnum && PartStart == INDEX_NONE)
+			{
+				PartStart = CharIndex;
+			}
+			else if (!bAlnum && PartStart != INDEX_NONE)
+			{
+				OutTerms.AddUnique(LowerText.Mid(PartStart, CharIndex - PartStart));
+				PartStart = INDEX_NONE;
+				++NumParts;
+			}
+		}
+
+		if (NumParts > 1)
+		{
+			OutTerms.AddUnique(LowerText.Mid(WordStart, WordEnd - WordStart).TrimStartAndEnd());
+		}
+
+		WordStart = WordEnd;
+	}
+
+	WordBreakIterator->ClearString();
+}
+
+void FXsollaStoreSearchIndex::TokenizeDocument(const FXsollaStoreSearchDocument& Document, TArray<FToken>& OutTokens) const
+{
+	const TPair<const FString*, EField> Fields[] = {
+		{&Document.Name, EField::Name},
+		{&Document.Sku, EField::Sku},
+		{&Document.GroupNames, EField::GroupName},
+		{&Document.Description, EField::Description}};
+
+	TArray<FString> FieldTerms;
+	for (const auto& Field : Fields)
+	{
+		FieldTerms.Reset();
+		Tokenize(*Field.Key, FieldTerms);
+
+		for (FString& Term : FieldTerms)
+		{
+			OutTokens.Add({MoveTemp(Term), Field.Value});
+		}
+	}
+}
+
+int32 FXsollaStoreSearchIndex::FindTerm(const FString& Term) const
+{
+	return Algo::BinarySearch(Terms, Term, &XsollaStoreSearchIndex::TermLess);
+}
+
+void FXsollaStoreSearchIndex::ScoreTerm(int32 TermIndex, float Quality, TArray<float>& TokenScores, TArray<int32>& TouchedDocuments) const
+{
+	for (int32 PostingIndex = PostingOffsets[TermIndex]; PostingIndex < PostingOffsets[TermIndex + 1]; ++PostingIndex)
+	{
+		const FPosting& Posting = Postings[PostingIndex];
+		const float Score = Quality * GetFieldWeight(Posting.Field);
+
+		float& TokenScore = TokenScores[Posting.Document];
+		if (TokenScore == 0.f)
+		{
+			TouchedDocuments.Add(Posting.Document);
+		}
+		TokenScore = FMath::Max(TokenScore, Score);
+	}
+}
+
+uint32 FXsollaStoreSearchIndex::GetVariantHash(const FString& Term, int32 RemovedChar)
+{
+	const TCHAR* Data = *Term;
+	if (RemovedChar == INDEX_NONE)
+	{
+		return FCrc::MemCrc32(Data, Term.Len() * sizeof(TCHAR));
+	}
+
+	const uint32 Hash = FCrc::MemCrc32(Data, RemovedChar * sizeof(TCHAR));
+	return FCrc::MemCrc32(Data + RemovedChar + 1, (Term.Len() - RemovedChar - 1) * sizeof(TCHAR), Hash);
+}
+
+bool FXsollaStoreSearchIndex::IsSingleTypo(const FString& A, const FString& B)
+{
+	const int32 LenA = A.Len();
+	const int32 LenB = B.Len();
+	if (FMath::Abs(LenA - LenB) > 1)
+	{
+		return false;
+	}
+
+	int32 Prefix = 0;
+	while (Prefix < LenA && Prefix < LenB && A[Prefix] == B[Prefix])
+	{
+		++Prefix;
+	}
+
+	int32 Suffix = 0;
+	while (Suffix < LenA - Prefix && Suffix < LenB - Prefix && A[LenA - 1 - Suffix] == B[LenB - 1 - Suffix])
+	{
+		++Suffix;
+	}
+
+	const int32 RestA = LenA - Prefix - Suffix;
+	const int32 RestB = LenB - Prefix - Suffix;
+
+	// Insertion, deletion or substitution
+	if (RestA <= 1 && RestB <= 1)
+	{
+		return true;
+	}
+
+	// Transposition of adjacent characters
+	return RestA == 2 && RestB == 2 && A[Prefix] == B[Prefix + 1] && A[Prefix + 1] == B[Prefix];
+}
+
+float FXsollaStoreSearchIndex::GetFieldWeight(EField Field)
+{
+	switch (Field)
+	{
+	case EField::Name:
+		return 4.f;
+
+	case EField::Sku:
+		return 3.f;
+
+	case EField::GroupName:
+		return 2.f;
+
+	default:
+		return 1.f;
+	}
+}
@@ -0,0 +1,124 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IBreakIterator;
+
+/** Searchable text of single catalog item */
+struct FXsollaStoreSearchDocument
+{
+	FString Sku;
+	FString Name;
+	FString Description;
+
+	/** Names of all item groups separated by spaces */
+	FString GroupNames;
+};
+
+struct FXsollaStoreSearchHit
+{
+	/** Index of document the index was built from */
+	int32 Index;
+
+	float Score;
+
+	FXsollaStoreSearchHit()
+		: Index(INDEX_NONE)
+		, Score(0.f){};
+
+	FXsollaStoreSearchHit(int32 InIndex, float InScore)
+		: Index(InIndex)
+		, Score(InScore){};
+};
+
+/**
+ * Inverted index of catalog item texts. Words are split by locale-aware word break iterator
+ * and matched exactly, by prefix or with a single typo (tokens of 4+ characters).
+ * Documents of unchanged items aren't tokenized again when index is rebuilt.
+ */
+class FXsollaStoreSearchIndex
+{
+public:
+	FXsollaStoreSearchIndex();
+
+	/** Replace indexed documents, document index is used as hit index */
+	void Build(const TArray<FXsollaStoreSearchDocument>& Documents);
+
+	/** Documents matching all words of text, best hits first */
+	TArray<FXsollaStoreSearchHit> Search(const FString& Text) const;
+
+	int32 GetTermCount() const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	enum class EField : uint8
+	{
+		Description,
+		GroupName,
+		Sku,
+		Name
+	};
+
+	struct FToken
+	{
+		FString Term;
+		EField Field;
+	};
+
+	struct FCachedDocument
+	{
+		/** Hash of indexed texts */
+		uint32 Hash;
+
+		TArray<FToken> Tokens;
+	};
+
+	/** Document with best field that contains the term */
+	struct FPosting
+	{
+		int32 Document;
+		EField Field;
+	};
+
+	/** Split text into lowercase words */
+	void Tokenize(const FString& Text, TArray<FString>& OutTerms) const;
+
+	void TokenizeDocument(const FXsollaStoreSearchDocument& Document, TArray<FToken>& OutTokens) const;
+
+	/** Index of term or INDEX_NONE */
+	int32 FindTerm(const FString& Term) const;
+
+	/** Add postings of term matched with quality to per-document token scores */
+	void ScoreTerm(int32 TermIndex, float Quality, TArray<float>& TokenScores, TArray<int32>& TouchedDocuments) const;
+
+	/** Hash of term with character removed (INDEX_NONE to keep all characters) */
+	static uint32 GetVariantHash(const FString& Term, int32 RemovedChar);
+
+	/** True if strings differ by at most one insertion, deletion, substitution or transposition */
+	static bool IsSingleTypo(const FString& A, const FString& B);
+
+	static float GetFieldWeight(EField Field);
+
+private:
+	/** Sorted unique terms */
+	TArray<FString> Terms;
+
+	/** Postings of term are [PostingOffsets[Term], PostingOffsets[Term + 1]) */
+	TArray<int32> PostingOffsets;
+	TArray<FPosting> Postings;
+
+	/** Hashes of terms and terms with one character removed to term indices */
+	TMultiMap<uint32, int32> TypoVariants;
+
+	int32 NumDocuments;
+
+	/** Tokens of indexed documents by sku, reused by next build if texts are the same */
+	TMap<FString, FCachedDocument> DocumentCache;
+
+	/** Word break iterator is reused by tokenization (game thread only) */
+	mutable TSharedPtr<IBreakIterator> WordBreakIterator;
+};
@@ -9,8 +9,18 @@ UXsollaStoreSettings::UXsollaStoreSettings(const FObjectInitializer& ObjectIniti
 	EnableSandbox = true;
 	EnableSandboxInShippingBuild = false;
 	UsePlatformBrowser = false;
+	ReuseBrowserWidget = false;
+	EnablePaymentTokenPrefetch = false;
+	PaymentTokenPrefetchTTL = 60.f;
+	EnablePaymentCompletionDetection = true;
 	BuildForSteam = false;
 	UseCrossPlatformAccountLinking = false;
+	ConsumeQueueFlushInterval = 1.f;
+	EnableOfflineJournal = false;
+	OfflineJournalRetryInterval = 15.f;
+	UseLoginTokenProvider = false;
+	EnableLoginWarmUp = false;
+	EnableConnectionWarmUp = false;
 	DemoProjectID = TEXT("44056");
 	PaymentInterfaceTheme = EXsollaPaymentUiTheme::Dark;
 }
@@ -4,62 +4,215 @@
 #include "XsollaStoreSubsystem.h"
 
 #include "XsollaStore.h"
+#include "XsollaStoreCatalog.h"
 #include "XsollaStoreCurrencyFormat.h"
 #include "XsollaStoreDataModel.h"
 #include "XsollaStoreDefines.h"
+#include "XsollaStoreEndpoints.h"
 #include "XsollaStoreImageLoader.h"
+#include "XsollaStoreOfflineJournal.h"
 #include "XsollaStoreSave.h"
 #include "XsollaStoreSettings.h"
+#include "XsollaUtilsAssetLoader.h"
+#include "XsollaUtilsAuthTokenProvider.h"
+#include "XsollaUtilsConnectionWarmer.h"
+#include "XsollaUtilsHttpTelemetry.h"
+#include "XsollaUtilsMemory.h"
+#include "XsollaUtilsPaymentUrl.h"
+#include "XsollaUtilsSaveGameWriter.h"
+#include "XsollaUtilsStats.h"
+#include "XsollaUtilsTokenParser.h"
+#include "XsollaUtilsTrace.h"
+#include "XsollaUtilsUrlOverrides.h"
+#include "XsollaWebBrowser.h"
+#include "XsollaWebBrowserHost.h"
+#include "XsollaWebBrowserWidgetPool.h"
 
 #include "Dom/JsonObject.h"
 #include "Engine/DataTable.h"
 #include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
 #include "Engine/World.h"
+#include "Internationalization/Culture.h"
+#include "Internationalization/FastDecimalFormat.h"
 #include "JsonObjectConverter.h"
 #include "Kismet/KismetTextLibrary.h"
-#include "Misc/Base64.h"
+#include "Misc/Paths.h"
 #include "Modules/ModuleManager.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
-#include "UObject/ConstructorHelpers.h"
+#include "TimerManager.h"
+#include "UObject/UObjectIterator.h"
 #include "UObject/Package.h"
 
 #define LOCTEXT_NAMESPACE "FXsollaStoreModule"
 
+namespace XsollaStoreMemory
+{
+	static void LogMemoryReport()
+	{
+		for (TObjectIterator<UXsollaStoreSubsystem> It; It; ++It)
+		{
+			if (It->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				continue;
+			}
+
+			const FStoreMemoryReport Report = It->GetMemoryReport();
+			UE_LOG(LogXsollaStore, Display, TEXT("Xsolla Store memory (%s):"), *It->GetPathName());
+			UE_LOG(LogXsollaStore, Display, TEXT("  Items:            %10lld bytes"), Report.Items);
+			UE_LOG(LogXsollaStore, Display, TEXT("  Groups:           %10lld bytes"), Report.Groups);
+			UE_LOG(LogXsollaStore, Display, TEXT("  SearchIndex:      %10lld bytes"), Report.SearchIndex);
+			UE_LOG(LogXsollaStore, Display, TEXT("  Currencies:       %10lld bytes"), Report.Currencies);
+			UE_LOG(LogXsollaStore, Display, TEXT("  CurrencyPackages: %10lld bytes"), Report.CurrencyPackages);
+			UE_LOG(LogXsollaStore, Display, TEXT("  Cart:             %10lld bytes"), Report.Cart);
+			UE_LOG(LogXsollaStore, Display, TEXT("  Inventory:        %10lld bytes"), Report.Inventory);
+			UE_LOG(LogXsollaStore, Display, TEXT("  Subscriptions:    %10lld bytes"), Report.Subscriptions);
+			UE_LOG(LogXsollaStore, Display, TEXT("  Images:           %10lld bytes (%d images)"), Report.Images, Report.ImageCount);
+			UE_LOG(LogXsollaStore, Display, TEXT("  PendingRequests:  %10lld bytes"), Report.PendingRequests);
+			UE_LOG(LogXsollaStore, Display, TEXT("  CurrencyLibrary:  %10lld bytes"), Report.CurrencyLibrary);
+			UE_LOG(LogXsollaStore, Display, TEXT("  Total:            %10lld bytes"), Report.Total);
+		}
+	}
+
+	static FAutoConsoleCommand MemReportCommand(
+		TEXT("Xsolla.MemReport"),
+		TEXT("Log estimated memory held by Xsolla Store caches"),
+		FConsoleCommandDelegate::CreateStatic(&LogMemoryReport));
+
+	/** Array storage with heap memory owned by its elements */
+	template <typename StructType>
+	int64 GetArrayMemorySize(const TArray<StructType>& Array)
+	{
+		int64 Size = Array.GetAllocatedSize();
+		for (const StructType& Value : Array)
+		{
+			Size += FXsollaUtilsMemory::GetAllocatedSize(StructType::StaticStruct(), &Value);
+		}
+
+		return Size;
+	}
+
+	int64 GetRequestMemorySize(const TSharedRef<IHttpRequest>& HttpRequest)
+	{
+		return HttpRequest->GetURL().GetAllocatedSize() + HttpRequest->GetContent().GetAllocatedSize();
+	}
+
+	int64 GetConsumeBatchMemorySize(const FXsollaConsumeBatch& Batch)
+	{
+		return Batch.AuthToken.GetAllocatedSize() + Batch.ItemSKU.GetAllocatedSize() + Batch.SuccessCallbacks.GetAllocatedSize() + Batch.ErrorCallbacks.GetAllocatedSize();
+	}
+} // namespace XsollaStoreMemory
+
+namespace XsollaStorePaymentTokenPrefetch
+{
+	/** Maximal number of prefetched tokens kept at once */
+	const int32 MaxPrefetchedTokens = 4;
+} // namespace XsollaStorePaymentTokenPrefetch
+
+namespace XsollaStoreWarmUp
+{
+	/** Time (in seconds) warm-up response can be used by consumer */
+	const double ResponseLifetime = 60.0;
+} // namespace XsollaStoreWarmUp
+
+namespace XsollaStoreOfflineReplay
+{
+	/** Retry interval stops growing after this number of failed attempts in a row */
+	const int32 MaxBackoffExponent = 5;
+} // namespace XsollaStoreOfflineReplay
+
 UXsollaStoreSubsystem::UXsollaStoreSubsystem()
 	: UGameInstanceSubsystem()
 {
-	static ConstructorHelpers::FObjectFinder<UDataTable> CurrencyLibraryObj(TEXT("DataTable'/Xsolla/Data/currency-format.currency-format'"));
-	CurrencyLibrary = CurrencyLibraryObj.Object;
-
-	static ConstructorHelpers::FClassFinder<UUserWidget> BrowserWidgetFinder(TEXT("/Xsolla/Browser/W_StoreBrowser.W_StoreBrowser_C"));
-	DefaultBrowserWidgetClass = BrowserWidgetFinder.Class;
+	// Assets aren't loaded until they're used or prefetched
+	CurrencyLibrary = nullptr;
+	CurrencyLibraryAsset = TSoftObjectPtr<UDataTable>(FSoftObjectPath(TEXT("/Xsolla/Data/currency-format.currency-format")));
+	DefaultBrowserWidgetClass = TSoftClassPtr<UUserWidget>(FSoftObjectPath(TEXT("/Xsolla/Browser/W_StoreBrowser.W_StoreBrowser_C")));
+	CurrencyLibraryLoader = MakeShared<FXsollaUtilsAssetLoader>(TArray<FSoftObjectPath>{CurrencyLibraryAsset.ToSoftObjectPath()});
+	BrowserWidgetLoader = MakeShared<FXsollaUtilsAssetLoader>(TArray<FSoftObjectPath>{DefaultBrowserWidgetClass.ToSoftObjectPath()});
 
 	// @TODO https://github.com/xsolla/store-ue4-sdk/issues/68
 	CachedCartCurrency = TEXT("USD");
+
+	LastConsumeBatchId = 0;
+	LastConsumeFlushId = 0;
+
+	bOfflineActionInProgress = false;
+	FailedOfflineReplays = 0;
+
+	PaymentOrderId = 0;
+	bPaymentCompletionDetected = false;
+	bPaymentInventoryRequested = false;
+
+	SaveInstance = nullptr;
+
+	Catalog = MakeShared<FXsollaStoreCatalog>();
 }
 
 void UXsollaStoreSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
+	SaveWriter = MakeShared<FXsollaSaveGameWriter>(UXsollaStoreSave::SaveSlotName, UXsollaStoreSave::UserIndex);
+
 	// Initialize subsystem with project identifier provided by user
 	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
+	if (!Settings->StoreApiBaseURL.IsEmpty())
+	{
+		FXsollaUtilsUrlOverrides::SetBaseUrlOverride(FXsollaUtilsUrlOverrides::StoreApiBaseUrl, Settings->StoreApiBaseURL);
+	}
+
+	if (Settings->EnableConnectionWarmUp)
+	{
+		FXsollaUtilsConnectionWarmer::WarmUp(FXsollaUtilsUrlOverrides::StoreApiBaseUrl, this);
+	}
+
 	Initialize(Settings->ProjectID);
 
+	AuthTokenReceivedHandle = FXsollaAuthTokenProviderRegistry::OnAuthTokenReceived().AddUObject(this, &UXsollaStoreSubsystem::HandleAuthTokenReceived);
+
 	UE_LOG(LogXsollaStore, Log, TEXT("%s: XsollaStore subsystem initialized"), *VA_FUNC_LINE);
 }
 
 void UXsollaStoreSubsystem::Deinitialize()
 {
-	// Do nothing for now
+	// Requests can't be sent from here: their completion is bound to this subsystem
+	DiscardConsumeQueue();
+
+	if (GetGameInstance())
+	{
+		GetGameInstance()->GetTimerManager().ClearTimer(OfflineReplayTimerHandle);
+	}
+
+	// Don't lose data waiting for coalesced write
+	if (SaveWriter.IsValid())
+	{
+		SaveWriter->Flush();
+	}
+
+	if (BrowserWidgetPool)
+	{
+		BrowserWidgetPool->Reset();
+	}
+
+	PrefetchedPaymentTokens.Empty();
+
+	FXsollaAuthTokenProviderRegistry::OnAuthTokenReceived().Remove(AuthTokenReceivedHandle);
+	WarmUpRequests.Empty();
+
+	// Warmed up hosts are static, so they would outlive PIE session (other game instances keep their own)
+	FXsollaUtilsConnectionWarmer::Release(this);
+
 	Super::Deinitialize();
 }
 
 void UXsollaStoreSubsystem::Initialize(const FString& InProjectId)
 {
+	XSOLLA_LLM_SCOPE();
+
 	ProjectID = InProjectId;
 
 	LoadData();
@@ -69,276 +222,295 @@ void UXsollaStoreSubsystem::Initialize(const FString& InProjectId)
 	{
 		ImageLoader = NewObject<UXsollaStoreImageLoader>();
 	}
+
+	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
+	if (Settings->EnableOfflineJournal && !OfflineJournal.IsValid())
+	{
+		OfflineJournal = MakeShareable(new FXsollaStoreOfflineJournal(FPaths::ProjectSavedDir() / TEXT("Xsolla") / TEXT("StoreOfflineJournal.jsonl")));
+		OfflineJournal->Load();
+
+		// Replay actions left from previous launch
+		ProcessOfflineJournal();
+	}
 }
 
 void UXsollaStoreSubsystem::UpdateVirtualItems(const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
 {
-	const FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/items/virtual_items"), *ProjectID);
+	auto OnResponse = [this, SuccessCallback](FStoreItemsData& ItemsData) {
+		// Blueprint structs are dropped after catalog is built, group ids are calculated by catalog
+		SetVirtualItems(ItemsData.Items);
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::GET);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::UpdateVirtualItems_HttpRequestComplete, SuccessCallback, ErrorCallback);
-	HttpRequest->ProcessRequest();
+		SuccessCallback.ExecuteIfBound();
+	};
+
+	const auto& Endpoint = XsollaStoreEndpoints::VirtualItems;
+	SendEndpointRequest(Endpoint, {}, FString(), Endpoint.MakeHandler(OnResponse, ErrorCallback));
 }
 
 void UXsollaStoreSubsystem::UpdateItemGroups(const FString& Locale, const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
 {
+	auto OnResponse = [this, SuccessCallback](FStoreItemsData& GroupsData) {
+		Catalog->SetGroups(GroupsData.Groups);
+
+		SuccessCallback.ExecuteIfBound();
+	};
+
 	const FString UsedLocale = Locale.IsEmpty() ? TEXT("en") : Locale;
-	const FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/items/groups?locale=%s"), *ProjectID, *UsedLocale);
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::GET);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::UpdateItemGroups_HttpRequestComplete, SuccessCallback, ErrorCallback);
-	HttpRequest->ProcessRequest();
+	const auto& Endpoint = XsollaStoreEndpoints::ItemGroups;
+	SendEndpointRequest(Endpoint, {UsedLocale}, FString(), Endpoint.MakeHandler(OnResponse, ErrorCallback));
 }
 
 void UXsollaStoreSubsystem::UpdateInventory(const FString& AuthToken, const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
 {
 	CachedAuthToken = AuthToken;
 
-	FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/user/inventory/items"), *ProjectID);
+	auto OnResponse = [this, SuccessCallback](FStoreInventory& ReceivedInventory) {
+		SetInventory(ReceivedInventory);
 
-	const FString Platform = GetPublishingPlatformName();
-	if (!Platform.IsEmpty())
-	{
-		Url += FString::Printf(TEXT("%splatform=%s"), Url.Contains(TEXT("?")) ? TEXT("&") : TEXT("?"), *Platform);
-	}
+		SuccessCallback.ExecuteIfBound();
+	};
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::GET, AuthToken);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::UpdateInventory_HttpRequestComplete, SuccessCallback, ErrorCallback);
-	HttpRequest->ProcessRequest();
+	const auto& Endpoint = XsollaStoreEndpoints::Inventory;
+	SendEndpointRequest(Endpoint, {}, AuthToken, Endpoint.MakeHandler(OnResponse, ErrorCallback));
 }
 
 void UXsollaStoreSubsystem::UpdateVirtualCurrencies(const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
 {
-	const FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/items/virtual_currency"), *ProjectID);
+	auto OnResponse = [this, SuccessCallback](FVirtualCurrencyData& CurrencyData) {
+		VirtualCurrencyData = MoveTemp(CurrencyData);
+		for (FVirtualCurrency& Currency : VirtualCurrencyData.Items)
+		{
+			Currency.price.ParseAmounts();
+		}
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::GET);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::UpdateVirtualCurrencies_HttpRequestComplete, SuccessCallback, ErrorCallback);
-	HttpRequest->ProcessRequest();
+		SuccessCallback.ExecuteIfBound();
+	};
+
+	const auto& Endpoint = XsollaStoreEndpoints::VirtualCurrencies;
+	SendEndpointRequest(Endpoint, {}, FString(), Endpoint.MakeHandler(OnResponse, ErrorCallback));
 }
 
 void UXsollaStoreSubsystem::UpdateVirtualCurrencyPackages(const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
 {
-	const FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/items/virtual_currency/package"), *ProjectID);
+	auto OnResponse = [this, SuccessCallback](FVirtualCurrencyPackagesData& PackagesData) {
+		SetVirtualCurrencyPackages(PackagesData.Items);
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::GET);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::UpdateVirtualCurrencyPackages_HttpRequestComplete, SuccessCallback, ErrorCallback);
-	HttpRequest->ProcessRequest();
+		SuccessCallback.ExecuteIfBound();
+	};
+
+	const auto& Endpoint = XsollaStoreEndpoints::VirtualCurrencyPackages;
+	SendEndpointRequest(Endpoint, {}, FString(), Endpoint.MakeHandler(OnResponse, ErrorCallback));
 }
 
 void UXsollaStoreSubsystem::UpdateVirtualCurrencyBalance(const FString& AuthToken, const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
 {
 	CachedAuthToken = AuthToken;
 
-	FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/user/virtual_currency_balance"), *ProjectID);
+	auto OnResponse = [this, SuccessCallback](FVirtualCurrencyBalanceData& BalanceData) {
+		VirtualCurrencyBalance = MoveTemp(BalanceData);
 
-	const FString Platform = GetPublishingPlatformName();
-	if (!Platform.IsEmpty())
-	{
-		Url += FString::Printf(TEXT("%splatform=%s"), Url.Contains(TEXT("?")) ? TEXT("&") : TEXT("?"), *Platform);
-	}
+		SuccessCallback.ExecuteIfBound();
+	};
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::GET, AuthToken);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::UpdateVirtualCurrencyBalance_HttpRequestComplete, SuccessCallback, ErrorCallback);
-	HttpRequest->ProcessRequest();
+	const auto& Endpoint = XsollaStoreEndpoints::VirtualCurrencyBalance;
+	SendEndpointRequest(Endpoint, {}, AuthToken, Endpoint.MakeHandler(OnResponse, ErrorCallback));
 }
 
 void UXsollaStoreSubsystem::UpdateSubscriptions(const FString& AuthToken, const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
 {
 	CachedAuthToken = AuthToken;
 
-	FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/user/subscriptions"), *ProjectID);
+	auto OnResponse = [this, SuccessCallback](FStoreSubscriptionData& SubscriptionData) {
+		Subscriptions = MoveTemp(SubscriptionData);
+
+		SuccessCallback.ExecuteIfBound();
+	};
+
+	const auto& Endpoint = XsollaStoreEndpoints::Subscriptions;
+	SendEndpointRequest(Endpoint, {}, AuthToken, Endpoint.MakeHandler(OnResponse, ErrorCallback));
+}
 
-	const FString Platform = GetPublishingPlatformName();
-	if (!Platform.IsEmpty())
+void UXsollaStoreSubsystem::WarmUpUserData(const FString& AuthToken)
+{
+	if (AuthToken.IsEmpty())
 	{
-		Url += FString::Printf(TEXT("%splatform=%s"), Url.Contains(TEXT("?")) ? TEXT("&") : TEXT("?"), *Platform);
+		return;
 	}
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::GET, AuthToken);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::UpdateSubscriptions_HttpRequestComplete, SuccessCallback, ErrorCallback);
-	HttpRequest->ProcessRequest();
+	UE_LOG(LogXsollaStore, Log, TEXT("%s: Warming up user data"), *VA_FUNC_LINE);
+
+	for (const FXsollaStoreEndpoint* Endpoint : XsollaStoreEndpoints::WarmUpEndpoints)
+	{
+		StartWarmUpRequest(*Endpoint, AuthToken);
+	}
 }
 
 void UXsollaStoreSubsystem::FetchPaymentToken(const FString& AuthToken, const FString& ItemSKU, const FString& Currency, const FString& Country, const FString& Locale, const FOnFetchTokenSuccess& SuccessCallback, const FOnStoreError& ErrorCallback)
 {
-	// Prepare request payload
-	TSharedPtr<FJsonObject> RequestDataJson = MakeShareable(new FJsonObject);
-	if (!Currency.IsEmpty())
-		RequestDataJson->SetStringField(TEXT("currency"), Currency);
-	if (!Country.IsEmpty())
-		RequestDataJson->SetStringField(TEXT("country"), Country);
-	if (!Locale.IsEmpty())
-		RequestDataJson->SetStringField(TEXT("locale"), Locale);
-
-	RequestDataJson->SetBoolField(TEXT("sandbox"), IsSandboxEnabled());
-
-	FString theme;
+	PaymentAuthToken = AuthToken;
 
 	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
-	switch (Settings->PaymentInterfaceTheme)
+	if (!Settings->UsePlatformBrowser)
 	{
-	case EXsollaPaymentUiTheme::Default:
-		theme = TEXT("default");
-		break;
-
-	case EXsollaPaymentUiTheme::DefaultDark:
-		theme = TEXT("default_dark");
-		break;
+		// Payment console is likely to be opened once token is received
+		PrefetchAssets();
+	}
 
-	case EXsollaPaymentUiTheme::Dark:
-		theme = TEXT("dark");
-		break;
+	if (Settings->EnablePaymentTokenPrefetch && TakePrefetchedPaymentToken(GetPaymentTokenPrefetchKey(AuthToken, ItemSKU, Currency, Country, Locale), SuccessCallback, ErrorCallback))
+	{
+		return;
+	}
 
-	default:
-		theme = TEXT("dark");
+	TSharedPtr<IHttpRequest> HttpRequest = CreateFetchPaymentTokenRequest(XsollaStoreEndpoints::ItemPaymentToken, {ItemSKU}, AuthToken, Currency, Country, Locale, ErrorCallback);
+	if (!HttpRequest.IsValid())
+	{
+		return;
 	}
 
-	TSharedPtr<FJsonObject> PaymentUiSettingsJson = MakeShareable(new FJsonObject);
-	PaymentUiSettingsJson->SetStringField(TEXT("theme"), theme);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, MakePaymentTokenHandler(SuccessCallback, ErrorCallback));
+	HttpRequest->ProcessRequest();
+}
 
-	TSharedPtr<FJsonObject> PaymentSettingsJson = MakeShareable(new FJsonObject);
-	PaymentSettingsJson->SetObjectField(TEXT("ui"), PaymentUiSettingsJson);
+void UXsollaStoreSubsystem::PrefetchPaymentToken(const FString& AuthToken, const FString& ItemSKU, const FString& Currency, const FString& Country, const FString& Locale)
+{
+	using namespace XsollaStorePaymentTokenPrefetch;
 
-	RequestDataJson->SetObjectField(TEXT("settings"), PaymentSettingsJson);
+	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
+	if (!Settings->EnablePaymentTokenPrefetch)
+	{
+		return;
+	}
 
-	const FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/payment/item/%s"), *ProjectID, *ItemSKU);
+	RemoveExpiredPaymentTokens();
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::POST, AuthToken, SerializeJson(RequestDataJson));
+	const FString PrefetchKey = GetPaymentTokenPrefetchKey(AuthToken, ItemSKU, Currency, Country, Locale);
+	if (PrefetchedPaymentTokens.Contains(PrefetchKey))
+	{
+		return;
+	}
 
-	if (Settings->BuildForSteam)
+	// Drop the oldest unused token when focus moves on (token with waiting purchase is never dropped)
+	if (PrefetchedPaymentTokens.Num() >= MaxPrefetchedTokens)
 	{
-		TSharedPtr<FJsonObject> PayloadJsonObject;
-		if (!ParseTokenPayload(AuthToken, PayloadJsonObject))
+		FString OldestKey;
+		double OldestTime = MAX_dbl;
+		for (const auto& PrefetchedToken : PrefetchedPaymentTokens)
 		{
-			UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't parse token payload"), *VA_FUNC_LINE);
-			ErrorCallback.ExecuteIfBound(0, 0, TEXT("Can't parse token payload"));
-			return;
+			if (!PrefetchedToken.Value.bHasWaitingPurchase && PrefetchedToken.Value.RequestTime < OldestTime)
+			{
+				OldestKey = PrefetchedToken.Key;
+				OldestTime = PrefetchedToken.Value.RequestTime;
+			}
 		}
 
-		FString SteamIdUrl;
-		if (!PayloadJsonObject->TryGetStringField(TEXT("id"), SteamIdUrl))
+		if (OldestKey.IsEmpty())
 		{
-			UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't find Steam profile ID in token payload"), *VA_FUNC_LINE);
-			ErrorCallback.ExecuteIfBound(0, 0, TEXT("Can't find Steam profile ID in token payload"));
 			return;
 		}
 
-		// Extract ID value from user's Steam profile URL
-		FString SteamId;
-		int SteamIdIndex;
-		if (SteamIdUrl.FindLastChar('/', SteamIdIndex))
+		// Token which is still being fetched is counted as wasted on its response
+		if (!PrefetchedPaymentTokens[OldestKey].AccessToken.IsEmpty())
 		{
-			SteamId = SteamIdUrl.RightChop(SteamIdIndex + 1);
+			PaymentTokenPrefetchStats.WastedTokens++;
 		}
-
-		HttpRequest->SetHeader(TEXT("x-steam-userid"), SteamId);
+		PrefetchedPaymentTokens.Remove(OldestKey);
 	}
 
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::FetchPaymentToken_HttpRequestComplete, SuccessCallback, ErrorCallback);
-	HttpRequest->ProcessRequest();
-}
+	TSharedPtr<IHttpRequest> HttpRequest = CreateFetchPaymentTokenRequest(XsollaStoreEndpoints::ItemPaymentToken, {ItemSKU}, AuthToken, Currency, Country, Locale, FOnStoreError());
+	if (!HttpRequest.IsValid())
+	{
+		return;
+	}
 
-void UXsollaStoreSubsystem::FetchCartPaymentToken(const FString& AuthToken, const FString& CartId, const FString& Currency, const FString& Country, const FString& Locale, const FOnFetchTokenSuccess& SuccessCallback, const FOnStoreError& ErrorCallback)
-{
-	CachedAuthToken = AuthToken;
-	CachedCartId = CartId;
+	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Prefetching payment token for %s"), *VA_FUNC_LINE, *ItemSKU);
 
-	// Prepare request payload
-	TSharedPtr<FJsonObject> RequestDataJson = MakeShareable(new FJsonObject);
-	if (!Currency.IsEmpty())
-		RequestDataJson->SetStringField(TEXT("currency"), Currency);
-	if (!Country.IsEmpty())
-		RequestDataJson->SetStringField(TEXT("country"), Country);
-	if (!Locale.IsEmpty())
-		RequestDataJson->SetStringField(TEXT("locale"), Locale);
+	FXsollaPrefetchedPaymentToken& PrefetchedToken = PrefetchedPaymentTokens.Add(PrefetchKey);
+	PrefetchedToken.RequestTime = FPlatformTime::Seconds();
+	PrefetchedToken.AuthToken = AuthToken;
+	PrefetchedToken.ItemSKU = ItemSKU;
+	PrefetchedToken.Currency = Currency;
+	PrefetchedToken.Country = Country;
+	PrefetchedToken.Locale = Locale;
 
-	RequestDataJson->SetBoolField(TEXT("sandbox"), IsSandboxEnabled());
+	PaymentTokenPrefetchStats.Prefetches++;
 
-	FString theme;
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::PrefetchPaymentToken_HttpRequestComplete, PrefetchKey);
+	HttpRequest->ProcessRequest();
+}
 
-	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
-	switch (Settings->PaymentInterfaceTheme)
+FStorePaymentTokenPrefetchStats UXsollaStoreSubsystem::GetPaymentTokenPrefetchStats() const
+{
+	FStorePaymentTokenPrefetchStats Stats = PaymentTokenPrefetchStats;
+	Stats.CachedTokens = 0;
+	Stats.InFlightRequests = 0;
+	for (const auto& PrefetchedToken : PrefetchedPaymentTokens)
 	{
-	case EXsollaPaymentUiTheme::Default:
-		theme = TEXT("default");
-		break;
-
-	case EXsollaPaymentUiTheme::DefaultDark:
-		theme = TEXT("default_dark");
-		break;
-
-	case EXsollaPaymentUiTheme::Dark:
-		theme = TEXT("dark");
-		break;
-
-	default:
-		theme = TEXT("dark");
+		if (PrefetchedToken.Value.AccessToken.IsEmpty())
+		{
+			Stats.InFlightRequests++;
+		}
+		else
+		{
+			Stats.CachedTokens++;
+		}
 	}
 
-	TSharedPtr<FJsonObject> PaymentUiSettingsJson = MakeShareable(new FJsonObject);
-	PaymentUiSettingsJson->SetStringField(TEXT("theme"), theme);
+	const int32 Purchases = Stats.Hits + Stats.Misses;
+	Stats.HitRate = Purchases > 0 ? static_cast<float>(Stats.Hits) / Purchases : 0.f;
+	Stats.WasteRate = Stats.Prefetches > 0 ? static_cast<float>(Stats.WastedTokens) / Stats.Prefetches : 0.f;
 
-	TSharedPtr<FJsonObject> PaymentSettingsJson = MakeShareable(new FJsonObject);
-	PaymentSettingsJson->SetObjectField(TEXT("ui"), PaymentUiSettingsJson);
+	return Stats;
+}
 
-	RequestDataJson->SetObjectField(TEXT("settings"), PaymentSettingsJson);
+void UXsollaStoreSubsystem::FetchCartPaymentToken(const FString& AuthToken, const FString& CartId, const FString& Currency, const FString& Country, const FString& Locale, const FOnFetchTokenSuccess& SuccessCallback, const FOnStoreError& ErrorCallback)
+{
+	CachedAuthToken = AuthToken;
+	CachedCartId = CartId;
+	PaymentAuthToken = AuthToken;
 
-	FString Url;
-	if (CartId.IsEmpty())
-	{
-		Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/payment/cart"), *ProjectID);
-	}
-	else
+	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
+	if (!Settings->UsePlatformBrowser)
 	{
-		Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/payment/cart/%s"), *ProjectID, *Cart.cart_id);
+		// Payment console is likely to be opened once token is received
+		PrefetchAssets();
 	}
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::POST, AuthToken, SerializeJson(RequestDataJson));
-
-	if (Settings->BuildForSteam)
+	TSharedPtr<IHttpRequest> HttpRequest = CartId.IsEmpty()
+		? CreateFetchPaymentTokenRequest(XsollaStoreEndpoints::CartPaymentToken, {}, AuthToken, Currency, Country, Locale, ErrorCallback)
+		: CreateFetchPaymentTokenRequest(XsollaStoreEndpoints::CartByIdPaymentToken, {Cart.cart_id}, AuthToken, Currency, Country, Locale, ErrorCallback);
+	if (!HttpRequest.IsValid())
 	{
-		TSharedPtr<FJsonObject> PayloadJsonObject;
-		if (!ParseTokenPayload(AuthToken, PayloadJsonObject))
-		{
-			UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't parse token payload"), *VA_FUNC_LINE);
-			ErrorCallback.ExecuteIfBound(0, 0, TEXT("Can't parse token payload"));
-			return;
-		}
-
-		FString SteamIdUrl;
-		if (!PayloadJsonObject->TryGetStringField(TEXT("id"), SteamIdUrl))
-		{
-			UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't find Steam profile ID in token payload"), *VA_FUNC_LINE);
-			ErrorCallback.ExecuteIfBound(0, 0, TEXT("Can't find Steam profile ID in token payload"));
-			return;
-		}
+		return;
+	}
 
-		// Extract ID value from user's Steam profile URL
-		FString SteamId;
-		int SteamIdIndex;
-		if (SteamIdUrl.FindLastChar('/', SteamIdIndex))
-		{
-			SteamId = SteamIdUrl.RightChop(SteamIdIndex + 1);
-		}
+	FXsollaStoreResponseHandler Handler = MakePaymentTokenHandler(SuccessCallback, ErrorCallback);
+	const TFunction<FString(const FString&)> HandleResponse = Handler.HandleResponse;
+	Handler.HandleResponse = [this, HandleResponse](const FString& Content) {
+		const FString ParseError = HandleResponse(Content);
+		ProcessNextCartRequest();
+		return ParseError;
+	};
+	Handler.HandleError = [this]() {
+		ProcessNextCartRequest();
+	};
 
-		HttpRequest->SetHeader(TEXT("x-steam-userid"), SteamId);
-	}
+	// Payment is made for cart with all changes requested before it (including journaled ones)
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, Handler);
 
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::FetchPaymentToken_HttpRequestComplete, SuccessCallback, ErrorCallback);
-	HttpRequest->ProcessRequest();
+	CartRequestsQueue.Add(HttpRequest.ToSharedRef());
+	ProcessNextCartRequest();
 }
 
 void UXsollaStoreSubsystem::LaunchPaymentConsole(const FString& AccessToken, UUserWidget*& BrowserWidget)
 {
-	FString PaystationUrl;
-	if (IsSandboxEnabled())
-	{
-		PaystationUrl = FString::Printf(TEXT("https://sandbox-secure.xsolla.com/paystation3?access_token=%s"), *AccessToken);
-	}
-	else
-	{
-		PaystationUrl = FString::Printf(TEXT("https://secure.xsolla.com/paystation3?access_token=%s"), *AccessToken);
-	}
+	LaunchPaymentConsole(AccessToken, BrowserWidget, FOnStoreError());
+}
+
+void UXsollaStoreSubsystem::LaunchPaymentConsole(const FString& AccessToken, UUserWidget*& BrowserWidget, const FOnStoreError& ErrorCallback)
+{
+	const FString& PaystationBaseUrl = IsSandboxEnabled() ? FXsollaUtilsUrlOverrides::SandboxPayStationBaseUrl : FXsollaUtilsUrlOverrides::PayStationBaseUrl;
+	const FString PaystationUrl = FXsollaUtilsUrlOverrides::Apply(FString::Printf(TEXT("%s?access_token=%s"), *PaystationBaseUrl, *AccessToken));
 
 	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
 	if (Settings->UsePlatformBrowser)
@@ -353,26 +525,200 @@ void UXsollaStoreSubsystem::LaunchPaymentConsole(const FString& AccessToken, UUs
 	{
 		UE_LOG(LogXsollaStore, Log, TEXT("%s: Loading Paystation: %s"), *VA_FUNC_LINE, *PaystationUrl);
 
-		// Check for user browser widget override
-		auto BrowserWidgetClass = (Settings->OverrideBrowserWidgetClass) ? Settings->OverrideBrowserWidgetClass : DefaultBrowserWidgetClass;
+		auto BrowserWidgetClass = GetBrowserWidgetClass();
+		if (!BrowserWidgetClass)
+		{
+			UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't load browser widget class"), *VA_FUNC_LINE);
+			BrowserWidget = nullptr;
+			ErrorCallback.ExecuteIfBound(0, 0, TEXT("Can't load browser widget class"));
+			return;
+		}
 
 		PengindPaystationUrl = PaystationUrl;
-		auto MyBrowser = CreateWidget<UUserWidget>(GEngine->GameViewport->GetWorld(), BrowserWidgetClass);
-		MyBrowser->AddToViewport(MAX_int32);
+		if (Settings->ReuseBrowserWidget)
+		{
+			BrowserWidget = GetBrowserWidgetPool()->Acquire(GEngine->GameViewport->GetWorld(), BrowserWidgetClass, PaystationUrl);
+		}
+		else
+		{
+			auto MyBrowser = CreateWidget<UUserWidget>(GEngine->GameViewport->GetWorld(), BrowserWidgetClass);
+			MyBrowser->AddToViewport(MAX_int32);
+
+			BrowserWidget = MyBrowser;
+		}
 
-		BrowserWidget = MyBrowser;
+		if (Settings->EnablePaymentCompletionDetection)
+		{
+			WatchPaymentBrowser(BrowserWidget);
+		}
 	}
 }
 
-void UXsollaStoreSubsystem::CheckOrder(const FString& AuthToken, int32 OrderId, const FOnCheckOrder& SuccessCallback, const FOnStoreError& ErrorCallback)
+void UXsollaStoreSubsystem::WatchPaymentBrowser(UUserWidget* BrowserWidget)
+{
+	bPaymentCompletionDetected = false;
+	bPaymentInventoryRequested = false;
+
+	for (UXsollaWebBrowser* Browser : UXsollaWebBrowser::FindBrowsers(BrowserWidget))
+	{
+		// Reused widget is bound already
+		Browser->OnUrlChanged.AddUniqueDynamic(this, &UXsollaStoreSubsystem::HandlePaymentUrlChanged);
+		Browser->OnBeforeNavigation.AddUniqueDynamic(this, &UXsollaStoreSubsystem::HandlePaymentNavigation);
+	}
+}
+
+void UXsollaStoreSubsystem::HandlePaymentUrlChanged(const FText& Url)
+{
+	DetectPaymentCompletion(Url.ToString());
+}
+
+void UXsollaStoreSubsystem::HandlePaymentNavigation(FString Url, bool bIsRedirect)
+{
+	DetectPaymentCompletion(Url);
+}
+
+void UXsollaStoreSubsystem::DetectPaymentCompletion(const FString& Url)
+{
+	// Status page and return URL redirect report the same payment
+	if (bPaymentCompletionDetected)
+	{
+		return;
+	}
+
+	FXsollaPaymentUrlResult PaymentResult;
+	if (!FXsollaUtilsPaymentUrl::Parse(Url, PaymentResult) || PaymentResult.Status == EXsollaPaymentUrlStatus::Unknown)
+	{
+		return;
+	}
+
+	bPaymentCompletionDetected = true;
+
+	const int32 OrderId = (PaymentResult.OrderId != 0) ? PaymentResult.OrderId : PaymentOrderId;
+
+	UE_LOG(LogXsollaStore, Log, TEXT("%s: Payment status detected: %s (order %d)"), *VA_FUNC_LINE, *PaymentResult.StatusName, OrderId);
+
+	// Items are granted by the time PayStation reports success, so inventory is refreshed along with order check
+	if (PaymentResult.Status == EXsollaPaymentUrlStatus::Done)
+	{
+		bPaymentInventoryRequested = true;
+		UpdateInventory(PaymentAuthToken, FOnStoreUpdate(), FOnStoreError());
+	}
+
+	if (OrderId != 0)
+	{
+		FOnCheckOrder CheckOrderCallback;
+		CheckOrderCallback.BindDynamic(this, &UXsollaStoreSubsystem::HandleDetectedOrderChecked);
+
+		CheckOrder(PaymentAuthToken, OrderId, CheckOrderCallback, FOnStoreError());
+	}
+}
+
+void UXsollaStoreSubsystem::HandleDetectedOrderChecked(int32 OrderId, EXsollaOrderStatus OrderStatus)
+{
+	if (OrderStatus == EXsollaOrderStatus::Done && !bPaymentInventoryRequested)
+	{
+		bPaymentInventoryRequested = true;
+		UpdateInventory(PaymentAuthToken, FOnStoreUpdate(), FOnStoreError());
+	}
+
+	OnPaymentStatusUpdate.Broadcast(OrderId, OrderStatus);
+}
+
+void UXsollaStoreSubsystem::PrewarmPaymentConsole()
+{
+	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
+	if (Settings->UsePlatformBrowser || !Settings->ReuseBrowserWidget || !GEngine->GameViewport)
+	{
+		return;
+	}
+
+	UWorld* World = GEngine->GameViewport->GetWorld();
+	auto BrowserWidgetClass = GetBrowserWidgetClass();
+	if (!BrowserWidgetClass)
+	{
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't load browser widget class"), *VA_FUNC_LINE);
+		return;
+	}
+
+	// Pending url of shown widget shouldn't be replaced
+	if (GetBrowserWidgetPool()->IsWarm(World, BrowserWidgetClass) || GetBrowserWidgetPool()->IsInUse())
+	{
+		return;
+	}
+
+	UE_LOG(LogXsollaStore, Log, TEXT("%s: Prewarming payment browser"), *VA_FUNC_LINE);
+
+	// Widget loads pending url on construct
+	PengindPaystationUrl = FXsollaWebBrowserHost::BlankUrl;
+	GetBrowserWidgetPool()->Prewarm(World, BrowserWidgetClass);
+}
+
+void UXsollaStoreSubsystem::PrefetchAssets()
+{
+	CurrencyLibraryLoader->Prefetch(FSimpleDelegate::CreateUObject(this, &UXsollaStoreSubsystem::HandleAssetsLoaded));
+	BrowserWidgetLoader->Prefetch();
+}
+
+void UXsollaStoreSubsystem::HandleAssetsLoaded()
+{
+	CurrencyLibrary = CurrencyLibraryAsset.Get();
+}
+
+TSubclassOf<UUserWidget> UXsollaStoreSubsystem::GetBrowserWidgetClass()
+{
+	// Check for user browser widget override
+	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
+	if (Settings->OverrideBrowserWidgetClass)
+	{
+		return Settings->OverrideBrowserWidgetClass;
+	}
+
+	BrowserWidgetLoader->Load();
+
+	return DefaultBrowserWidgetClass.Get();
+}
+
+UXsollaWebBrowserWidgetPool* UXsollaStoreSubsystem::GetBrowserWidgetPool()
+{
+	if (!BrowserWidgetPool)
+	{
+		BrowserWidgetPool = NewObject<UXsollaWebBrowserWidgetPool>(this);
+	}
+
+	return BrowserWidgetPool;
+}
+
+void UXsollaStoreSubsystem::CheckOrder(const FString& AuthToken, int32 OrderId, const FOnCheckOrder& SuccessCallback, const FOnStoreError& ErrorCallback)
 {
 	CachedAuthToken = AuthToken;
 
-	const FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/order/%d"), *ProjectID, OrderId);
+	auto OnResponse = [SuccessCallback](TSharedPtr<FJsonObject>& JsonObject) {
+		const int32 ReceivedOrderId = JsonObject->GetNumberField(TEXT("order_id"));
+		const FString Status = JsonObject->GetStringField(TEXT("status"));
+		EXsollaOrderStatus OrderStatus = EXsollaOrderStatus::Unknown;
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::GET, AuthToken);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::CheckOrder_HttpRequestComplete, SuccessCallback, ErrorCallback);
-	HttpRequest->ProcessRequest();
+		if (Status == TEXT("new"))
+		{
+			OrderStatus = EXsollaOrderStatus::New;
+		}
+		else if (Status == TEXT("paid"))
+		{
+			OrderStatus = EXsollaOrderStatus::Paid;
+		}
+		else if (Status == TEXT("done"))
+		{
+			OrderStatus = EXsollaOrderStatus::Done;
+		}
+		else
+		{
+			UE_LOG(LogXsollaStore, Warning, TEXT("%s: Unknown order status: %s [%d]"), *VA_FUNC_LINE, *Status, ReceivedOrderId);
+		}
+
+		SuccessCallback.ExecuteIfBound(ReceivedOrderId, OrderStatus);
+	};
+
+	const auto& Endpoint = XsollaStoreEndpoints::Order;
+	SendEndpointRequest(Endpoint, {OrderId}, AuthToken, Endpoint.MakeHandler(OnResponse, ErrorCallback));
 }
 
 void UXsollaStoreSubsystem::ClearCart(const FString& AuthToken, const FString& CartId, const FOnStoreCartUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
@@ -380,21 +726,28 @@ void UXsollaStoreSubsystem::ClearCart(const FString& AuthToken, const FString& C
 	CachedAuthToken = AuthToken;
 	CachedCartId = CartId;
 
-	FString Url;
-	if (CartId.IsEmpty())
+	const FString RequestCartId = CartId.IsEmpty() ? FString() : Cart.cart_id;
+
+	if (IsOfflineJournalEnabled())
 	{
-		Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/cart/clear"), *ProjectID);
+		FStoreOfflineAction Action;
+		Action.Type = EXsollaOfflineActionType::ClearCart;
+		Action.CartId = RequestCartId;
+
+		FXsollaOfflineActionCallbacks Callbacks;
+		Callbacks.CartUpdateCallback = SuccessCallback;
+		Callbacks.ErrorCallback = ErrorCallback;
+
+		JournalOfflineAction(Action, AuthToken, Callbacks);
 	}
 	else
 	{
-		Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/cart/%s/clear"), *ProjectID, *Cart.cart_id);
-	}
-
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::PUT, AuthToken);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::ClearCart_HttpRequestComplete, SuccessCallback, ErrorCallback);
+		TSharedRef<IHttpRequest> HttpRequest = CreateClearCartRequest(AuthToken, RequestCartId);
+		FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, MakeClearCartHandler(SuccessCallback, ErrorCallback));
 
-	CartRequestsQueue.Add(HttpRequest);
-	ProcessNextCartRequest();
+		CartRequestsQueue.Add(HttpRequest);
+		ProcessNextCartRequest();
+	}
 
 	// Just cleanup local cart
 	Cart.Items.Empty();
@@ -406,18 +759,41 @@ void UXsollaStoreSubsystem::UpdateCart(const FString& AuthToken, const FString&
 	CachedAuthToken = AuthToken;
 	CachedCartId = CartId;
 
-	FString Url;
-	if (CartId.IsEmpty())
-	{
-		Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/cart"), *ProjectID);
-	}
-	else
+	auto OnResponse = [this, SuccessCallback](FStoreCart& ReceivedCart) {
+		Cart = MoveTemp(ReceivedCart);
+
+		Cart.price.ParseAmounts();
+		for (FStoreCartItem& Item : Cart.Items)
+		{
+			Item.price.ParseAmounts();
+			for (FVirtualCurrencyPrice& VirtualPrice : Item.vc_prices)
+			{
+				VirtualPrice.calculated_price.ParseAmounts();
+			}
+		}
+
+		OnCartUpdate.Broadcast(Cart);
+
+		SuccessCallback.ExecuteIfBound();
+
+		ProcessNextCartRequest();
+	};
+
+	const FXsollaStoreResponseHandler Handler = XsollaStoreEndpoints::Cart.MakeHandler(OnResponse, ErrorCallback, [this]() {
+		ProcessNextCartRequest();
+	});
+
+	// Only current user cart is warmed up
+	if (CartId.IsEmpty() && TakeWarmUpRequest(XsollaStoreEndpoints::Cart, AuthToken,
+								FHttpRequestCompleteDelegate::CreateUObject(this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, Handler)))
 	{
-		Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/cart/%s"), *ProjectID, *Cart.cart_id);
+		return;
 	}
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::GET, AuthToken);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::UpdateCart_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	TSharedRef<IHttpRequest> HttpRequest = CartId.IsEmpty()
+		? CreateEndpointRequest(XsollaStoreEndpoints::Cart, {}, AuthToken)
+		: CreateEndpointRequest(XsollaStoreEndpoints::CartById, {Cart.cart_id}, AuthToken);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, Handler);
 
 	CartRequestsQueue.Add(HttpRequest);
 	ProcessNextCartRequest();
@@ -428,823 +804,1671 @@ void UXsollaStoreSubsystem::AddToCart(const FString& AuthToken, const FString& C
 	CachedAuthToken = AuthToken;
 	CachedCartId = CartId;
 
-	// Prepare request payload
-	TSharedPtr<FJsonObject> RequestDataJson = MakeShareable(new FJsonObject);
-	RequestDataJson->SetNumberField(TEXT("quantity"), Quantity);
+	const FString RequestCartId = CartId.IsEmpty() ? FString() : Cart.cart_id;
 
-	FString Url;
-	if (CartId.IsEmpty())
+	if (IsOfflineJournalEnabled())
 	{
-		Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/cart/item/%s"), *ProjectID, *ItemSKU);
+		FStoreOfflineAction Action;
+		Action.Type = EXsollaOfflineActionType::AddToCart;
+		Action.CartId = RequestCartId;
+		Action.ItemSKU = ItemSKU;
+		Action.Quantity = Quantity;
+
+		FXsollaOfflineActionCallbacks Callbacks;
+		Callbacks.CartUpdateCallback = SuccessCallback;
+		Callbacks.ErrorCallback = ErrorCallback;
+
+		JournalOfflineAction(Action, AuthToken, Callbacks);
 	}
 	else
 	{
-		Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/cart/%s/item/%s"), *ProjectID, *Cart.cart_id, *ItemSKU);
+		TSharedRef<IHttpRequest> HttpRequest = CreateAddToCartRequest(AuthToken, RequestCartId, ItemSKU, Quantity);
+		FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, MakeCartItemHandler(SuccessCallback, ErrorCallback));
+
+		CartRequestsQueue.Add(HttpRequest);
+		ProcessNextCartRequest();
 	}
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::PUT, AuthToken, SerializeJson(RequestDataJson));
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::AddToCart_HttpRequestComplete, SuccessCallback, ErrorCallback);
+	UpdateCartItemLocally(ItemSKU, Quantity);
 
-	CartRequestsQueue.Add(HttpRequest);
-	ProcessNextCartRequest();
+	OnCartUpdate.Broadcast(Cart);
+}
 
-	// Try to update item quantity
+void UXsollaStoreSubsystem::UpdateCartItemLocally(const FString& ItemSKU, int32 Quantity)
+{
 	auto CartItem = Cart.Items.FindByPredicate([ItemSKU](const FStoreCartItem& InItem) {
 		return InItem.sku == ItemSKU;
 	});
 
 	if (CartItem)
 	{
-		CartItem->quantity = FMath::Max(0, Quantity);
+		CartItem->quantity = FMath::Max(0, Quantity);
+	}
+	else
+	{
+		const int32 StoreItemIndex = Catalog->FindItem(ItemSKU);
+		if (StoreItemIndex != INDEX_NONE)
+		{
+			FStoreCartItem Item(Catalog->GetItem(StoreItemIndex));
+			Item.quantity = FMath::Max(0, Quantity);
+
+			// @TODO Predict price locally before cart sync https://github.com/xsolla/store-ue4-sdk/issues/68
+
+			Cart.Items.Add(Item);
+		}
+		else
+		{
+			const int32 CurrencyPackageIndex = Catalog->FindCurrencyPackage(ItemSKU);
+			if (CurrencyPackageIndex != INDEX_NONE)
+			{
+				FStoreCartItem Item(Catalog->GetCurrencyPackage(CurrencyPackageIndex));
+				Item.quantity = FMath::Max(0, Quantity);
+
+				Cart.Items.Add(Item);
+			}
+			else
+			{
+				UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't find provided SKU in local cache: %s"), *VA_FUNC_LINE, *ItemSKU);
+			}
+		}
+	}
+}
+
+void UXsollaStoreSubsystem::SetVirtualItems(const TArray<FStoreItem>& Items)
+{
+	Catalog->SetItems(Items);
+}
+
+void UXsollaStoreSubsystem::SetVirtualCurrencyPackages(const TArray<FVirtualCurrencyPackage>& Packages)
+{
+	Catalog->SetCurrencyPackages(Packages);
+}
+
+void UXsollaStoreSubsystem::RemoveFromCart(const FString& AuthToken, const FString& CartId, const FString& ItemSKU, const FOnStoreCartUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
+{
+	CachedAuthToken = AuthToken;
+	CachedCartId = CartId;
+
+	const FString RequestCartId = CartId.IsEmpty() ? FString() : Cart.cart_id;
+
+	if (IsOfflineJournalEnabled())
+	{
+		FStoreOfflineAction Action;
+		Action.Type = EXsollaOfflineActionType::RemoveFromCart;
+		Action.CartId = RequestCartId;
+		Action.ItemSKU = ItemSKU;
+
+		FXsollaOfflineActionCallbacks Callbacks;
+		Callbacks.CartUpdateCallback = SuccessCallback;
+		Callbacks.ErrorCallback = ErrorCallback;
+
+		JournalOfflineAction(Action, AuthToken, Callbacks);
+	}
+	else
+	{
+		TSharedRef<IHttpRequest> HttpRequest = CreateRemoveFromCartRequest(AuthToken, RequestCartId, ItemSKU);
+		FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, MakeCartItemHandler(SuccessCallback, ErrorCallback));
+
+		CartRequestsQueue.Add(HttpRequest);
+		ProcessNextCartRequest();
+	}
+
+	for (int32 i = Cart.Items.Num() - 1; i >= 0; --i)
+	{
+		if (Cart.Items[i].sku == ItemSKU)
+		{
+			Cart.Items.RemoveAt(i);
+			break;
+		}
+	}
+
+	OnCartUpdate.Broadcast(Cart);
+}
+
+void UXsollaStoreSubsystem::ConsumeInventoryItem(const FString& AuthToken, const FString& ItemSKU, int32 Quantity, const FString& InstanceID, const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
+{
+	CachedAuthToken = AuthToken;
+
+	if (IsOfflineJournalEnabled())
+	{
+		FStoreOfflineAction Action;
+		Action.Type = EXsollaOfflineActionType::ConsumeItem;
+		Action.ItemSKU = ItemSKU;
+		Action.Quantity = Quantity;
+		Action.InstanceID = InstanceID;
+
+		FXsollaOfflineActionCallbacks Callbacks;
+		Callbacks.UpdateCallback = SuccessCallback;
+		Callbacks.ErrorCallback = ErrorCallback;
+
+		JournalOfflineAction(Action, AuthToken, Callbacks);
+		return;
+	}
+
+	TSharedRef<IHttpRequest> HttpRequest = CreateConsumeRequest(AuthToken, ItemSKU, Quantity, InstanceID);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, MakeConsumeHandler(SuccessCallback, ErrorCallback));
+
+	HttpRequest->ProcessRequest();
+}
+
+void UXsollaStoreSubsystem::QueueConsumeInventoryItem(const FString& AuthToken, const FString& ItemSKU, int32 Quantity, const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
+{
+	if (Quantity <= 0)
+	{
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Only positive quantity of countable item can be queued: %s (%d)"), *VA_FUNC_LINE, *ItemSKU, Quantity);
+		ErrorCallback.ExecuteIfBound(0, 0, TEXT("Only positive quantity of countable item can be queued"));
+		return;
+	}
+
+	CachedAuthToken = AuthToken;
+
+	// Calls with different tokens can't be aggregated, each token is sent with its own request
+	FXsollaConsumeBatch& Batch = ConsumeQueue.FindOrAdd(TPair<FString, FString>(ItemSKU, AuthToken));
+	Batch.AuthToken = AuthToken;
+	Batch.ItemSKU = ItemSKU;
+	Batch.Quantity += Quantity;
+	Batch.SuccessCallbacks.Add(SuccessCallback);
+	Batch.ErrorCallbacks.Add(ErrorCallback);
+
+	ApplyConsumeBatch(Batch, Quantity);
+	OnInventoryUpdate.Broadcast(Inventory);
+
+	ConsumeQueueStats.QueuedCalls++;
+
+	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
+	if (Settings->ConsumeQueueFlushInterval > 0.f && GetGameInstance())
+	{
+		FTimerManager& TimerManager = GetGameInstance()->GetTimerManager();
+		if (!TimerManager.IsTimerActive(ConsumeQueueTimerHandle))
+		{
+			TimerManager.SetTimer(ConsumeQueueTimerHandle, this, &UXsollaStoreSubsystem::FlushConsumeQueue, Settings->ConsumeQueueFlushInterval, false);
+		}
+	}
+}
+
+void UXsollaStoreSubsystem::FlushConsumeQueue()
+{
+	if (GetGameInstance())
+	{
+		GetGameInstance()->GetTimerManager().ClearTimer(ConsumeQueueTimerHandle);
+	}
+
+	if (ConsumeQueue.Num() == 0)
+	{
+		return;
+	}
+
+	// Inventory is changed by consumptions, so warm-up response is stale
+	FXsollaStoreWarmUpRequest WarmUpRequest;
+	if (WarmUpRequests.RemoveAndCopyValue(XsollaStoreEndpoints::Inventory.Name, WarmUpRequest) && WarmUpRequest.Consumer.IsBound())
+	{
+		UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Warm-up inventory is stale, requesting it again"), *VA_FUNC_LINE);
+
+		TSharedRef<IHttpRequest> HttpRequest = CreateEndpointRequest(XsollaStoreEndpoints::Inventory, {}, WarmUpRequest.AuthToken);
+		HttpRequest->OnProcessRequestComplete() = WarmUpRequest.Consumer;
+		HttpRequest->ProcessRequest();
+	}
+
+	const int32 FlushId = ++LastConsumeFlushId;
+	PendingConsumeFlushes.Add(FlushId, TPair<double, int32>(FPlatformTime::Seconds(), ConsumeQueue.Num()));
+
+	for (auto& QueueItem : ConsumeQueue)
+	{
+		const int32 BatchId = ++LastConsumeBatchId;
+
+		FXsollaConsumeBatch& Batch = ConsumeInFlight.Add(BatchId, MoveTemp(QueueItem.Value));
+		Batch.FlushId = FlushId;
+
+		UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Sending aggregated consumption: %s (%d) for %d call(s)"), *VA_FUNC_LINE, *Batch.ItemSKU, Batch.Quantity, Batch.SuccessCallbacks.Num());
+
+		if (IsOfflineJournalEnabled())
+		{
+			FStoreOfflineAction Action;
+			Action.Type = EXsollaOfflineActionType::ConsumeItem;
+			Action.ItemSKU = Batch.ItemSKU;
+			Action.Quantity = Batch.Quantity;
+
+			FXsollaOfflineActionCallbacks Callbacks;
+			Callbacks.ConsumeBatchId = BatchId;
+
+			JournalOfflineAction(Action, Batch.AuthToken, Callbacks);
+		}
+		else
+		{
+			TSharedRef<IHttpRequest> HttpRequest = CreateConsumeRequest(Batch.AuthToken, Batch.ItemSKU, Batch.Quantity, FString());
+			FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::ConsumeQueue_HttpRequestComplete, BatchId);
+			HttpRequest->ProcessRequest();
+		}
+
+		ConsumeQueueStats.SentRequests++;
+	}
+
+	ConsumeQueue.Empty();
+}
+
+void UXsollaStoreSubsystem::DiscardConsumeQueue()
+{
+	if (GetGameInstance())
+	{
+		GetGameInstance()->GetTimerManager().ClearTimer(ConsumeQueueTimerHandle);
+	}
+
+	for (auto& QueueItem : ConsumeQueue)
+	{
+		FXsollaConsumeBatch& Batch = QueueItem.Value;
+
+		if (IsOfflineJournalEnabled())
+		{
+			FStoreOfflineAction Action;
+			Action.Type = EXsollaOfflineActionType::ConsumeItem;
+			Action.ItemSKU = Batch.ItemSKU;
+			Action.Quantity = Batch.Quantity;
+
+			// Journal is replayed on next initialization
+			const FString ActionId = AppendOfflineAction(Action, Batch.AuthToken);
+			UE_LOG(LogXsollaStore, Log, TEXT("%s: Aggregated consumption is journaled on shutdown: %s (%d) as %s"), *VA_FUNC_LINE, *Batch.ItemSKU, Batch.Quantity, *ActionId);
+			continue;
+		}
+
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Aggregated consumption is dropped on shutdown: %s (%d)"), *VA_FUNC_LINE, *Batch.ItemSKU, Batch.Quantity);
+
+		RevertConsumeBatch(Batch);
+		for (const auto& ErrorCallback : Batch.ErrorCallbacks)
+		{
+			ErrorCallback.ExecuteIfBound(0, 0, TEXT("Consumption was dropped on shutdown"));
+		}
+	}
+
+	ConsumeQueue.Empty();
+}
+
+FStoreConsumeQueueStats UXsollaStoreSubsystem::GetConsumeQueueStats() const
+{
+	FStoreConsumeQueueStats Stats = ConsumeQueueStats;
+	Stats.QueueDepth = ConsumeQueue.Num();
+	Stats.PendingQuantity = 0;
+	for (const auto& QueueItem : ConsumeQueue)
+	{
+		Stats.PendingQuantity += QueueItem.Value.Quantity;
+	}
+	Stats.InFlightRequests = ConsumeInFlight.Num();
+
+	return Stats;
+}
+
+void UXsollaStoreSubsystem::GetVirtualCurrency(const FString& CurrencySKU, const FOnCurrencyUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
+{
+	auto OnResponse = [SuccessCallback](FVirtualCurrency& Currency) {
+		Currency.price.ParseAmounts();
+
+		SuccessCallback.ExecuteIfBound(Currency);
+	};
+
+	const auto& Endpoint = XsollaStoreEndpoints::VirtualCurrency;
+	SendEndpointRequest(Endpoint, {CurrencySKU}, FString(), Endpoint.MakeHandler(OnResponse, ErrorCallback));
+}
+
+void UXsollaStoreSubsystem::GetVirtualCurrencyPackage(const FString& PackageSKU, const FOnCurrencyPackageUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
+{
+	auto OnResponse = [SuccessCallback](FVirtualCurrencyPackage& CurrencyPackage) {
+		CurrencyPackage.price.ParseAmounts();
+
+		SuccessCallback.ExecuteIfBound(CurrencyPackage);
+	};
+
+	const auto& Endpoint = XsollaStoreEndpoints::VirtualCurrencyPackage;
+	SendEndpointRequest(Endpoint, {PackageSKU}, FString(), Endpoint.MakeHandler(OnResponse, ErrorCallback));
+}
+
+void UXsollaStoreSubsystem::BuyItemWithVirtualCurrency(const FString& AuthToken, const FString& ItemSKU, const FString& CurrencySKU, const FOnPurchaseUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
+{
+	CachedAuthToken = AuthToken;
+
+	if (IsOfflineJournalEnabled())
+	{
+		FStoreOfflineAction Action;
+		Action.Type = EXsollaOfflineActionType::BuyWithVirtualCurrency;
+		Action.ItemSKU = ItemSKU;
+		Action.CurrencySKU = CurrencySKU;
+
+		FXsollaOfflineActionCallbacks Callbacks;
+		Callbacks.PurchaseCallback = SuccessCallback;
+		Callbacks.ErrorCallback = ErrorCallback;
+
+		JournalOfflineAction(Action, AuthToken, Callbacks);
+		return;
+	}
+
+	TSharedRef<IHttpRequest> HttpRequest = CreateBuyItemWithVirtualCurrencyRequest(AuthToken, ItemSKU, CurrencySKU);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, MakePurchaseHandler(SuccessCallback, ErrorCallback));
+	HttpRequest->ProcessRequest();
+}
+
+TArray<FStoreOfflineAction> UXsollaStoreSubsystem::GetPendingOfflineActions() const
+{
+	TArray<FStoreOfflineAction> PendingActions;
+	if (OfflineJournal.IsValid())
+	{
+		for (const auto& Entry : OfflineJournal->GetEntries())
+		{
+			PendingActions.Add(Entry.Action);
+		}
+	}
+
+	return PendingActions;
+}
+
+void UXsollaStoreSubsystem::ReplayOfflineActions()
+{
+	if (GetGameInstance())
+	{
+		GetGameInstance()->GetTimerManager().ClearTimer(OfflineReplayTimerHandle);
+	}
+
+	ProcessOfflineJournal();
+}
+
+void UXsollaStoreSubsystem::Endpoint_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FXsollaStoreResponseHandler Handler)
+{
+	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, Handler.ErrorCallback))
+	{
+		if (Handler.HandleError)
+		{
+			Handler.HandleError();
+		}
+		return;
+	}
+
+	const FString ResponseStr = HttpResponse->GetContentAsString();
+	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
+
+	const FString ParseError = Handler.HandleResponse(ResponseStr);
+	if (!ParseError.IsEmpty())
+	{
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: %s"), *VA_FUNC_LINE, *ParseError);
+		Handler.ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, ParseError);
+
+		if (Handler.HandleError)
+		{
+			Handler.HandleError();
+		}
+	}
+}
+
+void UXsollaStoreSubsystem::PrefetchPaymentToken_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString PrefetchKey)
+{
+	int32 StatusCode;
+	int32 ErrorCode;
+	FString ErrorStr;
+	FString AccessToken;
+	int32 OrderId = 0;
+
+	bool bFailed = ParseRequestError(HttpRequest, HttpResponse, bSucceeded, StatusCode, ErrorCode, ErrorStr);
+	if (!bFailed)
+	{
+		TSharedPtr<FJsonObject> JsonObject;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
+		if (XSOLLA_TRACE_EXPRESSION(XsollaJsonParse, FJsonSerializer::Deserialize(Reader, JsonObject)))
+		{
+			AccessToken = JsonObject->GetStringField(TEXT("token"));
+			OrderId = JsonObject->GetNumberField(TEXT("order_id"));
+		}
+		else
+		{
+			UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
+
+			bFailed = true;
+			StatusCode = HttpResponse->GetResponseCode();
+			ErrorCode = 0;
+			ErrorStr = TEXT("Can't deserialize server response");
+		}
+	}
+
+	// Token was evicted or dropped while being fetched
+	FXsollaPrefetchedPaymentToken* PrefetchedToken = PrefetchedPaymentTokens.Find(PrefetchKey);
+	if (!PrefetchedToken)
+	{
+		if (!bFailed)
+		{
+			PaymentTokenPrefetchStats.WastedTokens++;
+		}
+		return;
+	}
+
+	if (bFailed)
+	{
+		PaymentTokenPrefetchStats.FailedPrefetches++;
+
+		const FXsollaPrefetchedPaymentToken FailedToken = *PrefetchedToken;
+		PrefetchedPaymentTokens.Remove(PrefetchKey);
+
+		if (!FailedToken.bHasWaitingPurchase)
+		{
+			return;
+		}
+
+		// Purchase shouldn't fail because of prefetch, so token is requested the same way as without it
+		UE_LOG(LogXsollaStore, Warning, TEXT("%s: Payment token prefetch failed, requesting it again for waiting purchase: %s"), *VA_FUNC_LINE, *FailedToken.ItemSKU);
+
+		TSharedPtr<IHttpRequest> FallbackRequest = CreateFetchPaymentTokenRequest(XsollaStoreEndpoints::ItemPaymentToken, {FailedToken.ItemSKU}, FailedToken.AuthToken, FailedToken.Currency, FailedToken.Country, FailedToken.Locale, FailedToken.WaitingErrorCallback);
+		if (!FallbackRequest.IsValid())
+		{
+			return;
+		}
+
+		FXsollaHttpTelemetry::BindHandler(FallbackRequest, this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, MakePaymentTokenHandler(FailedToken.WaitingSuccessCallback, FailedToken.WaitingErrorCallback));
+		FallbackRequest->ProcessRequest();
+		return;
+	}
+
+	if (PrefetchedToken->bHasWaitingPurchase)
+	{
+		const FOnFetchTokenSuccess WaitingSuccessCallback = PrefetchedToken->WaitingSuccessCallback;
+		PrefetchedPaymentTokens.Remove(PrefetchKey);
+
+		PaymentOrderId = OrderId;
+
+		WaitingSuccessCallback.ExecuteIfBound(AccessToken, OrderId);
+		return;
+	}
+
+	PrefetchedToken->AccessToken = AccessToken;
+	PrefetchedToken->OrderId = OrderId;
+	PrefetchedToken->FetchTime = FPlatformTime::Seconds();
+}
+
+void UXsollaStoreSubsystem::WarmUp_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString WarmUpKey)
+{
+	// Request could be dropped while being sent (cart was changed, for example)
+	FXsollaStoreWarmUpRequest* WarmUpRequest = WarmUpRequests.Find(WarmUpKey);
+	if (!WarmUpRequest || WarmUpRequest->HttpRequest != HttpRequest)
+	{
+		return;
+	}
+
+	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Warm-up request %s finished in %.0f ms"), *VA_FUNC_LINE, *WarmUpKey, (FPlatformTime::Seconds() - WarmUpRequest->StartTime) * 1000.0);
+
+	if (WarmUpRequest->Consumer.IsBound())
+	{
+		const FHttpRequestCompleteDelegate Consumer = WarmUpRequest->Consumer;
+		WarmUpRequests.Remove(WarmUpKey);
+
+		Consumer.ExecuteIfBound(HttpRequest, HttpResponse, bSucceeded);
+		return;
+	}
+
+	// Failed request is repeated by consumer
+	if (!bSucceeded || !HttpResponse.IsValid() || !EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
+	{
+		WarmUpRequests.Remove(WarmUpKey);
+		return;
+	}
+
+	WarmUpRequest->bCompleted = true;
+	WarmUpRequest->HttpResponse = HttpResponse;
+	WarmUpRequest->bSucceeded = bSucceeded;
+}
+
+void UXsollaStoreSubsystem::ConsumeQueue_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, int32 BatchId)
+{
+	int32 StatusCode;
+	int32 ErrorCode;
+	FString ErrorStr;
+	const bool bFailed = ParseRequestError(HttpRequest, HttpResponse, bSucceeded, StatusCode, ErrorCode, ErrorStr);
+	if (!bFailed)
+	{
+		FString ResponseStr = HttpResponse->GetContentAsString();
+		UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
+	}
+
+	CompleteConsumeBatch(BatchId, bFailed, StatusCode, ErrorCode, ErrorStr);
+}
+
+void UXsollaStoreSubsystem::CompleteConsumeBatch(int32 BatchId, bool bFailed, int32 StatusCode, int32 ErrorCode, const FString& ErrorStr)
+{
+	FXsollaConsumeBatch Batch;
+	if (!ConsumeInFlight.RemoveAndCopyValue(BatchId, Batch))
+	{
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't find consume batch: %d"), *VA_FUNC_LINE, BatchId);
+		return;
+	}
+
+	// Update flush latency metrics when the last request of flush is answered
+	if (auto PendingFlush = PendingConsumeFlushes.Find(Batch.FlushId))
+	{
+		if (--PendingFlush->Value <= 0)
+		{
+			const float FlushLatency = FPlatformTime::Seconds() - PendingFlush->Key;
+			PendingConsumeFlushes.Remove(Batch.FlushId);
+
+			ConsumeQueueStats.LastFlushLatency = FlushLatency;
+			ConsumeQueueStats.AverageFlushLatency = (ConsumeQueueStats.AverageFlushLatency * ConsumeQueueStats.CompletedFlushes + FlushLatency) / (ConsumeQueueStats.CompletedFlushes + 1);
+			ConsumeQueueStats.CompletedFlushes++;
+		}
+	}
+
+	if (bFailed)
+	{
+		// Server rejected consumption, so restore local inventory state
+		RevertConsumeBatch(Batch);
+		OnInventoryUpdate.Broadcast(Inventory);
+	}
+
+	// Optimistic values are replaced with server state, inventory received while batch was in flight could miss it
+	ReconcileInventory(Batch.AuthToken);
+
+	if (bFailed)
+	{
+		for (const auto& ErrorCallback : Batch.ErrorCallbacks)
+		{
+			ErrorCallback.ExecuteIfBound(StatusCode, ErrorCode, ErrorStr);
+		}
+		return;
+	}
+
+	for (const auto& SuccessCallback : Batch.SuccessCallbacks)
+	{
+		SuccessCallback.ExecuteIfBound();
+	}
+}
+
+void UXsollaStoreSubsystem::OfflineAction_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString ActionId)
+{
+	bOfflineActionInProgress = false;
+	OfflineCartRequest.Reset();
+
+	const FXsollaOfflineJournalEntry* Entry = OfflineJournal.IsValid() ? OfflineJournal->FindEntry(ActionId) : nullptr;
+	if (!Entry)
+	{
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't find journaled action: %s"), *VA_FUNC_LINE, *ActionId);
+		ProcessNextCartRequest();
+		return;
+	}
+
+	const EXsollaOfflineActionType ActionType = Entry->Action.Type;
+	const bool bCartAction = IsCartOfflineAction(ActionType);
+	const FString AuthToken = GetOfflineActionAuthToken(Entry->UserId);
+
+	// Request didn't leave the client, so it's the only case action can be sent again as is
+	if (HttpRequest->GetStatus() == EHttpRequestStatus::Failed_ConnectionError)
+	{
+		UE_LOG(LogXsollaStore, Warning, TEXT("%s: Journaled action wasn't delivered (no connection), will retry later: %s"), *VA_FUNC_LINE, *ActionId);
+
+		OfflineJournal->MarkNotSent(ActionId);
+
+		if (bCartAction)
+		{
+			ProcessNextCartRequest();
+		}
+
+		ScheduleOfflineReplay();
+
+		OnOfflineActionsUpdate.Broadcast(GetPendingOfflineActions());
+		return;
+	}
+
+	// Server could apply action even if it answered with server error or response was lost, and Store API doesn't
+	// deduplicate requests. Cart change is checked against server cart, other actions fail and their state is requested again.
+	const int32 ResponseCode = HttpResponse.IsValid() ? HttpResponse->GetResponseCode() : 0;
+	const bool bResultUnknown = !bSucceeded || !HttpResponse.IsValid() || ResponseCode >= EHttpResponseCodes::ServerError;
+	if (bResultUnknown && bCartAction)
+	{
+		UE_LOG(LogXsollaStore, Warning, TEXT("%s: Result of journaled cart action is unknown (code %d), checking server cart: %s"), *VA_FUNC_LINE, ResponseCode, *ActionId);
+
+		ReconcileOfflineAction(ActionId, AuthToken);
+		return;
+	}
+
+	if (!bResultUnknown)
+	{
+		FailedOfflineReplays = 0;
+	}
+
+	OfflineJournal->Acknowledge(ActionId);
+
+	FXsollaOfflineActionCallbacks Callbacks;
+	OfflineActionCallbacks.RemoveAndCopyValue(ActionId, Callbacks);
+
+	switch (ActionType)
+	{
+	case EXsollaOfflineActionType::ConsumeItem:
+		if (Callbacks.ConsumeBatchId != INDEX_NONE)
+		{
+			ConsumeQueue_HttpRequestComplete(HttpRequest, HttpResponse, bSucceeded, Callbacks.ConsumeBatchId);
+		}
+		else
+		{
+			Endpoint_HttpRequestComplete(HttpRequest, HttpResponse, bSucceeded, MakeConsumeHandler(Callbacks.UpdateCallback, Callbacks.ErrorCallback));
+		}
+		break;
+
+	case EXsollaOfflineActionType::BuyWithVirtualCurrency:
+		Endpoint_HttpRequestComplete(HttpRequest, HttpResponse, bSucceeded, MakePurchaseHandler(Callbacks.PurchaseCallback, Callbacks.ErrorCallback));
+		break;
+
+	case EXsollaOfflineActionType::AddToCart:
+	case EXsollaOfflineActionType::RemoveFromCart:
+		Endpoint_HttpRequestComplete(HttpRequest, HttpResponse, bSucceeded, MakeCartItemHandler(Callbacks.CartUpdateCallback, Callbacks.ErrorCallback));
+		break;
+
+	case EXsollaOfflineActionType::ClearCart:
+		Endpoint_HttpRequestComplete(HttpRequest, HttpResponse, bSucceeded, MakeClearCartHandler(Callbacks.CartUpdateCallback, Callbacks.ErrorCallback));
+		break;
+
+	default:
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Unknown journaled action type %d: %s"), *VA_FUNC_LINE, static_cast<int32>(ActionType), *ActionId);
+		Callbacks.ErrorCallback.ExecuteIfBound(0, 0, TEXT("Unknown journaled action type"));
+	}
+
+	// Consume batch reconciles inventory itself
+	if (bResultUnknown && Callbacks.ConsumeBatchId == INDEX_NONE)
+	{
+		ResyncOfflineActionState(ActionType, AuthToken);
+	}
+
+	OnOfflineActionsUpdate.Broadcast(GetPendingOfflineActions());
+
+	ProcessOfflineJournal();
+}
+
+bool UXsollaStoreSubsystem::HandleRequestError(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreError ErrorCallback)
+{
+	int32 StatusCode;
+	int32 ErrorCode;
+	FString ErrorStr;
+	if (ParseRequestError(HttpRequest, HttpResponse, bSucceeded, StatusCode, ErrorCode, ErrorStr))
+	{
+		ErrorCallback.ExecuteIfBound(StatusCode, ErrorCode, ErrorStr);
+		return true;
+	}
+
+	return false;
+}
+
+bool UXsollaStoreSubsystem::ParseRequestError(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, int32& OutStatusCode, int32& OutErrorCode, FString& OutErrorStr)
+{
+	FString ErrorStr;
+	int32 ErrorCode = 0;
+	int32 StatusCode = 204;
+	FString ResponseStr = TEXT("invalid");
+
+	if (bSucceeded && HttpResponse.IsValid())
+	{
+		ResponseStr = HttpResponse->GetContentAsString();
+
+		if (!EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
+		{
+			StatusCode = HttpResponse->GetResponseCode();
+			ErrorStr = FString::Printf(TEXT("Invalid response. code=%d error=%s"), HttpResponse->GetResponseCode(), *ResponseStr);
+
+			// Example: {"statusCode":403,"errorCode":0,"errorMessage":"Token not found"}
+			TSharedPtr<FJsonObject> JsonObject;
+			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*ResponseStr);
+			if (XSOLLA_TRACE_EXPRESSION(XsollaJsonParse, FJsonSerializer::Deserialize(Reader, JsonObject)))
+			{
+				static const FString ErrorFieldName = TEXT("errorMessage");
+				if (JsonObject->HasTypedField<EJson::String>(ErrorFieldName))
+				{
+					StatusCode = JsonObject->GetNumberField(TEXT("statusCode"));
+					ErrorCode = JsonObject->GetNumberField(TEXT("errorCode"));
+					ErrorStr = JsonObject->GetStringField(ErrorFieldName);
+				}
+				else
+				{
+					ErrorStr = FString::Printf(TEXT("Can't deserialize error json: no field '%s' found"), *ErrorFieldName);
+				}
+			}
+			else
+			{
+				ErrorStr = TEXT("Can't deserialize error json");
+			}
+		}
+	}
+	else
+	{
+		ErrorStr = TEXT("No response");
+	}
+
+	OutStatusCode = StatusCode;
+	OutErrorCode = ErrorCode;
+	OutErrorStr = ErrorStr;
+
+	if (!ErrorStr.IsEmpty())
+	{
+		UE_LOG(LogXsollaStore, Warning, TEXT("%s: request failed (%s): %s"), *VA_FUNC_LINE, *ErrorStr, *ResponseStr);
+		return true;
+	}
+
+	return false;
+}
+
+void UXsollaStoreSubsystem::LoadData()
+{
+	// Slot is read once, save object in memory is the actual data afterwards
+	if (!SaveInstance)
+	{
+		SaveInstance = UXsollaStoreSave::LoadOrCreate();
+	}
+
+	const FXsollaStoreSaveData& CartData = SaveInstance->GetCartData();
+
+	CachedCartCurrency = CartData.CartCurrency;
+	Cart.cart_id = CartData.CartId;
+
+	OnCartUpdate.Broadcast(Cart);
+}
+
+void UXsollaStoreSubsystem::SaveData()
+{
+	const FXsollaStoreSaveData CartData(Cart.cart_id, CachedCartCurrency);
+
+	if (!SaveInstance || !SaveWriter.IsValid())
+	{
+		UXsollaStoreSave::Save(CartData);
+		return;
+	}
+
+	SaveInstance->SetCartData(CartData);
+	SaveWriter->Save(SaveInstance);
+}
+
+bool UXsollaStoreSubsystem::IsSandboxEnabled() const
+{
+	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
+	bool bIsSandboxEnabled = Settings->EnableSandbox;
+
+#if UE_BUILD_SHIPPING
+	bIsSandboxEnabled = Settings->EnableSandbox && Settings->EnableSandboxInShippingBuild;
+	if (bIsSandboxEnabled)
+	{
+		UE_LOG(LogXsollaStore, Warning, TEXT("%s: Sandbox should be disabled in Shipping build"), *VA_FUNC_LINE);
+	}
+#endif // UE_BUILD_SHIPPING
+
+	return bIsSandboxEnabled;
+}
+
+TSharedRef<IHttpRequest> UXsollaStoreSubsystem::CreateHttpRequest(const FString& Url, const EXsollaRequestVerb Verb, const FString& AuthToken, const FString& Content)
+{
+	TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
+
+	// Temporal solution with headers processing on server-side #37
+	const FString MetaUrl = FString::Printf(TEXT("%sengine=ue4&engine_v=%s&sdk=store&sdk_v=%s"),
+		Url.Contains(TEXT("?")) ? TEXT("&") : TEXT("?"),
+		ENGINE_VERSION_STRING,
+		XSOLLA_STORE_VERSION);
+	HttpRequest->SetURL(FXsollaUtilsUrlOverrides::Apply(Url) + MetaUrl);
+
+	// Xsolla meta
+	HttpRequest->SetHeader(TEXT("X-ENGINE"), TEXT("UE4"));
+	HttpRequest->SetHeader(TEXT("X-ENGINE-V"), ENGINE_VERSION_STRING);
+	HttpRequest->SetHeader(TEXT("X-SDK"), TEXT("STORE"));
+	HttpRequest->SetHeader(TEXT("X-SDK-V"), XSOLLA_STORE_VERSION);
+
+	switch (Verb)
+	{
+	case EXsollaRequestVerb::GET:
+		HttpRequest->SetVerb(TEXT("GET"));
+
+		// Check that we doen't provide content with GET request
+		if (!Content.IsEmpty())
+		{
+			UE_LOG(LogXsollaStore, Warning, TEXT("%s: Request content is not empty for GET request. Maybe you should use POST one?"), *VA_FUNC_LINE);
+		}
+		break;
+
+	case EXsollaRequestVerb::POST:
+		HttpRequest->SetVerb(TEXT("POST"));
+		break;
+
+	case EXsollaRequestVerb::PUT:
+		HttpRequest->SetVerb(TEXT("PUT"));
+		break;
+
+	case EXsollaRequestVerb::DELETE:
+		HttpRequest->SetVerb(TEXT("DELETE"));
+		break;
+
+	default:
+		unimplemented();
+	}
+
+	if (!AuthToken.IsEmpty())
+	{
+		HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *GetActualAuthToken(AuthToken)));
+	}
+
+	if (!Content.IsEmpty())
+	{
+		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+		HttpRequest->SetContentAsString(Content);
+	}
+
+	FXsollaHttpTelemetry::Get().TrackRequest(HttpRequest);
+
+	return HttpRequest;
+}
+
+TSharedPtr<IHttpRequest> UXsollaStoreSubsystem::CreateFetchPaymentTokenRequest(const FXsollaStoreEndpoint& Endpoint, const FStringFormatOrderedArguments& Args, const FString& AuthToken, const FString& Currency, const FString& Country, const FString& Locale, const FOnStoreError& ErrorCallback)
+{
+	// Prepare request payload
+	TSharedPtr<FJsonObject> RequestDataJson = MakeShareable(new FJsonObject);
+	if (!Currency.IsEmpty())
+		RequestDataJson->SetStringField(TEXT("currency"), Currency);
+	if (!Country.IsEmpty())
+		RequestDataJson->SetStringField(TEXT("country"), Country);
+	if (!Locale.IsEmpty())
+		RequestDataJson->SetStringField(TEXT("locale"), Locale);
+
+	RequestDataJson->SetBoolField(TEXT("sandbox"), IsSandboxEnabled());
+
+	FString theme;
+
+	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
+	switch (Settings->PaymentInterfaceTheme)
+	{
+	case EXsollaPaymentUiTheme::Default:
+		theme = TEXT("default");
+		break;
+
+	case EXsollaPaymentUiTheme::DefaultDark:
+		theme = TEXT("default_dark");
+		break;
+
+	case EXsollaPaymentUiTheme::Dark:
+		theme = TEXT("dark");
+		break;
+
+	default:
+		theme = TEXT("dark");
+	}
+
+	TSharedPtr<FJsonObject> PaymentUiSettingsJson = MakeShareable(new FJsonObject);
+	PaymentUiSettingsJson->SetStringField(TEXT("theme"), theme);
+
+	TSharedPtr<FJsonObject> PaymentSettingsJson = MakeShareable(new FJsonObject);
+	PaymentSettingsJson->SetObjectField(TEXT("ui"), PaymentUiSettingsJson);
+
+	RequestDataJson->SetObjectField(TEXT("settings"), PaymentSettingsJson);
+
+	TSharedRef<IHttpRequest> HttpRequest = CreateEndpointRequest(Endpoint, Args, AuthToken, SerializeJson(RequestDataJson));
+
+	if (Settings->BuildForSteam)
+	{
+		const FXsollaJwtClaimsPtr Claims = FXsollaUtilsTokenParser::GetClaims(AuthToken);
+		if (!Claims.IsValid())
+		{
+			UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't parse token payload"), *VA_FUNC_LINE);
+			ErrorCallback.ExecuteIfBound(0, 0, TEXT("Can't parse token payload"));
+			return nullptr;
+		}
+
+		FString SteamIdUrl;
+		if (!Claims->TryGetClaim(TEXT("id"), SteamIdUrl))
+		{
+			UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't find Steam profile ID in token payload"), *VA_FUNC_LINE);
+			ErrorCallback.ExecuteIfBound(0, 0, TEXT("Can't find Steam profile ID in token payload"));
+			return nullptr;
+		}
+
+		// Extract ID value from user's Steam profile URL
+		FString SteamId;
+		int SteamIdIndex;
+		if (SteamIdUrl.FindLastChar('/', SteamIdIndex))
+		{
+			SteamId = SteamIdUrl.RightChop(SteamIdIndex + 1);
+		}
+
+		HttpRequest->SetHeader(TEXT("x-steam-userid"), SteamId);
+	}
+
+	return HttpRequest;
+}
+
+FString UXsollaStoreSubsystem::GetPaymentTokenPrefetchKey(const FString& AuthToken, const FString& ItemSKU, const FString& Currency, const FString& Country, const FString& Locale) const
+{
+	// Token is issued for user, so auth token is a part of the key
+	return FString::Printf(TEXT("%s|%s|%s|%s|%s"), *ItemSKU, *Currency, *Country, *Locale, *AuthToken);
+}
+
+bool UXsollaStoreSubsystem::TakePrefetchedPaymentToken(const FString& PrefetchKey, const FOnFetchTokenSuccess& SuccessCallback, const FOnStoreError& ErrorCallback)
+{
+	RemoveExpiredPaymentTokens();
+
+	FXsollaPrefetchedPaymentToken* PrefetchedToken = PrefetchedPaymentTokens.Find(PrefetchKey);
+	if (!PrefetchedToken || PrefetchedToken->bHasWaitingPurchase)
+	{
+		PaymentTokenPrefetchStats.Misses++;
+		return false;
 	}
-	else
-	{
-		auto StoreItem = ItemsData.Items.FindByPredicate([ItemSKU](const FStoreItem& InItem) {
-			return InItem.sku == ItemSKU;
-		});
 
-		if (StoreItem)
-		{
-			FStoreCartItem Item(*StoreItem);
-			Item.quantity = FMath::Max(0, Quantity);
+	PaymentTokenPrefetchStats.Hits++;
 
-			// @TODO Predict price locally before cart sync https://github.com/xsolla/store-ue4-sdk/issues/68
+	// Purchase is completed when token is fetched
+	if (PrefetchedToken->AccessToken.IsEmpty())
+	{
+		PrefetchedToken->bHasWaitingPurchase = true;
+		PrefetchedToken->WaitingSuccessCallback = SuccessCallback;
+		PrefetchedToken->WaitingErrorCallback = ErrorCallback;
+		return true;
+	}
 
-			Cart.Items.Add(Item);
-		}
-		else
-		{
-			auto CurrencyPackageItem = VirtualCurrencyPackages.Items.FindByPredicate([ItemSKU](const FVirtualCurrencyPackage& InItem) {
-				return InItem.sku == ItemSKU;
-			});
+	// Token is bound to its order, so it's used once
+	const FString AccessToken = PrefetchedToken->AccessToken;
+	const int32 OrderId = PrefetchedToken->OrderId;
+	PrefetchedPaymentTokens.Remove(PrefetchKey);
 
-			if (CurrencyPackageItem)
-			{
-				FStoreCartItem Item(*CurrencyPackageItem);
-				Item.quantity = FMath::Max(0, Quantity);
+	PaymentOrderId = OrderId;
 
-				Cart.Items.Add(Item);
-			}
-			else
-			{
-				UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't find provided SKU in local cache: %s"), *VA_FUNC_LINE, *ItemSKU);
-			}
-		}
-	}
+	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Using prefetched payment token of order %d"), *VA_FUNC_LINE, OrderId);
 
-	OnCartUpdate.Broadcast(Cart);
+	SuccessCallback.ExecuteIfBound(AccessToken, OrderId);
+	return true;
 }
 
-void UXsollaStoreSubsystem::RemoveFromCart(const FString& AuthToken, const FString& CartId, const FString& ItemSKU, const FOnStoreCartUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
+void UXsollaStoreSubsystem::RemoveExpiredPaymentTokens()
 {
-	CachedAuthToken = AuthToken;
-	CachedCartId = CartId;
+	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
+	const double Now = FPlatformTime::Seconds();
 
-	FString Url;
-	if (CartId.IsEmpty())
+	for (auto It = PrefetchedPaymentTokens.CreateIterator(); It; ++It)
 	{
-		Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/cart/item/%s"), *ProjectID, *ItemSKU);
-	}
-	else
-	{
-		Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/cart/%s/item/%s"), *ProjectID, *Cart.cart_id, *ItemSKU);
+		// Tokens being fetched expire after they are received
+		if (!It->Value.AccessToken.IsEmpty() && Now - It->Value.FetchTime > Settings->PaymentTokenPrefetchTTL)
+		{
+			PaymentTokenPrefetchStats.WastedTokens++;
+			It.RemoveCurrent();
+		}
 	}
+}
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::DELETE, AuthToken);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::RemoveFromCart_HttpRequestComplete, SuccessCallback, ErrorCallback);
-
-	CartRequestsQueue.Add(HttpRequest);
-	ProcessNextCartRequest();
+FString UXsollaStoreSubsystem::GetEndpointUrl(const FXsollaStoreEndpoint& Endpoint, const FStringFormatOrderedArguments& Args)
+{
+	FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/"), *ProjectID) + FString::Format(Endpoint.PathTemplate, Args);
 
-	for (int32 i = Cart.Items.Num() - 1; i >= 0; --i)
+	if (Endpoint.bPlatformQuery)
 	{
-		if (Cart.Items[i].sku == ItemSKU)
+		const FString Platform = GetPublishingPlatformName();
+		if (!Platform.IsEmpty())
 		{
-			Cart.Items.RemoveAt(i);
-			break;
+			Url += FString::Printf(TEXT("%splatform=%s"), Url.Contains(TEXT("?")) ? TEXT("&") : TEXT("?"), *Platform);
 		}
 	}
 
-	OnCartUpdate.Broadcast(Cart);
+	return Url;
 }
 
-void UXsollaStoreSubsystem::ConsumeInventoryItem(const FString& AuthToken, const FString& ItemSKU, int32 Quantity, const FString& InstanceID, const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
+TSharedRef<IHttpRequest> UXsollaStoreSubsystem::CreateEndpointRequest(const FXsollaStoreEndpoint& Endpoint, const FStringFormatOrderedArguments& Args, const FString& AuthToken, const FString& Content)
 {
-	CachedAuthToken = AuthToken;
+	return CreateHttpRequest(GetEndpointUrl(Endpoint, Args), Endpoint.Verb, Endpoint.bUserAuth ? AuthToken : FString(), Content);
+}
 
-	// Prepare request payload
-	TSharedPtr<FJsonObject> RequestDataJson = MakeShareable(new FJsonObject);
-	RequestDataJson->SetStringField(TEXT("sku"), ItemSKU);
+void UXsollaStoreSubsystem::SendEndpointRequest(const FXsollaStoreEndpoint& Endpoint, const FStringFormatOrderedArguments& Args, const FString& AuthToken, const FXsollaStoreResponseHandler& Handler, const FString& Content)
+{
+	const FHttpRequestCompleteDelegate OnComplete = FXsollaHttpTelemetry::WrapHandler(FHttpRequestCompleteDelegate::CreateUObject(this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, Handler));
 
-	if (Quantity == 0)
-	{
-		RequestDataJson->SetObjectField(TEXT("quantity"), nullptr);
-	}
-	else
+	if (Endpoint.Cache == EXsollaStoreEndpointCache::WarmUp && TakeWarmUpRequest(Endpoint, AuthToken, OnComplete))
 	{
-		RequestDataJson->SetNumberField(TEXT("quantity"), Quantity);
+		return;
 	}
 
-	if (InstanceID.IsEmpty())
-	{
-		RequestDataJson->SetObjectField(TEXT("instance_id"), nullptr);
-	}
-	else
-	{
-		RequestDataJson->SetStringField(TEXT("instance_id"), InstanceID);
-	}
+	TSharedRef<IHttpRequest> HttpRequest = CreateEndpointRequest(Endpoint, Args, AuthToken, Content);
+	HttpRequest->OnProcessRequestComplete() = OnComplete;
+	HttpRequest->ProcessRequest();
+}
 
-	FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/user/inventory/item/consume"), *ProjectID);
+FXsollaStoreResponseHandler UXsollaStoreSubsystem::MakePaymentTokenHandler(const FOnFetchTokenSuccess& SuccessCallback, const FOnStoreError& ErrorCallback)
+{
+	auto OnResponse = [this, SuccessCallback](TSharedPtr<FJsonObject>& JsonObject) {
+		const FString AccessToken = JsonObject->GetStringField(TEXT("token"));
+		const int32 OrderId = JsonObject->GetNumberField(TEXT("order_id"));
 
-	const FString Platform = GetPublishingPlatformName();
-	if (!Platform.IsEmpty())
-	{
-		Url += FString::Printf(TEXT("%splatform=%s"), Url.Contains(TEXT("?")) ? TEXT("&") : TEXT("?"), *Platform);
-	}
+		PaymentOrderId = OrderId;
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::POST, AuthToken, SerializeJson(RequestDataJson));
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::ConsumeInventoryItem_HttpRequestComplete, SuccessCallback, ErrorCallback);
+		SuccessCallback.ExecuteIfBound(AccessToken, OrderId);
+	};
 
-	HttpRequest->ProcessRequest();
+	return XsollaStoreEndpoints::ItemPaymentToken.MakeHandler(OnResponse, ErrorCallback);
 }
 
-void UXsollaStoreSubsystem::GetVirtualCurrency(const FString& CurrencySKU, const FOnCurrencyUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
+FXsollaStoreResponseHandler UXsollaStoreSubsystem::MakePurchaseHandler(const FOnPurchaseUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
 {
-	const FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/items/virtual_currency/sku/%s"), *ProjectID, *CurrencySKU);
+	auto OnResponse = [SuccessCallback](TSharedPtr<FJsonObject>& JsonObject) {
+		SuccessCallback.ExecuteIfBound(JsonObject->GetNumberField(TEXT("order_id")));
+	};
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::GET);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::GetVirtualCurrency_HttpRequestComplete, SuccessCallback, ErrorCallback);
-	HttpRequest->ProcessRequest();
+	return XsollaStoreEndpoints::BuyWithVirtualCurrency.MakeHandler(OnResponse, ErrorCallback);
 }
 
-void UXsollaStoreSubsystem::GetVirtualCurrencyPackage(const FString& PackageSKU, const FOnCurrencyPackageUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
+FXsollaStoreResponseHandler UXsollaStoreSubsystem::MakeConsumeHandler(const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
 {
-	const FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/items/virtual_currency/package/sku/%s"), *ProjectID, *PackageSKU);
+	auto OnResponse = [SuccessCallback](FXsollaStoreNoContent&) {
+		SuccessCallback.ExecuteIfBound();
+	};
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::GET);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::GetVirtualCurrencyPackage_HttpRequestComplete, SuccessCallback, ErrorCallback);
-	HttpRequest->ProcessRequest();
+	return XsollaStoreEndpoints::ConsumeItem.MakeHandler(OnResponse, ErrorCallback);
 }
 
-void UXsollaStoreSubsystem::BuyItemWithVirtualCurrency(const FString& AuthToken, const FString& ItemSKU, const FString& CurrencySKU, const FOnPurchaseUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
+FXsollaStoreResponseHandler UXsollaStoreSubsystem::MakeCartItemHandler(const FOnStoreCartUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
 {
-	CachedAuthToken = AuthToken;
+	auto OnResponse = [this, SuccessCallback](FXsollaStoreNoContent&) {
+		SuccessCallback.ExecuteIfBound();
 
-	FString Url = FString::Printf(TEXT("https://store.xsolla.com/api/v2/project/%s/payment/item/%s/virtual/%s"), *ProjectID, *ItemSKU, *CurrencySKU);
+		ProcessNextCartRequest();
+	};
 
-	const FString Platform = GetPublishingPlatformName();
-	if (!Platform.IsEmpty())
-	{
-		Url += FString::Printf(TEXT("%splatform=%s"), Url.Contains(TEXT("?")) ? TEXT("&") : TEXT("?"), *Platform);
-	}
+	// Local cart is already changed, so it's synced with server if change is rejected
+	auto OnError = [this, SuccessCallback, ErrorCallback]() {
+		UpdateCart(CachedAuthToken, CachedCartId, SuccessCallback, ErrorCallback);
+	};
 
-	TSharedRef<IHttpRequest> HttpRequest = CreateHttpRequest(Url, EXsollaRequestVerb::POST, AuthToken);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UXsollaStoreSubsystem::BuyItemWithVirtualCurrency_HttpRequestComplete, SuccessCallback, ErrorCallback);
-	HttpRequest->ProcessRequest();
+	return XsollaStoreEndpoints::CartItem.MakeHandler(OnResponse, ErrorCallback, OnError);
 }
 
-void UXsollaStoreSubsystem::UpdateVirtualItems_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback)
+FXsollaStoreResponseHandler UXsollaStoreSubsystem::MakeClearCartHandler(const FOnStoreCartUpdate& SuccessCallback, const FOnStoreError& ErrorCallback)
 {
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
-	{
-		return;
-	}
+	auto OnResponse = [this, SuccessCallback](FXsollaStoreNoContent&) {
+		SuccessCallback.ExecuteIfBound();
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
-	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
-		return;
-	}
+		ProcessNextCartRequest();
+	};
+
+	return XsollaStoreEndpoints::ClearCart.MakeHandler(OnResponse, ErrorCallback, [this]() {
+		ProcessNextCartRequest();
+	});
+}
+
+void UXsollaStoreSubsystem::StartWarmUpRequest(const FXsollaStoreEndpoint& Endpoint, const FString& AuthToken)
+{
+	const FString WarmUpKey = Endpoint.Name;
 
-	if (!FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), FStoreItemsData::StaticStruct(), &ItemsData))
+	// Same data is being requested already
+	const FXsollaStoreWarmUpRequest* ExistingRequest = WarmUpRequests.Find(WarmUpKey);
+	if (ExistingRequest && ExistingRequest->AuthToken == AuthToken && !ExistingRequest->bCompleted)
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't convert server response to struct"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't convert server response to struct"));
 		return;
 	}
 
-	// Update categories now
-	for (auto& Item : ItemsData.Items)
-	{
-		for (auto& ItemGroup : Item.groups)
-		{
-			ItemsData.GroupIds.Add(ItemGroup.external_id);
-		}
-	}
+	TSharedRef<IHttpRequest> HttpRequest = CreateEndpointRequest(Endpoint, {}, AuthToken);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::WarmUp_HttpRequestComplete, WarmUpKey);
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
+	FXsollaStoreWarmUpRequest WarmUpRequest;
+	WarmUpRequest.AuthToken = AuthToken;
+	WarmUpRequest.StartTime = FPlatformTime::Seconds();
+	WarmUpRequest.HttpRequest = HttpRequest;
+	WarmUpRequests.Add(WarmUpKey, WarmUpRequest);
 
-	SuccessCallback.ExecuteIfBound();
+	HttpRequest->ProcessRequest();
 }
 
-void UXsollaStoreSubsystem::UpdateItemGroups_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback)
+bool UXsollaStoreSubsystem::TakeWarmUpRequest(const FXsollaStoreEndpoint& Endpoint, const FString& AuthToken, const FHttpRequestCompleteDelegate& Consumer)
 {
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
+	const FString WarmUpKey = Endpoint.Name;
+
+	FXsollaStoreWarmUpRequest* WarmUpRequest = WarmUpRequests.Find(WarmUpKey);
+	if (!WarmUpRequest)
 	{
-		return;
+		return false;
 	}
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+	if (WarmUpRequest->AuthToken != AuthToken || WarmUpRequest->Consumer.IsBound())
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
-		return;
+		return false;
 	}
 
-	// Deserialize to new object
-	FStoreItemsData GroupsData;
-	if (!FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), FStoreItemsData::StaticStruct(), &GroupsData))
+	if (!WarmUpRequest->bCompleted)
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't convert server response to struct"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't convert server response to struct"));
-		return;
+		UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Waiting for warm-up request %s"), *VA_FUNC_LINE, *WarmUpKey);
+
+		WarmUpRequest->Consumer = Consumer;
+		return true;
 	}
 
-	// Cache data as it should now
-	ItemsData.Groups = GroupsData.Groups;
+	const FXsollaStoreWarmUpRequest CompletedRequest = *WarmUpRequest;
+	WarmUpRequests.Remove(WarmUpKey);
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
+	if (FPlatformTime::Seconds() - CompletedRequest.StartTime > XsollaStoreWarmUp::ResponseLifetime)
+	{
+		return false;
+	}
+
+	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Using warm-up response %s"), *VA_FUNC_LINE, *WarmUpKey);
 
-	SuccessCallback.ExecuteIfBound();
+	Consumer.ExecuteIfBound(CompletedRequest.HttpRequest, CompletedRequest.HttpResponse, CompletedRequest.bSucceeded);
+	return true;
 }
 
-void UXsollaStoreSubsystem::UpdateInventory_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback)
+void UXsollaStoreSubsystem::HandleAuthTokenReceived(const UObject* InGameInstance, const FString& Token)
 {
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
+	if (InGameInstance != GetGameInstance())
 	{
 		return;
 	}
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+	// Journaled actions are replayed with token of current login
+	if (IsOfflineJournalEnabled())
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
-		return;
+		CachedAuthToken = Token;
+		ProcessOfflineJournal();
 	}
 
-	FStoreInventory newInventory;
-	if (!FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), FStoreInventory::StaticStruct(), &newInventory))
+	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
+	if (Settings->EnableLoginWarmUp)
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't convert server response to struct"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't convert server response to struct"));
-		return;
+		WarmUpUserData(Token);
 	}
-
-	Inventory = newInventory;
-
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
-
-	SuccessCallback.ExecuteIfBound();
 }
 
-void UXsollaStoreSubsystem::UpdateVirtualCurrencies_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback)
+TSharedRef<IHttpRequest> UXsollaStoreSubsystem::CreateConsumeRequest(const FString& AuthToken, const FString& ItemSKU, int32 Quantity, const FString& InstanceID)
 {
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
+	// Prepare request payload
+	TSharedPtr<FJsonObject> RequestDataJson = MakeShareable(new FJsonObject);
+	RequestDataJson->SetStringField(TEXT("sku"), ItemSKU);
+
+	if (Quantity == 0)
 	{
-		return;
+		RequestDataJson->SetObjectField(TEXT("quantity"), nullptr);
 	}
-
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+	else
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
-		return;
+		RequestDataJson->SetNumberField(TEXT("quantity"), Quantity);
 	}
 
-	if (!FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), FVirtualCurrencyData::StaticStruct(), &VirtualCurrencyData))
+	if (InstanceID.IsEmpty())
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't convert server response to struct"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't convert server response to struct"));
-		return;
+		RequestDataJson->SetObjectField(TEXT("instance_id"), nullptr);
+	}
+	else
+	{
+		RequestDataJson->SetStringField(TEXT("instance_id"), InstanceID);
 	}
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
-
-	SuccessCallback.ExecuteIfBound();
+	return CreateEndpointRequest(XsollaStoreEndpoints::ConsumeItem, {}, AuthToken, SerializeJson(RequestDataJson));
 }
 
-void UXsollaStoreSubsystem::UpdateVirtualCurrencyPackages_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback)
+TSharedRef<IHttpRequest> UXsollaStoreSubsystem::CreateBuyItemWithVirtualCurrencyRequest(const FString& AuthToken, const FString& ItemSKU, const FString& CurrencySKU)
 {
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
-	{
-		return;
-	}
+	return CreateEndpointRequest(XsollaStoreEndpoints::BuyWithVirtualCurrency, {ItemSKU, CurrencySKU}, AuthToken);
+}
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
-	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
-		return;
-	}
+TSharedRef<IHttpRequest> UXsollaStoreSubsystem::CreateAddToCartRequest(const FString& AuthToken, const FString& CartId, const FString& ItemSKU, int32 Quantity)
+{
+	// Prepare request payload
+	TSharedPtr<FJsonObject> RequestDataJson = MakeShareable(new FJsonObject);
+	RequestDataJson->SetNumberField(TEXT("quantity"), Quantity);
 
-	if (!FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), FVirtualCurrencyPackagesData::StaticStruct(), &VirtualCurrencyPackages))
+	if (CartId.IsEmpty())
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't convert server response to struct"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't convert server response to struct"));
-		return;
+		return CreateEndpointRequest(XsollaStoreEndpoints::CartItem, {ItemSKU}, AuthToken, SerializeJson(RequestDataJson));
 	}
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
-
-	SuccessCallback.ExecuteIfBound();
+	return CreateEndpointRequest(XsollaStoreEndpoints::CartByIdItem, {CartId, ItemSKU}, AuthToken, SerializeJson(RequestDataJson));
 }
 
-void UXsollaStoreSubsystem::UpdateVirtualCurrencyBalance_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback)
+TSharedRef<IHttpRequest> UXsollaStoreSubsystem::CreateRemoveFromCartRequest(const FString& AuthToken, const FString& CartId, const FString& ItemSKU)
 {
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
+	if (CartId.IsEmpty())
 	{
-		return;
+		return CreateEndpointRequest(XsollaStoreEndpoints::RemoveCartItem, {ItemSKU}, AuthToken);
 	}
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
-	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
-		return;
-	}
+	return CreateEndpointRequest(XsollaStoreEndpoints::RemoveCartByIdItem, {CartId, ItemSKU}, AuthToken);
+}
 
-	if (!FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), FVirtualCurrencyBalanceData::StaticStruct(), &VirtualCurrencyBalance))
+TSharedRef<IHttpRequest> UXsollaStoreSubsystem::CreateClearCartRequest(const FString& AuthToken, const FString& CartId)
+{
+	if (CartId.IsEmpty())
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't convert server response to struct"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't convert server response to struct"));
-		return;
+		return CreateEndpointRequest(XsollaStoreEndpoints::ClearCart, {}, AuthToken);
 	}
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
-
-	SuccessCallback.ExecuteIfBound();
+	return CreateEndpointRequest(XsollaStoreEndpoints::ClearCartById, {CartId}, AuthToken);
 }
 
-void UXsollaStoreSubsystem::UpdateSubscriptions_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback)
+TSharedPtr<IHttpRequest> UXsollaStoreSubsystem::CreateOfflineActionRequest(const FStoreOfflineAction& Action, const FString& AuthToken)
 {
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
+	switch (Action.Type)
 	{
-		return;
-	}
+	case EXsollaOfflineActionType::BuyWithVirtualCurrency:
+		return CreateBuyItemWithVirtualCurrencyRequest(AuthToken, Action.ItemSKU, Action.CurrencySKU);
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
-	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
-		return;
-	}
+	case EXsollaOfflineActionType::AddToCart:
+		return CreateAddToCartRequest(AuthToken, Action.CartId, Action.ItemSKU, Action.Quantity);
 
-	FStoreSubscriptionData receivedSubscriptions;
-	if (!FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), FStoreSubscriptionData::StaticStruct(), &receivedSubscriptions))
-	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't convert server response to struct"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't convert server response to struct"));
-		return;
+	case EXsollaOfflineActionType::RemoveFromCart:
+		return CreateRemoveFromCartRequest(AuthToken, Action.CartId, Action.ItemSKU);
+
+	case EXsollaOfflineActionType::ClearCart:
+		return CreateClearCartRequest(AuthToken, Action.CartId);
+
+	case EXsollaOfflineActionType::ConsumeItem:
+		return CreateConsumeRequest(AuthToken, Action.ItemSKU, Action.Quantity, Action.InstanceID);
+
+	default:
+		return nullptr;
 	}
+}
 
-	Subscriptions = receivedSubscriptions;
+void UXsollaStoreSubsystem::JournalOfflineAction(FStoreOfflineAction Action, const FString& AuthToken, const FXsollaOfflineActionCallbacks& Callbacks)
+{
+	const FString ActionId = AppendOfflineAction(Action, AuthToken);
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
+	OfflineActionCallbacks.Add(ActionId, Callbacks);
+	OnOfflineActionsUpdate.Broadcast(GetPendingOfflineActions());
 
-	SuccessCallback.ExecuteIfBound();
+	ProcessOfflineJournal();
 }
 
-void UXsollaStoreSubsystem::FetchPaymentToken_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnFetchTokenSuccess SuccessCallback, FOnStoreError ErrorCallback)
+FString UXsollaStoreSubsystem::AppendOfflineAction(FStoreOfflineAction Action, const FString& AuthToken)
 {
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
-	{
-		return;
-	}
+	Action.ActionId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens);
+	Action.CreatedAt = FDateTime::UtcNow();
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
+	const FXsollaJwtClaimsPtr Claims = FXsollaUtilsTokenParser::GetClaims(AuthToken);
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+	FXsollaOfflineJournalEntry Entry;
+	Entry.Action = Action;
+	Entry.UserId = Claims.IsValid() ? Claims->Sub : FString();
+
+	if (!OfflineJournal->Append(Entry))
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
-		return;
+		UE_LOG(LogXsollaStore, Warning, TEXT("%s: Action is kept in memory only: %s"), *VA_FUNC_LINE, *Action.ActionId);
 	}
 
-	FString AccessToken = JsonObject->GetStringField(TEXT("token"));
-	int32 OrderId = JsonObject->GetNumberField(TEXT("order_id"));
-
-	SuccessCallback.ExecuteIfBound(AccessToken, OrderId);
+	return Action.ActionId;
 }
 
-void UXsollaStoreSubsystem::CheckOrder_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnCheckOrder SuccessCallback, FOnStoreError ErrorCallback)
+void UXsollaStoreSubsystem::ProcessOfflineJournal()
 {
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
+	if (!IsOfflineJournalEnabled() || bOfflineActionInProgress || OfflineJournal->GetEntries().Num() == 0)
 	{
 		return;
 	}
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
-
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+	// Failed delivery is retried by timer only, so new actions don't bypass backoff
+	if (GetGameInstance() && GetGameInstance()->GetTimerManager().IsTimerActive(OfflineReplayTimerHandle))
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
 		return;
 	}
 
-	int32 OrderId = JsonObject->GetNumberField(TEXT("order_id"));
-	FString Status = JsonObject->GetStringField(TEXT("status"));
-	EXsollaOrderStatus OrderStatus = EXsollaOrderStatus::Unknown;
-
-	if (Status == TEXT("new"))
+	// Action without user can't be attributed to any login, so it's never sent with token of somebody else
+	TArray<FString> OrphanedActionIds;
+	for (const auto& JournalEntry : OfflineJournal->GetEntries())
 	{
-		OrderStatus = EXsollaOrderStatus::New;
+		if (JournalEntry.UserId.IsEmpty())
+		{
+			OrphanedActionIds.Add(JournalEntry.Action.ActionId);
+		}
 	}
-	else if (Status == TEXT("paid"))
+
+	for (const FString& OrphanedActionId : OrphanedActionIds)
 	{
-		OrderStatus = EXsollaOrderStatus::Paid;
+		DropOfflineAction(OrphanedActionId, TEXT("Journaled action has no owning user"));
 	}
-	else if (Status == TEXT("done"))
+
+	// Error callbacks could journal new action
+	if (bOfflineActionInProgress)
 	{
-		OrderStatus = EXsollaOrderStatus::Done;
+		return;
 	}
-	else
+
+	// Actions are sent one by one to keep their order, actions of other users wait for their login
+	const FXsollaOfflineJournalEntry* Entry = nullptr;
+	FString AuthToken;
+	for (const auto& JournalEntry : OfflineJournal->GetEntries())
 	{
-		UE_LOG(LogXsollaStore, Warning, TEXT("%s: Unknown order status: %s [%d]"), *VA_FUNC_LINE, *Status, OrderId);
+		AuthToken = GetOfflineActionAuthToken(JournalEntry.UserId);
+		if (!AuthToken.IsEmpty())
+		{
+			Entry = &JournalEntry;
+			break;
+		}
 	}
 
-	SuccessCallback.ExecuteIfBound(OrderId, OrderStatus);
-}
-
-void UXsollaStoreSubsystem::CreateCart_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreCartUpdate SuccessCallback, FOnStoreError ErrorCallback)
-{
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
+	if (!Entry)
 	{
-		ProcessNextCartRequest();
 		return;
 	}
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
+	const FString ActionId = Entry->Action.ActionId;
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+	// Request made before restart could reach server
+	if (Entry->bSent)
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
+		ReconcileOfflineAction(ActionId, AuthToken);
 		return;
 	}
 
-	Cart = FStoreCart(JsonObject->GetStringField(TEXT("cart_id")));
-	OnCartUpdate.Broadcast(Cart);
-
-	SaveData();
-
-	SuccessCallback.ExecuteIfBound();
-}
+	const bool bCartAction = IsCartOfflineAction(Entry->Action.Type);
 
-void UXsollaStoreSubsystem::ClearCart_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreCartUpdate SuccessCallback, FOnStoreError ErrorCallback)
-{
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
+	TSharedPtr<IHttpRequest> HttpRequest = CreateOfflineActionRequest(Entry->Action, AuthToken);
+	if (!HttpRequest.IsValid())
 	{
-		ProcessNextCartRequest();
+		DropOfflineAction(ActionId, TEXT("Unknown journaled action type"));
+		ProcessOfflineJournal();
 		return;
 	}
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
-
-	SuccessCallback.ExecuteIfBound();
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::OfflineAction_HttpRequestComplete, ActionId);
 
-	ProcessNextCartRequest();
-}
+	OfflineJournal->MarkAttempt(ActionId);
+	bOfflineActionInProgress = true;
 
-void UXsollaStoreSubsystem::UpdateCart_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreCartUpdate SuccessCallback, FOnStoreError ErrorCallback)
-{
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
+	// Cart changes are kept in order with live cart requests
+	if (bCartAction)
 	{
+		OfflineCartRequest = HttpRequest;
+		CartRequestsQueue.Add(HttpRequest.ToSharedRef());
 		ProcessNextCartRequest();
-		return;
 	}
-
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+	else
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
-		return;
+		HttpRequest->ProcessRequest();
 	}
+}
 
-	if (!FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), FStoreCart::StaticStruct(), &Cart))
+void UXsollaStoreSubsystem::ScheduleOfflineReplay()
+{
+	using namespace XsollaStoreOfflineReplay;
+
+	if (!GetGameInstance())
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't convert server response to struct"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't convert server response to struct"));
 		return;
 	}
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
-
-	OnCartUpdate.Broadcast(Cart);
+	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
+	const float RetryInterval = Settings->OfflineJournalRetryInterval * (1 << FMath::Min(FailedOfflineReplays, MaxBackoffExponent));
+	FailedOfflineReplays++;
 
-	SuccessCallback.ExecuteIfBound();
+	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Journaled actions delivery is retried in %.0f s"), *VA_FUNC_LINE, RetryInterval);
 
-	ProcessNextCartRequest();
+	GetGameInstance()->GetTimerManager().SetTimer(OfflineReplayTimerHandle, this, &UXsollaStoreSubsystem::ReplayOfflineActions, RetryInterval, false);
 }
 
-void UXsollaStoreSubsystem::AddToCart_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreCartUpdate SuccessCallback, FOnStoreError ErrorCallback)
+void UXsollaStoreSubsystem::ReconcileOfflineAction(const FString& ActionId, const FString& AuthToken)
 {
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
+	const FXsollaOfflineJournalEntry* Entry = OfflineJournal->FindEntry(ActionId);
+	if (!Entry)
 	{
-		UpdateCart(CachedAuthToken, CachedCartId, SuccessCallback, ErrorCallback);
 		return;
 	}
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
-
-	SuccessCallback.ExecuteIfBound();
-
-	ProcessNextCartRequest();
-}
-
-void UXsollaStoreSubsystem::RemoveFromCart_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreCartUpdate SuccessCallback, FOnStoreError ErrorCallback)
-{
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
+	const FStoreOfflineAction Action = Entry->Action;
+	if (!IsCartOfflineAction(Action.Type))
 	{
-		UpdateCart(CachedAuthToken, CachedCartId, SuccessCallback, ErrorCallback);
+		// Server state can't tell this action from other consumptions and purchases, so it's dropped rather than applied twice
+		DropOfflineAction(ActionId, TEXT("Journaled action could reach server, its result is unknown"));
+		ResyncOfflineActionState(Action.Type, AuthToken);
+
+		ProcessOfflineJournal();
 		return;
 	}
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
-
-	SuccessCallback.ExecuteIfBound();
+	auto OnResponse = [this, ActionId](FStoreCart& ServerCart) {
+		bOfflineActionInProgress = false;
+		OfflineCartRequest.Reset();
 
-	ProcessNextCartRequest();
-}
+		const FXsollaOfflineJournalEntry* ReconciledEntry = OfflineJournal->FindEntry(ActionId);
+		if (ReconciledEntry && IsCartOfflineActionApplied(ReconciledEntry->Action, ServerCart))
+		{
+			UE_LOG(LogXsollaStore, Log, TEXT("%s: Journaled cart action was applied by server: %s"), *VA_FUNC_LINE, *ActionId);
 
-void UXsollaStoreSubsystem::ConsumeInventoryItem_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback)
-{
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
-	{
-		return;
-	}
+			FailedOfflineReplays = 0;
+			OfflineJournal->Acknowledge(ActionId);
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
+			FXsollaOfflineActionCallbacks Callbacks;
+			OfflineActionCallbacks.RemoveAndCopyValue(ActionId, Callbacks);
+			Callbacks.CartUpdateCallback.ExecuteIfBound();
+		}
+		else if (ReconciledEntry)
+		{
+			// Cart change sets absolute state, so it's sent again once it's known it wasn't applied
+			OfflineJournal->MarkNotSent(ActionId);
+		}
 
-	SuccessCallback.ExecuteIfBound();
-}
+		OnOfflineActionsUpdate.Broadcast(GetPendingOfflineActions());
 
-void UXsollaStoreSubsystem::GetVirtualCurrency_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnCurrencyUpdate SuccessCallback, FOnStoreError ErrorCallback)
-{
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
-	{
 		ProcessNextCartRequest();
-		return;
-	}
+		ProcessOfflineJournal();
+	};
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
+	auto OnError = [this]() {
+		bOfflineActionInProgress = false;
+		OfflineCartRequest.Reset();
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
-	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
-		return;
-	}
+		ScheduleOfflineReplay();
+		ProcessNextCartRequest();
+	};
 
-	FVirtualCurrency currency;
-	if (!FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), FVirtualCurrency::StaticStruct(), &currency))
-	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't convert server response to struct"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't convert server response to struct"));
-		return;
-	}
+	TSharedRef<IHttpRequest> HttpRequest = Action.CartId.IsEmpty()
+		? CreateEndpointRequest(XsollaStoreEndpoints::Cart, {}, AuthToken)
+		: CreateEndpointRequest(XsollaStoreEndpoints::CartById, {Action.CartId}, AuthToken);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, XsollaStoreEndpoints::Cart.MakeHandler(OnResponse, FOnStoreError(), OnError));
 
-	SuccessCallback.ExecuteIfBound(currency);
+	bOfflineActionInProgress = true;
+	OfflineCartRequest = HttpRequest;
+	CartRequestsQueue.Add(HttpRequest);
+	ProcessNextCartRequest();
 }
 
-void UXsollaStoreSubsystem::GetVirtualCurrencyPackage_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnCurrencyPackageUpdate SuccessCallback, FOnStoreError ErrorCallback)
+void UXsollaStoreSubsystem::DropOfflineAction(const FString& ActionId, const FString& ErrorStr)
 {
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
-	{
-		ProcessNextCartRequest();
-		return;
-	}
+	UE_LOG(LogXsollaStore, Error, TEXT("%s: Dropping journaled action %s: %s"), *VA_FUNC_LINE, *ActionId, *ErrorStr);
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
+	OfflineJournal->Acknowledge(ActionId);
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+	FXsollaOfflineActionCallbacks Callbacks;
+	OfflineActionCallbacks.RemoveAndCopyValue(ActionId, Callbacks);
+	if (Callbacks.ConsumeBatchId != INDEX_NONE)
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
-		return;
+		CompleteConsumeBatch(Callbacks.ConsumeBatchId, true, 0, 0, ErrorStr);
 	}
-
-	FVirtualCurrencyPackage currencyPackage;
-	if (!FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), FVirtualCurrencyPackage::StaticStruct(), &currencyPackage))
+	else
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't convert server response to struct"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't convert server response to struct"));
-		return;
+		Callbacks.ErrorCallback.ExecuteIfBound(0, 0, ErrorStr);
 	}
 
-	SuccessCallback.ExecuteIfBound(currencyPackage);
+	OnOfflineActionsUpdate.Broadcast(GetPendingOfflineActions());
 }
 
-void UXsollaStoreSubsystem::BuyItemWithVirtualCurrency_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnPurchaseUpdate SuccessCallback, FOnStoreError ErrorCallback)
+void UXsollaStoreSubsystem::ResyncOfflineActionState(EXsollaOfflineActionType ActionType, const FString& AuthToken)
 {
-	if (HandleRequestError(HttpRequest, HttpResponse, bSucceeded, ErrorCallback))
+	if (AuthToken.IsEmpty())
 	{
 		return;
 	}
 
-	FString ResponseStr = HttpResponse->GetContentAsString();
-	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Response: %s"), *VA_FUNC_LINE, *ResponseStr);
-
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*HttpResponse->GetContentAsString());
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+	if (ActionType == EXsollaOfflineActionType::ConsumeItem || ActionType == EXsollaOfflineActionType::BuyWithVirtualCurrency)
 	{
-		UE_LOG(LogXsollaStore, Error, TEXT("%s: Can't deserialize server response"), *VA_FUNC_LINE);
-		ErrorCallback.ExecuteIfBound(HttpResponse->GetResponseCode(), 0, TEXT("Can't deserialize server response"));
-		return;
+		ReconcileInventory(AuthToken);
 	}
 
-	int32 OrderId = JsonObject->GetNumberField(TEXT("order_id"));
+	if (ActionType == EXsollaOfflineActionType::BuyWithVirtualCurrency)
+	{
+		auto OnResponse = [this](FVirtualCurrencyBalanceData& BalanceData) {
+			VirtualCurrencyBalance = MoveTemp(BalanceData);
+		};
 
-	SuccessCallback.ExecuteIfBound(OrderId);
+		// Warm-up response could be received before the purchase, so it isn't used
+		const auto& Endpoint = XsollaStoreEndpoints::VirtualCurrencyBalance;
+		TSharedRef<IHttpRequest> HttpRequest = CreateEndpointRequest(Endpoint, {}, AuthToken);
+		FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, Endpoint.MakeHandler(OnResponse, FOnStoreError()));
+		HttpRequest->ProcessRequest();
+	}
 }
 
-bool UXsollaStoreSubsystem::HandleRequestError(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreError ErrorCallback)
+bool UXsollaStoreSubsystem::IsCartOfflineActionApplied(const FStoreOfflineAction& Action, const FStoreCart& ServerCart)
 {
-	FString ErrorStr;
-	int32 ErrorCode = 0;
-	int32 StatusCode = 204;
-	FString ResponseStr = TEXT("invalid");
+	const FString& ItemSKU = Action.ItemSKU;
+	const FStoreCartItem* CartItem = ServerCart.Items.FindByPredicate([&ItemSKU](const FStoreCartItem& InItem) {
+		return InItem.sku == ItemSKU;
+	});
 
-	if (bSucceeded && HttpResponse.IsValid())
+	switch (Action.Type)
 	{
-		ResponseStr = HttpResponse->GetContentAsString();
+	case EXsollaOfflineActionType::AddToCart:
+		return Action.Quantity > 0 ? (CartItem && CartItem->quantity == Action.Quantity) : !CartItem;
 
-		if (!EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()))
-		{
-			StatusCode = HttpResponse->GetResponseCode();
-			ErrorStr = FString::Printf(TEXT("Invalid response. code=%d error=%s"), HttpResponse->GetResponseCode(), *ResponseStr);
+	case EXsollaOfflineActionType::RemoveFromCart:
+		return !CartItem;
 
-			// Example: {"statusCode":403,"errorCode":0,"errorMessage":"Token not found"}
-			TSharedPtr<FJsonObject> JsonObject;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(*ResponseStr);
-			if (FJsonSerializer::Deserialize(Reader, JsonObject))
-			{
-				static const FString ErrorFieldName = TEXT("errorMessage");
-				if (JsonObject->HasTypedField<EJson::String>(ErrorFieldName))
-				{
-					StatusCode = JsonObject->GetNumberField(TEXT("statusCode"));
-					ErrorCode = JsonObject->GetNumberField(TEXT("errorCode"));
-					ErrorStr = JsonObject->GetStringField(ErrorFieldName);
-				}
-				else
-				{
-					ErrorStr = FString::Printf(TEXT("Can't deserialize error json: no field '%s' found"), *ErrorFieldName);
-				}
-			}
-			else
-			{
-				ErrorStr = TEXT("Can't deserialize error json");
-			}
-		}
+	case EXsollaOfflineActionType::ClearCart:
+		return ServerCart.Items.Num() == 0;
+
+	default:
+		return false;
 	}
-	else
+}
+
+bool UXsollaStoreSubsystem::HasPendingCartOfflineActions() const
+{
+	if (!IsOfflineJournalEnabled())
 	{
-		ErrorStr = TEXT("No response");
+		return false;
 	}
 
-	if (!ErrorStr.IsEmpty())
+	for (const auto& Entry : OfflineJournal->GetEntries())
 	{
-		UE_LOG(LogXsollaStore, Warning, TEXT("%s: request failed (%s): %s"), *VA_FUNC_LINE, *ErrorStr, *ResponseStr);
-		ErrorCallback.ExecuteIfBound(StatusCode, ErrorCode, ErrorStr);
-		return true;
+		if (IsCartOfflineAction(Entry.Action.Type) && !GetOfflineActionAuthToken(Entry.UserId).IsEmpty())
+		{
+			return true;
+		}
 	}
 
 	return false;
 }
 
-void UXsollaStoreSubsystem::LoadData()
+FString UXsollaStoreSubsystem::GetOfflineActionAuthToken(const FString& UserId) const
 {
-	auto CartData = UXsollaStoreSave::Load();
+	if (CachedAuthToken.IsEmpty() || UserId.IsEmpty())
+	{
+		return FString();
+	}
 
-	CachedCartCurrency = CartData.CartCurrency;
-	Cart.cart_id = CartData.CartId;
+	const FXsollaJwtClaimsPtr CachedClaims = FXsollaUtilsTokenParser::GetClaims(CachedAuthToken);
+	if (CachedClaims.IsValid() && CachedClaims->Sub == UserId)
+	{
+		return CachedAuthToken;
+	}
 
-	OnCartUpdate.Broadcast(Cart);
+	return FString();
 }
 
-void UXsollaStoreSubsystem::SaveData()
+bool UXsollaStoreSubsystem::IsCartOfflineAction(EXsollaOfflineActionType ActionType)
 {
-	UXsollaStoreSave::Save(FXsollaStoreSaveData(Cart.cart_id, CachedCartCurrency));
+	return ActionType == EXsollaOfflineActionType::AddToCart || ActionType == EXsollaOfflineActionType::RemoveFromCart || ActionType == EXsollaOfflineActionType::ClearCart;
 }
 
-bool UXsollaStoreSubsystem::IsSandboxEnabled() const
+FString UXsollaStoreSubsystem::GetActualAuthToken(const FString& AuthToken) const
 {
 	const UXsollaStoreSettings* Settings = FXsollaStoreModule::Get().GetSettings();
-	bool bIsSandboxEnabled = Settings->EnableSandbox;
+	if (!Settings->UseLoginTokenProvider)
+	{
+		return AuthToken;
+	}
 
-#if UE_BUILD_SHIPPING
-	bIsSandboxEnabled = Settings->EnableSandbox && Settings->EnableSandboxInShippingBuild;
-	if (bIsSandboxEnabled)
+	IXsollaAuthTokenProvider* TokenProvider = FXsollaAuthTokenProviderRegistry::Find(GetGameInstance());
+	if (!TokenProvider)
 	{
-		UE_LOG(LogXsollaStore, Warning, TEXT("%s: Sandbox should be disabled in Shipping build"), *VA_FUNC_LINE);
+		UE_LOG(LogXsollaStore, Warning, TEXT("%s: No token provider registered, is XsollaLogin module enabled?"), *VA_FUNC_LINE);
+		return AuthToken;
 	}
-#endif // UE_BUILD_SHIPPING
 
-	return bIsSandboxEnabled;
+	// Token of another user (or one passed on purpose) is sent as is
+	const FString RefreshedAuthToken = TokenProvider->GetRefreshedAuthToken(AuthToken);
+	return RefreshedAuthToken.IsEmpty() ? AuthToken : RefreshedAuthToken;
 }
 
-TSharedRef<IHttpRequest> UXsollaStoreSubsystem::CreateHttpRequest(const FString& Url, const EXsollaRequestVerb Verb, const FString& AuthToken, const FString& Content)
+bool UXsollaStoreSubsystem::IsOfflineJournalEnabled() const
 {
-	TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
+	return OfflineJournal.IsValid();
+}
 
-	// Temporal solution with headers processing on server-side #37
-	const FString MetaUrl = FString::Printf(TEXT("%sengine=ue4&engine_v=%s&sdk=store&sdk_v=%s"),
-		Url.Contains(TEXT("?")) ? TEXT("&") : TEXT("?"),
-		ENGINE_VERSION_STRING,
-		XSOLLA_STORE_VERSION);
-	HttpRequest->SetURL(Url + MetaUrl);
+void UXsollaStoreSubsystem::ApplyConsumeBatch(FXsollaConsumeBatch& Batch, int32 Quantity)
+{
+	const FString& ItemSKU = Batch.ItemSKU;
+	auto InventoryItem = Inventory.Items.FindByPredicate([ItemSKU](const FStoreInventoryItem& InItem) {
+		return InItem.sku == ItemSKU && InItem.instance_id.IsEmpty();
+	});
 
-	// Xsolla meta
-	HttpRequest->SetHeader(TEXT("X-ENGINE"), TEXT("UE4"));
-	HttpRequest->SetHeader(TEXT("X-ENGINE-V"), ENGINE_VERSION_STRING);
-	HttpRequest->SetHeader(TEXT("X-SDK"), TEXT("STORE"));
-	HttpRequest->SetHeader(TEXT("X-SDK-V"), XSOLLA_STORE_VERSION);
+	if (!InventoryItem)
+	{
+		UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Can't find provided SKU in local inventory: %s"), *VA_FUNC_LINE, *ItemSKU);
+		return;
+	}
 
-	switch (Verb)
+	// Consumption of item with limited uses spends its uses, other items are spent by quantity
+	if (InventoryItem->remaining_uses > 0 || Batch.AppliedRemainingUses > 0)
 	{
-	case EXsollaRequestVerb::GET:
-		HttpRequest->SetVerb(TEXT("GET"));
+		const int32 RemainingUsesDelta = FMath::Clamp(Quantity, 0, InventoryItem->remaining_uses);
+		InventoryItem->remaining_uses -= RemainingUsesDelta;
+		Batch.AppliedRemainingUses += RemainingUsesDelta;
+	}
+	else
+	{
+		const int32 QuantityDelta = FMath::Clamp(Quantity, 0, InventoryItem->quantity);
+		InventoryItem->quantity -= QuantityDelta;
+		Batch.AppliedQuantity += QuantityDelta;
+	}
+}
 
-		// Check that we doen't provide content with GET request
-		if (!Content.IsEmpty())
-		{
-			UE_LOG(LogXsollaStore, Warning, TEXT("%s: Request content is not empty for GET request. Maybe you should use POST one?"), *VA_FUNC_LINE);
-		}
-		break;
+void UXsollaStoreSubsystem::RevertConsumeBatch(FXsollaConsumeBatch& Batch)
+{
+	const FString& ItemSKU = Batch.ItemSKU;
+	auto InventoryItem = Inventory.Items.FindByPredicate([ItemSKU](const FStoreInventoryItem& InItem) {
+		return InItem.sku == ItemSKU && InItem.instance_id.IsEmpty();
+	});
 
-	case EXsollaRequestVerb::POST:
-		HttpRequest->SetVerb(TEXT("POST"));
-		break;
+	if (InventoryItem)
+	{
+		InventoryItem->quantity += Batch.AppliedQuantity;
+		InventoryItem->remaining_uses += Batch.AppliedRemainingUses;
+	}
 
-	case EXsollaRequestVerb::PUT:
-		HttpRequest->SetVerb(TEXT("PUT"));
-		break;
+	Batch.AppliedQuantity = 0;
+	Batch.AppliedRemainingUses = 0;
+}
 
-	case EXsollaRequestVerb::DELETE:
-		HttpRequest->SetVerb(TEXT("DELETE"));
-		break;
+void UXsollaStoreSubsystem::SetInventory(FStoreInventory& ReceivedInventory)
+{
+	Inventory = MoveTemp(ReceivedInventory);
 
-	default:
-		unimplemented();
+	// Server state is authoritative for sent consumptions (they are reconciled when answered), while queued ones should be applied again
+	for (auto& InFlightItem : ConsumeInFlight)
+	{
+		InFlightItem.Value.AppliedQuantity = 0;
+		InFlightItem.Value.AppliedRemainingUses = 0;
 	}
 
-	if (!AuthToken.IsEmpty())
+	for (auto& QueueItem : ConsumeQueue)
 	{
-		HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *AuthToken));
+		QueueItem.Value.AppliedQuantity = 0;
+		QueueItem.Value.AppliedRemainingUses = 0;
+		ApplyConsumeBatch(QueueItem.Value, QueueItem.Value.Quantity);
 	}
 
-	if (!Content.IsEmpty())
+	OnInventoryUpdate.Broadcast(Inventory);
+}
+
+void UXsollaStoreSubsystem::ReconcileInventory(const FString& AuthToken)
+{
+	// Each answered batch would request the same state otherwise
+	if (ConsumeInFlight.Num() > 0 || AuthToken.IsEmpty())
 	{
-		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-		HttpRequest->SetContentAsString(Content);
+		return;
 	}
 
-	return HttpRequest;
+	UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Reconciling inventory after consumptions"), *VA_FUNC_LINE);
+
+	auto OnResponse = [this](FStoreInventory& ReceivedInventory) {
+		SetInventory(ReceivedInventory);
+	};
+
+	// Warm-up response could be received before consumptions, so it isn't used
+	const auto& Endpoint = XsollaStoreEndpoints::Inventory;
+	TSharedRef<IHttpRequest> HttpRequest = CreateEndpointRequest(Endpoint, {}, AuthToken);
+	FXsollaHttpTelemetry::BindHandler(HttpRequest, this, &UXsollaStoreSubsystem::Endpoint_HttpRequestComplete, Endpoint.MakeHandler(OnResponse, FOnStoreError()));
+	HttpRequest->ProcessRequest();
 }
 
 FString UXsollaStoreSubsystem::SerializeJson(const TSharedPtr<FJsonObject> DataJson) const
@@ -1255,28 +2479,20 @@ FString UXsollaStoreSubsystem::SerializeJson(const TSharedPtr<FJsonObject> DataJ
 	return JsonContent;
 }
 
-bool UXsollaStoreSubsystem::ParseTokenPayload(const FString& Token, TSharedPtr<FJsonObject>& PayloadJsonObject) const
+void UXsollaStoreSubsystem::ProcessNextCartRequest()
 {
-	TArray<FString> TokenParts;
-	Token.ParseIntoArray(TokenParts, TEXT("."));
-
-	FString PayloadStr;
-	if (!FBase64::Decode(TokenParts[1], PayloadStr))
+	// Cart could be changed after warm-up request was sent, so its response is stale
+	FXsollaStoreWarmUpRequest WarmUpRequest;
+	if (WarmUpRequests.RemoveAndCopyValue(XsollaStoreEndpoints::Cart.Name, WarmUpRequest) && WarmUpRequest.Consumer.IsBound())
 	{
-		return false;
-	}
+		// UpdateCart is waiting for it, so cart is requested again after pending changes
+		UE_LOG(LogXsollaStore, Verbose, TEXT("%s: Warm-up cart is stale, requesting it again"), *VA_FUNC_LINE);
 
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PayloadStr);
-	if (!FJsonSerializer::Deserialize(Reader, PayloadJsonObject))
-	{
-		return false;
+		TSharedRef<IHttpRequest> HttpRequest = CreateEndpointRequest(XsollaStoreEndpoints::Cart, {}, WarmUpRequest.AuthToken);
+		HttpRequest->OnProcessRequestComplete() = WarmUpRequest.Consumer;
+		CartRequestsQueue.Add(HttpRequest);
 	}
 
-	return true;
-}
-
-void UXsollaStoreSubsystem::ProcessNextCartRequest()
-{
 	// Cleanup finished requests firts
 	int32 CartRequestsNum = CartRequestsQueue.Num();
 	for (int32 i = CartRequestsNum - 1; i >= 0; --i)
@@ -1299,10 +2515,18 @@ void UXsollaStoreSubsystem::ProcessNextCartRequest()
 		}
 	}
 
-	// Launch next one if we have it
-	if (!bRequestInProcess && CartRequestsQueue.Num() > 0)
+	// Launch next one if we have it, live requests wait for journaled cart actions so they can't overtake them
+	if (!bRequestInProcess)
 	{
-		CartRequestsQueue[0].Get().ProcessRequest();
+		const bool bHoldLiveRequests = HasPendingCartOfflineActions();
+		for (const auto& CartRequest : CartRequestsQueue)
+		{
+			if (!bHoldLiveRequests || &CartRequest.Get() == OfflineCartRequest.Get())
+			{
+				CartRequest.Get().ProcessRequest();
+				break;
+			}
+		}
 	}
 }
 
@@ -1378,33 +2602,53 @@ TArray<FStoreItem> UXsollaStoreSubsystem::GetVirtualItems(const FString& GroupFi
 {
 	if (GroupFilter.IsEmpty())
 	{
-		return ItemsData.Items;
+		return Catalog->GetItems();
 	}
 	else
 	{
-		return ItemsData.Items.FilterByPredicate([GroupFilter](const FStoreItem& InStoreItem) {
-			for (auto& ItemGroup : InStoreItem.groups)
-			{
-				if (ItemGroup.external_id == GroupFilter)
-				{
-					return true;
-				}
-			}
-			return false;
-		});
+		return Catalog->GetItemsInGroup(GroupFilter);
 	}
 }
 
 TArray<FStoreItem> UXsollaStoreSubsystem::GetVirtualItemsWithoutGroup() const
 {
-	return ItemsData.Items.FilterByPredicate([](const FStoreItem& InStoreItem) {
-		return InStoreItem.groups.Num() == 0;
-	});
+	return Catalog->GetItemsWithoutGroup();
+}
+
+FStoreItemsQueryResult UXsollaStoreSubsystem::SearchVirtualItems(const FString& SearchText, int32 Limit) const
+{
+	FStoreItemsQuery Query;
+	Query.SearchText = SearchText;
+	Query.SortBy = EXsollaItemsSortBy::Relevance;
+	Query.Limit = Limit;
+
+	return QueryVirtualItems(Query);
+}
+
+FStoreItemsQueryResult UXsollaStoreSubsystem::QueryVirtualItems(const FStoreItemsQuery& Query) const
+{
+	XSOLLA_TRACE_SCOPE(XsollaStore_QueryVirtualItems);
+
+	const TArray<int32> Indices = Catalog->QueryItems(Query);
+
+	FStoreItemsQueryResult Result;
+	Result.TotalCount = Indices.Num();
+
+	const int32 First = FMath::Clamp(Query.Offset, 0, Indices.Num());
+	const int32 Last = (Query.Limit > 0) ? FMath::Min(First + Query.Limit, Indices.Num()) : Indices.Num();
+
+	Result.Items.Reserve(Last - First);
+	for (int32 Index = First; Index < Last; ++Index)
+	{
+		Result.Items.Add(Catalog->GetItem(Indices[Index]));
+	}
+
+	return Result;
 }
 
 FStoreItemsData UXsollaStoreSubsystem::GetItemsData() const
 {
-	return ItemsData;
+	return Catalog->GetItemsData();
 }
 
 TArray<FVirtualCurrency> UXsollaStoreSubsystem::GetVirtualCurrencyData() const
@@ -1414,7 +2658,7 @@ TArray<FVirtualCurrency> UXsollaStoreSubsystem::GetVirtualCurrencyData() const
 
 TArray<FVirtualCurrencyPackage> UXsollaStoreSubsystem::GetVirtualCurrencyPackages() const
 {
-	return VirtualCurrencyPackages.Items;
+	return Catalog->GetCurrencyPackages();
 }
 
 TArray<FVirtualCurrencyBalance> UXsollaStoreSubsystem::GetVirtualCurrencyBalance() const
@@ -1444,7 +2688,65 @@ FString UXsollaStoreSubsystem::GetPendingPaystationUrl() const
 
 UDataTable* UXsollaStoreSubsystem::GetCurrencyLibrary() const
 {
-	return CurrencyLibrary;
+	CurrencyLibraryLoader->Load();
+	return CurrencyLibraryAsset.Get();
+}
+
+FStoreMemoryReport UXsollaStoreSubsystem::GetMemoryReport() const
+{
+	using namespace XsollaStoreMemory;
+
+	FStoreMemoryReport Report;
+	Report.Items = Catalog->GetItemsAllocatedSize() + Catalog->GetColumnsAllocatedSize();
+	Report.Groups = Catalog->GetGroupsAllocatedSize();
+	Report.SearchIndex = Catalog->GetSearchIndexAllocatedSize();
+	Report.Currencies = GetArrayMemorySize(VirtualCurrencyData.Items) + GetArrayMemorySize(VirtualCurrencyBalance.Items);
+	Report.CurrencyPackages = Catalog->GetCurrencyPackagesAllocatedSize();
+	Report.Cart = FXsollaUtilsMemory::GetAllocatedSize(FStoreCart::StaticStruct(), &Cart);
+	Report.Inventory = GetArrayMemorySize(Inventory.Items);
+	Report.Subscriptions = GetArrayMemorySize(Subscriptions.Items);
+
+	if (ImageLoader)
+	{
+		Report.Images = ImageLoader->GetImagesMemorySize();
+		Report.ImageCount = ImageLoader->GetImageCount();
+		Report.PendingRequests += ImageLoader->GetPendingRequestsMemorySize();
+	}
+
+	Report.PendingRequests += CartRequestsQueue.GetAllocatedSize();
+	for (const auto& HttpRequest : CartRequestsQueue)
+	{
+		Report.PendingRequests += GetRequestMemorySize(HttpRequest);
+	}
+
+	Report.PendingRequests += ConsumeQueue.GetAllocatedSize() + ConsumeInFlight.GetAllocatedSize();
+	for (const auto& QueueItem : ConsumeQueue)
+	{
+		Report.PendingRequests += QueueItem.Key.Key.GetAllocatedSize() + QueueItem.Key.Value.GetAllocatedSize() + GetConsumeBatchMemorySize(QueueItem.Value);
+	}
+	for (const auto& InFlightItem : ConsumeInFlight)
+	{
+		Report.PendingRequests += GetConsumeBatchMemorySize(InFlightItem.Value);
+	}
+
+	Report.PendingRequests += OfflineActionCallbacks.GetAllocatedSize();
+	if (OfflineJournal.IsValid())
+	{
+		for (const auto& Entry : OfflineJournal->GetEntries())
+		{
+			Report.PendingRequests += sizeof(Entry) + Entry.UserId.GetAllocatedSize() + FXsollaUtilsMemory::GetAllocatedSize(FStoreOfflineAction::StaticStruct(), &Entry.Action);
+		}
+	}
+
+	// Report shouldn't load currency library
+	if (const UDataTable* LoadedCurrencyLibrary = CurrencyLibraryAsset.Get())
+	{
+		Report.CurrencyLibrary = LoadedCurrencyLibrary->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	}
+
+	Report.Total = Report.Items + Report.Groups + Report.SearchIndex + Report.Currencies + Report.CurrencyPackages + Report.Cart + Report.Inventory + Report.Subscriptions + Report.Images + Report.PendingRequests + Report.CurrencyLibrary;
+
+	return Report;
 }
 
 UXsollaStoreImageLoader* UXsollaStoreSubsystem::GetImageLoader() const
@@ -1465,7 +2767,14 @@ FString UXsollaStoreSubsystem::FormatPrice(float Amount, const FString& Currency
 		return FString();
 	}
 
-	auto Row = GetCurrencyLibrary()->FindRow<FXsollaStoreCurrency>(FName(*Currency), FString());
+	const UDataTable* CurrencyLibraryTable = GetCurrencyLibrary();
+	if (!CurrencyLibraryTable)
+	{
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Currency library isn't loaded, price is not formatted"), *VA_FUNC_LINE);
+		return FString::SanitizeFloat(Amount);
+	}
+
+	auto Row = CurrencyLibraryTable->FindRow<FXsollaStoreCurrency>(FName(*Currency), FString());
 	if (Row)
 	{
 		FString SanitizedAmount = UKismetTextLibrary::Conv_FloatToText(Amount, ERoundingMode::HalfToEven, false, true, 1, 324, Row->fractionSize, Row->fractionSize).ToString();
@@ -1476,4 +2785,64 @@ FString UXsollaStoreSubsystem::FormatPrice(float Amount, const FString& Currency
 	return FString();
 }
 
+FString UXsollaStoreSubsystem::FormatPriceDecimal(const FStoreDecimal& Amount, const FString& Currency) const
+{
+	if (Currency.IsEmpty() || !Amount.IsValid())
+	{
+		UE_LOG(LogXsollaStore, Warning, TEXT("%s: In PA there is no price provided for certain item"), *VA_FUNC_LINE);
+		return FString();
+	}
+
+	const UDataTable* CurrencyLibraryTable = GetCurrencyLibrary();
+	if (!CurrencyLibraryTable)
+	{
+		UE_LOG(LogXsollaStore, Error, TEXT("%s: Currency library isn't loaded, price is not formatted"), *VA_FUNC_LINE);
+		return Amount.ToString();
+	}
+
+	auto Row = CurrencyLibraryTable->FindRow<FXsollaStoreCurrency>(FName(*Currency), FString());
+	if (Row)
+	{
+		// Amount which doesn't fit currency scale is shown with its own digits rather than as zero
+		FStoreDecimal DisplayAmount = Amount.Rescale(Row->fractionSize);
+		if (!DisplayAmount.IsValid())
+		{
+			UE_LOG(LogXsollaStore, Warning, TEXT("%s: Can't round price to currency precision (%s %s)"), *VA_FUNC_LINE, *Amount.ToString(), *Currency);
+			DisplayAmount = Amount;
+		}
+
+		FString WholePart = DisplayAmount.ToString();
+		FString FractionPart;
+		WholePart.Split(TEXT("."), &WholePart, &FractionPart);
+		const bool bNegative = WholePart.RemoveFromStart(TEXT("-"));
+
+		// Only integer part goes through culture formatting, so fraction digits stay exact
+		const FDecimalNumberFormattingRules& Rules = FInternationalization::Get().GetCurrentCulture()->GetDecimalNumberFormattingRules();
+		FNumberFormattingOptions Options;
+		Options.SetUseGrouping(true);
+
+		FString SanitizedAmount = FText::AsNumber(FCString::Atoi64(*WholePart), &Options).ToString();
+		if (!FractionPart.IsEmpty())
+		{
+			SanitizedAmount.AppendChar(Rules.DecimalSeparatorCharacter);
+			SanitizedAmount += FractionPart;
+		}
+
+		if (bNegative)
+		{
+			SanitizedAmount = Rules.NegativePrefixString + SanitizedAmount + Rules.NegativeSuffixString;
+		}
+
+		return Row->symbol.format.Replace(TEXT("$"), *Row->symbol.grapheme).Replace(TEXT("1"), *SanitizedAmount);
+	}
+
+	UE_LOG(LogXsollaStore, Error, TEXT("%s: Failed to format price (%s %s)"), *VA_FUNC_LINE, *Amount.ToString(), *Currency);
+	return FString();
+}
+
+FString UXsollaStoreSubsystem::FormatStorePrice(const FStorePrice& Price) const
+{
+	return FormatPriceDecimal(Price.amount_decimal, Price.currency);
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -16,6 +16,113 @@ enum class EXsollaOrderStatus : uint8
 	Done
 };
 
+/** Store mutation that can be journaled while offline */
+UENUM(BlueprintType)
+enum class EXsollaOfflineActionType : uint8
+{
+	ConsumeItem,
+	BuyWithVirtualCurrency,
+	AddToCart,
+	RemoveFromCart,
+	ClearCart
+};
+
+/** Virtual items query ordering */
+UENUM(BlueprintType)
+enum class EXsollaItemsSortBy : uint8
+{
+	/** Keep catalog order */
+	None,
+	Name,
+	Price,
+	/** Default virtual price amount, items without virtual price go last */
+	VirtualPrice,
+	/** Best search matches first (catalog order without search text) */
+	Relevance
+};
+
+/** Virtual items query filter by is_free flag */
+UENUM(BlueprintType)
+enum class EXsollaItemsFreeFilter : uint8
+{
+	Any,
+	Free,
+	Paid
+};
+
+/**
+ * Exact fixed-point decimal amount: Value minor units, 10^Scale minor units per currency unit.
+ * Default decimal is invalid (amount is missing, which isn't the same as zero one).
+ * Arithmetic with invalid operand or overflowing result gives invalid decimal.
+ */
+USTRUCT(BlueprintType)
+struct XSOLLASTORE_API FStoreDecimal
+{
+	GENERATED_BODY()
+
+	/** Amount in minor units */
+	UPROPERTY(BlueprintReadOnly, Category = "Decimal")
+	int64 Value;
+
+	/** Number of fraction digits */
+	UPROPERTY(BlueprintReadOnly, Category = "Decimal")
+	int32 Scale;
+
+	/** Whether amount is set (parsed successfully or calculated without overflow) */
+	UPROPERTY(BlueprintReadOnly, Category = "Decimal")
+	bool bIsValid;
+
+public:
+	FStoreDecimal()
+		: Value(0)
+		, Scale(0)
+		, bIsValid(false){};
+
+	FStoreDecimal(int64 InValue, int32 InScale)
+		: Value(InValue)
+		, Scale(InScale)
+		, bIsValid(true){};
+
+	/** Maximal number of fraction digits, extra digits are truncated on parse */
+	static const int32 MaxScale = 9;
+
+	/** Parse decimal string (e.g. "1.99"), keeping all its fraction digits. False (and invalid decimal) if string isn't a number or doesn't fit */
+	static bool Parse(const FString& String, FStoreDecimal& OutDecimal);
+
+	bool IsValid() const;
+
+	/** Amount in minor units of another scale, extra digits are rounded half to even */
+	int64 GetValue(int32 InScale) const;
+
+	/** Same amount with another scale, extra digits are rounded half to even */
+	FStoreDecimal Rescale(int32 InScale) const;
+
+	/** Negative if this amount is less than other one, positive if greater, zero if equal. Invalid amount is less than any valid one */
+	int32 Compare(const FStoreDecimal& Other) const;
+
+	/** Discount of Amount relative to AmountWithoutDiscount in whole percents (0 if there is no discount) */
+	static int32 GetDiscountPercent(const FStoreDecimal& Amount, const FStoreDecimal& AmountWithoutDiscount);
+
+	/** True if amount is valid and equals zero */
+	bool IsZero() const;
+
+	/** Decimal string with all fraction digits, e.g. "1.99" (empty if decimal is invalid) */
+	FString ToString() const;
+
+	double ToDouble() const;
+
+	FStoreDecimal operator+(const FStoreDecimal& Other) const;
+	FStoreDecimal operator-(const FStoreDecimal& Other) const;
+	FStoreDecimal operator*(int32 Quantity) const;
+
+	bool operator==(const FStoreDecimal& Other) const { return Compare(Other) == 0; }
+	bool operator!=(const FStoreDecimal& Other) const { return Compare(Other) != 0; }
+	bool operator<(const FStoreDecimal& Other) const { return Compare(Other) < 0; }
+	bool operator>(const FStoreDecimal& Other) const { return Compare(Other) > 0; }
+	bool operator<=(const FStoreDecimal& Other) const { return Compare(Other) <= 0; }
+	bool operator>=(const FStoreDecimal& Other) const { return Compare(Other) >= 0; }
+};
+
 USTRUCT(BlueprintType)
 struct XSOLLASTORE_API FStorePrice
 {
@@ -30,8 +137,22 @@ struct XSOLLASTORE_API FStorePrice
 	UPROPERTY(BlueprintReadOnly, Category = "Price")
 	FString currency;
 
+	/** Exact amount, parsed once when price is received */
+	UPROPERTY(BlueprintReadOnly, Category = "Price")
+	FStoreDecimal amount_decimal;
+
+	/** Exact amount without discount, parsed once when price is received */
+	UPROPERTY(BlueprintReadOnly, Category = "Price")
+	FStoreDecimal amount_without_discount_decimal;
+
 public:
 	FStorePrice(){};
+
+	/** Parse string amounts into decimal ones */
+	void ParseAmounts();
+
+	/** Discount in whole percents (0 if there is no discount) */
+	int32 GetDiscountPercent() const;
 };
 
 USTRUCT(BlueprintType)
@@ -69,6 +190,18 @@ struct XSOLLASTORE_API FVirtualCurrencyCalculatedPrice
 
 	UPROPERTY(BlueprintReadOnly, Category = "Virtual Currency Calculated Price")
 	FString amount_without_discount;
+
+	/** Exact amount, parsed once when price is received */
+	UPROPERTY(BlueprintReadOnly, Category = "Virtual Currency Calculated Price")
+	FStoreDecimal amount_decimal;
+
+	/** Exact amount without discount, parsed once when price is received */
+	UPROPERTY(BlueprintReadOnly, Category = "Virtual Currency Calculated Price")
+	FStoreDecimal amount_without_discount_decimal;
+
+public:
+	/** Parse string amounts into decimal ones */
+	void ParseAmounts();
 };
 
 USTRUCT(BlueprintType)
@@ -437,6 +570,7 @@ public:
 		: sku(Item.sku)
 		, name(Item.name)
 		, is_free(Item.is_free)
+		, price(Item.price)
 		, image_url(Item.image_url)
 		, quantity(0){};
 
@@ -444,6 +578,7 @@ public:
 		: sku(CurrencyPackage.sku)
 		, name(CurrencyPackage.name)
 		, is_free(CurrencyPackage.is_free)
+		, price(CurrencyPackage.price)
 		, image_url(CurrencyPackage.image_url)
 		, quantity(0){};
 
@@ -612,3 +747,302 @@ public:
 public:
 	FStoreSubscriptionData(){};
 };
+
+USTRUCT(BlueprintType)
+struct XSOLLASTORE_API FStoreConsumeQueueStats
+{
+public:
+	GENERATED_BODY()
+
+	/** Number of distinct SKUs waiting to be sent */
+	UPROPERTY(BlueprintReadOnly, Category = "Consume Queue Stats")
+	int32 QueueDepth;
+
+	/** Total quantity waiting to be sent */
+	UPROPERTY(BlueprintReadOnly, Category = "Consume Queue Stats")
+	int32 PendingQuantity;
+
+	/** Number of consume requests sent but not yet answered */
+	UPROPERTY(BlueprintReadOnly, Category = "Consume Queue Stats")
+	int32 InFlightRequests;
+
+	/** Number of queue flushes completed since initialization */
+	UPROPERTY(BlueprintReadOnly, Category = "Consume Queue Stats")
+	int32 CompletedFlushes;
+
+	/** Number of consume calls queued since initialization */
+	UPROPERTY(BlueprintReadOnly, Category = "Consume Queue Stats")
+	int32 QueuedCalls;
+
+	/** Number of consume requests actually sent since initialization */
+	UPROPERTY(BlueprintReadOnly, Category = "Consume Queue Stats")
+	int32 SentRequests;
+
+	/** Time (in seconds) between last flush and its last response */
+	UPROPERTY(BlueprintReadOnly, Category = "Consume Queue Stats")
+	float LastFlushLatency;
+
+	/** Average time (in seconds) between flush and its last response */
+	UPROPERTY(BlueprintReadOnly, Category = "Consume Queue Stats")
+	float AverageFlushLatency;
+
+public:
+	FStoreConsumeQueueStats()
+		: QueueDepth(0)
+		, PendingQuantity(0)
+		, InFlightRequests(0)
+		, CompletedFlushes(0)
+		, QueuedCalls(0)
+		, SentRequests(0)
+		, LastFlushLatency(0.f)
+		, AverageFlushLatency(0.f){};
+};
+
+USTRUCT(BlueprintType)
+struct XSOLLASTORE_API FStorePaymentTokenPrefetchStats
+{
+public:
+	GENERATED_BODY()
+
+	/** Number of prefetched tokens waiting to be used */
+	UPROPERTY(BlueprintReadOnly, Category = "Payment Token Prefetch Stats")
+	int32 CachedTokens;
+
+	/** Number of prefetch requests sent but not yet answered */
+	UPROPERTY(BlueprintReadOnly, Category = "Payment Token Prefetch Stats")
+	int32 InFlightRequests;
+
+	/** Number of prefetch requests sent since initialization */
+	UPROPERTY(BlueprintReadOnly, Category = "Payment Token Prefetch Stats")
+	int32 Prefetches;
+
+	/** Number of prefetch requests failed since initialization */
+	UPROPERTY(BlueprintReadOnly, Category = "Payment Token Prefetch Stats")
+	int32 FailedPrefetches;
+
+	/** Number of purchases completed with prefetched token */
+	UPROPERTY(BlueprintReadOnly, Category = "Payment Token Prefetch Stats")
+	int32 Hits;
+
+	/** Number of purchases which had to fetch token */
+	UPROPERTY(BlueprintReadOnly, Category = "Payment Token Prefetch Stats")
+	int32 Misses;
+
+	/** Number of prefetched tokens expired or evicted without use */
+	UPROPERTY(BlueprintReadOnly, Category = "Payment Token Prefetch Stats")
+	int32 WastedTokens;
+
+	/** Share of purchases completed with prefetched token */
+	UPROPERTY(BlueprintReadOnly, Category = "Payment Token Prefetch Stats")
+	float HitRate;
+
+	/** Share of prefetched tokens which were wasted */
+	UPROPERTY(BlueprintReadOnly, Category = "Payment Token Prefetch Stats")
+	float WasteRate;
+
+public:
+	FStorePaymentTokenPrefetchStats()
+		: CachedTokens(0)
+		, InFlightRequests(0)
+		, Prefetches(0)
+		, FailedPrefetches(0)
+		, Hits(0)
+		, Misses(0)
+		, WastedTokens(0)
+		, HitRate(0.f)
+		, WasteRate(0.f){};
+};
+
+USTRUCT(BlueprintType)
+struct XSOLLASTORE_API FStoreOfflineAction
+{
+public:
+	GENERATED_BODY()
+
+	/** Unique action identifier */
+	UPROPERTY(BlueprintReadOnly, Category = "Offline Action")
+	FString ActionId;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Offline Action")
+	EXsollaOfflineActionType Type;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Offline Action")
+	FString ItemSKU;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Offline Action")
+	FString CurrencySKU;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Offline Action")
+	FString CartId;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Offline Action")
+	FString InstanceID;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Offline Action")
+	int32 Quantity;
+
+	/** Time (UTC) when action was journaled */
+	UPROPERTY(BlueprintReadOnly, Category = "Offline Action")
+	FDateTime CreatedAt;
+
+	/** Number of delivery attempts made in current session */
+	UPROPERTY(BlueprintReadOnly, Category = "Offline Action")
+	int32 Attempts;
+
+public:
+	FStoreOfflineAction()
+		: Type(EXsollaOfflineActionType::ConsumeItem)
+		, Quantity(0)
+		, Attempts(0){};
+};
+
+/** Estimated memory (in bytes) held by Store subsystem caches */
+USTRUCT(BlueprintType)
+struct XSOLLASTORE_API FStoreMemoryReport
+{
+public:
+	GENERATED_BODY()
+
+	/** Virtual items catalog */
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Report")
+	int64 Items;
+
+	/** Item groups */
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Report")
+	int64 Groups;
+
+	/** Full-text search index of virtual items */
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Report")
+	int64 SearchIndex;
+
+	/** Virtual currencies and their balance */
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Report")
+	int64 Currencies;
+
+	/** Virtual currency packages */
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Report")
+	int64 CurrencyPackages;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Report")
+	int64 Cart;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Report")
+	int64 Inventory;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Report")
+	int64 Subscriptions;
+
+	/** Decoded images (estimated as BGRA pixels of each cached brush) */
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Report")
+	int64 Images;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Report")
+	int32 ImageCount;
+
+	/** Queued cart requests, consume queue, offline journal and pending image requests */
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Report")
+	int64 PendingRequests;
+
+	/** Currency format DataTable */
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Report")
+	int64 CurrencyLibrary;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Memory Report")
+	int64 Total;
+
+public:
+	FStoreMemoryReport()
+		: Items(0)
+		, Groups(0)
+		, SearchIndex(0)
+		, Currencies(0)
+		, CurrencyPackages(0)
+		, Cart(0)
+		, Inventory(0)
+		, Subscriptions(0)
+		, Images(0)
+		, ImageCount(0)
+		, PendingRequests(0)
+		, CurrencyLibrary(0)
+		, Total(0){};
+};
+
+/** Filter, ordering and page of cached virtual items. String filters ignore case */
+USTRUCT(BlueprintType)
+struct XSOLLASTORE_API FStoreItemsQuery
+{
+public:
+	GENERATED_BODY()
+
+	/** Words to search in item name, sku, group names and description (empty for any). Last word may be incomplete */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Items Query")
+	FString SearchText;
+
+	/** Group external id items should belong to (empty for any) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Items Query")
+	FString Group;
+
+	/** Item type, e.g. virtual_good (empty for any) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Items Query")
+	FString Type;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Items Query")
+	EXsollaItemsFreeFilter FreeFilter;
+
+	/** Real price currency ISO code, e.g. USD (empty for any) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Items Query")
+	FString PriceCurrency;
+
+	/** Minimal real price, e.g. 1.99 (empty for no bound) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Items Query")
+	FString MinPrice;
+
+	/** Maximal real price, e.g. 9.99 (empty for no bound) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Items Query")
+	FString MaxPrice;
+
+	/** Virtual currency sku items should be purchasable with (empty for any) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Items Query")
+	FString VirtualCurrency;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Items Query")
+	EXsollaItemsSortBy SortBy;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Items Query")
+	bool bSortDescending;
+
+	/** Number of matching items to skip */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Items Query")
+	int32 Offset;
+
+	/** Maximal number of items to return (0 for all) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Items Query")
+	int32 Limit;
+
+public:
+	FStoreItemsQuery()
+		: FreeFilter(EXsollaItemsFreeFilter::Any)
+		, SortBy(EXsollaItemsSortBy::None)
+		, bSortDescending(false)
+		, Offset(0)
+		, Limit(0){};
+};
+
+USTRUCT(BlueprintType)
+struct XSOLLASTORE_API FStoreItemsQueryResult
+{
+public:
+	GENERATED_BODY()
+
+	/** Requested page of matching items */
+	UPROPERTY(BlueprintReadOnly, Category = "Items Query Result")
+	TArray<FStoreItem> Items;
+
+	/** Number of all matching items */
+	UPROPERTY(BlueprintReadOnly, Category = "Items Query Result")
+	int32 TotalCount;
+
+public:
+	FStoreItemsQueryResult()
+		: TotalCount(0){};
+};
@@ -26,6 +26,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store", meta = (AutoCreateRefTerm = "SuccessCallback, ErrorCallback"))
 	void LoadImage(FString URL, const FOnImageLoaded& SuccessCallback, const FOnImageLoadFailed& ErrorCallback);
 
+	/** Decode downloaded image into BGRA pixels */
+	static bool DecodeImage(const TArray<uint8>& ImageData, TArray<uint8>& OutRawData, int32& OutWidth, int32& OutHeight);
+
+	/** Number of cached image brushes */
+	int32 GetImageCount() const;
+
+	/** Estimated memory of cached images (BGRA pixels of each brush) */
+	SIZE_T GetImagesMemorySize() const;
+
+	/** Memory held by pending image requests callbacks */
+	SIZE_T GetPendingRequestsMemorySize() const;
+
 protected:
 	/** */
 	void LoadImage_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnImageLoaded SuccessCallback, FOnImageLoadFailed ErrorCallback);
@@ -26,6 +26,34 @@ public:
 	UFUNCTION(BlueprintPure, meta = (DisplayName = "Equal (StoreCart)", CompactNodeTitle = "===", ScriptMethod = "Equals", ScriptOperator = "==", Keywords = "== equal"), Category = "Xsolla|Store|Cart")
 	static bool Equal_StoreCartStoreCart(const FStoreCart& A, const FStoreCart& B);
 
+	/** Returns true if decimal A is equal to decimal B (A == B) */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Equal (StoreDecimal)", CompactNodeTitle = "==", Keywords = "== equal"), Category = "Xsolla|Store|Price")
+	static bool EqualEqual_StoreDecimalStoreDecimal(const FStoreDecimal& A, const FStoreDecimal& B);
+
+	/** Returns true if decimal A is less than decimal B (A < B) */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Less (StoreDecimal)", CompactNodeTitle = "<", Keywords = "< less"), Category = "Xsolla|Store|Price")
+	static bool Less_StoreDecimalStoreDecimal(const FStoreDecimal& A, const FStoreDecimal& B);
+
+	/** Exact sum of two decimals (A + B) */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Add (StoreDecimal)", CompactNodeTitle = "+", Keywords = "+ add plus"), Category = "Xsolla|Store|Price")
+	static FStoreDecimal Add_StoreDecimalStoreDecimal(const FStoreDecimal& A, const FStoreDecimal& B);
+
+	/** Exact product of decimal and quantity (A * B) */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Multiply (StoreDecimal)", CompactNodeTitle = "*", Keywords = "* multiply"), Category = "Xsolla|Store|Price")
+	static FStoreDecimal Multiply_StoreDecimalInt(const FStoreDecimal& A, int32 B);
+
+	/** Decimal string with all fraction digits, e.g. "1.99" */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "ToString (StoreDecimal)", CompactNodeTitle = "->", BlueprintAutocast), Category = "Xsolla|Store|Price")
+	static FString Conv_StoreDecimalToString(const FStoreDecimal& InDecimal);
+
+	/** Discount of price in whole percents (0 if there is no discount) */
+	UFUNCTION(BlueprintPure, Category = "Xsolla|Store|Price")
+	static int32 GetPriceDiscountPercent(const FStorePrice& Price);
+
+	/** Exact sum of cart items prices multiplied by their quantities. Invalid if any price is missing or items have different currencies */
+	UFUNCTION(BlueprintPure, Category = "Xsolla|Store|Cart")
+	static FStoreDecimal GetCartItemsTotal(const FStoreCart& Cart);
+
 	/** Make FDateTime structure based on a given timestamp */
 	UFUNCTION(BlueprintPure, Category = "Xsolla|Store")
 	static FDateTime MakeDateTimeFromTimestamp(int64 time);
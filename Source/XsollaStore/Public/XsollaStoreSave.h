@@ -37,6 +37,12 @@ public:
 	static FXsollaStoreSaveData Load();
 	static void Save(const FXsollaStoreSaveData& InCartData);
 
+	/** Load save object from slot or create new one, it's kept in memory for further writes */
+	static UXsollaStoreSave* LoadOrCreate();
+
+	const FXsollaStoreSaveData& GetCartData() const;
+	void SetCartData(const FXsollaStoreSaveData& InCartData);
+
 public:
 	static const FString SaveSlotName;
 
@@ -64,6 +64,31 @@ public:
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings")
 	bool UsePlatformBrowser;
 
+	/**
+	 * If enabled, payment browser widget is kept after payment console is closed and reused by next purchase
+	 * (browser view is kept by shared browser host either way). Browser widget should load pending paystation url on Construct.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings", meta = (EditCondition = "!UsePlatformBrowser"))
+	bool ReuseBrowserWidget;
+
+	/**
+	 * If enabled, PrefetchPaymentToken fetches payment token ahead of purchase, so purchase of focused item starts without waiting for it.
+	 * Each prefetched token creates an order, watch wasted tokens metric (see GetPaymentTokenPrefetchStats).
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings")
+	bool EnablePaymentTokenPrefetch;
+
+	/** Time (in seconds) prefetched payment token can be used for purchase. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings", meta = (EditCondition = "EnablePaymentTokenPrefetch", ClampMin = "1"))
+	float PaymentTokenPrefetchTTL;
+
+	/**
+	 * If enabled, payment browser URLs are watched for PayStation status and return URL redirects, so order is checked
+	 * and inventory is refreshed as soon as payment is finished (see OnPaymentStatusUpdate).
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings", meta = (EditCondition = "!UsePlatformBrowser"))
+	bool EnablePaymentCompletionDetection;
+
 	/** Enable to process tasks such as authentication and payment via Steam. */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings")
 	bool BuildForSteam;
@@ -76,6 +101,53 @@ public:
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings", meta = (EditCondition = "UseCrossPlatformAccountLinking"))
 	EXsollaPublishingPlatform Platform;
 
+	/**
+	 * Time window (in seconds) used to aggregate queued inventory item consumptions before they are sent.
+	 * Set to zero to send queued consumptions on explicit flush only.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings", meta = (ClampMin = "0"))
+	float ConsumeQueueFlushInterval;
+
+	/**
+	 * If enabled, inventory consumptions, purchases for virtual currency and cart changes are written to on-disk journal
+	 * before they are sent, and replayed in order when connection is restored or on next launch.
+	 * Only actions which didn't reach server are sent again: if result is unknown (server error, lost response), cart change
+	 * is checked against server cart, while consumption or purchase fails and inventory is requested again.
+	 * Auth tokens are not written to disk, actions from previous launch are replayed once the same user is logged in.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings")
+	bool EnableOfflineJournal;
+
+	/** Time (in seconds) before first retry of journaled actions delivery while offline, it's doubled with each failed retry (up to 32 times). */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings", meta = (EditCondition = "EnableOfflineJournal", ClampMin = "1"))
+	float OfflineJournalRetryInterval;
+
+	/**
+	 * If enabled, Store requests passed a token that Xsolla Login token manager has refreshed since use the refreshed one.
+	 * Other tokens are sent as is. Requires XsollaLogin module.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings")
+	bool UseLoginTokenProvider;
+
+	/**
+	 * If enabled, inventory, virtual currency balance, subscriptions and cart are requested as soon as Xsolla Login gets user token,
+	 * and first UpdateInventory, UpdateVirtualCurrencyBalance, UpdateSubscriptions and UpdateCart calls use these responses.
+	 * Requires XsollaLogin module.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings")
+	bool EnableLoginWarmUp;
+
+	/** If enabled, connection to Store API is opened on subsystem initialization, so first request doesn't wait for DNS lookup and TLS handshake. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings")
+	bool EnableConnectionWarmUp;
+
+	/**
+	 * Base URL of Store API used instead of https://store.xsolla.com/api (staging or mock server, for example).
+	 * Leave empty to use live service.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Settings", meta = (DisplayName = "Store API Base URL"))
+	FString StoreApiBaseURL;
+
 	/** Demo Project ID */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Store Demo")
 	FString DemoProjectID;
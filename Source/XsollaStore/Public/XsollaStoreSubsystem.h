@@ -25,12 +25,23 @@ enum class EXsollaRequestVerb : uint8
 };
 
 class UXsollaStoreImageLoader;
+class UXsollaWebBrowserWidgetPool;
 class UDataTable;
 class FJsonObject;
+class FXsollaStoreCatalog;
+struct FXsollaStoreEndpoint;
+struct FXsollaStoreResponseHandler;
+class FXsollaStoreOfflineJournal;
+class FXsollaSaveGameWriter;
+class FXsollaUtilsAssetLoader;
+class UXsollaStoreSave;
 
 DECLARE_DYNAMIC_DELEGATE(FOnStoreUpdate);
 DECLARE_DYNAMIC_DELEGATE(FOnStoreCartUpdate);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCartUpdate, const FStoreCart&, Cart);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryUpdate, const FStoreInventory&, Inventory);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnOfflineActionsUpdate, const TArray<FStoreOfflineAction>&, PendingActions);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPaymentStatusUpdate, int32, OrderId, EXsollaOrderStatus, OrderStatus);
 DECLARE_DYNAMIC_DELEGATE_ThreeParams(FOnStoreError, int32, StatusCode, int32, ErrorCode, const FString&, ErrorMessage);
 DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnFetchTokenSuccess, const FString&, AccessToken, int32, OrderId);
 DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnCheckOrder, int32, OrderId, EXsollaOrderStatus, OrderStatus);
@@ -38,6 +49,95 @@ DECLARE_DYNAMIC_DELEGATE_OneParam(FOnCurrencyUpdate, const FVirtualCurrency&, Cu
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnCurrencyPackageUpdate, const FVirtualCurrencyPackage&, CurrencyPackage);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnPurchaseUpdate, int32, OrderId);
 
+/** Aggregated inventory item consumption (one request per SKU) */
+struct FXsollaConsumeBatch
+{
+	FString AuthToken;
+	FString ItemSKU;
+	int32 Quantity;
+
+	/** Values subtracted from local inventory optimistically (used for rollback), only one of them is used depending on item */
+	int32 AppliedQuantity;
+	int32 AppliedRemainingUses;
+
+	/** Identifier of flush the batch was sent with */
+	int32 FlushId;
+
+	TArray<FOnStoreUpdate> SuccessCallbacks;
+	TArray<FOnStoreError> ErrorCallbacks;
+
+	FXsollaConsumeBatch()
+		: Quantity(0)
+		, AppliedQuantity(0)
+		, AppliedRemainingUses(0)
+		, FlushId(INDEX_NONE){};
+};
+
+/** Callbacks of journaled action, available only in session the action was made */
+struct FXsollaOfflineActionCallbacks
+{
+	FOnStoreUpdate UpdateCallback;
+	FOnStoreCartUpdate CartUpdateCallback;
+	FOnPurchaseUpdate PurchaseCallback;
+	FOnStoreError ErrorCallback;
+
+	/** Consume queue batch the action was created for */
+	int32 ConsumeBatchId;
+
+	FXsollaOfflineActionCallbacks()
+		: ConsumeBatchId(INDEX_NONE){};
+};
+
+/** Payment token fetched ahead of purchase */
+struct FXsollaPrefetchedPaymentToken
+{
+	/** Empty while token is being fetched */
+	FString AccessToken;
+	int32 OrderId;
+
+	double RequestTime;
+	double FetchTime;
+
+	/** Token request parameters, used to request token again for waiting purchase if prefetch fails */
+	FString AuthToken;
+	FString ItemSKU;
+	FString Currency;
+	FString Country;
+	FString Locale;
+
+	/** Purchase requested while token is being fetched, completed on response */
+	bool bHasWaitingPurchase;
+	FOnFetchTokenSuccess WaitingSuccessCallback;
+	FOnStoreError WaitingErrorCallback;
+
+	FXsollaPrefetchedPaymentToken()
+		: OrderId(0)
+		, RequestTime(0.0)
+		, FetchTime(0.0)
+		, bHasWaitingPurchase(false){};
+};
+
+/** User data request started ahead of the game asking for it */
+struct FXsollaStoreWarmUpRequest
+{
+	FString AuthToken;
+	double StartTime;
+
+	/** Finished request and its response, kept for first consumer */
+	bool bCompleted;
+	FHttpRequestPtr HttpRequest;
+	FHttpResponsePtr HttpResponse;
+	bool bSucceeded;
+
+	/** Handler of consumer asked for data while request is in flight */
+	FHttpRequestCompleteDelegate Consumer;
+
+	FXsollaStoreWarmUpRequest()
+		: StartTime(0.0)
+		, bCompleted(false)
+		, bSucceeded(false){};
+};
+
 UCLASS()
 class XSOLLASTORE_API UXsollaStoreSubsystem : public UGameInstanceSubsystem
 {
@@ -119,6 +219,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store|VirtualCurrency", meta = (AutoCreateRefTerm = "SuccessCallback, ErrorCallback"))
 	void UpdateSubscriptions(const FString& AuthToken, const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback);
 
+	/** Request inventory, virtual currency balance, subscriptions and current cart in parallel ahead of time,
+	 * so first UpdateInventory, UpdateVirtualCurrencyBalance, UpdateSubscriptions and UpdateCart calls don't wait for server.
+	 * Called automatically on login if EnableLoginWarmUp setting is set.
+	 *
+	 * @param AuthToken User authorization token.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store")
+	void WarmUpUserData(const FString& AuthToken);
+
 	/**
 	 * Initiate item purchase session and fetch token for payment console
 	 *
@@ -133,6 +242,24 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store", meta = (AutoCreateRefTerm = "SuccessCallback, ErrorCallback"))
 	void FetchPaymentToken(const FString& AuthToken, const FString& ItemSKU, const FString& Currency, const FString& Country, const FString& Locale, const FOnFetchTokenSuccess& SuccessCallback, const FOnStoreError& ErrorCallback);
 
+	/**
+	 * Speculatively fetch payment token (call it when item buy button is focused or hovered), so FetchPaymentToken
+	 * with the same parameters is completed without request. Unused token is dropped after PaymentTokenPrefetchTTL.
+	 * Requires EnablePaymentTokenPrefetch setting.
+	 *
+	 * @param AuthToken User authorization token.
+	 * @param ItemSKU Desired item SKU.
+	 * @param Currency (optional) Desired payment currency. Leave empty to use default value.
+	 * @param Country (optional) Desired payment country ISO code. Leave empty to use default value.
+	 * @param Locale (optional) Desired payment locale. Leave empty to use default value.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store")
+	void PrefetchPaymentToken(const FString& AuthToken, const FString& ItemSKU, const FString& Currency, const FString& Country, const FString& Locale);
+
+	/** Get payment token prefetch hit rate and wasted tokens metrics */
+	UFUNCTION(BlueprintPure, Category = "Xsolla|Store")
+	FStorePaymentTokenPrefetchStats GetPaymentTokenPrefetchStats() const;
+
 	/**
 	 * Initiate cart purchase session and fetch token for payment console
 	 *
@@ -151,10 +278,26 @@ public:
 	 *
 	 * @param AccessToken Payment token used during purchase processing.
 	 * @param BrowserWidget Widget to represent payment form. Can be set in project settings.
+	 * @param ErrorCallback Called if browser widget can't be created.
 	 */
-	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store")
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store", meta = (AutoCreateRefTerm = "ErrorCallback"))
+	void LaunchPaymentConsole(const FString& AccessToken, UUserWidget*& BrowserWidget, const FOnStoreError& ErrorCallback);
+
+	UE_DEPRECATED(4.25, "Use LaunchPaymentConsole with ErrorCallback to know when browser widget can't be created")
 	void LaunchPaymentConsole(const FString& AccessToken, UUserWidget*& BrowserWidget);
 
+	/** Create payment browser widget ahead of purchase (call it when store screen is opened),
+	 * so LaunchPaymentConsole doesn't wait for widget and browser view creation. Requires ReuseBrowserWidget setting.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store")
+	void PrewarmPaymentConsole();
+
+	/** Start background loading of Store assets (currency library and browser widget),
+	 * otherwise they are loaded on first use.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store")
+	void PrefetchAssets();
+
 	/** Check pending order status
 	 *
 	 * @param AuthToken User authorization token.
@@ -225,6 +368,27 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store|Inventory", meta = (AutoCreateRefTerm = "SuccessCallback, ErrorCallback"))
 	void ConsumeInventoryItem(const FString& AuthToken, const FString& ItemSKU, int32 Quantity, const FString& InstanceID, const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback);
 
+	/**
+	 * Queue consumption of countable inventory item. Queued quantities are aggregated per SKU and sent
+	 * after ConsumeQueueFlushInterval (see project settings) or on explicit flush. Local inventory is updated immediately.
+	 *
+	 * @param AuthToken User authorization token.
+	 * @param ItemSKU Desired item SKU.
+	 * @param Quantity Items quantity. Should be positive.
+	 * @param SuccessCallback Callback function called after successful inventory item consumption.
+	 * @param ErrorCallback Callback function called after request resulted with an error. Local inventory is restored in this case.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store|Inventory", meta = (AutoCreateRefTerm = "SuccessCallback, ErrorCallback"))
+	void QueueConsumeInventoryItem(const FString& AuthToken, const FString& ItemSKU, int32 Quantity, const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback);
+
+	/** Send all queued inventory item consumptions right now */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store|Inventory")
+	void FlushConsumeQueue();
+
+	/** Get inventory consumption queue depth and flush latency metrics */
+	UFUNCTION(BlueprintPure, Category = "Xsolla|Store|Inventory")
+	FStoreConsumeQueueStats GetConsumeQueueStats() const;
+
 	/** Get virtual currency with specified SKU
 	 *
 	 * @param CurrencySKU Desired currency SKU
@@ -254,54 +418,190 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store|VirtualCurrency", meta = (AutoCreateRefTerm = "SuccessCallback, ErrorCallback"))
 	void BuyItemWithVirtualCurrency(const FString& AuthToken, const FString& ItemSKU, const FString& CurrencySKU, const FOnPurchaseUpdate& SuccessCallback, const FOnStoreError& ErrorCallback);
 
-protected:
-	void UpdateVirtualItems_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback);
-	void UpdateItemGroups_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback);
-	void UpdateInventory_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback);
-	void UpdateVirtualCurrencies_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback);
-	void UpdateVirtualCurrencyPackages_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback);
-	void UpdateVirtualCurrencyBalance_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback);
-	void UpdateSubscriptions_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback);
+	/** Get actions from offline journal which weren't delivered yet */
+	UFUNCTION(BlueprintPure, Category = "Xsolla|Store|Offline")
+	TArray<FStoreOfflineAction> GetPendingOfflineActions() const;
 
-	void FetchPaymentToken_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnFetchTokenSuccess SuccessCallback, FOnStoreError ErrorCallback);
-	void CheckOrder_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnCheckOrder SuccessCallback, FOnStoreError ErrorCallback);
+	/** Try to deliver pending offline actions right now */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store|Offline")
+	void ReplayOfflineActions();
 
-	void CreateCart_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreCartUpdate SuccessCallback, FOnStoreError ErrorCallback);
-	void ClearCart_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreCartUpdate SuccessCallback, FOnStoreError ErrorCallback);
-	void UpdateCart_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreCartUpdate SuccessCallback, FOnStoreError ErrorCallback);
-	void AddToCart_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreCartUpdate SuccessCallback, FOnStoreError ErrorCallback);
-	void RemoveFromCart_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreCartUpdate SuccessCallback, FOnStoreError ErrorCallback);
+protected:
+	/** Check error and pass response to typed handler (same path for all endpoints) */
+	void Endpoint_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FXsollaStoreResponseHandler Handler);
 
-	void ConsumeInventoryItem_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreUpdate SuccessCallback, FOnStoreError ErrorCallback);
+	void PrefetchPaymentToken_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString PrefetchKey);
+	void WarmUp_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString WarmUpKey);
+	void ConsumeQueue_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, int32 BatchId);
 
-	void GetVirtualCurrency_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnCurrencyUpdate SuccessCallback, FOnStoreError ErrorCallback);
-	void GetVirtualCurrencyPackage_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnCurrencyPackageUpdate SuccessCallback, FOnStoreError ErrorCallback);
+	/** Finish sent consume batch: rollback local inventory if it failed, pass result to callers and reconcile inventory */
+	void CompleteConsumeBatch(int32 BatchId, bool bFailed, int32 StatusCode, int32 ErrorCode, const FString& ErrorStr);
 
-	void BuyItemWithVirtualCurrency_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnPurchaseUpdate SuccessCallback, FOnStoreError ErrorCallback);
+	void OfflineAction_HttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString ActionId);
 
 	/** Return true if error is happened */
 	bool HandleRequestError(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FOnStoreError ErrorCallback);
 
+	/** Return true if error is happened, error details are written to output params */
+	bool ParseRequestError(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, int32& OutStatusCode, int32& OutErrorCode, FString& OutErrorStr);
+
 protected:
 	/** Load save game and extract data */
 	void LoadData();
 
-	/** Save cached data or reset one if necessary */
+	/** Save cached data or reset one if necessary. Data is written in background */
 	void SaveData();
 
 	/** Check whether sandbox is enabled */
 	bool IsSandboxEnabled() const;
 
 private:
+	/** Replace cached virtual items */
+	void SetVirtualItems(const TArray<FStoreItem>& Items);
+
+	/** Replace cached virtual currency packages */
+	void SetVirtualCurrencyPackages(const TArray<FVirtualCurrencyPackage>& Packages);
+
 	/** Create http request and add Xsolla API meta */
 	TSharedRef<IHttpRequest> CreateHttpRequest(const FString& Url, const EXsollaRequestVerb Verb = EXsollaRequestVerb::GET, const FString& AuthToken = FString(), const FString& Content = FString());
 
+	/** Watch payment browser URLs to detect finished payment */
+	void WatchPaymentBrowser(UUserWidget* BrowserWidget);
+
+	UFUNCTION()
+	void HandlePaymentUrlChanged(const FText& Url);
+
+	UFUNCTION()
+	void HandlePaymentNavigation(FString Url, bool bIsRedirect);
+
+	/** Check order and refresh inventory once if URL reports payment status */
+	void DetectPaymentCompletion(const FString& Url);
+
+	UFUNCTION()
+	void HandleDetectedOrderChecked(int32 OrderId, EXsollaOrderStatus OrderStatus);
+
+	/** Create item or cart payment token request, nullptr if request can't be made (error callback is executed then) */
+	TSharedPtr<IHttpRequest> CreateFetchPaymentTokenRequest(const FXsollaStoreEndpoint& Endpoint, const FStringFormatOrderedArguments& Args, const FString& AuthToken, const FString& Currency, const FString& Country, const FString& Locale, const FOnStoreError& ErrorCallback);
+
+	/** Key of prefetched payment token for purchase parameters */
+	FString GetPaymentTokenPrefetchKey(const FString& AuthToken, const FString& ItemSKU, const FString& Currency, const FString& Country, const FString& Locale) const;
+
+	/** Complete purchase with prefetched token, return false if there is no one */
+	bool TakePrefetchedPaymentToken(const FString& PrefetchKey, const FOnFetchTokenSuccess& SuccessCallback, const FOnStoreError& ErrorCallback);
+
+	/** Drop prefetched tokens which weren't used in time */
+	void RemoveExpiredPaymentTokens();
+
+	/** Url of endpoint with request arguments and publishing platform */
+	FString GetEndpointUrl(const FXsollaStoreEndpoint& Endpoint, const FStringFormatOrderedArguments& Args);
+
+	/** Create endpoint request, response handler should be bound by caller */
+	TSharedRef<IHttpRequest> CreateEndpointRequest(const FXsollaStoreEndpoint& Endpoint, const FStringFormatOrderedArguments& Args, const FString& AuthToken, const FString& Content = FString());
+
+	/** Send endpoint request (or take warm-up response if endpoint allows it) */
+	void SendEndpointRequest(const FXsollaStoreEndpoint& Endpoint, const FStringFormatOrderedArguments& Args, const FString& AuthToken, const FXsollaStoreResponseHandler& Handler, const FString& Content = FString());
+
+	/** Handler of item or cart payment token response */
+	FXsollaStoreResponseHandler MakePaymentTokenHandler(const FOnFetchTokenSuccess& SuccessCallback, const FOnStoreError& ErrorCallback);
+
+	/** Handler of purchase for virtual currency response */
+	FXsollaStoreResponseHandler MakePurchaseHandler(const FOnPurchaseUpdate& SuccessCallback, const FOnStoreError& ErrorCallback);
+
+	/** Handler of inventory item consumption response */
+	FXsollaStoreResponseHandler MakeConsumeHandler(const FOnStoreUpdate& SuccessCallback, const FOnStoreError& ErrorCallback);
+
+	/** Handler of cart item change response, cart is synced with server if change is rejected */
+	FXsollaStoreResponseHandler MakeCartItemHandler(const FOnStoreCartUpdate& SuccessCallback, const FOnStoreError& ErrorCallback);
+
+	/** Handler of cart clearing response */
+	FXsollaStoreResponseHandler MakeClearCartHandler(const FOnStoreCartUpdate& SuccessCallback, const FOnStoreError& ErrorCallback);
+
+	/** Start warm-up request of endpoint, response is held for first consumer */
+	void StartWarmUpRequest(const FXsollaStoreEndpoint& Endpoint, const FString& AuthToken);
+
+	/** Pass warm-up response to consumer (once it's received), return false if there is no warm-up request for token */
+	bool TakeWarmUpRequest(const FXsollaStoreEndpoint& Endpoint, const FString& AuthToken, const FHttpRequestCompleteDelegate& Consumer);
+
+	void HandleAuthTokenReceived(const UObject* InGameInstance, const FString& Token);
+
+	/** Create inventory item consumption request */
+	TSharedRef<IHttpRequest> CreateConsumeRequest(const FString& AuthToken, const FString& ItemSKU, int32 Quantity, const FString& InstanceID);
+
+	/** Create purchase for virtual currency request */
+	TSharedRef<IHttpRequest> CreateBuyItemWithVirtualCurrencyRequest(const FString& AuthToken, const FString& ItemSKU, const FString& CurrencySKU);
+
+	/** Create cart item quantity change request */
+	TSharedRef<IHttpRequest> CreateAddToCartRequest(const FString& AuthToken, const FString& CartId, const FString& ItemSKU, int32 Quantity);
+
+	/** Apply cart item quantity change to local cart before it's synced with server */
+	void UpdateCartItemLocally(const FString& ItemSKU, int32 Quantity);
+
+	/** Create cart item removal request */
+	TSharedRef<IHttpRequest> CreateRemoveFromCartRequest(const FString& AuthToken, const FString& CartId, const FString& ItemSKU);
+
+	/** Create cart clearing request */
+	TSharedRef<IHttpRequest> CreateClearCartRequest(const FString& AuthToken, const FString& CartId);
+
+	/** Create request for journaled action, returns null for unknown action type */
+	TSharedPtr<IHttpRequest> CreateOfflineActionRequest(const FStoreOfflineAction& Action, const FString& AuthToken);
+
+	/** Write action to offline journal and start its delivery */
+	void JournalOfflineAction(FStoreOfflineAction Action, const FString& AuthToken, const FXsollaOfflineActionCallbacks& Callbacks);
+
+	/** Write action to offline journal without delivery, returns action id */
+	FString AppendOfflineAction(FStoreOfflineAction Action, const FString& AuthToken);
+
+	/** Journal consumptions that wait for aggregation window (or drop them with error if journal isn't used) without sending requests */
+	void DiscardConsumeQueue();
+
+	/** Send oldest pending journaled action if nothing is in flight and no retry is scheduled */
+	void ProcessOfflineJournal();
+
+	/** Schedule retry of journaled actions delivery, interval grows with each failed attempt */
+	void ScheduleOfflineReplay();
+
+	/** Check result of journaled action which could reach server: cart change is compared with server cart, other actions are dropped */
+	void ReconcileOfflineAction(const FString& ActionId, const FString& AuthToken);
+
+	/** Remove action from journal and fail it with provided error */
+	void DropOfflineAction(const FString& ActionId, const FString& ErrorStr);
+
+	/** Request server state changed by journaled action with unknown result */
+	void ResyncOfflineActionState(EXsollaOfflineActionType ActionType, const FString& AuthToken);
+
+	/** Check whether server cart already has change made by journaled cart action */
+	static bool IsCartOfflineActionApplied(const FStoreOfflineAction& Action, const FStoreCart& ServerCart);
+
+	/** Check whether current user has journaled cart actions, live cart requests wait for them */
+	bool HasPendingCartOfflineActions() const;
+
+	/** Get current token if it belongs to user journaled action was made by, empty otherwise (or if action has no user) */
+	FString GetOfflineActionAuthToken(const FString& UserId) const;
+
+	/** Check whether journaled action is sent through cart requests queue */
+	static bool IsCartOfflineAction(EXsollaOfflineActionType ActionType);
+
+	/** Get token request should be sent with: token that replaced AuthToken by refresh if token provider is enabled, AuthToken otherwise */
+	FString GetActualAuthToken(const FString& AuthToken) const;
+
+	/** Check whether offline journal is used */
+	bool IsOfflineJournalEnabled() const;
+
+	/** Subtract quantity from remaining uses (items with limited uses) or quantity of cached inventory item, applied value is written to batch */
+	void ApplyConsumeBatch(FXsollaConsumeBatch& Batch, int32 Quantity);
+
+	/** Restore cached inventory item values subtracted by batch */
+	void RevertConsumeBatch(FXsollaConsumeBatch& Batch);
+
+	/** Replace cached inventory with server state and apply consumptions that aren't sent yet */
+	void SetInventory(FStoreInventory& ReceivedInventory);
+
+	/** Request inventory to replace optimistic values once all sent consumptions are answered */
+	void ReconcileInventory(const FString& AuthToken);
+
 	/** Serialize json object into string */
 	FString SerializeJson(const TSharedPtr<FJsonObject> DataJson) const;
 
-	/** Parse JWT token and get its payload as json object */
-	bool ParseTokenPayload(const FString& Token, TSharedPtr<FJsonObject>& PayloadJsonObject) const;
-
 	/** Try to execute next request in queue */
 	void ProcessNextCartRequest();
 
@@ -311,6 +611,80 @@ private:
 	/** Queue to store cart change requests */
 	TArray<TSharedRef<IHttpRequest>> CartRequestsQueue;
 
+	/** Inventory item consumptions waiting to be sent (by SKU and auth token) */
+	TMap<TPair<FString, FString>, FXsollaConsumeBatch> ConsumeQueue;
+
+	/** Inventory item consumptions sent and waiting for response (by batch id) */
+	TMap<int32, FXsollaConsumeBatch> ConsumeInFlight;
+
+	/** Start time and number of unanswered requests of each pending flush (by flush id) */
+	TMap<int32, TPair<double, int32>> PendingConsumeFlushes;
+
+	/** Timer used to send consume queue after aggregation window */
+	FTimerHandle ConsumeQueueTimerHandle;
+
+	/** Last used consume batch identifier */
+	int32 LastConsumeBatchId;
+
+	/** Last used consume flush identifier */
+	int32 LastConsumeFlushId;
+
+	/** Consume queue metrics */
+	FStoreConsumeQueueStats ConsumeQueueStats;
+
+	/** Auth token of last payment (used for order check of detected payment) */
+	FString PaymentAuthToken;
+
+	/** Order of last fetched payment token */
+	int32 PaymentOrderId;
+
+	/** Whether payment status was detected in shown payment console */
+	bool bPaymentCompletionDetected;
+
+	/** Whether inventory refresh was requested for detected payment */
+	bool bPaymentInventoryRequested;
+
+	/** Speculatively fetched payment tokens (by prefetch key) */
+	TMap<FString, FXsollaPrefetchedPaymentToken> PrefetchedPaymentTokens;
+
+	/** Payment token prefetch metrics */
+	FStorePaymentTokenPrefetchStats PaymentTokenPrefetchStats;
+
+	/** User data requested on login (by endpoint name) */
+	TMap<FString, FXsollaStoreWarmUpRequest> WarmUpRequests;
+
+	FDelegateHandle AuthTokenReceivedHandle;
+
+	/** On-disk journal of Store mutations (valid if enabled in settings) */
+	TSharedPtr<FXsollaStoreOfflineJournal> OfflineJournal;
+
+	/** Background writer of cart data, repeated saves are coalesced */
+	TSharedPtr<FXsollaSaveGameWriter> SaveWriter;
+
+	/** Cached virtual items, groups and currency packages in compact form */
+	TSharedPtr<FXsollaStoreCatalog> Catalog;
+
+	/** Lazy loader of currency library */
+	TSharedPtr<FXsollaUtilsAssetLoader> CurrencyLibraryLoader;
+
+	/** Lazy loader of default browser widget (price formatting shouldn't wait for it) */
+	TSharedPtr<FXsollaUtilsAssetLoader> BrowserWidgetLoader;
+
+	/** Callbacks of journaled actions made in current session (by action id) */
+	TMap<FString, FXsollaOfflineActionCallbacks> OfflineActionCallbacks;
+
+	/** Timer used to retry delivery of journaled actions */
+	FTimerHandle OfflineReplayTimerHandle;
+
+	/** Whether journaled action is being sent now */
+	bool bOfflineActionInProgress;
+
+	/** Journaled cart request in cart requests queue, it's the only one sent while journal has cart actions */
+	TSharedPtr<IHttpRequest> OfflineCartRequest;
+
+	/** Number of failed delivery attempts in a row, used for retry backoff */
+	int32 FailedOfflineReplays;
+
 public:
 	/** Get list of cached virtual items filtered by Category
 	 *
@@ -323,6 +697,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store")
 	TArray<FStoreItem> GetVirtualItemsWithoutGroup() const;
 
+	/** Get page of cached virtual items matching query filters, sorted as requested */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store")
+	FStoreItemsQueryResult QueryVirtualItems(const FStoreItemsQuery& Query) const;
+
+	/** Search cached virtual items by name, sku, group names and description, best matches first
+	 *
+	 * @param SearchText Words to search, last word may be incomplete and words may have a typo.
+	 * @param Limit Maximal number of items to return (0 for all).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store")
+	FStoreItemsQueryResult SearchVirtualItems(const FString& SearchText, int32 Limit = 20) const;
+
 	/** Get cached items data */
 	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store")
 	FStoreItemsData GetItemsData() const;
@@ -359,27 +745,37 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Xsolla|Store")
 	UDataTable* GetCurrencyLibrary() const;
 
+	/** Get estimated memory held by cached catalog, cart, inventory, images and pending requests (see Xsolla.MemReport) */
+	UFUNCTION(BlueprintPure, Category = "Xsolla|Store")
+	FStoreMemoryReport GetMemoryReport() const;
+
 public:
 	/** Event occured when the cart was changed or updated */
 	UPROPERTY(BlueprintAssignable, Category = "Xsolla|Store|Cart")
 	FOnCartUpdate OnCartUpdate;
 
+	/** Event occured when cached inventory was changed or updated */
+	UPROPERTY(BlueprintAssignable, Category = "Xsolla|Store|Inventory")
+	FOnInventoryUpdate OnInventoryUpdate;
+
+	/** Event occured when list of pending offline actions was changed */
+	UPROPERTY(BlueprintAssignable, Category = "Xsolla|Store|Offline")
+	FOnOfflineActionsUpdate OnOfflineActionsUpdate;
+
+	/** Event occured when payment console reported finished payment and its order was checked */
+	UPROPERTY(BlueprintAssignable, Category = "Xsolla|Store")
+	FOnPaymentStatusUpdate OnPaymentStatusUpdate;
+
 protected:
 	/** Cached Xsolla Store project id */
 	FString ProjectID;
 
-	/** Cached virtual items list */
-	FStoreItemsData ItemsData;
-
 	/** Current cart */
 	FStoreCart Cart;
 
 	/** Cached list of virtual currencies */
 	FVirtualCurrencyData VirtualCurrencyData;
 
-	/** Cached virtual currency packages */
-	FVirtualCurrencyPackagesData VirtualCurrencyPackages;
-
 	/** Cached virtual currency balance */
 	FVirtualCurrencyBalanceData VirtualCurrencyBalance;
 
@@ -401,8 +797,8 @@ protected:
 	/** Pending paystation url to be opened in browser */
 	FString PengindPaystationUrl;
 
-	/** Loaded currency library asset */
-	UPROPERTY(BlueprintReadOnly, Category = "Xsolla|Currency")
+	/** Loaded currency library asset (Blueprint reads load it through GetCurrencyLibrary) */
+	UPROPERTY(BlueprintReadOnly, BlueprintGetter = GetCurrencyLibrary, Category = "Xsolla|Currency")
 	UDataTable* CurrencyLibrary;
 
 public:
@@ -412,8 +808,29 @@ private:
 	UPROPERTY()
 	UXsollaStoreImageLoader* ImageLoader;
 
+	/** Payment browser widget reused between purchases */
+	UPROPERTY()
+	UXsollaWebBrowserWidgetPool* BrowserWidgetPool;
+
+	UPROPERTY()
+	TSoftClassPtr<UUserWidget> DefaultBrowserWidgetClass;
+
+	/** Currency library asset (loaded on first GetCurrencyLibrary call) */
 	UPROPERTY()
-	TSubclassOf<UUserWidget> DefaultBrowserWidgetClass;
+	TSoftObjectPtr<UDataTable> CurrencyLibraryAsset;
+
+	/** Keep loaded currency library in CurrencyLibrary property */
+	void HandleAssetsLoaded();
+
+	/** Get browser widget class set in settings or default one (loaded on first use) */
+	TSubclassOf<UUserWidget> GetBrowserWidgetClass();
+
+	/** Get payment browser widget pool (created on first use) */
+	UXsollaWebBrowserWidgetPool* GetBrowserWidgetPool();
+
+	/** Save object kept in memory, so slot isn't read on each save */
+	UPROPERTY()
+	UXsollaStoreSave* SaveInstance;
 
 public:
 	/** Async load image from web
@@ -428,4 +845,12 @@ public:
 	/** Format store price using currency-format library https://github.com/xsolla/currency-format */
 	UFUNCTION(BlueprintPure, Category = "Xsolla|Store")
 	FString FormatPrice(float Amount, const FString& Currency = TEXT("USD")) const;
+
+	/** Format exact store price using currency-format library, amount is rounded to currency minor units without float conversion */
+	UFUNCTION(BlueprintPure, Category = "Xsolla|Store")
+	FString FormatPriceDecimal(const FStoreDecimal& Amount, const FString& Currency = TEXT("USD")) const;
+
+	/** Format store price using its exact amount and currency */
+	UFUNCTION(BlueprintPure, Category = "Xsolla|Store")
+	FString FormatStorePrice(const FStorePrice& Price) const;
 };
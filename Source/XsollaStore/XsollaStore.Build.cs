@@ -17,7 +17,8 @@ public class XsollaStore : ModuleRules
                 "Json",
                 "JsonUtilities",
                 "UMG",
-                "XsollaWebBrowser"
+                "XsollaWebBrowser",
+                "XsollaUtils"
             }
             );
 
@@ -0,0 +1,116 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsCrypto.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace XsollaUtilsCryptoTests
+{
+	TArray<uint8> FromHex(const FString& Hex)
+	{
+		TArray<uint8> Bytes;
+		Bytes.SetNumUninitialized(Hex.Len() / 2);
+		HexToBytes(Hex, Bytes.GetData());
+		return Bytes;
+	}
+
+	TArray<uint8> FromString(const ANSICHAR* String)
+	{
+		return TArray<uint8>(reinterpret_cast<const uint8*>(String), FCStringAnsi::Strlen(String));
+	}
+
+	FString ToHex(const uint8* Digest)
+	{
+		return BytesToHex(Digest, FXsollaUtilsCrypto::Sha256DigestSize).ToLower();
+	}
+
+	FString Sha256(const TArray<uint8>& Data)
+	{
+		uint8 Digest[FXsollaUtilsCrypto::Sha256DigestSize];
+		FXsollaUtilsCrypto::Sha256(Data.GetData(), Data.Num(), Digest);
+		return ToHex(Digest);
+	}
+
+	FString HmacSha256(const TArray<uint8>& Key, const TArray<uint8>& Data)
+	{
+		uint8 Digest[FXsollaUtilsCrypto::Sha256DigestSize];
+		FXsollaUtilsCrypto::HmacSha256(Key.GetData(), Key.Num(), Data.GetData(), Data.Num(), Digest);
+		return ToHex(Digest);
+	}
+
+	/** 1024-bit key and RS256 signature of "header.payload" */
+	static const TCHAR* RsaModulus = TEXT("D256CF38233B35D94F9F6246A1DE64B64931AF9F016A35C5DC91AA18B0FD09C8ED6D8D30E8801562594C167659F0CCE277A56E07180D90B669EBF02333CA62A1215B09A79C41CB1ACF28EDCE88917EF6BF4C79461F4FEBC10D62606CFC21E4EB6570B1E2F746CCEA0C813CAD0A3E84BEC12836816B07C154B2977659F954C42F");
+	static const TCHAR* RsaExponent = TEXT("010001");
+	static const TCHAR* RsaSignature = TEXT("99ca3b866b2af09579e598b6a2cba72347df5dffae2d93d61b35c2773c583558c2da25495237826054a738fe6efe82fe6c42917b56bdcb1ded6f3c79d1baeb5aed7c5754c389467e81a2f2f76825464f07d8ab82b6298f13ede0268ba5e1c4c31970f9b3d9b50eba24e2d359dbe4bbca0102f8882f28f074f45ac0ad5b0fd0fd");
+} // namespace XsollaUtilsCryptoTests
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXsollaUtilsCryptoSha256Test, "Xsolla.Utils.Crypto.Sha256", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FXsollaUtilsCryptoSha256Test::RunTest(const FString& Parameters)
+{
+	using namespace XsollaUtilsCryptoTests;
+
+	// NIST FIPS 180-2 examples
+	TestEqual(TEXT("Empty message"), Sha256(TArray<uint8>()), TEXT("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+	TestEqual(TEXT("One block message"), Sha256(FromString("abc")), TEXT("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+	TestEqual(TEXT("Two block message"), Sha256(FromString("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")), TEXT("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXsollaUtilsCryptoHmacSha256Test, "Xsolla.Utils.Crypto.HmacSha256", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FXsollaUtilsCryptoHmacSha256Test::RunTest(const FString& Parameters)
+{
+	using namespace XsollaUtilsCryptoTests;
+
+	// RFC 4231 test cases 1, 2 and 6
+	TArray<uint8> Key;
+	Key.Init(0x0b, 20);
+	TestEqual(TEXT("Test case 1"), HmacSha256(Key, FromString("Hi There")), TEXT("b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7"));
+
+	TestEqual(TEXT("Test case 2"), HmacSha256(FromString("Jefe"), FromString("what do ya want for nothing?")), TEXT("5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"));
+
+	Key.Init(0xaa, 131);
+	TestEqual(TEXT("Test case 6"), HmacSha256(Key, FromString("Test Using Larger Than Block-Size Key - Hash Key First")), TEXT("60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXsollaUtilsCryptoRsaTest, "Xsolla.Utils.Crypto.RsaPkcs1Sha256", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FXsollaUtilsCryptoRsaTest::RunTest(const FString& Parameters)
+{
+	using namespace XsollaUtilsCryptoTests;
+
+	FXsollaRsaPublicKey Key;
+	if (!TestTrue(TEXT("Key is imported"), Key.Initialize(FromHex(RsaModulus), FromHex(RsaExponent))))
+	{
+		return false;
+	}
+
+	const TArray<uint8> Signature = FromHex(RsaSignature);
+	const TArray<uint8> Data = FromString("header.payload");
+	TestTrue(TEXT("Valid signature"), Key.VerifyPkcs1Sha256(Data.GetData(), Data.Num(), Signature));
+
+	const TArray<uint8> TamperedData = FromString("header.payloae");
+	TestFalse(TEXT("Tampered data"), Key.VerifyPkcs1Sha256(TamperedData.GetData(), TamperedData.Num(), Signature));
+
+	TArray<uint8> TamperedSignature = Signature;
+	TamperedSignature[10] ^= 0x01;
+	TestFalse(TEXT("Tampered signature"), Key.VerifyPkcs1Sha256(Data.GetData(), Data.Num(), TamperedSignature));
+
+	TestFalse(TEXT("Short signature"), Key.VerifyPkcs1Sha256(Data.GetData(), Data.Num(), TArray<uint8>(Signature.GetData(), Signature.Num() - 1)));
+
+	FXsollaRsaPublicKey EvenModulusKey;
+	TArray<uint8> EvenModulus = FromHex(RsaModulus);
+	EvenModulus.Last() &= 0xfe;
+	TestFalse(TEXT("Even modulus is rejected"), EvenModulusKey.Initialize(EvenModulus, FromHex(RsaExponent)));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
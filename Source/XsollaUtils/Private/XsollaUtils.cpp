@@ -0,0 +1,57 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtils.h"
+
+#include "XsollaUtilsConnectionWarmer.h"
+#include "XsollaUtilsDefines.h"
+#include "XsollaUtilsHttpTelemetry.h"
+#include "XsollaUtilsTokenParser.h"
+
+#if WITH_EDITOR
+#include "AssetRegistryModule.h"
+#include "GameDelegates.h"
+#endif
+
+void FXsollaUtilsModule::StartupModule()
+{
+	FXsollaHttpTelemetry::Get().Initialize();
+
+#if WITH_EDITOR
+	ModifyCookHandle = FGameDelegates::Get().GetModifyCookDelegate().AddRaw(this, &FXsollaUtilsModule::ModifyCook);
+#endif // WITH_EDITOR
+
+	UE_LOG(LogXsollaUtils, Log, TEXT("%s: XsollaUtils module started"), *VA_FUNC_LINE);
+}
+
+void FXsollaUtilsModule::ShutdownModule()
+{
+#if WITH_EDITOR
+	FGameDelegates::Get().GetModifyCookDelegate().Remove(ModifyCookHandle);
+#endif // WITH_EDITOR
+
+	FXsollaHttpTelemetry::Get().Shutdown();
+	FXsollaUtilsTokenParser::ResetCache();
+	FXsollaUtilsConnectionWarmer::Reset();
+}
+
+#if WITH_EDITOR
+void FXsollaUtilsModule::ModifyCook(TArray<FName>& PackagesToCook, TArray<FName>& PackagesToNeverCook)
+{
+	// SDK assets are referenced by soft paths only, so cooker can't find them through references
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	for (const TCHAR* Directory : {TEXT("/Xsolla/Browser"), TEXT("/Xsolla/Data")})
+	{
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPath(FName(Directory), Assets, true);
+		for (const FAssetData& Asset : Assets)
+		{
+			PackagesToCook.AddUnique(Asset.PackageName);
+		}
+	}
+}
+#endif // WITH_EDITOR
+
+IMPLEMENT_MODULE(FXsollaUtilsModule, XsollaUtils)
+
+DEFINE_LOG_CATEGORY(LogXsollaUtils);
@@ -0,0 +1,83 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsAssetLoader.h"
+
+#include "XsollaUtilsDefines.h"
+#include "XsollaUtilsStats.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Assets Blocking Load"), STAT_XsollaAssetsBlockingLoad, STATGROUP_Xsolla);
+
+FXsollaUtilsAssetLoader::FXsollaUtilsAssetLoader(const TArray<FSoftObjectPath>& InAssets)
+	: Assets(InAssets)
+	, RequestTime(0.0)
+{
+}
+
+FXsollaUtilsAssetLoader::~FXsollaUtilsAssetLoader()
+{
+	if (Handle.IsValid())
+	{
+		Handle->CancelHandle();
+		Handle.Reset();
+	}
+}
+
+void FXsollaUtilsAssetLoader::Prefetch(const FSimpleDelegate& InOnLoaded)
+{
+	if (InOnLoaded.IsBound())
+	{
+		OnLoaded = InOnLoaded;
+	}
+
+	if (Handle.IsValid() || Assets.Num() == 0)
+	{
+		return;
+	}
+
+	// Engine streamable manager outlives loaders owned by subsystems
+	if (!UAssetManager::IsValid())
+	{
+		UE_LOG(LogXsollaUtils, Error, TEXT("%s: Asset manager isn't created, can't load assets"), *VA_FUNC_LINE);
+		return;
+	}
+
+	RequestTime = FPlatformTime::Seconds();
+	Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		Assets, FStreamableDelegate::CreateRaw(this, &FXsollaUtilsAssetLoader::HandleLoadCompleted), FStreamableManager::AsyncLoadHighPriority);
+}
+
+void FXsollaUtilsAssetLoader::Load()
+{
+	if (IsLoaded())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_XsollaAssetsBlockingLoad);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Prefetch();
+	if (Handle.IsValid())
+	{
+		Handle->WaitUntilComplete();
+	}
+
+	UE_LOG(LogXsollaUtils, Log, TEXT("%s: Game thread was blocked by assets loading for %.2f ms"), *VA_FUNC_LINE, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+bool FXsollaUtilsAssetLoader::IsLoaded() const
+{
+	return Assets.Num() == 0 || (Handle.IsValid() && Handle->HasLoadCompleted());
+}
+
+void FXsollaUtilsAssetLoader::HandleLoadCompleted()
+{
+	UE_LOG(LogXsollaUtils, Verbose, TEXT("%s: %d assets loaded in %.2f ms"), *VA_FUNC_LINE, Assets.Num(), (FPlatformTime::Seconds() - RequestTime) * 1000.0);
+
+	OnLoaded.ExecuteIfBound();
+}
@@ -0,0 +1,41 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsAuthTokenProvider.h"
+
+#include "XsollaUtilsDefines.h"
+
+TMap<TWeakObjectPtr<const UObject>, TWeakObjectPtr<UObject>> FXsollaAuthTokenProviderRegistry::Providers;
+FOnXsollaAuthTokenReceived FXsollaAuthTokenProviderRegistry::AuthTokenReceived;
+
+void FXsollaAuthTokenProviderRegistry::Register(const UObject* GameInstance, UObject* Provider)
+{
+	if (!GameInstance || !Provider || !Provider->GetClass()->ImplementsInterface(UXsollaAuthTokenProvider::StaticClass()))
+	{
+		UE_LOG(LogXsollaUtils, Error, TEXT("%s: Invalid token provider"), *VA_FUNC_LINE);
+		return;
+	}
+
+	Providers.Add(GameInstance, Provider);
+}
+
+void FXsollaAuthTokenProviderRegistry::Unregister(const UObject* GameInstance)
+{
+	Providers.Remove(GameInstance);
+}
+
+IXsollaAuthTokenProvider* FXsollaAuthTokenProviderRegistry::Find(const UObject* GameInstance)
+{
+	const TWeakObjectPtr<UObject>* Provider = Providers.Find(GameInstance);
+	if (!Provider || !Provider->IsValid())
+	{
+		return nullptr;
+	}
+
+	return Cast<IXsollaAuthTokenProvider>(Provider->Get());
+}
+
+FOnXsollaAuthTokenReceived& FXsollaAuthTokenProviderRegistry::OnAuthTokenReceived()
+{
+	return AuthTokenReceived;
+}
@@ -0,0 +1,117 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsConnectionWarmer.h"
+
+#include "XsollaUtilsDefines.h"
+#include "XsollaUtilsUrlOverrides.h"
+
+#include "HttpModule.h"
+
+TMap<FString, FXsollaUtilsConnectionWarmer::FOriginState> FXsollaUtilsConnectionWarmer::Origins;
+
+void FXsollaUtilsConnectionWarmer::WarmUp(const FString& Url, const UObject* Owner)
+{
+	check(IsInGameThread());
+
+	const FString ActualUrl = FXsollaUtilsUrlOverrides::Apply(Url);
+	const FString Origin = GetOrigin(ActualUrl);
+	if (Origin.IsEmpty())
+	{
+		return;
+	}
+
+	FOriginState* ExistingState = Origins.Find(Origin);
+	if (ExistingState)
+	{
+		if (Owner)
+		{
+			ExistingState->Owners.Add(FObjectKey(Owner));
+		}
+		return;
+	}
+
+	UE_LOG(LogXsollaUtils, Verbose, TEXT("%s: Warming up connection to %s"), *VA_FUNC_LINE, *Origin);
+
+	TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetURL(ActualUrl);
+	HttpRequest->SetVerb(TEXT("HEAD"));
+	HttpRequest->OnProcessRequestComplete().BindStatic(&FXsollaUtilsConnectionWarmer::HandleWarmUpComplete, Origin);
+
+	FOriginState& State = Origins.Add(Origin);
+	if (Owner)
+	{
+		State.Owners.Add(FObjectKey(Owner));
+	}
+
+	HttpRequest->ProcessRequest();
+}
+
+void FXsollaUtilsConnectionWarmer::Release(const UObject* Owner)
+{
+	check(IsInGameThread());
+
+	if (!Owner)
+	{
+		return;
+	}
+
+	// Hosts warmed up without owner are kept until reset
+	const FObjectKey OwnerKey(Owner);
+	for (auto It = Origins.CreateIterator(); It; ++It)
+	{
+		if (It.Value().Owners.Remove(OwnerKey) > 0 && It.Value().Owners.Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool FXsollaUtilsConnectionWarmer::IsWarmedUp(const FString& Url)
+{
+	const FOriginState* State = Origins.Find(GetOrigin(Url));
+	return State && State->bWarmedUp;
+}
+
+FString FXsollaUtilsConnectionWarmer::GetOrigin(const FString& Url)
+{
+	const int32 SchemeEnd = Url.Find(TEXT("://"));
+	if (SchemeEnd == INDEX_NONE)
+	{
+		return FString();
+	}
+
+	const int32 PathStart = Url.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, SchemeEnd + 3);
+	return ((PathStart == INDEX_NONE) ? Url : Url.Left(PathStart)).ToLower();
+}
+
+void FXsollaUtilsConnectionWarmer::Reset()
+{
+	check(IsInGameThread());
+
+	Origins.Empty();
+}
+
+void FXsollaUtilsConnectionWarmer::HandleWarmUpComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString Origin)
+{
+	// Warm-up of host that was released meanwhile
+	FOriginState* State = Origins.Find(Origin);
+	if (!State)
+	{
+		return;
+	}
+
+	// Any response status means connection is open
+	if (!bSucceeded || !HttpResponse.IsValid())
+	{
+		UE_LOG(LogXsollaUtils, Warning, TEXT("%s: Can't warm up connection to %s"), *VA_FUNC_LINE, *Origin);
+
+		// Let next warm-up try again
+		Origins.Remove(Origin);
+		return;
+	}
+
+	UE_LOG(LogXsollaUtils, Verbose, TEXT("%s: Connection to %s is warmed up in %.0f ms"), *VA_FUNC_LINE, *Origin, HttpRequest->GetElapsedTime() * 1000.f);
+
+	State->bWarmedUp = true;
+}
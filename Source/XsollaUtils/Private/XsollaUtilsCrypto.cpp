@@ -0,0 +1,132 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsCrypto.h"
+
+#define UI UI_ST
+THIRD_PARTY_INCLUDES_START
+#include "openssl/bn.h"
+#include "openssl/crypto.h"
+#include "openssl/err.h"
+#include "openssl/evp.h"
+#include "openssl/hmac.h"
+#include "openssl/objects.h"
+#include "openssl/rsa.h"
+#include "openssl/sha.h"
+THIRD_PARTY_INCLUDES_END
+#undef UI
+
+static_assert(FXsollaUtilsCrypto::Sha256DigestSize == SHA256_DIGEST_LENGTH, "Unexpected SHA-256 digest size");
+
+namespace XsollaUtilsCrypto
+{
+	/** Smallest and largest supported RSA modulus sizes in bytes */
+	static const int32 MinModulusSize = 128;
+	static const int32 MaxModulusSize = 1024;
+} // namespace XsollaUtilsCrypto
+
+void FXsollaUtilsCrypto::Sha256(const uint8* Data, int32 DataSize, uint8* OutDigest)
+{
+	SHA256(Data, DataSize, OutDigest);
+}
+
+void FXsollaUtilsCrypto::HmacSha256(const uint8* Key, int32 KeySize, const uint8* Data, int32 DataSize, uint8* OutDigest)
+{
+	// OpenSSL rejects null key, so empty one is passed as zero-length buffer
+	static const uint8 EmptyKey = 0;
+
+	unsigned int DigestSize = 0;
+	HMAC(EVP_sha256(), KeySize > 0 ? Key : &EmptyKey, KeySize, Data, DataSize, OutDigest, &DigestSize);
+	check(DigestSize == Sha256DigestSize);
+}
+
+bool FXsollaUtilsCrypto::ConstantTimeEquals(const uint8* A, const uint8* B, int32 Size)
+{
+	return CRYPTO_memcmp(A, B, Size) == 0;
+}
+
+FXsollaRsaPublicKey::FXsollaRsaPublicKey()
+	: Key(nullptr)
+{
+}
+
+FXsollaRsaPublicKey::~FXsollaRsaPublicKey()
+{
+	Reset();
+}
+
+bool FXsollaRsaPublicKey::Initialize(const TArray<uint8>& InModulus, const TArray<uint8>& InExponent)
+{
+	using namespace XsollaUtilsCrypto;
+
+	Reset();
+
+	// Leading zeroes are ignored (JWKS values shouldn't have them, but some encoders add sign byte)
+	BIGNUM* Modulus = BN_bin2bn(InModulus.GetData(), InModulus.Num(), nullptr);
+	BIGNUM* Exponent = BN_bin2bn(InExponent.GetData(), InExponent.Num(), nullptr);
+
+	const bool bSupported = Modulus && Exponent &&
+							BN_num_bytes(Modulus) >= MinModulusSize && BN_num_bytes(Modulus) <= MaxModulusSize && BN_is_odd(Modulus) &&
+							!BN_is_zero(Exponent) && BN_num_bytes(Exponent) <= BN_num_bytes(Modulus);
+
+	RSA* NewKey = bSupported ? RSA_new() : nullptr;
+	if (!NewKey)
+	{
+		BN_free(Modulus);
+		BN_free(Exponent);
+		return false;
+	}
+
+	// Key takes ownership of numbers
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+	if (RSA_set0_key(NewKey, Modulus, Exponent, nullptr) != 1)
+	{
+		BN_free(Modulus);
+		BN_free(Exponent);
+		RSA_free(NewKey);
+		return false;
+	}
+#else
+	NewKey->n = Modulus;
+	NewKey->e = Exponent;
+#endif
+
+	Key = NewKey;
+
+	return true;
+}
+
+bool FXsollaRsaPublicKey::IsValid() const
+{
+	return Key != nullptr;
+}
+
+bool FXsollaRsaPublicKey::VerifyPkcs1Sha256(const uint8* Data, int32 DataSize, const TArray<uint8>& Signature) const
+{
+	if (!IsValid() || Signature.Num() != RSA_size(Key))
+	{
+		return false;
+	}
+
+	uint8 Digest[FXsollaUtilsCrypto::Sha256DigestSize];
+	FXsollaUtilsCrypto::Sha256(Data, DataSize, Digest);
+
+	const bool bVerified = RSA_verify(NID_sha256, Digest, FXsollaUtilsCrypto::Sha256DigestSize,
+							   Signature.GetData(), Signature.Num(), Key) == 1;
+	if (!bVerified)
+	{
+		// Don't leave errors in thread queue for engine SSL code to pick up
+		ERR_clear_error();
+	}
+
+	return bVerified;
+}
+
+void FXsollaRsaPublicKey::Reset()
+{
+	if (Key)
+	{
+		RSA_free(Key);
+		Key = nullptr;
+	}
+}
@@ -0,0 +1,602 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsHttpTelemetry.h"
+
+#include "XsollaUtilsConnectionWarmer.h"
+#include "XsollaUtilsDefines.h"
+#include "XsollaUtilsStats.h"
+#include "XsollaUtilsTrace.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Http Requests In Flight"), STAT_XsollaHttpRequestsInFlight, STATGROUP_Xsolla);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Http Requests Completed"), STAT_XsollaHttpRequestsCompleted, STATGROUP_Xsolla);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Http Errors"), STAT_XsollaHttpErrors, STATGROUP_Xsolla);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Http Bytes Sent"), STAT_XsollaHttpBytesSent, STATGROUP_Xsolla);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Http Bytes Received"), STAT_XsollaHttpBytesReceived, STATGROUP_Xsolla);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Http Last Total (ms)"), STAT_XsollaHttpLastTotal, STATGROUP_Xsolla);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Http Last TTFB (ms)"), STAT_XsollaHttpLastTimeToFirstByte, STATGROUP_Xsolla);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Http Last Parse (ms)"), STAT_XsollaHttpLastParse, STATGROUP_Xsolla);
+
+namespace XsollaUtilsHttpTelemetry
+{
+	static TAutoConsoleVariable<float> CVarDumpInterval(
+		TEXT("Xsolla.Telemetry.DumpInterval"),
+		0.f,
+		TEXT("Interval of Xsolla http telemetry dump (seconds, 0 to disable)"));
+
+	static TAutoConsoleVariable<int32> CVarDumpToFile(
+		TEXT("Xsolla.Telemetry.DumpToFile"),
+		0,
+		TEXT("Write Xsolla http telemetry dumps to Saved/XsollaTelemetry"));
+
+	static FAutoConsoleCommand DumpCommand(
+		TEXT("Xsolla.Telemetry.Dump"),
+		TEXT("Log Xsolla http telemetry and broadcast it to dump listeners"),
+		FConsoleCommandDelegate::CreateLambda([]() {
+			FXsollaHttpTelemetry::Get().Dump();
+		}));
+
+	static FAutoConsoleCommand ResetCommand(
+		TEXT("Xsolla.Telemetry.Reset"),
+		TEXT("Drop collected Xsolla http telemetry"),
+		FConsoleCommandDelegate::CreateLambda([]() {
+			FXsollaHttpTelemetry::Get().Reset();
+		}));
+
+	/** Endpoints above the limit are counted as "other", so unexpected urls can't grow stats unbounded */
+	static const int32 MaxEndpoints = 128;
+
+	/** Tracked requests above the limit trigger pruning of destroyed ones */
+	static const int32 MaxTrackedRequests = 256;
+
+	/** Path segments followed by identifier (project id, sku, cart id, order id, social provider) */
+	static const TCHAR* IdentifierMarkers[] = {
+		TEXT("project"),
+		TEXT("cart"),
+		TEXT("item"),
+		TEXT("sku"),
+		TEXT("order"),
+		TEXT("virtual"),
+		TEXT("social")};
+
+	/** Path segments which are never identifiers even after marker */
+	static const TCHAR* Keywords[] = {
+		TEXT("cart"),
+		TEXT("clear"),
+		TEXT("consume"),
+		TEXT("item")};
+
+	bool IsIn(const FString& Segment, const TCHAR* const* Words, int32 WordCount)
+	{
+		for (int32 Index = 0; Index < WordCount; ++Index)
+		{
+			if (Segment.Equals(Words[Index], ESearchCase::IgnoreCase))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool IsIdentifier(const FString& Segment)
+	{
+		if (Segment.IsNumeric())
+		{
+			return true;
+		}
+
+		// UUID-like
+		if (Segment.Len() == 36 && Segment[8] == TEXT('-') && Segment[13] == TEXT('-'))
+		{
+			return true;
+		}
+
+		return false;
+	}
+
+	int32 GetResponseBytes(FHttpResponsePtr HttpResponse)
+	{
+		return HttpResponse.IsValid() ? HttpResponse->GetContent().Num() : 0;
+	}
+
+	TSharedRef<FJsonObject> TimingToJson(const FXsollaHttpTimingStats& Stats)
+	{
+		TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+		JsonObject->SetNumberField(TEXT("count"), Stats.Count);
+		JsonObject->SetNumberField(TEXT("min_ms"), Stats.MinMs);
+		JsonObject->SetNumberField(TEXT("max_ms"), Stats.MaxMs);
+		JsonObject->SetNumberField(TEXT("avg_ms"), Stats.AverageMs);
+		JsonObject->SetNumberField(TEXT("p50_ms"), Stats.P50Ms);
+		JsonObject->SetNumberField(TEXT("p90_ms"), Stats.P90Ms);
+		JsonObject->SetNumberField(TEXT("p99_ms"), Stats.P99Ms);
+
+		TArray<TSharedPtr<FJsonValue>> Buckets;
+		for (int32 Bucket : Stats.Buckets)
+		{
+			Buckets.Add(MakeShared<FJsonValueNumber>(Bucket));
+		}
+		JsonObject->SetArrayField(TEXT("buckets"), Buckets);
+
+		return JsonObject;
+	}
+
+	void RunHandler(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FHttpRequestCompleteDelegate Handler)
+	{
+		FXsollaHttpTelemetryScope TelemetryScope(HttpRequest, HttpResponse, bSucceeded);
+		XSOLLA_TRACE_SCOPE(XsollaHttpResponse);
+		XSOLLA_LLM_SCOPE();
+
+		Handler.ExecuteIfBound(HttpRequest, HttpResponse, bSucceeded);
+	}
+} // namespace XsollaUtilsHttpTelemetry
+
+FXsollaHttpTelemetry::FHistogram::FHistogram()
+	: Count(0)
+	, SumMs(0.)
+	, MinMs(0.)
+	, MaxMs(0.)
+{
+	Buckets.SetNumZeroed(GetBucketUpperBoundsMs().Num() + 1);
+}
+
+void FXsollaHttpTelemetry::FHistogram::Add(double Ms)
+{
+	const TArray<float>& UpperBounds = GetBucketUpperBoundsMs();
+
+	int32 Bucket = 0;
+	while (Bucket < UpperBounds.Num() && Ms > UpperBounds[Bucket])
+	{
+		++Bucket;
+	}
+	Buckets[Bucket]++;
+
+	MinMs = (Count == 0) ? Ms : FMath::Min(MinMs, Ms);
+	MaxMs = (Count == 0) ? Ms : FMath::Max(MaxMs, Ms);
+	SumMs += Ms;
+	Count++;
+}
+
+FXsollaHttpTimingStats FXsollaHttpTelemetry::FHistogram::ToStats() const
+{
+	FXsollaHttpTimingStats Stats;
+	Stats.Count = Count;
+	Stats.Buckets = Buckets;
+	if (Count == 0)
+	{
+		return Stats;
+	}
+
+	Stats.MinMs = MinMs;
+	Stats.MaxMs = MaxMs;
+	Stats.AverageMs = SumMs / Count;
+
+	const TArray<float>& UpperBounds = GetBucketUpperBoundsMs();
+	auto GetPercentile = [this, &UpperBounds](double Percentile) {
+		const int32 Rank = FMath::Max(1, FMath::CeilToInt(Percentile * Count));
+		int32 Accumulated = 0;
+		for (int32 Bucket = 0; Bucket < Buckets.Num(); ++Bucket)
+		{
+			Accumulated += Buckets[Bucket];
+			if (Accumulated >= Rank)
+			{
+				// Bucket bound can't be above the slowest sample
+				return (Bucket < UpperBounds.Num()) ? FMath::Min<double>(UpperBounds[Bucket], MaxMs) : MaxMs;
+			}
+		}
+		return MaxMs;
+	};
+
+	Stats.P50Ms = GetPercentile(0.5);
+	Stats.P90Ms = GetPercentile(0.9);
+	Stats.P99Ms = GetPercentile(0.99);
+
+	return Stats;
+}
+
+FXsollaHttpEndpointStats FXsollaHttpTelemetry::FEndpointData::ToStats(const FString& Endpoint) const
+{
+	FXsollaHttpEndpointStats Stats;
+	Stats.Endpoint = Endpoint;
+	Stats.RequestCount = RequestCount;
+	Stats.ErrorCount = ErrorCount;
+	Stats.StatusCodes = StatusCodes;
+	Stats.RequestBytes = RequestBytes;
+	Stats.ResponseBytes = ResponseBytes;
+	Stats.Queue = Queue.ToStats();
+	Stats.TimeToFirstByte = TimeToFirstByte.ToStats();
+	Stats.Total = Total.ToStats();
+	Stats.Parse = Parse.ToStats();
+	return Stats;
+}
+
+FXsollaHttpTelemetry::FXsollaHttpTelemetry()
+	: LastDumpTime(0.)
+{
+}
+
+FXsollaHttpTelemetry& FXsollaHttpTelemetry::Get()
+{
+	static FXsollaHttpTelemetry Instance;
+	return Instance;
+}
+
+void FXsollaHttpTelemetry::Initialize()
+{
+	if (!DumpTickerHandle.IsValid())
+	{
+		LastDumpTime = FPlatformTime::Seconds();
+		DumpTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FXsollaHttpTelemetry::HandleDumpTicker), 1.f);
+	}
+}
+
+void FXsollaHttpTelemetry::Shutdown()
+{
+	if (DumpTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(DumpTickerHandle);
+		DumpTickerHandle.Reset();
+	}
+
+	OnDump.Clear();
+}
+
+void FXsollaHttpTelemetry::TrackRequest(const TSharedRef<IHttpRequest>& HttpRequest)
+{
+	using namespace XsollaUtilsHttpTelemetry;
+
+	FTrackedRequest TrackedRequest;
+	TrackedRequest.Request = HttpRequest;
+	TrackedRequest.Endpoint = GetEndpointName(HttpRequest->GetVerb(), HttpRequest->GetURL());
+	TrackedRequest.CreatedTime = FPlatformTime::Seconds();
+	TrackedRequest.bConnectionWarmedUp = FXsollaUtilsConnectionWarmer::IsWarmedUp(HttpRequest->GetURL());
+
+	// Progress isn't used by SDK, so it's free to detect first response bytes
+	HttpRequest->OnRequestProgress().BindRaw(this, &FXsollaHttpTelemetry::HandleRequestProgress);
+
+	FScopeLock Lock(&DataLock);
+
+	if (TrackedRequests.Num() >= MaxTrackedRequests)
+	{
+		PruneTrackedRequests();
+	}
+
+	TrackedRequests.Add(&HttpRequest.Get(), TrackedRequest);
+	INC_DWORD_STAT(STAT_XsollaHttpRequestsInFlight);
+
+	FXsollaUtilsTrace::OutputRequestBegin(&HttpRequest.Get(), TrackedRequest.Endpoint, HttpRequest->GetContentLength());
+}
+
+TArray<FXsollaHttpEndpointStats> FXsollaHttpTelemetry::GetEndpointStats() const
+{
+	FScopeLock Lock(&DataLock);
+
+	TArray<FXsollaHttpEndpointStats> Stats;
+	for (const auto& Endpoint : Endpoints)
+	{
+		Stats.Add(Endpoint.Value.ToStats(Endpoint.Key));
+	}
+
+	return Stats;
+}
+
+bool FXsollaHttpTelemetry::GetEndpointStats(const FString& Endpoint, FXsollaHttpEndpointStats& OutStats) const
+{
+	FScopeLock Lock(&DataLock);
+
+	const FEndpointData* EndpointData = Endpoints.Find(Endpoint);
+	if (!EndpointData)
+	{
+		return false;
+	}
+
+	OutStats = EndpointData->ToStats(Endpoint);
+	return true;
+}
+
+void FXsollaHttpTelemetry::GetFirstRequestStats(FXsollaHttpTimingStats& OutCold, FXsollaHttpTimingStats& OutWarmedUp) const
+{
+	FScopeLock Lock(&DataLock);
+
+	OutCold = FirstRequestCold.ToStats();
+	OutWarmedUp = FirstRequestWarmedUp.ToStats();
+}
+
+void FXsollaHttpTelemetry::Reset()
+{
+	FScopeLock Lock(&DataLock);
+
+	Endpoints.Empty();
+	FirstRequestOrigins.Empty();
+	FirstRequestCold = FHistogram();
+	FirstRequestWarmedUp = FHistogram();
+}
+
+FString FXsollaHttpTelemetry::ToJson() const
+{
+	using namespace XsollaUtilsHttpTelemetry;
+
+	TSharedRef<FJsonObject> TelemetryJson = MakeShared<FJsonObject>();
+	TelemetryJson->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+
+	TArray<TSharedPtr<FJsonValue>> BucketBoundsJson;
+	for (float UpperBound : GetBucketUpperBoundsMs())
+	{
+		BucketBoundsJson.Add(MakeShared<FJsonValueNumber>(UpperBound));
+	}
+	TelemetryJson->SetArrayField(TEXT("bucket_upper_bounds_ms"), BucketBoundsJson);
+
+	TArray<TSharedPtr<FJsonValue>> EndpointsJson;
+	for (const FXsollaHttpEndpointStats& Stats : GetEndpointStats())
+	{
+		TSharedRef<FJsonObject> EndpointJson = MakeShared<FJsonObject>();
+		EndpointJson->SetStringField(TEXT("endpoint"), Stats.Endpoint);
+		EndpointJson->SetNumberField(TEXT("requests"), Stats.RequestCount);
+		EndpointJson->SetNumberField(TEXT("errors"), Stats.ErrorCount);
+		EndpointJson->SetNumberField(TEXT("request_bytes"), Stats.RequestBytes);
+		EndpointJson->SetNumberField(TEXT("response_bytes"), Stats.ResponseBytes);
+
+		TSharedRef<FJsonObject> StatusCodesJson = MakeShared<FJsonObject>();
+		for (const auto& StatusCode : Stats.StatusCodes)
+		{
+			StatusCodesJson->SetNumberField(FString::FromInt(StatusCode.Key), StatusCode.Value);
+		}
+		EndpointJson->SetObjectField(TEXT("status_codes"), StatusCodesJson);
+
+		EndpointJson->SetObjectField(TEXT("queue"), TimingToJson(Stats.Queue));
+		EndpointJson->SetObjectField(TEXT("ttfb"), TimingToJson(Stats.TimeToFirstByte));
+		EndpointJson->SetObjectField(TEXT("total"), TimingToJson(Stats.Total));
+		EndpointJson->SetObjectField(TEXT("parse"), TimingToJson(Stats.Parse));
+
+		EndpointsJson.Add(MakeShared<FJsonValueObject>(EndpointJson));
+	}
+	TelemetryJson->SetArrayField(TEXT("endpoints"), EndpointsJson);
+
+	FXsollaHttpTimingStats FirstRequestColdStats;
+	FXsollaHttpTimingStats FirstRequestWarmedUpStats;
+	GetFirstRequestStats(FirstRequestColdStats, FirstRequestWarmedUpStats);
+
+	TSharedRef<FJsonObject> FirstRequestJson = MakeShared<FJsonObject>();
+	FirstRequestJson->SetObjectField(TEXT("cold"), TimingToJson(FirstRequestColdStats));
+	FirstRequestJson->SetObjectField(TEXT("warmed_up"), TimingToJson(FirstRequestWarmedUpStats));
+	TelemetryJson->SetObjectField(TEXT("first_request"), FirstRequestJson);
+
+	FString JsonStr;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonStr);
+	FJsonSerializer::Serialize(TelemetryJson, Writer);
+
+	return JsonStr;
+}
+
+void FXsollaHttpTelemetry::Dump()
+{
+	using namespace XsollaUtilsHttpTelemetry;
+
+	const FString TelemetryJson = ToJson();
+	UE_LOG(LogXsollaUtils, Log, TEXT("%s: Http telemetry: %s"), *VA_FUNC_LINE, *TelemetryJson);
+
+	if (CVarDumpToFile.GetValueOnGameThread() != 0)
+	{
+		const FString Filename = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("XsollaTelemetry"), FString::Printf(TEXT("HttpTelemetry-%s.json"), *FDateTime::Now().ToString()));
+		if (!FFileHelper::SaveStringToFile(TelemetryJson, *Filename))
+		{
+			UE_LOG(LogXsollaUtils, Error, TEXT("%s: Can't write http telemetry: %s"), *VA_FUNC_LINE, *Filename);
+		}
+	}
+
+	OnDump.Broadcast(TelemetryJson);
+}
+
+const TArray<float>& FXsollaHttpTelemetry::GetBucketUpperBoundsMs()
+{
+	static const TArray<float> UpperBounds = {5.f, 10.f, 25.f, 50.f, 100.f, 250.f, 500.f, 1000.f, 2500.f, 5000.f, 10000.f};
+	return UpperBounds;
+}
+
+FHttpRequestCompleteDelegate FXsollaHttpTelemetry::WrapHandler(const FHttpRequestCompleteDelegate& Handler)
+{
+	return FHttpRequestCompleteDelegate::CreateStatic(&XsollaUtilsHttpTelemetry::RunHandler, Handler);
+}
+
+FString FXsollaHttpTelemetry::GetEndpointName(const FString& Verb, const FString& Url)
+{
+	using namespace XsollaUtilsHttpTelemetry;
+
+	// Drop scheme, host and query
+	FString Path = Url;
+	const int32 SchemeEnd = Path.Find(TEXT("://"));
+	if (SchemeEnd != INDEX_NONE)
+	{
+		const int32 PathStart = Path.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, SchemeEnd + 3);
+		Path = (PathStart == INDEX_NONE) ? FString() : Path.RightChop(PathStart);
+	}
+
+	int32 QueryStart;
+	if (Path.FindChar(TEXT('?'), QueryStart))
+	{
+		Path.LeftInline(QueryStart);
+	}
+
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("/"));
+
+	for (int32 Index = 0; Index < Segments.Num(); ++Index)
+	{
+		const bool bAfterMarker = (Index > 0) && IsIn(Segments[Index - 1], IdentifierMarkers, UE_ARRAY_COUNT(IdentifierMarkers)) && !IsIn(Segments[Index], Keywords, UE_ARRAY_COUNT(Keywords));
+		if (bAfterMarker || IsIdentifier(Segments[Index]))
+		{
+			Segments[Index] = TEXT("{id}");
+		}
+	}
+
+	return FString::Printf(TEXT("%s /%s"), *Verb, *FString::Join(Segments, TEXT("/")));
+}
+
+void FXsollaHttpTelemetry::BeginHandler(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+{
+	using namespace XsollaUtilsHttpTelemetry;
+
+	if (!HttpRequest.IsValid())
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	FScopeLock Lock(&DataLock);
+
+	FTrackedRequest* TrackedRequest = TrackedRequests.Find(HttpRequest.Get());
+	if (!TrackedRequest)
+	{
+		return;
+	}
+
+	if (TrackedRequest->HandlerDepth++ > 0)
+	{
+		return;
+	}
+
+	TrackedRequest->HandlerStartTime = Now;
+	DEC_DWORD_STAT(STAT_XsollaHttpRequestsInFlight);
+
+	FEndpointData* EndpointData = Endpoints.Find(TrackedRequest->Endpoint);
+	if (!EndpointData)
+	{
+		if (Endpoints.Num() >= MaxEndpoints)
+		{
+			TrackedRequest->Endpoint = TEXT("other");
+		}
+		EndpointData = &Endpoints.FindOrAdd(TrackedRequest->Endpoint);
+	}
+
+	// Elapsed time is counted by http module from the moment request was sent
+	const double TotalMs = HttpRequest->GetElapsedTime() * 1000.;
+	const double QueueMs = FMath::Max(0., (Now - TrackedRequest->CreatedTime) * 1000. - TotalMs);
+	const double SentTime = Now - TotalMs / 1000.;
+
+	const int32 ResponseCode = (bSucceeded && HttpResponse.IsValid()) ? HttpResponse->GetResponseCode() : 0;
+	const bool bFailed = !EHttpResponseCodes::IsOk(ResponseCode);
+	const int32 RequestBytes = HttpRequest->GetContentLength();
+	const int32 ResponseBytes = GetResponseBytes(HttpResponse);
+
+	FXsollaUtilsTrace::OutputRequestEnd(HttpRequest.Get(), TrackedRequest->Endpoint, ResponseCode, ResponseBytes);
+
+	EndpointData->RequestCount++;
+	EndpointData->ErrorCount += bFailed ? 1 : 0;
+	EndpointData->StatusCodes.FindOrAdd(ResponseCode)++;
+	EndpointData->RequestBytes += RequestBytes;
+	EndpointData->ResponseBytes += ResponseBytes;
+	EndpointData->Queue.Add(QueueMs);
+	EndpointData->Total.Add(TotalMs);
+
+	// First request to host pays connection setup unless it was warmed up
+	const FString Origin = FXsollaUtilsConnectionWarmer::GetOrigin(HttpRequest->GetURL());
+	if (!Origin.IsEmpty() && !FirstRequestOrigins.Contains(Origin))
+	{
+		FirstRequestOrigins.Add(Origin);
+		(TrackedRequest->bConnectionWarmedUp ? FirstRequestWarmedUp : FirstRequestCold).Add(TotalMs);
+	}
+
+	if (TrackedRequest->FirstByteTime > 0.)
+	{
+		const double TimeToFirstByteMs = FMath::Max(0., (TrackedRequest->FirstByteTime - SentTime) * 1000.);
+		EndpointData->TimeToFirstByte.Add(TimeToFirstByteMs);
+		SET_FLOAT_STAT(STAT_XsollaHttpLastTimeToFirstByte, TimeToFirstByteMs);
+	}
+
+	INC_DWORD_STAT(STAT_XsollaHttpRequestsCompleted);
+	INC_DWORD_STAT_BY(STAT_XsollaHttpErrors, bFailed ? 1 : 0);
+	INC_DWORD_STAT_BY(STAT_XsollaHttpBytesSent, RequestBytes);
+	INC_DWORD_STAT_BY(STAT_XsollaHttpBytesReceived, ResponseBytes);
+	SET_FLOAT_STAT(STAT_XsollaHttpLastTotal, TotalMs);
+}
+
+void FXsollaHttpTelemetry::EndHandler(FHttpRequestPtr HttpRequest)
+{
+	if (!HttpRequest.IsValid())
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	FScopeLock Lock(&DataLock);
+
+	FTrackedRequest* TrackedRequest = TrackedRequests.Find(HttpRequest.Get());
+	if (!TrackedRequest || --TrackedRequest->HandlerDepth > 0)
+	{
+		return;
+	}
+
+	const double ParseMs = (Now - TrackedRequest->HandlerStartTime) * 1000.;
+	if (FEndpointData* EndpointData = Endpoints.Find(TrackedRequest->Endpoint))
+	{
+		EndpointData->Parse.Add(ParseMs);
+	}
+	SET_FLOAT_STAT(STAT_XsollaHttpLastParse, ParseMs);
+
+	TrackedRequests.Remove(HttpRequest.Get());
+}
+
+void FXsollaHttpTelemetry::HandleRequestProgress(FHttpRequestPtr HttpRequest, int32 BytesSent, int32 BytesReceived)
+{
+	if (BytesReceived <= 0 || !HttpRequest.IsValid())
+	{
+		return;
+	}
+
+	FScopeLock Lock(&DataLock);
+
+	FTrackedRequest* TrackedRequest = TrackedRequests.Find(HttpRequest.Get());
+	if (TrackedRequest && TrackedRequest->FirstByteTime == 0.)
+	{
+		TrackedRequest->FirstByteTime = FPlatformTime::Seconds();
+	}
+}
+
+bool FXsollaHttpTelemetry::HandleDumpTicker(float DeltaTime)
+{
+	using namespace XsollaUtilsHttpTelemetry;
+
+	const float DumpInterval = CVarDumpInterval.GetValueOnGameThread();
+	const double Now = FPlatformTime::Seconds();
+	if (DumpInterval > 0.f && Now - LastDumpTime >= DumpInterval)
+	{
+		LastDumpTime = Now;
+		Dump();
+	}
+
+	return true;
+}
+
+void FXsollaHttpTelemetry::PruneTrackedRequests()
+{
+	for (auto It = TrackedRequests.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Request.IsValid())
+		{
+			It.RemoveCurrent();
+			DEC_DWORD_STAT(STAT_XsollaHttpRequestsInFlight);
+		}
+	}
+}
+
+FXsollaHttpTelemetryScope::FXsollaHttpTelemetryScope(FHttpRequestPtr InHttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+	: HttpRequest(InHttpRequest)
+{
+	FXsollaHttpTelemetry::Get().BeginHandler(HttpRequest, HttpResponse, bSucceeded);
+}
+
+FXsollaHttpTelemetryScope::~FXsollaHttpTelemetryScope()
+{
+	FXsollaHttpTelemetry::Get().EndHandler(HttpRequest);
+}
@@ -0,0 +1,253 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsJwtVerifier.h"
+
+#include "XsollaUtilsCrypto.h"
+#include "XsollaUtilsDefines.h"
+#include "XsollaUtilsTokenParser.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/DateTime.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace XsollaUtilsJwtVerifier
+{
+	/** Decode base64url encoded json object */
+	TSharedPtr<FJsonObject> DecodeJsonObject(const FString& Source)
+	{
+		TArray<uint8> Bytes;
+		if (!FXsollaUtilsTokenParser::DecodeBase64Url(Source, Bytes) || Bytes.Num() == 0)
+		{
+			return nullptr;
+		}
+
+		FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+		const FString JsonStr(Converter.Length(), Converter.Get());
+
+		TSharedPtr<FJsonObject> JsonObject;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonStr);
+		if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+		{
+			return nullptr;
+		}
+
+		return JsonObject;
+	}
+} // namespace XsollaUtilsJwtVerifier
+
+const TCHAR* LexToString(EXsollaJwtVerifyResult Result)
+{
+	switch (Result)
+	{
+	case EXsollaJwtVerifyResult::Valid:
+		return TEXT("Valid");
+
+	case EXsollaJwtVerifyResult::Malformed:
+		return TEXT("Malformed token");
+
+	case EXsollaJwtVerifyResult::UnsupportedAlgorithm:
+		return TEXT("Unsupported signature algorithm");
+
+	case EXsollaJwtVerifyResult::KeyNotFound:
+		return TEXT("Signing key not found");
+
+	case EXsollaJwtVerifyResult::InvalidSignature:
+		return TEXT("Invalid signature");
+
+	case EXsollaJwtVerifyResult::Expired:
+		return TEXT("Token expired");
+
+	case EXsollaJwtVerifyResult::InvalidIssuer:
+		return TEXT("Invalid issuer");
+
+	case EXsollaJwtVerifyResult::InvalidAudience:
+		return TEXT("Invalid audience");
+
+	default:
+		return TEXT("Unknown");
+	}
+}
+
+void FXsollaJwtVerifier::SetSecret(const FString& Secret)
+{
+	FTCHARToUTF8 SecretUtf8(*Secret);
+
+	FRWScopeLock Lock(KeysLock, SLT_Write);
+	SecretBytes.Reset();
+	SecretBytes.Append(reinterpret_cast<const uint8*>(SecretUtf8.Get()), SecretUtf8.Length());
+}
+
+int32 FXsollaJwtVerifier::SetJwks(const FString& JwksJson)
+{
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JwksJson);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogXsollaUtils, Error, TEXT("%s: Can't deserialize JWKS: %s"), *VA_FUNC_LINE, *JwksJson);
+		return 0;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* KeysArray = nullptr;
+	if (!JsonObject->TryGetArrayField(TEXT("keys"), KeysArray))
+	{
+		UE_LOG(LogXsollaUtils, Error, TEXT("%s: JWKS has no keys field"), *VA_FUNC_LINE);
+		return 0;
+	}
+
+	TMap<FString, FRsaPublicKeyPtr> NewKeys;
+	for (const auto& KeyValue : *KeysArray)
+	{
+		const TSharedPtr<FJsonObject>* KeyObject = nullptr;
+		if (!KeyValue.IsValid() || !KeyValue->TryGetObject(KeyObject))
+		{
+			continue;
+		}
+
+		FString Kty, Use, Alg, Kid, Modulus, Exponent;
+		(*KeyObject)->TryGetStringField(TEXT("kty"), Kty);
+		(*KeyObject)->TryGetStringField(TEXT("use"), Use);
+		(*KeyObject)->TryGetStringField(TEXT("alg"), Alg);
+		(*KeyObject)->TryGetStringField(TEXT("kid"), Kid);
+		(*KeyObject)->TryGetStringField(TEXT("n"), Modulus);
+		(*KeyObject)->TryGetStringField(TEXT("e"), Exponent);
+
+		if (Kty != TEXT("RSA") || (!Use.IsEmpty() && Use != TEXT("sig")) || (!Alg.IsEmpty() && Alg != TEXT("RS256")))
+		{
+			continue;
+		}
+
+		TArray<uint8> ModulusBytes, ExponentBytes;
+		TSharedPtr<FXsollaRsaPublicKey, ESPMode::ThreadSafe> Key = MakeShared<FXsollaRsaPublicKey, ESPMode::ThreadSafe>();
+		if (!FXsollaUtilsTokenParser::DecodeBase64Url(Modulus, ModulusBytes) ||
+			!FXsollaUtilsTokenParser::DecodeBase64Url(Exponent, ExponentBytes) ||
+			!Key->Initialize(ModulusBytes, ExponentBytes))
+		{
+			UE_LOG(LogXsollaUtils, Warning, TEXT("%s: Skipping unsupported JWKS key: %s"), *VA_FUNC_LINE, *Kid);
+			continue;
+		}
+
+		NewKeys.Add(Kid, Key);
+	}
+
+	UE_LOG(LogXsollaUtils, Log, TEXT("%s: Imported %d JWKS key(s)"), *VA_FUNC_LINE, NewKeys.Num());
+
+	const int32 NumKeys = NewKeys.Num();
+
+	FRWScopeLock Lock(KeysLock, SLT_Write);
+	RsaKeys = MoveTemp(NewKeys);
+
+	return NumKeys;
+}
+
+bool FXsollaJwtVerifier::HasKey(const FString& KeyId) const
+{
+	return FindKey(KeyId).IsValid();
+}
+
+EXsollaJwtVerifyResult FXsollaJwtVerifier::Verify(const FString& Token, const FXsollaJwtVerifyOptions& Options) const
+{
+	TArray<FString> TokenParts;
+	Token.ParseIntoArray(TokenParts, TEXT("."), false);
+	if (TokenParts.Num() != 3 || TokenParts[2].IsEmpty())
+	{
+		return EXsollaJwtVerifyResult::Malformed;
+	}
+
+	const TSharedPtr<FJsonObject> Header = XsollaUtilsJwtVerifier::DecodeJsonObject(TokenParts[0]);
+	TArray<uint8> Signature;
+	if (!Header.IsValid() || !FXsollaUtilsTokenParser::DecodeBase64Url(TokenParts[2], Signature))
+	{
+		return EXsollaJwtVerifyResult::Malformed;
+	}
+
+	FString Alg, Kid;
+	Header->TryGetStringField(TEXT("alg"), Alg);
+	Header->TryGetStringField(TEXT("kid"), Kid);
+
+	// Signing input is "header.payload", all its characters are base64url ones
+	const FTCHARToUTF8 SigningInput(*Token, TokenParts[0].Len() + 1 + TokenParts[1].Len());
+	const uint8* SigningInputData = reinterpret_cast<const uint8*>(SigningInput.Get());
+
+	if (Alg == TEXT("HS256"))
+	{
+		uint8 Digest[FXsollaUtilsCrypto::Sha256DigestSize];
+		{
+			FRWScopeLock Lock(KeysLock, SLT_ReadOnly);
+			if (SecretBytes.Num() == 0)
+			{
+				return EXsollaJwtVerifyResult::KeyNotFound;
+			}
+
+			FXsollaUtilsCrypto::HmacSha256(SecretBytes.GetData(), SecretBytes.Num(), SigningInputData, SigningInput.Length(), Digest);
+		}
+
+		if (Signature.Num() != FXsollaUtilsCrypto::Sha256DigestSize ||
+			!FXsollaUtilsCrypto::ConstantTimeEquals(Signature.GetData(), Digest, FXsollaUtilsCrypto::Sha256DigestSize))
+		{
+			return EXsollaJwtVerifyResult::InvalidSignature;
+		}
+	}
+	else if (Alg == TEXT("RS256"))
+	{
+		const FRsaPublicKeyPtr Key = FindKey(Kid);
+		if (!Key.IsValid())
+		{
+			return EXsollaJwtVerifyResult::KeyNotFound;
+		}
+
+		if (!Key->VerifyPkcs1Sha256(SigningInputData, SigningInput.Length(), Signature))
+		{
+			return EXsollaJwtVerifyResult::InvalidSignature;
+		}
+	}
+	else
+	{
+		// Including "none", which must never be accepted
+		return EXsollaJwtVerifyResult::UnsupportedAlgorithm;
+	}
+
+	const FXsollaJwtClaimsPtr Claims = FXsollaUtilsTokenParser::GetClaims(Token);
+	if (!Claims.IsValid())
+	{
+		return EXsollaJwtVerifyResult::Malformed;
+	}
+
+	if (Claims->Exp != 0 && FDateTime::UtcNow().ToUnixTimestamp() > Claims->Exp + Options.Leeway)
+	{
+		return EXsollaJwtVerifyResult::Expired;
+	}
+
+	if (!Options.Issuer.IsEmpty() && Claims->Iss != Options.Issuer)
+	{
+		return EXsollaJwtVerifyResult::InvalidIssuer;
+	}
+
+	if (!Options.Audience.IsEmpty() && !Claims->Aud.Contains(Options.Audience))
+	{
+		return EXsollaJwtVerifyResult::InvalidAudience;
+	}
+
+	return EXsollaJwtVerifyResult::Valid;
+}
+
+FXsollaJwtVerifier::FRsaPublicKeyPtr FXsollaJwtVerifier::FindKey(const FString& KeyId) const
+{
+	FRWScopeLock Lock(KeysLock, SLT_ReadOnly);
+
+	if (const FRsaPublicKeyPtr* Key = RsaKeys.Find(KeyId))
+	{
+		return *Key;
+	}
+
+	if (KeyId.IsEmpty() && RsaKeys.Num() == 1)
+	{
+		for (const auto& Pair : RsaKeys)
+		{
+			return Pair.Value;
+		}
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,29 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsLibrary.h"
+
+UXsollaUtilsLibrary::UXsollaUtilsLibrary(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+TArray<FXsollaHttpEndpointStats> UXsollaUtilsLibrary::GetHttpTelemetry()
+{
+	return FXsollaHttpTelemetry::Get().GetEndpointStats();
+}
+
+bool UXsollaUtilsLibrary::GetHttpEndpointTelemetry(const FString& Endpoint, FXsollaHttpEndpointStats& Stats)
+{
+	return FXsollaHttpTelemetry::Get().GetEndpointStats(Endpoint, Stats);
+}
+
+FString UXsollaUtilsLibrary::GetHttpTelemetryJson()
+{
+	return FXsollaHttpTelemetry::Get().ToJson();
+}
+
+void UXsollaUtilsLibrary::ResetHttpTelemetry()
+{
+	FXsollaHttpTelemetry::Get().Reset();
+}
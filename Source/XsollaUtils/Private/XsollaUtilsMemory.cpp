@@ -0,0 +1,128 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsMemory.h"
+
+#include "XsollaUtilsStats.h"
+
+#include "Runtime/Launch/Resources/Version.h"
+#include "UObject/Class.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+
+DEFINE_STAT(STAT_XsollaLLM);
+
+namespace XsollaUtilsMemory
+{
+#if ENGINE_MINOR_VERSION < 25
+	// Properties are UObjects before 4.25
+	using FProperty = UProperty;
+	using FStrProperty = UStrProperty;
+	using FTextProperty = UTextProperty;
+	using FStructProperty = UStructProperty;
+	using FArrayProperty = UArrayProperty;
+	using FMapProperty = UMapProperty;
+	using FSetProperty = USetProperty;
+
+	template <typename PropertyType>
+	const PropertyType* CastField(const FProperty* Property)
+	{
+		return Cast<PropertyType>(Property);
+	}
+#endif
+
+	SIZE_T GetPropertyAllocatedSize(const FProperty* Property, const void* Value);
+
+	SIZE_T GetStructAllocatedSize(const UScriptStruct* Struct, const void* Data)
+	{
+		SIZE_T Size = 0;
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+			{
+				Size += GetPropertyAllocatedSize(*It, It->ContainerPtrToValuePtr<void>(Data, Index));
+			}
+		}
+
+		return Size;
+	}
+
+	SIZE_T GetPropertyAllocatedSize(const FProperty* Property, const void* Value)
+	{
+		if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+		{
+			return StrProperty->GetPropertyValue(Value).GetAllocatedSize();
+		}
+
+		if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+		{
+			// Text data is shared, count its display string only
+			return TextProperty->GetPropertyValue(Value).ToString().GetAllocatedSize();
+		}
+
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			return GetStructAllocatedSize(StructProperty->Struct, Value);
+		}
+
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper Helper(ArrayProperty, Value);
+
+			SIZE_T Size = Helper.Num() * ArrayProperty->Inner->ElementSize;
+			for (int32 Index = 0; Index < Helper.Num(); ++Index)
+			{
+				Size += GetPropertyAllocatedSize(ArrayProperty->Inner, Helper.GetRawPtr(Index));
+			}
+
+			return Size;
+		}
+
+		if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+		{
+			FScriptMapHelper Helper(MapProperty, Value);
+
+			// Pair storage and hash bucket per element
+			SIZE_T Size = Helper.Num() * (MapProperty->KeyProp->ElementSize + MapProperty->ValueProp->ElementSize + sizeof(FSetElementId) * 2);
+			for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+			{
+				if (Helper.IsValidIndex(Index))
+				{
+					Size += GetPropertyAllocatedSize(MapProperty->KeyProp, Helper.GetKeyPtr(Index));
+					Size += GetPropertyAllocatedSize(MapProperty->ValueProp, Helper.GetValuePtr(Index));
+				}
+			}
+
+			return Size;
+		}
+
+		if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		{
+			FScriptSetHelper Helper(SetProperty, Value);
+
+			SIZE_T Size = Helper.Num() * (SetProperty->ElementProp->ElementSize + sizeof(FSetElementId) * 2);
+			for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+			{
+				if (Helper.IsValidIndex(Index))
+				{
+					Size += GetPropertyAllocatedSize(SetProperty->ElementProp, Helper.GetElementPtr(Index));
+				}
+			}
+
+			return Size;
+		}
+
+		// Numbers, enums, names and object pointers don't own heap memory
+		return 0;
+	}
+} // namespace XsollaUtilsMemory
+
+SIZE_T FXsollaUtilsMemory::GetAllocatedSize(const UScriptStruct* Struct, const void* Data)
+{
+	if (!Struct || !Data)
+	{
+		return 0;
+	}
+
+	return XsollaUtilsMemory::GetStructAllocatedSize(Struct, Data);
+}
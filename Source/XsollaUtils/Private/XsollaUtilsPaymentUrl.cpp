@@ -0,0 +1,92 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsPaymentUrl.h"
+
+#include "GenericPlatform/GenericPlatformHttp.h"
+
+namespace XsollaUtilsPaymentUrl
+{
+	void ParseQuery(const FString& Query, TMap<FString, FString>& OutParameters)
+	{
+		TArray<FString> Pairs;
+		Query.ParseIntoArray(Pairs, TEXT("&"));
+
+		for (const FString& Pair : Pairs)
+		{
+			FString Key;
+			FString Value;
+			if (!Pair.Split(TEXT("="), &Key, &Value))
+			{
+				Key = Pair;
+			}
+
+			if (!Key.IsEmpty())
+			{
+				OutParameters.Add(FGenericPlatformHttp::UrlDecode(Key).ToLower(), FGenericPlatformHttp::UrlDecode(Value));
+			}
+		}
+	}
+
+	/** Query part of URL (or of its fragment) */
+	FString GetQuery(const FString& Url)
+	{
+		FString Query;
+		return Url.Split(TEXT("?"), nullptr, &Query) ? Query : FString();
+	}
+} // namespace XsollaUtilsPaymentUrl
+
+bool FXsollaUtilsPaymentUrl::Parse(const FString& Url, FXsollaPaymentUrlResult& OutResult)
+{
+	const TMap<FString, FString> Parameters = GetParameters(Url);
+
+	const FString* Status = Parameters.Find(TEXT("status"));
+	if (!Status || Status->IsEmpty())
+	{
+		return false;
+	}
+
+	FXsollaPaymentUrlResult Result;
+	Result.StatusName = Status->ToLower();
+
+	if (Result.StatusName == TEXT("done") || Result.StatusName == TEXT("success"))
+	{
+		Result.Status = EXsollaPaymentUrlStatus::Done;
+	}
+	else if (Result.StatusName == TEXT("troubled") || Result.StatusName == TEXT("error") || Result.StatusName == TEXT("failed"))
+	{
+		Result.Status = EXsollaPaymentUrlStatus::Failed;
+	}
+	else if (Result.StatusName == TEXT("canceled") || Result.StatusName == TEXT("cancelled"))
+	{
+		Result.Status = EXsollaPaymentUrlStatus::Canceled;
+	}
+
+	if (const FString* OrderId = Parameters.Find(TEXT("order_id")))
+	{
+		Result.OrderId = FCString::Atoi(**OrderId);
+	}
+
+	if (const FString* InvoiceId = Parameters.Find(TEXT("invoice_id")))
+	{
+		Result.InvoiceId = *InvoiceId;
+	}
+
+	OutResult = Result;
+	return true;
+}
+
+TMap<FString, FString> FXsollaUtilsPaymentUrl::GetParameters(const FString& Url)
+{
+	using namespace XsollaUtilsPaymentUrl;
+
+	FString Location = Url;
+	FString Fragment;
+	Url.Split(TEXT("#"), &Location, &Fragment);
+
+	TMap<FString, FString> Parameters;
+	ParseQuery(GetQuery(Location), Parameters);
+	ParseQuery(GetQuery(Fragment), Parameters);
+
+	return Parameters;
+}
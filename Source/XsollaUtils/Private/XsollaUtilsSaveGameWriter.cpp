@@ -0,0 +1,114 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsSaveGameWriter.h"
+
+#include "XsollaUtilsDefines.h"
+#include "XsollaUtilsTrace.h"
+
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "GameFramework/SaveGame.h"
+#include "Kismet/GameplayStatics.h"
+
+FXsollaSaveGameWriter::FXsollaSaveGameWriter(const FString& InSlotName, int32 InUserIndex, float InCoalescingInterval)
+	: SlotName(InSlotName)
+	, UserIndex(InUserIndex)
+	, CoalescingInterval(InCoalescingInterval)
+{
+}
+
+FXsollaSaveGameWriter::~FXsollaSaveGameWriter()
+{
+	Flush();
+}
+
+void FXsollaSaveGameWriter::Save(USaveGame* SaveGame)
+{
+	check(IsInGameThread());
+
+	PendingSaveGame = SaveGame;
+	ScheduleWrite();
+}
+
+void FXsollaSaveGameWriter::Flush()
+{
+	if (CoalescingTimerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(CoalescingTimerHandle);
+		CoalescingTimerHandle.Reset();
+	}
+
+	if (WriteTask.IsValid())
+	{
+		WriteTask.Wait();
+		WriteTask = TFuture<bool>();
+	}
+
+	if (PendingSaveGame.IsValid())
+	{
+		XSOLLA_TRACE_SCOPE(XsollaSaveGameWrite);
+
+		if (!UGameplayStatics::SaveGameToSlot(PendingSaveGame.Get(), SlotName, UserIndex))
+		{
+			UE_LOG(LogXsollaUtils, Error, TEXT("%s: Can't write save game slot: %s"), *VA_FUNC_LINE, *SlotName);
+		}
+	}
+
+	PendingSaveGame.Reset();
+}
+
+bool FXsollaSaveGameWriter::HandleCoalescingTimer(float DeltaTime)
+{
+	CoalescingTimerHandle.Reset();
+
+	StartWrite();
+
+	// One-shot timer
+	return false;
+}
+
+void FXsollaSaveGameWriter::StartWrite()
+{
+	if (!PendingSaveGame.IsValid())
+	{
+		return;
+	}
+
+	// Previous write is still in progress, try again later so writes don't overlap
+	if (WriteTask.IsValid() && !WriteTask.IsReady())
+	{
+		ScheduleWrite();
+		return;
+	}
+
+	TArray<uint8> SaveData;
+	const bool bSerialized = XSOLLA_TRACE_EXPRESSION(XsollaSaveGameSerialize, UGameplayStatics::SaveGameToMemory(PendingSaveGame.Get(), SaveData));
+	PendingSaveGame.Reset();
+
+	if (!bSerialized)
+	{
+		UE_LOG(LogXsollaUtils, Error, TEXT("%s: Can't serialize save game for slot: %s"), *VA_FUNC_LINE, *SlotName);
+		return;
+	}
+
+	const FString TaskSlotName = SlotName;
+	const int32 TaskUserIndex = UserIndex;
+	WriteTask = Async(EAsyncExecution::ThreadPool, [SaveData = MoveTemp(SaveData), TaskSlotName, TaskUserIndex]() {
+		const bool bSaved = XSOLLA_TRACE_EXPRESSION(XsollaSaveGameWrite, UGameplayStatics::SaveDataToSlot(SaveData, TaskSlotName, TaskUserIndex));
+		if (!bSaved)
+		{
+			UE_LOG(LogXsollaUtils, Error, TEXT("%s: Can't write save game slot: %s"), *VA_FUNC_LINE, *TaskSlotName);
+		}
+
+		return bSaved;
+	});
+}
+
+void FXsollaSaveGameWriter::ScheduleWrite()
+{
+	if (!CoalescingTimerHandle.IsValid())
+	{
+		CoalescingTimerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FXsollaSaveGameWriter::HandleCoalescingTimer), CoalescingInterval);
+	}
+}
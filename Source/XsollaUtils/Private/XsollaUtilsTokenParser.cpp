@@ -0,0 +1,183 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsTokenParser.h"
+
+#include "XsollaUtilsDefines.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/Base64.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace XsollaUtilsTokenParser
+{
+	/** Cache is dropped entirely when this number of tokens is reached */
+	static const int32 MaxCachedTokens = 32;
+
+	struct FCachedClaims
+	{
+		FString Token;
+		FXsollaJwtClaimsPtr Claims;
+	};
+
+	FCriticalSection& GetCacheLock()
+	{
+		static FCriticalSection CacheLock;
+		return CacheLock;
+	}
+
+	TMap<uint32, FCachedClaims>& GetCache()
+	{
+		static TMap<uint32, FCachedClaims> Cache;
+		return Cache;
+	}
+} // namespace XsollaUtilsTokenParser
+
+bool FXsollaJwtClaims::TryGetClaim(const FString& Name, FString& OutValue) const
+{
+	if (const FString* Value = Claims.Find(Name))
+	{
+		OutValue = *Value;
+		return true;
+	}
+
+	return false;
+}
+
+FXsollaJwtClaimsPtr FXsollaUtilsTokenParser::GetClaims(const FString& Token)
+{
+	using namespace XsollaUtilsTokenParser;
+
+	const uint32 TokenHash = GetTypeHash(Token);
+
+	{
+		FScopeLock Lock(&GetCacheLock());
+		if (const FCachedClaims* CachedClaims = GetCache().Find(TokenHash))
+		{
+			// Hash collision is possible, so check the token itself
+			if (CachedClaims->Token == Token)
+			{
+				return CachedClaims->Claims;
+			}
+		}
+	}
+
+	// Malformed tokens are cached too, so they aren't parsed again
+	FXsollaJwtClaimsPtr Claims = ParseClaims(Token);
+
+	{
+		FScopeLock Lock(&GetCacheLock());
+		TMap<uint32, FCachedClaims>& Cache = GetCache();
+		if (Cache.Num() >= MaxCachedTokens)
+		{
+			Cache.Empty();
+		}
+
+		FCachedClaims& CachedClaims = Cache.FindOrAdd(TokenHash);
+		CachedClaims.Token = Token;
+		CachedClaims.Claims = Claims;
+	}
+
+	return Claims;
+}
+
+bool FXsollaUtilsTokenParser::DecodeBase64Url(const FString& Source, TArray<uint8>& OutBytes)
+{
+	FString Base64 = Source.Replace(TEXT("-"), TEXT("+")).Replace(TEXT("_"), TEXT("/"));
+
+	// Restore padding stripped by base64url encoding
+	switch (Base64.Len() % 4)
+	{
+	case 0:
+		break;
+
+	case 2:
+		Base64 += TEXT("==");
+		break;
+
+	case 3:
+		Base64 += TEXT("=");
+		break;
+
+	default:
+		return false;
+	}
+
+	return FBase64::Decode(Base64, OutBytes);
+}
+
+void FXsollaUtilsTokenParser::ResetCache()
+{
+	using namespace XsollaUtilsTokenParser;
+
+	FScopeLock Lock(&GetCacheLock());
+	GetCache().Empty();
+}
+
+FXsollaJwtClaimsPtr FXsollaUtilsTokenParser::ParseClaims(const FString& Token)
+{
+	TArray<FString> TokenParts;
+	Token.ParseIntoArray(TokenParts, TEXT("."), false);
+	if (TokenParts.Num() != 3)
+	{
+		UE_LOG(LogXsollaUtils, Warning, TEXT("%s: Token should consist of three parts, found %d"), *VA_FUNC_LINE, TokenParts.Num());
+		return nullptr;
+	}
+
+	TArray<uint8> PayloadBytes;
+	if (!DecodeBase64Url(TokenParts[1], PayloadBytes) || PayloadBytes.Num() == 0)
+	{
+		UE_LOG(LogXsollaUtils, Warning, TEXT("%s: Can't decode token payload"), *VA_FUNC_LINE);
+		return nullptr;
+	}
+
+	// Payload is UTF-8 encoded json
+	FUTF8ToTCHAR PayloadConverter(reinterpret_cast<const ANSICHAR*>(PayloadBytes.GetData()), PayloadBytes.Num());
+	const FString PayloadStr(PayloadConverter.Length(), PayloadConverter.Get());
+
+	TSharedPtr<FJsonObject> PayloadJsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PayloadStr);
+	if (!FJsonSerializer::Deserialize(Reader, PayloadJsonObject) || !PayloadJsonObject.IsValid())
+	{
+		UE_LOG(LogXsollaUtils, Warning, TEXT("%s: Can't deserialize token payload"), *VA_FUNC_LINE);
+		return nullptr;
+	}
+
+	TSharedPtr<FXsollaJwtClaims, ESPMode::ThreadSafe> Claims = MakeShared<FXsollaJwtClaims, ESPMode::ThreadSafe>();
+
+	for (const auto& Field : PayloadJsonObject->Values)
+	{
+		FString Value;
+		if (Field.Value.IsValid() && Field.Value->TryGetString(Value))
+		{
+			Claims->Claims.Add(Field.Key, Value);
+		}
+	}
+
+	Claims->TryGetClaim(TEXT("sub"), Claims->Sub);
+	Claims->TryGetClaim(TEXT("provider"), Claims->Provider);
+	Claims->TryGetClaim(TEXT("id"), Claims->Id);
+	Claims->TryGetClaim(TEXT("iss"), Claims->Iss);
+
+	FString Aud;
+	if (Claims->TryGetClaim(TEXT("aud"), Aud))
+	{
+		Claims->Aud.Add(Aud);
+	}
+	else
+	{
+		PayloadJsonObject->TryGetStringArrayField(TEXT("aud"), Claims->Aud);
+	}
+
+	PayloadJsonObject->TryGetBoolField(TEXT("is_master"), Claims->bIsMaster);
+
+	double Exp = 0.;
+	if (PayloadJsonObject->TryGetNumberField(TEXT("exp"), Exp))
+	{
+		Claims->Exp = static_cast<int64>(Exp);
+	}
+
+	return Claims;
+}
@@ -0,0 +1,31 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsTrace.h"
+
+#if XSOLLA_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_DEFINE(XsollaChannel)
+
+#endif // XSOLLA_TRACE_ENABLED
+
+void FXsollaUtilsTrace::OutputRequestBegin(const void* Request, const FString& Endpoint, int32 RequestBytes)
+{
+#if XSOLLA_TRACE_ENABLED
+	if (XsollaChannel)
+	{
+		// Request address pairs begin and end of concurrent requests to the same endpoint
+		TRACE_BOOKMARK(TEXT("Xsolla %s begin [%llx] %d bytes"), *Endpoint, static_cast<uint64>(reinterpret_cast<UPTRINT>(Request)), FMath::Max(0, RequestBytes));
+	}
+#endif // XSOLLA_TRACE_ENABLED
+}
+
+void FXsollaUtilsTrace::OutputRequestEnd(const void* Request, const FString& Endpoint, int32 StatusCode, int32 ResponseBytes)
+{
+#if XSOLLA_TRACE_ENABLED
+	if (XsollaChannel)
+	{
+		TRACE_BOOKMARK(TEXT("Xsolla %s end [%llx] %d, %d bytes"), *Endpoint, static_cast<uint64>(reinterpret_cast<UPTRINT>(Request)), StatusCode, FMath::Max(0, ResponseBytes));
+	}
+#endif // XSOLLA_TRACE_ENABLED
+}
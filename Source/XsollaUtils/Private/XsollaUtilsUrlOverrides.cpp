@@ -0,0 +1,82 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaUtilsUrlOverrides.h"
+
+#include "XsollaUtilsDefines.h"
+
+#include "Misc/ScopeLock.h"
+
+namespace XsollaUtilsUrlOverrides
+{
+	FCriticalSection& GetOverridesLock()
+	{
+		static FCriticalSection OverridesLock;
+		return OverridesLock;
+	}
+
+	TMap<FString, FString>& GetOverrides()
+	{
+		static TMap<FString, FString> Overrides;
+		return Overrides;
+	}
+} // namespace XsollaUtilsUrlOverrides
+
+const FString FXsollaUtilsUrlOverrides::StoreApiBaseUrl(TEXT("https://store.xsolla.com/api"));
+const FString FXsollaUtilsUrlOverrides::LoginApiBaseUrl(TEXT("https://login.xsolla.com/api"));
+const FString FXsollaUtilsUrlOverrides::PayStationBaseUrl(TEXT("https://secure.xsolla.com/paystation3"));
+const FString FXsollaUtilsUrlOverrides::SandboxPayStationBaseUrl(TEXT("https://sandbox-secure.xsolla.com/paystation3"));
+
+void FXsollaUtilsUrlOverrides::SetBaseUrlOverride(const FString& DefaultBaseUrl, const FString& OverrideBaseUrl)
+{
+	using namespace XsollaUtilsUrlOverrides;
+
+	FScopeLock Lock(&GetOverridesLock());
+	if (OverrideBaseUrl.IsEmpty())
+	{
+		GetOverrides().Remove(DefaultBaseUrl);
+		UE_LOG(LogXsollaUtils, Log, TEXT("%s: Base URL override removed: %s"), *VA_FUNC_LINE, *DefaultBaseUrl);
+	}
+	else
+	{
+		// Trailing slash would produce double slashes in request URLs
+		FString BaseUrl = OverrideBaseUrl;
+		BaseUrl.RemoveFromEnd(TEXT("/"));
+
+		GetOverrides().Add(DefaultBaseUrl, BaseUrl);
+		UE_LOG(LogXsollaUtils, Log, TEXT("%s: Base URL override: %s -> %s"), *VA_FUNC_LINE, *DefaultBaseUrl, *BaseUrl);
+	}
+}
+
+FString FXsollaUtilsUrlOverrides::GetBaseUrl(const FString& DefaultBaseUrl)
+{
+	using namespace XsollaUtilsUrlOverrides;
+
+	FScopeLock Lock(&GetOverridesLock());
+	const FString* BaseUrl = GetOverrides().Find(DefaultBaseUrl);
+	return BaseUrl ? *BaseUrl : DefaultBaseUrl;
+}
+
+FString FXsollaUtilsUrlOverrides::Apply(const FString& Url)
+{
+	using namespace XsollaUtilsUrlOverrides;
+
+	FScopeLock Lock(&GetOverridesLock());
+	for (const auto& Override : GetOverrides())
+	{
+		if (Url.StartsWith(Override.Key, ESearchCase::CaseSensitive))
+		{
+			return Override.Value + Url.RightChop(Override.Key.Len());
+		}
+	}
+
+	return Url;
+}
+
+void FXsollaUtilsUrlOverrides::Reset()
+{
+	using namespace XsollaUtilsUrlOverrides;
+
+	FScopeLock Lock(&GetOverridesLock());
+	GetOverrides().Empty();
+}
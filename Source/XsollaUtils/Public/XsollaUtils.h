@@ -0,0 +1,47 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+/**
+ * Xsolla SDK shared utilities used by Login, Store and PayStation modules
+ */
+class FXsollaUtilsModule : public IModuleInterface
+{
+public:
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+	/**
+	 * Singleton-like access to this module's interface.  This is just for convenience!
+	 * Beware of calling this during the shutdown phase, though.  Your module might have been unloaded already.
+	 *
+	 * @return Returns singleton instance, loading the module on demand if needed
+	 */
+	static inline FXsollaUtilsModule& Get()
+	{
+		return FModuleManager::LoadModuleChecked<FXsollaUtilsModule>("XsollaUtils");
+	}
+
+	/**
+	 * Checks to see if this module is loaded and ready.  It is only valid to call Get() if IsAvailable() returns true.
+	 *
+	 * @return True if the module is loaded and ready to use
+	 */
+	static inline bool IsAvailable()
+	{
+		return FModuleManager::Get().IsModuleLoaded("XsollaUtils");
+	}
+
+private:
+#if WITH_EDITOR
+	/** Add SDK assets to cook, they're referenced by soft paths only */
+	void ModifyCook(TArray<FName>& PackagesToCook, TArray<FName>& PackagesToNeverCook);
+
+	FDelegateHandle ModifyCookHandle;
+#endif // WITH_EDITOR
+};
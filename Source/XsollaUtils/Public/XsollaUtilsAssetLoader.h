@@ -0,0 +1,44 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+struct FStreamableHandle;
+
+/**
+ * Lazy loader of SDK assets referenced by soft paths, so nothing is loaded on subsystem construction.
+ * Assets are streamed in background on Prefetch or loaded on first Load call (which waits for background
+ * loading if it's started already), then kept in memory while loader exists.
+ */
+class XSOLLAUTILS_API FXsollaUtilsAssetLoader
+{
+public:
+	FXsollaUtilsAssetLoader(const TArray<FSoftObjectPath>& InAssets);
+	~FXsollaUtilsAssetLoader();
+
+	/** Start background loading of assets, delegate is called once they're loaded */
+	void Prefetch(const FSimpleDelegate& InOnLoaded = FSimpleDelegate());
+
+	/** Make sure assets are loaded (blocks game thread if they aren't) */
+	void Load();
+
+	/** True if all assets are loaded */
+	bool IsLoaded() const;
+
+private:
+	void HandleLoadCompleted();
+
+private:
+	TArray<FSoftObjectPath> Assets;
+
+	/** Streaming request keeping assets loaded */
+	TSharedPtr<FStreamableHandle> Handle;
+
+	/** Time the loading was requested at */
+	double RequestTime;
+
+	FSimpleDelegate OnLoaded;
+};
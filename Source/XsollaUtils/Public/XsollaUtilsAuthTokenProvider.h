@@ -0,0 +1,53 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "UObject/WeakObjectPtr.h"
+
+#include "XsollaUtilsAuthTokenProvider.generated.h"
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UXsollaAuthTokenProvider : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/** Source of actual user authorization token (implemented by Login token manager) */
+class XSOLLAUTILS_API IXsollaAuthTokenProvider
+{
+	GENERATED_BODY()
+
+public:
+	/** Get current user authorization token, empty if user isn't authenticated */
+	virtual FString GetAuthToken() const = 0;
+
+	/** Get token that replaced AuthToken by refresh, empty if AuthToken wasn't refreshed by this provider */
+	virtual FString GetRefreshedAuthToken(const FString& AuthToken) const = 0;
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnXsollaAuthTokenReceived, const UObject* /* GameInstance */, const FString& /* Token */);
+
+/** Token providers registered for game instances, so modules can share tokens without direct dependency */
+class XSOLLAUTILS_API FXsollaAuthTokenProviderRegistry
+{
+public:
+	/** Register token provider object for game instance */
+	static void Register(const UObject* GameInstance, UObject* Provider);
+
+	/** Remove token provider registered for game instance */
+	static void Unregister(const UObject* GameInstance);
+
+	/** Find token provider for game instance, returns nullptr if nothing is registered */
+	static IXsollaAuthTokenProvider* Find(const UObject* GameInstance);
+
+	/** Event broadcast by provider when user got token by authentication (not by token refresh) */
+	static FOnXsollaAuthTokenReceived& OnAuthTokenReceived();
+
+private:
+	static TMap<TWeakObjectPtr<const UObject>, TWeakObjectPtr<UObject>> Providers;
+
+	static FOnXsollaAuthTokenReceived AuthTokenReceived;
+};
@@ -0,0 +1,49 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Opens connections to Xsolla hosts ahead of first request, so DNS lookup and TLS handshake aren't paid by login or purchase.
+ * Cheap HEAD request is sent once per host while any owner uses it, then connection is kept alive by http module for following requests.
+ * Url overrides are applied, so staging or local stand-in server is warmed up if it's set.
+ * First request latency with and without warm-up is collected by http telemetry (see FXsollaHttpTelemetry::GetFirstRequestStats).
+ */
+class XSOLLAUTILS_API FXsollaUtilsConnectionWarmer
+{
+public:
+	/** Send HEAD request to host of url unless it's already warmed up, owner keeps host state until it's released */
+	static void WarmUp(const FString& Url, const UObject* Owner = nullptr);
+
+	/** Drop owner from warmed up hosts, host is forgotten when its last owner is gone (next PIE run warms it up again) */
+	static void Release(const UObject* Owner);
+
+	/** True if connection to host of url was opened by warm-up */
+	static bool IsWarmedUp(const FString& Url);
+
+	/** Scheme, host and port of url */
+	static FString GetOrigin(const FString& Url);
+
+	/** Forget all warmed up hosts including ones warmed up without owner (module shutdown) */
+	static void Reset();
+
+private:
+	static void HandleWarmUpComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FString Origin);
+
+	struct FOriginState
+	{
+		/** False while warm-up request is in flight */
+		bool bWarmedUp = false;
+
+		/** Objects that requested warm-up of host */
+		TSet<FObjectKey> Owners;
+	};
+
+	/** Warmed up hosts by origin */
+	static TMap<FString, FOriginState> Origins;
+};
@@ -0,0 +1,54 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Minimal set of crypto primitives required for JWT signature verification (backed by engine OpenSSL) */
+class XSOLLAUTILS_API FXsollaUtilsCrypto
+{
+public:
+	/** Size of SHA-256 digest in bytes */
+	static const int32 Sha256DigestSize = 32;
+
+	/** Calculate SHA-256 digest of data. OutDigest should fit Sha256DigestSize bytes */
+	static void Sha256(const uint8* Data, int32 DataSize, uint8* OutDigest);
+
+	/** Calculate HMAC-SHA256 of data. OutDigest should fit Sha256DigestSize bytes */
+	static void HmacSha256(const uint8* Key, int32 KeySize, const uint8* Data, int32 DataSize, uint8* OutDigest);
+
+	/** Compare buffers in time independent of their content */
+	static bool ConstantTimeEquals(const uint8* A, const uint8* B, int32 Size);
+};
+
+struct rsa_st;
+
+/**
+ * RSA public key prepared for repeated signature verification.
+ * Key is immutable after initialization and can be used from any thread.
+ */
+class XSOLLAUTILS_API FXsollaRsaPublicKey
+{
+public:
+	FXsollaRsaPublicKey();
+	~FXsollaRsaPublicKey();
+
+	FXsollaRsaPublicKey(const FXsollaRsaPublicKey&) = delete;
+	FXsollaRsaPublicKey& operator=(const FXsollaRsaPublicKey&) = delete;
+
+	/** Initialize key from big-endian modulus and exponent. Returns false if key is unsupported */
+	bool Initialize(const TArray<uint8>& Modulus, const TArray<uint8>& Exponent);
+
+	/** Whether key is initialized */
+	bool IsValid() const;
+
+	/** Verify RSASSA-PKCS1-v1_5 signature with SHA-256 digest (RS256) */
+	bool VerifyPkcs1Sha256(const uint8* Data, int32 DataSize, const TArray<uint8>& Signature) const;
+
+private:
+	void Reset();
+
+	/** OpenSSL key, null until initialized */
+	rsa_st* Key;
+};
@@ -0,0 +1,267 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+#include "XsollaUtilsHttpTelemetry.generated.h"
+
+/** Latency distribution of one request phase */
+USTRUCT(BlueprintType)
+struct XSOLLAUTILS_API FXsollaHttpTimingStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	int32 Count;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	float MinMs;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	float MaxMs;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	float AverageMs;
+
+	/** Percentiles are estimated by histogram bucket upper bounds */
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	float P50Ms;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	float P90Ms;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	float P99Ms;
+
+	/** Number of samples in each bucket, see FXsollaHttpTelemetry::GetBucketUpperBoundsMs() */
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	TArray<int32> Buckets;
+
+	FXsollaHttpTimingStats()
+		: Count(0)
+		, MinMs(0.f)
+		, MaxMs(0.f)
+		, AverageMs(0.f)
+		, P50Ms(0.f)
+		, P90Ms(0.f)
+		, P99Ms(0.f){};
+};
+
+/** Telemetry of single endpoint (verb and url path with identifiers replaced by {id}) */
+USTRUCT(BlueprintType)
+struct XSOLLAUTILS_API FXsollaHttpEndpointStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	FString Endpoint;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	int32 RequestCount;
+
+	/** Requests failed to connect or completed with non-2xx status */
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	int32 ErrorCount;
+
+	/** Responses count by http status (0 for connection failures) */
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	TMap<int32, int32> StatusCodes;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	int64 RequestBytes;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	int64 ResponseBytes;
+
+	/** Time from request creation until it was sent (SDK queues and http module queue) */
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	FXsollaHttpTimingStats Queue;
+
+	/** Time from sending until first response bytes were received */
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	FXsollaHttpTimingStats TimeToFirstByte;
+
+	/** Time from sending until response was completed */
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	FXsollaHttpTimingStats Total;
+
+	/** Time spent in SDK response handler (parsing and callbacks) */
+	UPROPERTY(BlueprintReadOnly, Category = "Http Telemetry")
+	FXsollaHttpTimingStats Parse;
+
+	FXsollaHttpEndpointStats()
+		: RequestCount(0)
+		, ErrorCount(0)
+		, RequestBytes(0)
+		, ResponseBytes(0){};
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnXsollaHttpTelemetryDump, const FString& /* TelemetryJson */);
+
+/**
+ * Per-endpoint latency, size and error telemetry of SDK http requests.
+ * Requests are tracked when created by SDK modules, and completed when response handler bound with BindHandler is run.
+ *
+ * Console: Xsolla.Telemetry.Dump, Xsolla.Telemetry.Reset
+ * Periodic dump: Xsolla.Telemetry.DumpInterval (seconds), Xsolla.Telemetry.DumpToFile
+ */
+class XSOLLAUTILS_API FXsollaHttpTelemetry
+{
+public:
+	static FXsollaHttpTelemetry& Get();
+
+	/** Start periodic dump ticker */
+	void Initialize();
+
+	/** Stop periodic dump ticker */
+	void Shutdown();
+
+	/** Start tracking request created by SDK module (call before request is processed) */
+	void TrackRequest(const TSharedRef<IHttpRequest>& HttpRequest);
+
+	/** Collected stats of all endpoints */
+	TArray<FXsollaHttpEndpointStats> GetEndpointStats() const;
+
+	/** Collected stats of endpoint, false if endpoint wasn't called */
+	bool GetEndpointStats(const FString& Endpoint, FXsollaHttpEndpointStats& OutStats) const;
+
+	/** Total time of first request to each host in session, split by whether connection was warmed up (see FXsollaUtilsConnectionWarmer) */
+	void GetFirstRequestStats(FXsollaHttpTimingStats& OutCold, FXsollaHttpTimingStats& OutWarmedUp) const;
+
+	/** Drop collected stats */
+	void Reset();
+
+	/** Serialize collected stats to json */
+	FString ToJson() const;
+
+	/** Broadcast stats json to OnDump listeners and write it to Saved/XsollaTelemetry if enabled */
+	void Dump();
+
+	/** Event occurs on every dump, use it to ship stats to own telemetry */
+	FOnXsollaHttpTelemetryDump OnDump;
+
+	/** Upper bounds of latency histogram buckets, last bucket is unbounded */
+	static const TArray<float>& GetBucketUpperBoundsMs();
+
+	/** Endpoint name of request: verb and url path with identifiers replaced by {id} */
+	static FString GetEndpointName(const FString& Verb, const FString& Url);
+
+	/** Response handler which runs Handler inside request telemetry, trace and LLM scopes */
+	static FHttpRequestCompleteDelegate WrapHandler(const FHttpRequestCompleteDelegate& Handler);
+
+	/** Bind UObject response handler to request, see WrapHandler */
+	template <typename UserClass, typename... VarTypes>
+	static void BindHandler(const FHttpRequestPtr& HttpRequest, UserClass* Object, typename TMemFunPtrType<false, UserClass, void(FHttpRequestPtr, FHttpResponsePtr, bool, VarTypes...)>::Type Func, VarTypes... Vars)
+	{
+		HttpRequest->OnProcessRequestComplete() = WrapHandler(FHttpRequestCompleteDelegate::CreateUObject(Object, Func, Vars...));
+	}
+
+protected:
+	friend class FXsollaHttpTelemetryScope;
+
+	/** Response handler started */
+	void BeginHandler(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
+
+	/** Response handler finished */
+	void EndHandler(FHttpRequestPtr HttpRequest);
+
+private:
+	FXsollaHttpTelemetry();
+
+	void HandleRequestProgress(FHttpRequestPtr HttpRequest, int32 BytesSent, int32 BytesReceived);
+
+	bool HandleDumpTicker(float DeltaTime);
+
+	struct FHistogram
+	{
+		TArray<int32> Buckets;
+		int32 Count;
+		double SumMs;
+		double MinMs;
+		double MaxMs;
+
+		FHistogram();
+
+		void Add(double Ms);
+		FXsollaHttpTimingStats ToStats() const;
+	};
+
+	struct FEndpointData
+	{
+		int32 RequestCount;
+		int32 ErrorCount;
+		TMap<int32, int32> StatusCodes;
+		int64 RequestBytes;
+		int64 ResponseBytes;
+
+		FHistogram Queue;
+		FHistogram TimeToFirstByte;
+		FHistogram Total;
+		FHistogram Parse;
+
+		FEndpointData()
+			: RequestCount(0)
+			, ErrorCount(0)
+			, RequestBytes(0)
+			, ResponseBytes(0){};
+
+		FXsollaHttpEndpointStats ToStats(const FString& Endpoint) const;
+	};
+
+	struct FTrackedRequest
+	{
+		TWeakPtr<IHttpRequest> Request;
+		FString Endpoint;
+		double CreatedTime;
+		double FirstByteTime;
+		double HandlerStartTime;
+
+		/** Handlers may be nested (journaled requests are dispatched to regular handlers) */
+		int32 HandlerDepth;
+
+		/** Whether connection to host was warmed up when request was created */
+		bool bConnectionWarmedUp;
+
+		FTrackedRequest()
+			: CreatedTime(0.)
+			, FirstByteTime(0.)
+			, HandlerStartTime(0.)
+			, HandlerDepth(0)
+			, bConnectionWarmedUp(false){};
+	};
+
+	/** Drop requests destroyed without response handler */
+	void PruneTrackedRequests();
+
+	mutable FCriticalSection DataLock;
+
+	TMap<FString, FEndpointData> Endpoints;
+
+	TMap<const IHttpRequest*, FTrackedRequest> TrackedRequests;
+
+	/** Hosts which got first request already */
+	TSet<FString> FirstRequestOrigins;
+
+	FHistogram FirstRequestCold;
+	FHistogram FirstRequestWarmedUp;
+
+	FDelegateHandle DumpTickerHandle;
+
+	double LastDumpTime;
+};
+
+/** Completes request telemetry and measures response handler time. Opened by handlers bound with FXsollaHttpTelemetry::BindHandler */
+class XSOLLAUTILS_API FXsollaHttpTelemetryScope
+{
+public:
+	FXsollaHttpTelemetryScope(FHttpRequestPtr InHttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
+	~FXsollaHttpTelemetryScope();
+
+private:
+	FHttpRequestPtr HttpRequest;
+};
@@ -0,0 +1,75 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Misc/ScopeRWLock.h"
+
+class FXsollaRsaPublicKey;
+
+/** Result of local JWT verification */
+enum class EXsollaJwtVerifyResult : uint8
+{
+	Valid,
+	Malformed,
+	UnsupportedAlgorithm,
+	/** No secret or no key with token kid, remote validation is required */
+	KeyNotFound,
+	InvalidSignature,
+	Expired,
+	InvalidIssuer,
+	InvalidAudience,
+};
+
+XSOLLAUTILS_API const TCHAR* LexToString(EXsollaJwtVerifyResult Result);
+
+/** Claims checks performed after signature verification */
+struct XSOLLAUTILS_API FXsollaJwtVerifyOptions
+{
+	/** Expected iss claim, not checked if empty */
+	FString Issuer;
+
+	/** Expected aud claim value, not checked if empty */
+	FString Audience;
+
+	/** Allowed clock skew for exp claim (seconds) */
+	int32 Leeway;
+
+	FXsollaJwtVerifyOptions()
+		: Leeway(0){};
+};
+
+/**
+ * Local JWT signature verifier supporting HS256 (shared secret) and RS256 (JWKS keys).
+ * Keys can be replaced at any time, verification is thread-safe, so dedicated servers
+ * can verify player tokens from worker threads.
+ */
+class XSOLLAUTILS_API FXsollaJwtVerifier
+{
+public:
+	/** Set HS256 shared secret */
+	void SetSecret(const FString& Secret);
+
+	/** Replace RS256 keys with the ones from JWKS json document. Returns number of imported keys */
+	int32 SetJwks(const FString& JwksJson);
+
+	/** Whether RS256 key with given id is known */
+	bool HasKey(const FString& KeyId) const;
+
+	/** Verify token signature and claims */
+	EXsollaJwtVerifyResult Verify(const FString& Token, const FXsollaJwtVerifyOptions& Options) const;
+
+private:
+	typedef TSharedPtr<const FXsollaRsaPublicKey, ESPMode::ThreadSafe> FRsaPublicKeyPtr;
+
+	/** Find RS256 key by id. Key id can be omitted if there is the only key */
+	FRsaPublicKeyPtr FindKey(const FString& KeyId) const;
+
+	mutable FRWLock KeysLock;
+
+	TArray<uint8> SecretBytes;
+
+	TMap<FString, FRsaPublicKeyPtr> RsaKeys;
+};
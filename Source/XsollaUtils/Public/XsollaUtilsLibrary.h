@@ -0,0 +1,33 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "XsollaUtilsHttpTelemetry.h"
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "XsollaUtilsLibrary.generated.h"
+
+UCLASS()
+class XSOLLAUTILS_API UXsollaUtilsLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/** Latency, size and error stats of all called Xsolla endpoints */
+	UFUNCTION(BlueprintPure, Category = "Xsolla|Telemetry")
+	static TArray<FXsollaHttpEndpointStats> GetHttpTelemetry();
+
+	/** Latency, size and error stats of endpoint (e.g. "GET /api/v2/project/{id}/items/virtual_items") */
+	UFUNCTION(BlueprintPure, Category = "Xsolla|Telemetry")
+	static bool GetHttpEndpointTelemetry(const FString& Endpoint, FXsollaHttpEndpointStats& Stats);
+
+	/** Collected http stats serialized to json */
+	UFUNCTION(BlueprintPure, Category = "Xsolla|Telemetry")
+	static FString GetHttpTelemetryJson();
+
+	/** Drop collected http stats */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Telemetry")
+	static void ResetHttpTelemetry();
+};
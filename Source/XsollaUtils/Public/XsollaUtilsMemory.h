@@ -0,0 +1,16 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UScriptStruct;
+
+/** Memory usage estimation of SDK data */
+class XSOLLAUTILS_API FXsollaUtilsMemory
+{
+public:
+	/** Heap memory owned by struct value (strings, arrays, maps and sets found by reflection), struct size itself isn't included */
+	static SIZE_T GetAllocatedSize(const UScriptStruct* Struct, const void* Data);
+};
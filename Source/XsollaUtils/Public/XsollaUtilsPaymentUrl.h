@@ -0,0 +1,47 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Payment result reported by PayStation redirect or status page URL */
+enum class EXsollaPaymentUrlStatus : uint8
+{
+	Unknown,
+	Done,
+	Failed,
+	Canceled
+};
+
+struct XSOLLAUTILS_API FXsollaPaymentUrlResult
+{
+	EXsollaPaymentUrlStatus Status;
+
+	/** Raw status parameter value */
+	FString StatusName;
+
+	/** Store order id (zero if URL doesn't contain it) */
+	int32 OrderId;
+
+	/** PayStation invoice id (empty if URL doesn't contain it) */
+	FString InvoiceId;
+
+	FXsollaPaymentUrlResult()
+		: Status(EXsollaPaymentUrlStatus::Unknown)
+		, OrderId(0){};
+};
+
+/**
+ * Parser of URLs PayStation navigates to when payment is finished: redirect to return URL
+ * (https://example.com/?invoice_id=1&status=done) or status page (.../paystation3/#/status?status=done).
+ */
+class XSOLLAUTILS_API FXsollaUtilsPaymentUrl
+{
+public:
+	/** Returns false if URL doesn't report payment status */
+	static bool Parse(const FString& Url, FXsollaPaymentUrlResult& OutResult);
+
+	/** Get query and fragment query parameters of URL (fragment ones take precedence) */
+	static TMap<FString, FString> GetParameters(const FString& Url);
+};
@@ -0,0 +1,50 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Async/Future.h"
+#include "UObject/WeakObjectPtr.h"
+
+class USaveGame;
+
+/**
+ * Background writer of save game slot. Save object is kept in memory by owner, writer serializes it
+ * on game thread and puts bytes to slot on worker thread. Writes requested within coalescing
+ * interval are merged into one, writes to the same slot never overlap.
+ */
+class XSOLLAUTILS_API FXsollaSaveGameWriter
+{
+public:
+	FXsollaSaveGameWriter(const FString& InSlotName, int32 InUserIndex, float InCoalescingInterval = 0.5f);
+	~FXsollaSaveGameWriter();
+
+	/** Schedule write of save object (game thread only) */
+	void Save(USaveGame* SaveGame);
+
+	/** Wait for background write and synchronously write pending data (call it on shutdown) */
+	void Flush();
+
+private:
+	bool HandleCoalescingTimer(float DeltaTime);
+
+	/** Serialize pending save object and start background write */
+	void StartWrite();
+
+	void ScheduleWrite();
+
+private:
+	FString SlotName;
+	int32 UserIndex;
+	float CoalescingInterval;
+
+	/** Save object waiting to be written */
+	TWeakObjectPtr<USaveGame> PendingSaveGame;
+
+	FDelegateHandle CoalescingTimerHandle;
+
+	/** Background write in progress */
+	TFuture<bool> WriteTask;
+};
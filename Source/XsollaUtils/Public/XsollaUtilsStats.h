@@ -0,0 +1,18 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemStats.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Stats/Stats.h"
+
+/** Stat group shared by all Xsolla SDK modules (stat Xsolla) */
+DECLARE_STATS_GROUP(TEXT("Xsolla"), STATGROUP_Xsolla, STATCAT_Advanced);
+
+/** Low level memory tracker tag of SDK allocations (stat LLMFULL, -llm) */
+DECLARE_LLM_MEMORY_STAT_EXTERN(TEXT("Xsolla"), STAT_XsollaLLM, STATGROUP_LLMFULL, XSOLLAUTILS_API);
+
+/** Tag allocations made in current scope as Xsolla SDK memory */
+#define XSOLLA_LLM_SCOPE() LLM_SCOPED_TAG_WITH_STAT(STAT_XsollaLLM, ELLMTracker::Default)
@@ -0,0 +1,63 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Claims of JWT token payload */
+struct XSOLLAUTILS_API FXsollaJwtClaims
+{
+	/** User ID */
+	FString Sub;
+
+	/** Authentication provider (xsolla, steam, etc.) */
+	FString Provider;
+
+	/** Provider-specific user ID (for example, Steam profile URL) */
+	FString Id;
+
+	/** Whether user account is a master one in cross-platform account linking */
+	bool bIsMaster;
+
+	/** Expiration time (unix timestamp), zero if not set */
+	int64 Exp;
+
+	/** Token issuer */
+	FString Iss;
+
+	/** Token audience (claim can be either string or array of strings) */
+	TArray<FString> Aud;
+
+	/** All scalar claims (including custom ones) converted to strings */
+	TMap<FString, FString> Claims;
+
+	FXsollaJwtClaims()
+		: bIsMaster(false)
+		, Exp(0){};
+
+	/** Get claim value by its name, returns false if claim is absent */
+	bool TryGetClaim(const FString& Name, FString& OutValue) const;
+};
+
+typedef TSharedPtr<const FXsollaJwtClaims, ESPMode::ThreadSafe> FXsollaJwtClaimsPtr;
+
+/**
+ * JWT token payload parser. Every token is parsed once, results are shared between
+ * Xsolla modules via cache keyed by token hash.
+ */
+class XSOLLAUTILS_API FXsollaUtilsTokenParser
+{
+public:
+	/** Get parsed claims of token. Returns invalid pointer if token is malformed */
+	static FXsollaJwtClaimsPtr GetClaims(const FString& Token);
+
+	/** Decode base64url string (padding is optional) */
+	static bool DecodeBase64Url(const FString& Source, TArray<uint8>& OutBytes);
+
+	/** Drop all cached claims */
+	static void ResetCache();
+
+private:
+	static FXsollaJwtClaimsPtr ParseClaims(const FString& Token);
+};
@@ -0,0 +1,45 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Trace/Trace.h"
+
+#if UE_TRACE_ENABLED && !UE_BUILD_SHIPPING
+#define XSOLLA_TRACE_ENABLED 1
+#else
+#define XSOLLA_TRACE_ENABLED 0
+#endif
+
+/**
+ * Unreal Insights channel of Xsolla SDK activity. Enable it with -trace=cpu,bookmark,xsolla
+ * (or "Trace.Enable xsolla" in console) to see SDK scopes and request bookmarks on the timeline.
+ */
+#if XSOLLA_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(XsollaChannel, XSOLLAUTILS_API);
+
+/** Named CPU scope on Xsolla channel */
+#define XSOLLA_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, XsollaChannel)
+#else
+#define XSOLLA_TRACE_SCOPE(Name)
+#endif
+
+/** Evaluate expression inside named CPU scope on Xsolla channel */
+#define XSOLLA_TRACE_EXPRESSION(Name, Expression) ([&]() { XSOLLA_TRACE_SCOPE(Name); return (Expression); }())
+
+/**
+ * Timing Insights bookmarks of SDK http requests. Requests outlive frames, so they can't be CPU scopes:
+ * begin and end are marked on the timeline instead, handler work is in scopes right after end bookmark.
+ */
+class XSOLLAUTILS_API FXsollaUtilsTrace
+{
+public:
+	/** Request is created by SDK module */
+	static void OutputRequestBegin(const void* Request, const FString& Endpoint, int32 RequestBytes);
+
+	/** Response is received and passed to SDK handler */
+	static void OutputRequestEnd(const void* Request, const FString& Endpoint, int32 StatusCode, int32 ResponseBytes);
+};
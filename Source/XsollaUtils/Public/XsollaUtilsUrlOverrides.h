@@ -0,0 +1,38 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Runtime replacement of Xsolla API base URLs. Requests of all SDK modules go through it,
+ * so the whole SDK can be pointed to a staging or mock server without code changes.
+ */
+class XSOLLAUTILS_API FXsollaUtilsUrlOverrides
+{
+public:
+	/** Base URL of Xsolla Store API */
+	static const FString StoreApiBaseUrl;
+
+	/** Base URL of Xsolla Login API */
+	static const FString LoginApiBaseUrl;
+
+	/** Base URL of PayStation payment console */
+	static const FString PayStationBaseUrl;
+
+	/** Base URL of PayStation payment console in sandbox mode */
+	static const FString SandboxPayStationBaseUrl;
+
+	/** Replace DefaultBaseUrl with OverrideBaseUrl in request URLs. Empty override removes replacement */
+	static void SetBaseUrlOverride(const FString& DefaultBaseUrl, const FString& OverrideBaseUrl);
+
+	/** Get actual base URL that is used instead of default one */
+	static FString GetBaseUrl(const FString& DefaultBaseUrl);
+
+	/** Apply registered replacements to request URL */
+	static FString Apply(const FString& Url);
+
+	/** Remove all replacements */
+	static void Reset();
+};
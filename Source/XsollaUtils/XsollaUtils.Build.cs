@@ -0,0 +1,46 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+using UnrealBuildTool;
+
+public class XsollaUtils : ModuleRules
+{
+    public XsollaUtils(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "CoreUObject",
+                "HTTP",
+                "Json",
+                "TraceLog"
+            }
+            );
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Engine"
+            }
+            );
+
+        // Crypto primitives for JWT verification
+        AddEngineThirdPartyPrivateStaticDependencies(Target, "OpenSSL");
+
+        if (Target.bBuildEditor)
+        {
+            PrivateDependencyModuleNames.AddRange(
+                new string[]
+                {
+                    "AssetRegistry",
+                    "UnrealEd"
+                }
+                );
+        }
+
+        PublicDefinitions.Add("WITH_XSOLLA_UTILS=1");
+    }
+}
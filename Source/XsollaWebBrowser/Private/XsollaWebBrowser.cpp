@@ -3,9 +3,16 @@
 
 #include "XsollaWebBrowser.h"
 
+#include "XsollaWebBrowserContainer.h"
+#include "XsollaWebBrowserHost.h"
+#include "XsollaWebBrowserModule.h"
+
 #include "Async/TaskGraphInterfaces.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
 #include "SWebBrowser.h"
 #include "Widgets/Layout/SBox.h"
+#include "Widgets/SNullWidget.h"
 #include "Widgets/Text/STextBlock.h"
 
 #define LOCTEXT_NAMESPACE "XsollaWebBrowser"
@@ -14,13 +21,14 @@ UXsollaWebBrowser::UXsollaWebBrowser(const FObjectInitializer& ObjectInitializer
 	: Super(ObjectInitializer)
 {
 	bIsVariable = true;
+	bOccluded = false;
 }
 
 void UXsollaWebBrowser::LoadURL(FString NewURL)
 {
-	if (WebBrowserWidget.IsValid())
+	if (BrowserContainer.IsValid())
 	{
-		return WebBrowserWidget->LoadURL(NewURL);
+		GetBrowserHost().Navigate(this, NewURL);
 	}
 }
 
@@ -28,17 +36,53 @@ FString UXsollaWebBrowser::GetUrl() const
 {
 	if (WebBrowserWidget.IsValid())
 	{
-		return WebBrowserWidget->GetUrl();
+		return GetBrowserHost().GetUrl(this);
 	}
 
 	return FString();
 }
 
+void UXsollaWebBrowser::ReleaseBrowser()
+{
+	if (WebBrowserWidget.IsValid())
+	{
+		GetBrowserHost().Detach(this);
+	}
+}
+
+TArray<UXsollaWebBrowser*> UXsollaWebBrowser::FindBrowsers(UUserWidget* UserWidget)
+{
+	TArray<UXsollaWebBrowser*> Browsers;
+	if (UserWidget && UserWidget->WidgetTree)
+	{
+		UserWidget->WidgetTree->ForEachWidget([&Browsers](UWidget* ChildWidget) {
+			if (UXsollaWebBrowser* Browser = Cast<UXsollaWebBrowser>(ChildWidget))
+			{
+				Browsers.Add(Browser);
+			}
+		});
+	}
+
+	return Browsers;
+}
+
+void UXsollaWebBrowser::SetOccluded(bool bInOccluded)
+{
+	bOccluded = bInOccluded;
+}
+
 void UXsollaWebBrowser::ReleaseSlateResources(bool bReleaseChildren)
 {
 	Super::ReleaseSlateResources(bReleaseChildren);
 
+	// Module can be unloaded already on exit
+	if (WebBrowserWidget.IsValid() && IXsollaWebBrowserModule::IsAvailable())
+	{
+		GetBrowserHost().Detach(this);
+	}
+
 	WebBrowserWidget.Reset();
+	BrowserContainer.Reset();
 }
 
 TSharedRef<SWidget> UXsollaWebBrowser::RebuildWidget()
@@ -56,18 +100,34 @@ TSharedRef<SWidget> UXsollaWebBrowser::RebuildWidget()
 	}
 	else
 	{
-		WebBrowserWidget = SNew(SWebBrowser)
-			.InitialURL(InitialURL)
-			.ShowControls(false)
-			.SupportsTransparency(bSupportsTransparency)
-			.OnUrlChanged(BIND_UOBJECT_DELEGATE(FOnTextChanged, HandleOnUrlChanged))
-			.OnBeforePopup(BIND_UOBJECT_DELEGATE(FOnBeforePopupDelegate, HandleOnBeforePopup));
-
-		return WebBrowserWidget.ToSharedRef();
+		BrowserContainer = SNew(SXsollaWebBrowserContainer);
+
+		GetBrowserHost().Attach(this, bSupportsTransparency);
+		if (!InitialURL.IsEmpty())
+		{
+			GetBrowserHost().Navigate(this, InitialURL);
+		}
+
+		return BrowserContainer.ToSharedRef();
 	}
 	// clang-format on
 }
 
+void UXsollaWebBrowser::SetBrowserView(TSharedPtr<SWebBrowser> BrowserView)
+{
+	WebBrowserWidget = BrowserView;
+
+	if (BrowserContainer.IsValid())
+	{
+		BrowserContainer->SetContent(BrowserView.IsValid() ? BrowserView.ToSharedRef() : SNullWidget::NullWidget);
+	}
+}
+
+FXsollaWebBrowserHost& UXsollaWebBrowser::GetBrowserHost()
+{
+	return IXsollaWebBrowserModule::Get().GetBrowserHost();
+}
+
 void UXsollaWebBrowser::HandleOnUrlChanged(const FText& InText)
 {
 	OnUrlChanged.Broadcast(InText);
@@ -102,6 +162,32 @@ bool UXsollaWebBrowser::HandleOnBeforePopup(FString URL, FString Frame)
 	return false;
 }
 
+void UXsollaWebBrowser::HandleOnBeforeNavigation(const FString& URL, bool bIsRedirect)
+{
+	if (!OnBeforeNavigation.IsBound())
+	{
+		return;
+	}
+
+	if (IsInGameThread())
+	{
+		OnBeforeNavigation.Broadcast(URL, bIsRedirect);
+	}
+	else
+	{
+		// clang-format off
+		TWeakObjectPtr<UXsollaWebBrowser> WeakThis = this;
+		FFunctionGraphTask::CreateAndDispatchWhenReady([WeakThis, URL, bIsRedirect]()
+		{
+			if (WeakThis.IsValid())
+			{
+				WeakThis->HandleOnBeforeNavigation(URL, bIsRedirect);
+			}
+		}, TStatId(), nullptr, ENamedThreads::GameThread);
+		// clang-format on
+	}
+}
+
 #if WITH_EDITOR
 const FText UXsollaWebBrowser::GetPaletteCategory()
 {
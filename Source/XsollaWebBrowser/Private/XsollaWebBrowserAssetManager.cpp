@@ -3,6 +3,11 @@
 
 #include "XsollaWebBrowserAssetManager.h"
 
+#include "XsollaUtilsAssetLoader.h"
+
+#include "IWebBrowserSingleton.h"
+#include "WebBrowserModule.h"
+
 #if WITH_EDITOR || PLATFORM_ANDROID || PLATFORM_IOS
 #include "WebBrowserTexture.h"
 #endif
@@ -18,10 +23,30 @@ UXsollaWebBrowserAssetManager::UXsollaWebBrowserAssetManager(const FObjectInitia
 #endif
 };
 
+void UXsollaWebBrowserAssetManager::PrefetchDefaultMaterials()
+{
+	if (!AssetLoader.IsValid())
+	{
+		AssetLoader = MakeShared<FXsollaUtilsAssetLoader>(TArray<FSoftObjectPath>{DefaultMaterial.ToSoftObjectPath(), DefaultTranslucentMaterial.ToSoftObjectPath()});
+	}
+
+	AssetLoader->Prefetch(FSimpleDelegate::CreateUObject(this, &UXsollaWebBrowserAssetManager::HandleDefaultMaterialsLoaded));
+}
+
 void UXsollaWebBrowserAssetManager::LoadDefaultMaterials()
 {
-	DefaultMaterial.LoadSynchronous();
-	DefaultTranslucentMaterial.LoadSynchronous();
+	PrefetchDefaultMaterials();
+	AssetLoader->Load();
+}
+
+void UXsollaWebBrowserAssetManager::HandleDefaultMaterialsLoaded()
+{
+	IWebBrowserSingleton* WebBrowserSingleton = IWebBrowserModule::Get().GetSingleton();
+	if (WebBrowserSingleton)
+	{
+		WebBrowserSingleton->SetDefaultMaterial(GetDefaultMaterial());
+		WebBrowserSingleton->SetDefaultTranslucentMaterial(GetDefaultTranslucentMaterial());
+	}
 }
 
 UMaterial* UXsollaWebBrowserAssetManager::GetDefaultMaterial() const
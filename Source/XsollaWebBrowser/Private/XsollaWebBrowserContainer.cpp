@@ -0,0 +1,35 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaWebBrowserContainer.h"
+
+#include "XsollaUtilsStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Web Browser Paint"), STAT_XsollaWebBrowserPaint, STATGROUP_Xsolla);
+
+namespace XsollaWebBrowserContainer
+{
+	/** Number of frames box may be skipped by paint before browser is considered hidden */
+	const uint64 HiddenFrames = 2;
+} // namespace XsollaWebBrowserContainer
+
+void SXsollaWebBrowserContainer::Construct(const FArguments& InArgs)
+{
+	SBox::Construct(SBox::FArguments());
+
+	LastPaintFrame = 0;
+}
+
+int32 SXsollaWebBrowserContainer::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_XsollaWebBrowserPaint);
+
+	LastPaintFrame = GFrameCounter;
+
+	return SBox::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+}
+
+bool SXsollaWebBrowserContainer::WasPaintedRecently() const
+{
+	return LastPaintFrame != 0 && GFrameCounter - LastPaintFrame <= XsollaWebBrowserContainer::HiddenFrames;
+}
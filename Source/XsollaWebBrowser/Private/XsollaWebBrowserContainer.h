@@ -0,0 +1,28 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "Widgets/Layout/SBox.h"
+
+/** Box holding browser view of widget, remembers when it was painted to detect hidden browser */
+class SXsollaWebBrowserContainer : public SBox
+{
+public:
+	SLATE_BEGIN_ARGS(SXsollaWebBrowserContainer)
+	{
+	}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	// SWidget interface
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	// End of SWidget interface
+
+	/** True if box was painted in one of last frames (it's collapsed, hidden or removed otherwise) */
+	bool WasPaintedRecently() const;
+
+private:
+	mutable uint64 LastPaintFrame;
+};
@@ -0,0 +1,439 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaWebBrowserHost.h"
+
+#include "XsollaUtilsStats.h"
+#include "XsollaWebBrowser.h"
+#include "XsollaWebBrowserContainer.h"
+#include "XsollaWebBrowserModule.h"
+#include "XsollaWebBrowserSettings.h"
+
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "IWebBrowserSingleton.h"
+#include "IWebBrowserWindow.h"
+#include "Misc/Paths.h"
+#include "SWebBrowser.h"
+#include "WebBrowserModule.h"
+#include "Widgets/SNullWidget.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Web Browser Views Active"), STAT_XsollaWebBrowserViewsActive, STATGROUP_Xsolla);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Web Browser Views Throttled"), STAT_XsollaWebBrowserViewsThrottled, STATGROUP_Xsolla);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Web Browser Views Paused"), STAT_XsollaWebBrowserViewsPaused, STATGROUP_Xsolla);
+
+namespace XsollaWebBrowserHost
+{
+	static TAutoConsoleVariable<int32> CVarMaxInstances(
+		TEXT("Xsolla.WebBrowser.MaxInstances"),
+		1,
+		TEXT("Maximal number of browser instances shared by Xsolla browser widgets"));
+
+	static TAutoConsoleVariable<int32> CVarFrameRate(
+		TEXT("Xsolla.WebBrowser.FrameRate"),
+		24,
+		TEXT("Frame rate of visible Xsolla browser (applied to browsers created afterwards)"));
+
+	static TAutoConsoleVariable<float> CVarBackgroundFrameRate(
+		TEXT("Xsolla.WebBrowser.BackgroundFrameRate"),
+		1.f,
+		TEXT("Frame rate of occluded Xsolla browser or browser of inactive application (0 to pause)"));
+} // namespace XsollaWebBrowserHost
+
+const FString FXsollaWebBrowserHost::BlankUrl(TEXT("about:blank"));
+
+FXsollaWebBrowserHost::FXsollaWebBrowserHost()
+	: bBrowserContextInitialized(false)
+{
+}
+
+FXsollaWebBrowserHost::~FXsollaWebBrowserHost()
+{
+	if (NavigationTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(NavigationTickerHandle);
+		NavigationTickerHandle.Reset();
+	}
+
+	if (ThrottleTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(ThrottleTickerHandle);
+		ThrottleTickerHandle.Reset();
+	}
+
+	// Views should be closed before their context is unregistered
+	Slots.Empty();
+
+	if (BrowserContext.IsValid() && IWebBrowserModule::IsAvailable())
+	{
+		if (IWebBrowserSingleton* WebBrowserSingleton = IWebBrowserModule::Get().GetSingleton())
+		{
+			WebBrowserSingleton->UnregisterContext(BrowserContext->Id);
+		}
+	}
+}
+
+void FXsollaWebBrowserHost::Attach(UXsollaWebBrowser* Owner, bool bSupportsTransparency)
+{
+	check(Owner);
+
+	if (FindSlot(Owner) != INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 SlotIndex = ChooseSlot(bSupportsTransparency);
+	FBrowserSlot& Slot = Slots[SlotIndex];
+
+	if (UXsollaWebBrowser* PreviousOwner = Slot.Owner.Get())
+	{
+		PreviousOwner->SetBrowserView(nullptr);
+	}
+	else if (TSharedPtr<SXsollaWebBrowserContainer> PreviousContainer = Slot.Container.Pin())
+	{
+		// Widget was destroyed without releasing its slate, so view is still parented to its box
+		PreviousContainer->SetContent(SNullWidget::NullWidget);
+	}
+
+	// Transparency is set on browser creation only
+	if (!Slot.Browser.IsValid() || Slot.bSupportsTransparency != bSupportsTransparency)
+	{
+		CreateBrowser(SlotIndex, bSupportsTransparency);
+	}
+	else if (!Slot.QueuedUrl.IsEmpty() || Slot.Browser->GetUrl() != BlankUrl)
+	{
+		// Page of previous widget (social auth or payment one) shouldn't be shown until new widget navigates
+		Slot.Browser->LoadURL(BlankUrl);
+	}
+
+	Slot.Owner = Owner;
+	Slot.Container = Owner->BrowserContainer;
+	Slot.AttachTime = FPlatformTime::Seconds();
+	Slot.QueuedUrl.Empty();
+
+	Owner->SetBrowserView(Slot.Browser);
+}
+
+void FXsollaWebBrowserHost::Detach(UXsollaWebBrowser* Owner)
+{
+	const int32 SlotIndex = FindSlot(Owner);
+	if (SlotIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	Slots[SlotIndex].Owner.Reset();
+	Slots[SlotIndex].Container.Reset();
+	Owner->SetBrowserView(nullptr);
+
+	// Page of previous widget shouldn't stay loaded in free view
+	QueueNavigation(SlotIndex, BlankUrl);
+}
+
+void FXsollaWebBrowserHost::Navigate(UXsollaWebBrowser* Owner, const FString& Url)
+{
+	check(Owner);
+
+	// Widget without slate has nothing to show browser in
+	if (!Owner->BrowserContainer.IsValid())
+	{
+		return;
+	}
+
+	Attach(Owner, Owner->bSupportsTransparency);
+	QueueNavigation(FindSlot(Owner), Url);
+}
+
+FString FXsollaWebBrowserHost::GetUrl(const UXsollaWebBrowser* Owner) const
+{
+	const int32 SlotIndex = FindSlot(Owner);
+	if (SlotIndex == INDEX_NONE)
+	{
+		return FString();
+	}
+
+	const FBrowserSlot& Slot = Slots[SlotIndex];
+	return Slot.QueuedUrl.IsEmpty() ? Slot.Browser->GetUrl() : Slot.QueuedUrl;
+}
+
+void FXsollaWebBrowserHost::FlushNavigationQueue()
+{
+	for (FBrowserSlot& Slot : Slots)
+	{
+		if (!Slot.QueuedUrl.IsEmpty())
+		{
+			Slot.Browser->LoadURL(Slot.QueuedUrl);
+			Slot.QueuedUrl.Empty();
+		}
+	}
+}
+
+int32 FXsollaWebBrowserHost::GetBrowserCount() const
+{
+	return Slots.Num();
+}
+
+int32 FXsollaWebBrowserHost::FindSlot(const UXsollaWebBrowser* Owner) const
+{
+	return Slots.IndexOfByPredicate([Owner](const FBrowserSlot& Slot) {
+		return Slot.Owner.Get() == Owner;
+	});
+}
+
+int32 FXsollaWebBrowserHost::ChooseSlot(bool bSupportsTransparency)
+{
+	using namespace XsollaWebBrowserHost;
+
+	// Free view of the same kind is ready to use
+	int32 FreeSlot = INDEX_NONE;
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+	{
+		if (!Slots[SlotIndex].Owner.IsValid())
+		{
+			if (Slots[SlotIndex].bSupportsTransparency == bSupportsTransparency)
+			{
+				return SlotIndex;
+			}
+
+			FreeSlot = SlotIndex;
+		}
+	}
+
+	if (Slots.Num() < FMath::Max(CVarMaxInstances.GetValueOnGameThread(), 1))
+	{
+		return Slots.AddDefaulted();
+	}
+
+	if (FreeSlot != INDEX_NONE)
+	{
+		return FreeSlot;
+	}
+
+	int32 OldestSlot = 0;
+	for (int32 SlotIndex = 1; SlotIndex < Slots.Num(); ++SlotIndex)
+	{
+		if (Slots[SlotIndex].AttachTime < Slots[OldestSlot].AttachTime)
+		{
+			OldestSlot = SlotIndex;
+		}
+	}
+
+	return OldestSlot;
+}
+
+void FXsollaWebBrowserHost::CreateBrowser(int32 SlotIndex, bool bSupportsTransparency)
+{
+	using namespace XsollaWebBrowserHost;
+
+	FBrowserSlot& Slot = Slots[SlotIndex];
+
+	// Window is created here to control its rendering, view creates its own one if there is no singleton
+	Slot.BrowserWindow.Reset();
+	Slot.bHidden = false;
+	if (IWebBrowserSingleton* WebBrowserSingleton = IWebBrowserModule::Get().GetSingleton())
+	{
+		// Browser texture uses default materials
+		IXsollaWebBrowserModule::Get().LoadDefaultMaterials();
+
+		FCreateBrowserWindowSettings WindowSettings;
+		WindowSettings.InitialURL = BlankUrl;
+		WindowSettings.bUseTransparency = bSupportsTransparency;
+		WindowSettings.BrowserFrameRate = FMath::Clamp(CVarFrameRate.GetValueOnGameThread(), 1, 60);
+		WindowSettings.Context = GetBrowserContext();
+
+		Slot.BrowserWindow = WebBrowserSingleton->CreateBrowserWindow(WindowSettings);
+	}
+
+	// clang-format off
+	Slot.Browser = SNew(SWebBrowser, Slot.BrowserWindow)
+		.InitialURL(BlankUrl)
+		.ShowControls(false)
+		.SupportsTransparency(bSupportsTransparency)
+		.OnUrlChanged(FOnTextChanged::CreateRaw(this, &FXsollaWebBrowserHost::HandleOnUrlChanged, SlotIndex))
+		.OnBeforePopup(FOnBeforePopupDelegate::CreateRaw(this, &FXsollaWebBrowserHost::HandleOnBeforePopup, SlotIndex))
+		.OnBeforeNavigation(FOnBeforeBrowse::CreateRaw(this, &FXsollaWebBrowserHost::HandleOnBeforeNavigation, SlotIndex));
+	// clang-format on
+
+	Slot.bSupportsTransparency = bSupportsTransparency;
+
+	if (!ThrottleTickerHandle.IsValid())
+	{
+		ThrottleTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FXsollaWebBrowserHost::HandleThrottleTicker));
+	}
+}
+
+void FXsollaWebBrowserHost::QueueNavigation(int32 SlotIndex, const FString& Url)
+{
+	Slots[SlotIndex].QueuedUrl = Url;
+
+	if (!NavigationTickerHandle.IsValid())
+	{
+		NavigationTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FXsollaWebBrowserHost::HandleNavigationTicker));
+	}
+}
+
+bool FXsollaWebBrowserHost::HandleNavigationTicker(float DeltaTime)
+{
+	FlushNavigationQueue();
+
+	NavigationTickerHandle.Reset();
+	return false;
+}
+
+FBrowserContextSettings* FXsollaWebBrowserHost::GetBrowserContext()
+{
+	if (bBrowserContextInitialized)
+	{
+		return BrowserContext.Get();
+	}
+
+	bBrowserContextInitialized = true;
+
+	const UXsollaWebBrowserSettings* Settings = IXsollaWebBrowserModule::Get().GetSettings();
+	IWebBrowserSingleton* WebBrowserSingleton = IWebBrowserModule::Get().GetSingleton();
+	if (!Settings->UsePersistentBrowserContext || Settings->BrowserContextId.IsEmpty() || !WebBrowserSingleton)
+	{
+		return nullptr;
+	}
+
+	const FString CacheDir = FPaths::ProjectSavedDir() / TEXT("Xsolla") / TEXT("WebCache") / Settings->BrowserContextId;
+
+	// Cache files aren't used by browser until context is registered
+	TrimBrowserCache(CacheDir, static_cast<int64>(Settings->BrowserCacheSizeLimit) * 1024 * 1024);
+
+	BrowserContext = MakeUnique<FBrowserContextSettings>(Settings->BrowserContextId);
+	BrowserContext->CookieStorageLocation = FPaths::ConvertRelativePathToFull(CacheDir / TEXT("Profile"));
+	BrowserContext->bPersistSessionCookies = Settings->PersistSessionCookies;
+
+	if (!WebBrowserSingleton->RegisterContext(*BrowserContext))
+	{
+		BrowserContext.Reset();
+	}
+
+	return BrowserContext.Get();
+}
+
+void FXsollaWebBrowserHost::TrimBrowserCache(const FString& CacheDir, int64 SizeLimit)
+{
+	IFileManager& FileManager = IFileManager::Get();
+	if (SizeLimit <= 0 || !FileManager.DirectoryExists(*CacheDir))
+	{
+		return;
+	}
+
+	int64 CacheSize = 0;
+	FileManager.IterateDirectoryStatRecursively(*CacheDir, [&CacheSize](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData) {
+		if (!StatData.bIsDirectory)
+		{
+			CacheSize += StatData.FileSize;
+		}
+		return true;
+	});
+
+	if (CacheSize <= SizeLimit)
+	{
+		return;
+	}
+
+	// Only cached resources are removed, so cookies and local storage survive
+	static const TArray<FString> CacheDirNames = {TEXT("Cache"), TEXT("Code Cache"), TEXT("GPUCache")};
+
+	TArray<FString> Directories;
+	FileManager.FindFilesRecursive(Directories, *CacheDir, TEXT("*"), false, true);
+	for (const FString& Directory : Directories)
+	{
+		if (CacheDirNames.Contains(FPaths::GetCleanFilename(Directory)))
+		{
+			FileManager.DeleteDirectory(*Directory, false, true);
+		}
+	}
+}
+
+bool FXsollaWebBrowserHost::HandleThrottleTicker(float DeltaTime)
+{
+	using namespace XsollaWebBrowserHost;
+
+	const float BackgroundFrameRate = CVarBackgroundFrameRate.GetValueOnGameThread();
+	const double FrameTime = 1.0 / FMath::Clamp(CVarFrameRate.GetValueOnGameThread(), 1, 60);
+	const bool bApplicationActive = FSlateApplication::IsInitialized() && FSlateApplication::Get().IsActive();
+	const double Now = FPlatformTime::Seconds();
+
+	int32 ActiveViews = 0;
+	int32 ThrottledViews = 0;
+	int32 PausedViews = 0;
+
+	for (FBrowserSlot& Slot : Slots)
+	{
+		if (!Slot.BrowserWindow.IsValid())
+		{
+			continue;
+		}
+
+		const UXsollaWebBrowser* Owner = Slot.Owner.Get();
+
+		bool bHidden = false;
+		if (!Owner || !Owner->BrowserContainer.IsValid() || !Owner->BrowserContainer->WasPaintedRecently())
+		{
+			bHidden = true;
+			PausedViews++;
+		}
+		else if (Owner->bOccluded || !bApplicationActive)
+		{
+			// Throttled window is shown for a single frame at background rate
+			if (BackgroundFrameRate > 0.f && Now >= Slot.BackgroundFrameEndTime + 1.0 / BackgroundFrameRate)
+			{
+				Slot.BackgroundFrameEndTime = Now + FrameTime;
+			}
+
+			bHidden = Now >= Slot.BackgroundFrameEndTime;
+			ThrottledViews++;
+		}
+		else
+		{
+			ActiveViews++;
+		}
+
+		if (bHidden != Slot.bHidden)
+		{
+			Slot.BrowserWindow->SetIsHidden(bHidden);
+			Slot.bHidden = bHidden;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_XsollaWebBrowserViewsActive, ActiveViews);
+	SET_DWORD_STAT(STAT_XsollaWebBrowserViewsThrottled, ThrottledViews);
+	SET_DWORD_STAT(STAT_XsollaWebBrowserViewsPaused, PausedViews);
+
+	return true;
+}
+
+void FXsollaWebBrowserHost::HandleOnUrlChanged(const FText& Text, int32 SlotIndex)
+{
+	if (UXsollaWebBrowser* Owner = Slots[SlotIndex].Owner.Get())
+	{
+		Owner->HandleOnUrlChanged(Text);
+	}
+}
+
+bool FXsollaWebBrowserHost::HandleOnBeforePopup(FString URL, FString Frame, int32 SlotIndex)
+{
+	if (UXsollaWebBrowser* Owner = Slots[SlotIndex].Owner.Get())
+	{
+		return Owner->HandleOnBeforePopup(URL, Frame);
+	}
+
+	return false;
+}
+
+bool FXsollaWebBrowserHost::HandleOnBeforeNavigation(const FString& Url, const FWebNavigationRequest& Request, int32 SlotIndex)
+{
+	UXsollaWebBrowser* Owner = Slots[SlotIndex].Owner.Get();
+	if (Owner && Request.bIsMainFrame)
+	{
+		Owner->HandleOnBeforeNavigation(Url, Request.bIsRedirect);
+	}
+
+	// Navigation is never blocked
+	return false;
+}
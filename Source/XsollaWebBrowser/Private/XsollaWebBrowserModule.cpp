@@ -4,37 +4,107 @@
 #include "XsollaWebBrowserModule.h"
 
 #include "XsollaWebBrowserAssetManager.h"
+#include "XsollaWebBrowserHost.h"
+#include "XsollaWebBrowserSettings.h"
 
-#include "IWebBrowserSingleton.h"
+#include "Developer/Settings/Public/ISettingsModule.h"
 #include "Materials/Material.h"
 #include "Modules/ModuleManager.h"
-#include "WebBrowserModule.h"
+
+#define LOCTEXT_NAMESPACE "FXsollaWebBrowserModule"
 
 class FXsollaWebBrowserModule : public IXsollaWebBrowserModule
 {
 public:
+	FXsollaWebBrowserModule()
+		: WebBrowserAssetMgr(nullptr)
+		, XsollaWebBrowserSettings(nullptr)
+	{
+	}
+
 	virtual void StartupModule() override
 	{
+		XsollaWebBrowserSettings = NewObject<UXsollaWebBrowserSettings>(GetTransientPackage(), "XsollaWebBrowserSettings", RF_Standalone);
+		XsollaWebBrowserSettings->AddToRoot();
+
+		// Register settings
+		if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
+		{
+			SettingsModule->RegisterSettings("Project", "Plugins", "XsollaWebBrowser",
+				LOCTEXT("RuntimeSettingsName", "Xsolla Web Browser"),
+				LOCTEXT("RuntimeSettingsDescription", "Configure Xsolla Web Browser"),
+				XsollaWebBrowserSettings);
+		}
+
+		BrowserHost = MakeUnique<FXsollaWebBrowserHost>();
+
 		if (WebBrowserAssetMgr == nullptr)
 		{
 			WebBrowserAssetMgr = NewObject<UXsollaWebBrowserAssetManager>((UObject*)GetTransientPackage(), NAME_None, RF_Transient | RF_Public);
-			WebBrowserAssetMgr->LoadDefaultMaterials();
+			WebBrowserAssetMgr->AddToRoot();
+
+			// Materials are only needed by browser views, so startup doesn't wait for them
+			WebBrowserAssetMgr->PrefetchDefaultMaterials();
+		}
+	}
+
+	virtual void ShutdownModule() override
+	{
+		// Browser views should be destroyed before web browser module is shut down
+		BrowserHost.Reset();
+
+		if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
+		{
+			SettingsModule->UnregisterSettings("Project", "Plugins", "XsollaWebBrowser");
+		}
 
-			IWebBrowserSingleton* WebBrowserSingleton = IWebBrowserModule::Get().GetSingleton();
-			if (WebBrowserSingleton)
+		if (!GExitPurge)
+		{
+			// If we're in exit purge, this object has already been destroyed
+			XsollaWebBrowserSettings->RemoveFromRoot();
+
+			if (WebBrowserAssetMgr)
 			{
-				WebBrowserSingleton->SetDefaultMaterial(WebBrowserAssetMgr->GetDefaultMaterial());
-				WebBrowserSingleton->SetDefaultTranslucentMaterial(WebBrowserAssetMgr->GetDefaultTranslucentMaterial());
+				WebBrowserAssetMgr->RemoveFromRoot();
 			}
 		}
+		else
+		{
+			XsollaWebBrowserSettings = nullptr;
+		}
+
+		WebBrowserAssetMgr = nullptr;
 	}
 
-	virtual void ShutdownModule() override
+	virtual FXsollaWebBrowserHost& GetBrowserHost() override
+	{
+		check(BrowserHost.IsValid());
+		return *BrowserHost;
+	}
+
+	virtual void LoadDefaultMaterials() override
 	{
+		if (WebBrowserAssetMgr)
+		{
+			WebBrowserAssetMgr->LoadDefaultMaterials();
+		}
+	}
+
+	virtual UXsollaWebBrowserSettings* GetSettings() const override
+	{
+		check(XsollaWebBrowserSettings);
+		return XsollaWebBrowserSettings;
 	}
 
 private:
 	UXsollaWebBrowserAssetManager* WebBrowserAssetMgr;
+
+	/** Module settings */
+	UXsollaWebBrowserSettings* XsollaWebBrowserSettings;
+
+	TUniquePtr<FXsollaWebBrowserHost> BrowserHost;
 };
 
+#undef LOCTEXT_NAMESPACE
+
 IMPLEMENT_MODULE(FXsollaWebBrowserModule, XsollaWebBrowser);
@@ -0,0 +1,13 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaWebBrowserSettings.h"
+
+UXsollaWebBrowserSettings::UXsollaWebBrowserSettings(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	UsePersistentBrowserContext = true;
+	BrowserContextId = TEXT("Xsolla");
+	PersistSessionCookies = false;
+	BrowserCacheSizeLimit = 100;
+}
@@ -0,0 +1,108 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#include "XsollaWebBrowserWidgetPool.h"
+
+#include "XsollaWebBrowser.h"
+
+#include "Engine/World.h"
+
+UXsollaWebBrowserWidgetPool::UXsollaWebBrowserWidgetPool(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, Widget(nullptr)
+{
+}
+
+void UXsollaWebBrowserWidgetPool::Prewarm(UWorld* World, TSubclassOf<UUserWidget> WidgetClass)
+{
+	if (!World || !WidgetClass || FindWidget(World, WidgetClass))
+	{
+		return;
+	}
+
+	Reset();
+
+	Widget = CreateWidget<UUserWidget>(World, WidgetClass);
+	if (Widget)
+	{
+		// Building slate creates browser view and runs widget Construct
+		PrewarmedSlateWidget = Widget->TakeWidget();
+	}
+}
+
+UUserWidget* UXsollaWebBrowserWidgetPool::Acquire(UWorld* World, TSubclassOf<UUserWidget> WidgetClass, const FString& Url)
+{
+	UUserWidget* PooledWidget = FindWidget(World, WidgetClass);
+	if (!PooledWidget)
+	{
+		Reset();
+
+		Widget = CreateWidget<UUserWidget>(World, WidgetClass);
+		PooledWidget = Widget;
+	}
+	else
+	{
+		// Widget with live slate (prewarmed or still shown) won't run Construct, so it's navigated here.
+		// Browsers of closed widget have no slate and load pending url on Construct instead
+		LoadUrl(Url);
+	}
+
+	if (!PooledWidget)
+	{
+		return nullptr;
+	}
+
+	if (!PooledWidget->IsInViewport())
+	{
+		PooledWidget->AddToViewport(MAX_int32);
+	}
+	PrewarmedSlateWidget.Reset();
+
+	return PooledWidget;
+}
+
+void UXsollaWebBrowserWidgetPool::Reset()
+{
+	if (Widget && Widget->IsInViewport())
+	{
+		Widget->RemoveFromParent();
+	}
+
+	PrewarmedSlateWidget.Reset();
+	Widget = nullptr;
+}
+
+bool UXsollaWebBrowserWidgetPool::IsWarm(UWorld* World, TSubclassOf<UUserWidget> WidgetClass) const
+{
+	return FindWidget(World, WidgetClass) && !Widget->IsInViewport();
+}
+
+bool UXsollaWebBrowserWidgetPool::IsInUse() const
+{
+	return Widget && Widget->IsInViewport();
+}
+
+void UXsollaWebBrowserWidgetPool::BeginDestroy()
+{
+	PrewarmedSlateWidget.Reset();
+
+	Super::BeginDestroy();
+}
+
+UUserWidget* UXsollaWebBrowserWidgetPool::FindWidget(UWorld* World, TSubclassOf<UUserWidget> WidgetClass) const
+{
+	if (Widget && !Widget->IsPendingKill() && Widget->GetClass() == WidgetClass && Widget->GetWorld() == World)
+	{
+		return Widget;
+	}
+
+	return nullptr;
+}
+
+void UXsollaWebBrowserWidgetPool::LoadUrl(const FString& Url)
+{
+	for (UXsollaWebBrowser* Browser : UXsollaWebBrowser::FindBrowsers(Widget))
+	{
+		Browser->LoadURL(Url);
+	}
+}
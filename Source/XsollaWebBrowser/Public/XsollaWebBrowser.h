@@ -7,14 +7,22 @@
 
 #include "XsollaWebBrowser.generated.h"
 
+class FXsollaWebBrowserHost;
+class SXsollaWebBrowserContainer;
+class UUserWidget;
+
+/** Browser widget showing browser view of shared FXsollaWebBrowserHost */
 UCLASS()
 class XSOLLAWEBBROWSER_API UXsollaWebBrowser : public UWidget
 {
 	GENERATED_UCLASS_BODY()
 
+	friend class FXsollaWebBrowserHost;
+
 public:
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUrlChanged, const FText&, Text);
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBeforePopup, FString, URL, FString, Frame);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBeforeNavigation, FString, URL, bool, bIsRedirect);
 
 	/**
 	 * Load the specified URL
@@ -32,6 +40,19 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Xsolla|Web Browser")
 	FString GetUrl() const;
 
+	/** Return browser view to shared host so other widgets can use it. View is taken back on next LoadURL */
+	void ReleaseBrowser();
+
+	/**
+	 * Mark browser as covered by other UI, so it's rendered at background frame rate (Xsolla.WebBrowser.BackgroundFrameRate).
+	 * Collapsed or hidden browser is paused automatically.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Xsolla|Web Browser")
+	void SetOccluded(bool bInOccluded);
+
+	/** Get all browsers of user widget hierarchy */
+	static TArray<UXsollaWebBrowser*> FindBrowsers(UUserWidget* UserWidget);
+
 	/** Called when the Url changes. */
 	UPROPERTY(BlueprintAssignable, Category = "Xsolla|Web Browser")
 	FOnUrlChanged OnUrlChanged;
@@ -40,6 +61,10 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Xsolla|Web Browser")
 	FOnBeforePopup OnBeforePopup;
 
+	/** Called before main frame navigates to URL (including server redirects which don't change displayed Url). */
+	UPROPERTY(BlueprintAssignable, Category = "Xsolla|Web Browser")
+	FOnBeforeNavigation OnBeforeNavigation;
+
 public:
 	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
 
@@ -57,8 +82,15 @@ protected:
 	bool bSupportsTransparency;
 
 protected:
+	/** Browser view attached by host (can be taken by other widget) */
 	TSharedPtr<class SWebBrowser> WebBrowserWidget;
 
+	/** Holds attached browser view in widget hierarchy */
+	TSharedPtr<SXsollaWebBrowserContainer> BrowserContainer;
+
+	/** Whether browser is covered by other UI */
+	bool bOccluded;
+
 protected:
 	// UWidget interface
 	virtual TSharedRef<SWidget> RebuildWidget() override;
@@ -66,4 +98,11 @@ protected:
 
 	void HandleOnUrlChanged(const FText& Text);
 	bool HandleOnBeforePopup(FString URL, FString Frame);
+	void HandleOnBeforeNavigation(const FString& URL, bool bIsRedirect);
+
+private:
+	/** Show browser view given by host (nullptr when it's taken back) */
+	void SetBrowserView(TSharedPtr<SWebBrowser> BrowserView);
+
+	static FXsollaWebBrowserHost& GetBrowserHost();
 };
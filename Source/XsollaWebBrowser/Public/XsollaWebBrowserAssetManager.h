@@ -8,6 +8,7 @@
 
 #include "XsollaWebBrowserAssetManager.generated.h"
 
+class FXsollaUtilsAssetLoader;
 class UMaterial;
 
 UCLASS()
@@ -16,6 +17,10 @@ class XSOLLAWEBBROWSER_API UXsollaWebBrowserAssetManager : public UObject
 	GENERATED_UCLASS_BODY()
 
 public:
+	/** Start background loading of default materials, they're set to browser singleton once loaded */
+	void PrefetchDefaultMaterials();
+
+	/** Make sure default materials are loaded and set to browser singleton (blocks if they aren't) */
 	void LoadDefaultMaterials();
 
 	UMaterial* GetDefaultMaterial() const;
@@ -27,4 +32,9 @@ protected:
 
 	UPROPERTY()
 	TSoftObjectPtr<UMaterial> DefaultTranslucentMaterial;
+
+private:
+	void HandleDefaultMaterialsLoaded();
+
+	TSharedPtr<FXsollaUtilsAssetLoader> AssetLoader;
 };
@@ -0,0 +1,123 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/WeakObjectPtr.h"
+
+class IWebBrowserWindow;
+struct FBrowserContextSettings;
+class SWebBrowser;
+class SXsollaWebBrowserContainer;
+class UXsollaWebBrowser;
+struct FWebNavigationRequest;
+
+/**
+ * Owns browser views shared by all Xsolla browser widgets (Login, Store and PayStation ones),
+ * so a session keeps Xsolla.WebBrowser.MaxInstances browser instances at most instead of one per widget.
+ * Widget gets a browser view when it's built or navigated; if all views are used, the least recently
+ * attached one is taken from its widget. Navigations are queued and only the latest one per view is loaded.
+ * Views are paused while their widgets aren't painted and rendered at background frame rate while widget is
+ * occluded or application isn't active.
+ */
+class XSOLLAWEBBROWSER_API FXsollaWebBrowserHost
+{
+public:
+	FXsollaWebBrowserHost();
+	~FXsollaWebBrowserHost();
+
+	/** Give browser view to widget (taken from other widget if there is no free one) */
+	void Attach(UXsollaWebBrowser* Owner, bool bSupportsTransparency);
+
+	/** Return browser view of widget to host, view is navigated to about:blank */
+	void Detach(UXsollaWebBrowser* Owner);
+
+	/** Queue navigation of widget browser view, view is attached to widget if necessary */
+	void Navigate(UXsollaWebBrowser* Owner, const FString& Url);
+
+	/** Url widget browser view is navigated to (including queued navigation) */
+	FString GetUrl(const UXsollaWebBrowser* Owner) const;
+
+	/** Load queued navigations right now */
+	void FlushNavigationQueue();
+
+	/** Number of created browser views */
+	int32 GetBrowserCount() const;
+
+	/** Page loaded by free browser views and prewarmed widgets */
+	static const FString BlankUrl;
+
+private:
+	struct FBrowserSlot
+	{
+		TSharedPtr<SWebBrowser> Browser;
+		bool bSupportsTransparency;
+
+		/** Browser window rendering the view (invalid if platform has no browser singleton) */
+		TSharedPtr<IWebBrowserWindow> BrowserWindow;
+
+		/** Whether window rendering is paused */
+		bool bHidden;
+
+		/** Time until which throttled window renders */
+		double BackgroundFrameEndTime;
+
+		/** Widget the view is attached to */
+		TWeakObjectPtr<UXsollaWebBrowser> Owner;
+
+		/** Box of widget the view is shown in (can outlive destroyed widget) */
+		TWeakPtr<SXsollaWebBrowserContainer> Container;
+
+		/** Time of last attach, used to choose view taken from its widget */
+		double AttachTime;
+
+		/** Url to be loaded on queue flush */
+		FString QueuedUrl;
+
+		FBrowserSlot()
+			: bSupportsTransparency(false)
+			, bHidden(false)
+			, BackgroundFrameEndTime(0.0)
+			, AttachTime(0.0){};
+	};
+
+	/** Register persistent browser context if it's enabled in settings, returns nullptr otherwise */
+	FBrowserContextSettings* GetBrowserContext();
+
+	/** Clear cache of browser context if it exceeds size limit */
+	static void TrimBrowserCache(const FString& CacheDir, int64 SizeLimit);
+
+	/** Index of slot attached to widget or INDEX_NONE */
+	int32 FindSlot(const UXsollaWebBrowser* Owner) const;
+
+	/** Index of slot to be attached to new widget */
+	int32 ChooseSlot(bool bSupportsTransparency);
+
+	void CreateBrowser(int32 SlotIndex, bool bSupportsTransparency);
+
+	void QueueNavigation(int32 SlotIndex, const FString& Url);
+
+	bool HandleNavigationTicker(float DeltaTime);
+
+	/** Pause or throttle rendering of views which aren't visible */
+	bool HandleThrottleTicker(float DeltaTime);
+
+	void HandleOnUrlChanged(const FText& Text, int32 SlotIndex);
+	bool HandleOnBeforePopup(FString URL, FString Frame, int32 SlotIndex);
+	bool HandleOnBeforeNavigation(const FString& Url, const FWebNavigationRequest& Request, int32 SlotIndex);
+
+private:
+	TArray<FBrowserSlot> Slots;
+
+	FDelegateHandle NavigationTickerHandle;
+
+	FDelegateHandle ThrottleTickerHandle;
+
+	/** Persistent browser context shared by all views */
+	TUniquePtr<FBrowserContextSettings> BrowserContext;
+
+	/** Whether browser context was set up (context may be disabled) */
+	bool bBrowserContextInitialized;
+};
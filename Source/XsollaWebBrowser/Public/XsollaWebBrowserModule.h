@@ -5,6 +5,9 @@
 
 #include "Modules/ModuleManager.h"
 
+class FXsollaWebBrowserHost;
+class UXsollaWebBrowserSettings;
+
 class IXsollaWebBrowserModule : public IModuleInterface
 {
 
@@ -29,4 +32,13 @@ public:
 	{
 		return FModuleManager::Get().IsModuleLoaded("XsollaWebBrowser");
 	}
+
+	/** Get browser views shared by Xsolla browser widgets */
+	virtual FXsollaWebBrowserHost& GetBrowserHost() = 0;
+
+	/** Make sure default browser materials are loaded (they're loaded in background on module startup) */
+	virtual void LoadDefaultMaterials() = 0;
+
+	/** Getter for internal settings object to support runtime configuration changes */
+	virtual UXsollaWebBrowserSettings* GetSettings() const = 0;
 };
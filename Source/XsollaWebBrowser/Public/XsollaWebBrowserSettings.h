@@ -0,0 +1,34 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "UObject/Object.h"
+
+#include "XsollaWebBrowserSettings.generated.h"
+
+UCLASS(config = Engine, defaultconfig)
+class XSOLLAWEBBROWSER_API UXsollaWebBrowserSettings : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/**
+	 * If enabled, Xsolla browsers use named browser context with on-disk cache and cookies (Saved/Xsolla/WebCache),
+	 * so static resources of PayStation and login pages aren't downloaded again on each browser opening.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Web Browser Settings")
+	bool UsePersistentBrowserContext;
+
+	/** Name of browser context and its cache folder. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Web Browser Settings", meta = (EditCondition = "UsePersistentBrowserContext"))
+	FString BrowserContextId;
+
+	/** Enable to keep session cookies between application launches. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Web Browser Settings", meta = (EditCondition = "UsePersistentBrowserContext"))
+	bool PersistSessionCookies;
+
+	/** Maximal size (in megabytes) of browser cache on disk, cache is cleared on launch if it's exceeded. Set to zero for no limit. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Xsolla Web Browser Settings", meta = (EditCondition = "UsePersistentBrowserContext", ClampMin = "0"))
+	int32 BrowserCacheSizeLimit;
+};
@@ -0,0 +1,55 @@
+// Copyright 2019 Xsolla Inc. All Rights Reserved.
+// @author Vladimir Alyamkin <ufna@ufna.ru>
+
+#pragma once
+
+#include "Blueprint/UserWidget.h"
+
+#include "XsollaWebBrowserWidgetPool.generated.h"
+
+class UXsollaWebBrowser;
+
+/**
+ * Keeps single browser widget between uses, so widget is created once. Its browser view isn't owned by widget:
+ * closed widget releases its slate and gives the view back to FXsollaWebBrowserHost, which hands it over on next show.
+ * Widget is expected to load pending URL on Construct and to remove itself from parent when closed
+ * (as default W_StoreBrowser and W_PayStationBrowser do).
+ */
+UCLASS()
+class XSOLLAWEBBROWSER_API UXsollaWebBrowserWidgetPool : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/** Create widget and its browser view ahead of use. Pending URL of widget owner should be FXsollaWebBrowserHost::BlankUrl for that time */
+	void Prewarm(UWorld* World, TSubclassOf<UUserWidget> WidgetClass);
+
+	/** Show pooled widget (created if there is no warm one) and navigate it to url */
+	UUserWidget* Acquire(UWorld* World, TSubclassOf<UUserWidget> WidgetClass, const FString& Url);
+
+	/** Drop pooled widget */
+	void Reset();
+
+	/** True if widget of class is created and isn't used now */
+	bool IsWarm(UWorld* World, TSubclassOf<UUserWidget> WidgetClass) const;
+
+	/** True if pooled widget is shown now */
+	bool IsInUse() const;
+
+	// UObject interface
+	virtual void BeginDestroy() override;
+	// End of UObject interface
+
+private:
+	/** Pooled widget if it can be used in world with class, nullptr otherwise */
+	UUserWidget* FindWidget(UWorld* World, TSubclassOf<UUserWidget> WidgetClass) const;
+
+	/** Navigate all browsers of pooled widget */
+	void LoadUrl(const FString& Url);
+
+	UPROPERTY()
+	UUserWidget* Widget;
+
+	/** Keeps slate of prewarmed widget alive until it's shown, so its Construct isn't run twice */
+	TSharedPtr<SWidget> PrewarmedSlateWidget;
+};
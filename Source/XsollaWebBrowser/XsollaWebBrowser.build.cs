@@ -21,6 +21,13 @@ namespace UnrealBuildTool.Rules
                     "Engine"
                 }
             );
+
+            PrivateDependencyModuleNames.AddRange(
+                new string[]
+                {
+                    "XsollaUtils"
+                }
+            );
             
             if (Target.bBuildEditor || Target.Platform == UnrealTargetPlatform.Android || Target.Platform == UnrealTargetPlatform.IOS)
             {